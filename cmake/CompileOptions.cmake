@@ -115,6 +115,16 @@ if (CMAKE_CXX_COMPILER_ID MATCHES "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "Clang"
     )
 endif ()
 
+# SIMD code paths
+option(JET_USE_AVX2 "Build the SIMD code paths for AVX2 and FMA" OFF)
+if (JET_USE_AVX2)
+    if (CMAKE_CXX_COMPILER_ID MATCHES "MSVC")
+        set(DEFAULT_COMPILE_OPTIONS ${DEFAULT_COMPILE_OPTIONS} /arch:AVX2)
+    else ()
+        set(DEFAULT_COMPILE_OPTIONS ${DEFAULT_COMPILE_OPTIONS} -mavx2 -mfma)
+    endif ()
+endif ()
+
 
 #
 # Linker options
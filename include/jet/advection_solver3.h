@@ -11,9 +11,11 @@
 #include <jet/constant_scalar_field3.h>
 #include <jet/constants.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/point3.h>
 #include <jet/scalar_grid3.h>
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace jet {
 
@@ -56,6 +58,34 @@ class AdvectionSolver3 {
         const ScalarField3& boundarySdf
             = ConstantScalarField3(kMaxD)) = 0;
 
+    //!
+    //! \brief Solves advection equation for the listed data points of given
+    //! scalar grid.
+    //!
+    //! This function solves the same equation as the scalar grid version of
+    //! AdvectionSolver3::advect, but only updates the data points of \p output
+    //! listed in \p dataPoints. The other data points are left unchanged,
+    //! which lets narrow-band solvers pay only for the active region. The
+    //! default implementation advects the entire grid into a temporary grid
+    //! and copies the listed data points.
+    //!
+    //! \param input Input scalar grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param dataPoints Indices of the data points to update.
+    //! \param output Output scalar grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    virtual void advectDataPoints(
+        const ScalarGrid3& input,
+        const VectorField3& flow,
+        double dt,
+        const std::vector<Point3UI>& dataPoints,
+        ScalarGrid3* output,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD));
+
     //!
     //! \brief Solves advection equation for given collocated vector grid.
     //!
@@ -109,6 +139,78 @@ class AdvectionSolver3 {
         FaceCenteredGrid3* output,
         const ScalarField3& boundarySdf
             = ConstantScalarField3(kMaxD));
+
+    //!
+    //! \brief Solves advection equation for multiple scalar grids at once.
+    //!
+    //! This function solves the same equation as the scalar grid version of
+    //! AdvectionSolver3::advect for each pair of \p inputs and \p outputs with
+    //! the same \p flow. The implementation can trace the flow once for the
+    //! grids which share the data point positions and gather all of them from
+    //! the same departure point. The default implementation advects the grids
+    //! one by one.
+    //!
+    //! \param inputs Input scalar grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param outputs Output scalar grids, one for each input grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    virtual void advect(
+        const std::vector<const ScalarGrid3*>& inputs,
+        const VectorField3& flow,
+        double dt,
+        const std::vector<ScalarGrid3*>& outputs,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD));
+
+    //!
+    //! \brief Solves advection equation for multiple collocated vector grids
+    //! at once.
+    //!
+    //! This function is the collocated vector grid version of the batched
+    //! AdvectionSolver3::advect. The default implementation advects the grids
+    //! one by one.
+    //!
+    //! \param inputs Input vector grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param outputs Output vector grids, one for each input grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    virtual void advect(
+        const std::vector<const CollocatedVectorGrid3*>& inputs,
+        const VectorField3& flow,
+        double dt,
+        const std::vector<CollocatedVectorGrid3*>& outputs,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD));
+
+    //!
+    //! \brief Solves advection equation for multiple face-centered vector
+    //! grids at once.
+    //!
+    //! This function is the face-centered vector grid version of the batched
+    //! AdvectionSolver3::advect. The grids with the same shape share the u, v
+    //! and w face positions. The default implementation advects the grids one
+    //! by one.
+    //!
+    //! \param inputs Input vector grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param outputs Output vector grids, one for each input grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    virtual void advect(
+        const std::vector<const FaceCenteredGrid3*>& inputs,
+        const VectorField3& flow,
+        double dt,
+        const std::vector<FaceCenteredGrid3*>& outputs,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD));
 };
 
 //! Shared pointer type for the 3-D advection solver.
@@ -46,6 +46,9 @@ class ApicSolver2 : public PicSolver2 {
     //! Transfers velocity field from grids to particles.
     void transferFromGridsToParticles() override;
 
+    //! Reorders the affine velocity data along with the particles.
+    void onParticlesSorted(const ConstArrayAccessor1<size_t>& order) override;
+
  private:
     Array1<Vector2D> _cX;
     Array1<Vector2D> _cY;
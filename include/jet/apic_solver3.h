@@ -40,12 +40,21 @@ class ApicSolver3 : public PicSolver3 {
     static Builder builder();
 
  protected:
+    //! Stores the affine velocity of the particles to the checkpoint.
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the affine velocity of the particles from the checkpoint.
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //! Transfers velocity field from particles to grids.
     void transferFromParticlesToGrids() override;
 
     //! Transfers velocity field from grids to particles.
     void transferFromGridsToParticles() override;
 
+    //! Reorders the affine velocity data along with the particles.
+    void onParticlesSorted(const ConstArrayAccessor1<size_t>& order) override;
+
  private:
     Array1<Vector3D> _cX;
     Array1<Vector3D> _cY;
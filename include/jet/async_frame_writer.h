@@ -0,0 +1,104 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_ASYNC_FRAME_WRITER_H_
+#define INCLUDE_JET_ASYNC_FRAME_WRITER_H_
+
+#include <jet/animation.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Writes simulation frames on a background thread.
+//!
+//! This class overlaps the frame output with the simulation. The simulation
+//! thread copies the state it wants to save into a snapshot buffer of type T,
+//! and the background thread passes the snapshot to the write function while
+//! the simulation advances to the next frame. The snapshot buffers are taken
+//! from a fixed-size pool and reused, so the memory grows to at most
+//! maxNumberOfPendingFrames snapshots. When all the buffers are waiting to be
+//! written, write() blocks until the background thread frees one. The frames
+//! are written in the order they are submitted.
+//!
+//! \tparam T Snapshot buffer type. It must be default constructible.
+//!
+template <typename T>
+class AsyncFrameWriter final {
+ public:
+    //! Function that copies the state of given frame into the snapshot.
+    typedef std::function<void(const Frame&, T*)> SnapshotFunction;
+
+    //! Function that writes the snapshot of given frame.
+    typedef std::function<void(const Frame&, const T&)> WriteFunction;
+
+    //!
+    //! \brief Constructs a writer and starts its background thread.
+    //!
+    //! \param[in] writeFunction            The function that writes a
+    //!     snapshot. It is called from the background thread and should not
+    //!     throw.
+    //! \param[in] maxNumberOfPendingFrames The number of snapshot buffers.
+    //!
+    explicit AsyncFrameWriter(const WriteFunction& writeFunction,
+                              size_t maxNumberOfPendingFrames = 2);
+
+    AsyncFrameWriter(const AsyncFrameWriter&) = delete;
+
+    //! Writes the pending frames and stops the background thread.
+    ~AsyncFrameWriter();
+
+    AsyncFrameWriter& operator=(const AsyncFrameWriter&) = delete;
+
+    //! Returns the maximum number of frames waiting to be written.
+    size_t maxNumberOfPendingFrames() const;
+
+    //! Returns the number of frames that are not written yet.
+    size_t numberOfPendingFrames() const;
+
+    //!
+    //! \brief Takes a snapshot of given frame and queues it for writing.
+    //!
+    //! This function waits for a free snapshot buffer, calls snapshotFunction
+    //! with it on the calling thread, and returns without waiting for the
+    //! write. If snapshotFunction throws, the frame is not queued and the
+    //! exception is rethrown.
+    //!
+    //! \param[in] frame            The frame to write.
+    //! \param[in] snapshotFunction The function that fills the snapshot.
+    //!
+    void write(const Frame& frame, const SnapshotFunction& snapshotFunction);
+
+    //! Waits until all the queued frames are written.
+    void flush();
+
+ private:
+    WriteFunction _writeFunction;
+    std::vector<std::unique_ptr<T>> _buffers;
+    std::vector<T*> _freeBuffers;
+    std::deque<std::pair<Frame, T*>> _pendingFrames;
+    bool _isStopping = false;
+    mutable std::mutex _mutex;
+    std::condition_variable _bufferFreed;
+    std::condition_variable _frameQueued;
+    std::thread _thread;
+
+    void run();
+};
+
+}  // namespace jet
+
+#include "detail/async_frame_writer-inl.h"
+
+#endif  // INCLUDE_JET_ASYNC_FRAME_WRITER_H_
@@ -7,9 +7,11 @@
 #ifndef INCLUDE_JET_BVH2_H_
 #define INCLUDE_JET_BVH2_H_
 
+#include <jet/bvh_build_method.h>
 #include <jet/intersection_query_engine2.h>
 #include <jet/nearest_neighbor_query_engine2.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace jet {
@@ -22,6 +24,10 @@ namespace jet {
 //! intersection tests. Also, NearestNeighborQueryEngine2 is implemented to
 //! provide nearest neighbor query.
 //!
+//! The nodes are stored in a compact 24-byte layout with single-precision
+//! bounds, which are rounded outward from the item bounds so that the queries
+//! never miss an item. The number of items is limited to 2^31.
+//!
 template <typename T>
 class Bvh2 final : public IntersectionQueryEngine2<T>,
                    public NearestNeighborQueryEngine2<T> {
@@ -33,9 +39,29 @@ class Bvh2 final : public IntersectionQueryEngine2<T>,
     //! Default constructor.
     Bvh2();
 
-    //! Builds bounding volume hierarchy.
+    //!
+    //! \brief Builds bounding volume hierarchy.
+    //!
+    //! \param[in] items       The items to store.
+    //! \param[in] itemsBounds The bounding boxes of the items.
+    //! \param[in] method      The tree construction method.
+    //!
     void build(const std::vector<T>& items,
-               const std::vector<BoundingBox2D>& itemsBounds);
+               const std::vector<BoundingBox2D>& itemsBounds,
+               BvhBuildMethod method = BvhBuildMethod::kMidpoint);
+
+    //!
+    //! \brief Updates the bounds of the items while keeping the tree.
+    //!
+    //! This function recomputes the node bounds bottom-up from the new item
+    //! bounds, which is much faster than rebuilding the tree. The queries stay
+    //! correct, but the tree can become less efficient as the items move away
+    //! from where it was built.
+    //!
+    //! \param[in] itemsBounds The new bounding boxes of the items, in the
+    //!                        same order as the items given to build().
+    //!
+    void refit(const std::vector<BoundingBox2D>& itemsBounds);
 
     //! Clears all the contents of this instance.
     void clear();
@@ -92,17 +118,20 @@ class Bvh2 final : public IntersectionQueryEngine2<T>,
 
  private:
     struct Node {
-        char flags;
+        float lower[2];
+        uint32_t flags;
+        float upper[2];
         union {
-            size_t child;
-            size_t item;
+            uint32_t child;
+            uint32_t item;
         };
-        BoundingBox2D bound;
 
         Node();
         void initLeaf(size_t it, const BoundingBox2D& b);
         void initInternal(uint8_t axis, size_t c, const BoundingBox2D& b);
         bool isLeaf() const;
+        BoundingBox2D bound() const;
+        void setBound(const BoundingBox2D& b);
     };
 
     BoundingBox2D _bound;
@@ -113,6 +142,9 @@ class Bvh2 final : public IntersectionQueryEngine2<T>,
     size_t build(size_t nodeIndex, size_t* itemIndices, size_t nItems,
                  size_t currentDepth);
 
+    void buildSah(size_t nodeIndex, size_t* itemIndices, size_t nItems,
+                  const std::vector<Vector2D>& centroids);
+
     size_t qsplit(size_t* itemIndices, size_t numItems, double pivot,
                   uint8_t axis);
 };
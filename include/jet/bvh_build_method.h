@@ -0,0 +1,28 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_BVH_BUILD_METHOD_H_
+#define INCLUDE_JET_BVH_BUILD_METHOD_H_
+
+namespace jet {
+
+//! Tree construction methods for Bvh2 and Bvh3.
+enum class BvhBuildMethod {
+    //! Splits each node at the midpoint of its longest axis.
+    kMidpoint,
+
+    //!
+    //! Splits each node where the surface area heuristic (SAH), evaluated on
+    //! binned item centroids, is minimal. The subtrees are built in parallel.
+    //! Building is slower than kMidpoint, but the tree is better balanced for
+    //! the queries.
+    //!
+    kSah
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_BVH_BUILD_METHOD_H_
@@ -65,6 +65,51 @@ void pcg(
     unsigned int* lastNumberOfIterations,
     double* lastResidualNorm);
 
+//!
+//! \brief Solves conjugate gradient with fused BLAS kernels.
+//!
+//! This function is equivalent to cg, but it requires BlasType to provide
+//! mvmDot and axpyAxpyDot, which merge the matrix-vector multiplication, the
+//! vector updates, and the dot products into fewer passes over the vectors.
+//!
+template <typename BlasType>
+void cgFused(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm);
+
+//!
+//! \brief Solves pre-conditioned conjugate gradient with fused BLAS kernels.
+//!
+//! This function is equivalent to pcg, but it requires BlasType to provide
+//! mvmDot and axpyAxpyDot. See cgFused for the details. Like pcg, the
+//! convergence is tested with r.(M^-1)r, and the last residual norm is its
+//! square root.
+//!
+template <
+    typename BlasType,
+    typename PrecondType>
+void pcgFused(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    PrecondType* M,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm);
+
 }  // namespace jet
 
 #include "detail/cg-inl.h"
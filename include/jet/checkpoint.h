@@ -0,0 +1,150 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_CHECKPOINT_H_
+#define INCLUDE_JET_CHECKPOINT_H_
+
+#include <jet/array_accessor1.h>
+#include <jet/serialization.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Chunked container for the state of a simulation.
+//!
+//! A checkpoint is a set of named chunks of bytes. PhysicsAnimation and its
+//! subclasses store their parameters, buffers and data layers as separate
+//! chunks, so a reader can skip the chunks it does not know and keep the
+//! defaults for the chunks that are missing. The chunks are written to the
+//! file in the order of their names, after a header with the format version.
+//!
+class Checkpoint final : public Serializable {
+ public:
+    //! Version of the checkpoint file format.
+    static const uint32_t kVersion;
+
+    //! Constructs an empty checkpoint.
+    Checkpoint();
+
+    //! Returns the number of chunks.
+    size_t numberOfChunks() const;
+
+    //! Returns true if the chunk with given name exists.
+    bool hasChunk(const std::string& name) const;
+
+    //! Returns the chunk with given name. Throws if the chunk does not exist.
+    const std::vector<uint8_t>& chunk(const std::string& name) const;
+
+    //! Sets the chunk with given name.
+    void setChunk(const std::string& name, const std::vector<uint8_t>& data);
+
+    //! Removes all the chunks.
+    void clear();
+
+    //! Stores the plain value to the chunk with given name.
+    template <typename T>
+    void setValue(const std::string& name, const T& value);
+
+    //!
+    //! \brief Loads the plain value from the chunk with given
+    //!     name.
+    //!
+    //! \return False if the chunk does not exist. Throws if the size of the
+    //!     chunk does not match the value.
+    //!
+    template <typename T>
+    bool getValue(const std::string& name, T* value) const;
+
+    //! Stores the array of plain values to the chunk with given
+    //! name.
+    template <typename T>
+    void setArray(const std::string& name, const ConstArrayAccessor1<T>& array);
+
+    //!
+    //! \brief Loads the array of plain values from the chunk
+    //!     with given name.
+    //!
+    //! \return False if the chunk does not exist. Throws if the size of the
+    //!     chunk is not a multiple of the value size.
+    //!
+    template <typename T>
+    bool getArray(const std::string& name, std::vector<T>* array) const;
+
+    //!
+    //! \brief Stores the state of the random engine to the chunk with given
+    //!     name.
+    //!
+    //! The state is stored as text, which is the only portable way the
+    //! standard library provides to serialize it.
+    //!
+    template <typename RandomEngine>
+    void setRandomEngine(const std::string& name, const RandomEngine& engine);
+
+    //!
+    //! \brief Loads the state of the random engine from the chunk with
+    //!     given name.
+    //!
+    //! \return False if the chunk does not exist.
+    //!
+    template <typename RandomEngine>
+    bool getRandomEngine(const std::string& name, RandomEngine* engine) const;
+
+    //! Stores the serializable object to the chunk with given name.
+    void setData(const std::string& name, const Serializable& data);
+
+    //!
+    //! \brief Loads the serializable object from the chunk with given name.
+    //!
+    //! \return False if the chunk does not exist.
+    //!
+    bool getData(const std::string& name, Serializable* data) const;
+
+    //! Serializes the checkpoint into the buffer.
+    void serialize(std::vector<uint8_t>* buffer) const override;
+
+    //! Deserializes the checkpoint from the buffer. Throws if the buffer is
+    //! not a checkpoint of a supported version.
+    void deserialize(const std::vector<uint8_t>& buffer) override;
+
+    //!
+    //! \brief Writes the checkpoint to the file.
+    //!
+    //! The chunks are streamed to the file one by one without building the
+    //! whole file in memory.
+    //!
+    //! \return False if the file could not be written.
+    //!
+    bool save(const std::string& filename) const;
+
+    //!
+    //! \brief Reads the checkpoint from the file.
+    //!
+    //! \return False if the file could not be read or is not a checkpoint of
+    //!     a supported version. The checkpoint is empty in that case.
+    //!
+    bool load(const std::string& filename);
+
+ private:
+    std::map<std::string, std::vector<uint8_t>> _chunks;
+
+    std::vector<uint8_t>* chunkBuffer(const std::string& name);
+
+    bool readChunks(const uint8_t* data, size_t size);
+};
+
+//! Shared pointer for the Checkpoint type.
+typedef std::shared_ptr<Checkpoint> CheckpointPtr;
+
+}  // namespace jet
+
+#include "detail/checkpoint-inl.h"
+
+#endif  // INCLUDE_JET_CHECKPOINT_H_
@@ -7,8 +7,11 @@
 #ifndef INCLUDE_JET_COLLIDER3_H_
 #define INCLUDE_JET_COLLIDER3_H_
 
+#include <jet/checkpoint.h>
+#include <jet/implicit_surface3.h>
 #include <jet/surface3.h>
 #include <functional>
+#include <string>
 
 namespace jet {
 
@@ -41,6 +44,14 @@ class Collider3 {
     //! Returns the velocity of the collider at given \p point.
     virtual Vector3D velocityAt(const Vector3D& point) const = 0;
 
+    //!
+    //! \brief Returns the signed distance from the surface to given \p point.
+    //!
+    //! The distance is negative inside the collider. The default
+    //! implementation queries the surface directly.
+    //!
+    virtual double signedDistance(const Vector3D& point) const;
+
     //!
     //! Resolves collision for given point.
     //!
@@ -84,6 +95,23 @@ class Collider3 {
     //!
     void setOnBeginUpdateCallback(const OnBeginUpdateCallback& callback);
 
+    //!
+    //! \brief      Stores the state of the collider to the checkpoint.
+    //!
+    //! The friction coefficient and the transform of the surface are stored
+    //! in the chunks whose names start with \p prefix. The surface itself and
+    //! the callback function are not stored.
+    //!
+    //! \param[in]  prefix     The prefix of the chunk names.
+    //! \param      checkpoint The checkpoint to store the state.
+    //!
+    virtual void saveCheckpoint(const std::string& prefix,
+                                Checkpoint* checkpoint) const;
+
+    //! Restores the state of the collider from the checkpoint.
+    virtual void loadCheckpoint(const std::string& prefix,
+                                const Checkpoint& checkpoint);
+
  protected:
     //! Internal query result structure.
     struct ColliderQueryResult final {
@@ -97,7 +125,7 @@ class Collider3 {
     void setSurface(const Surface3Ptr& newSurface);
 
     //! Outputs closest point's information.
-    void getClosestPoint(
+    virtual void getClosestPoint(
         const Surface3Ptr& surface,
         const Vector3D& queryPoint,
         ColliderQueryResult* result) const;
@@ -110,6 +138,7 @@ class Collider3 {
 
  private:
     Surface3Ptr _surface;
+    ImplicitSurface3Ptr _implicitSurface;
     double _frictionCoeffient = 0.0;
     OnBeginUpdateCallback _onUpdateCallback;
 };
@@ -27,6 +27,14 @@ class ColliderSet3 final : public Collider3 {
     //! Returns the velocity of the collider at given \p point.
     Vector3D velocityAt(const Vector3D& point) const override;
 
+    //! Stores the state of the colliders in the set to the checkpoint.
+    void saveCheckpoint(const std::string& prefix,
+                        Checkpoint* checkpoint) const override;
+
+    //! Restores the state of the colliders in the set from the checkpoint.
+    void loadCheckpoint(const std::string& prefix,
+                        const Checkpoint& checkpoint) override;
+
     //! Adds a collider to the set.
     void addCollider(const Collider3Ptr& collider);
 
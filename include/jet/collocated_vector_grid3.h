@@ -82,6 +82,17 @@ class CollocatedVectorGrid3 : public VectorGrid3 {
     //! Returns sampled value at given position \p x.
     Vector3D sample(const Vector3D& x) const override;
 
+    //!
+    //! \brief Samples the grid at the given \p points.
+    //!
+    //! The points are sampled with the linear sampler directly, without going
+    //! through the sampler function object.
+    //!
+    void sample(
+        const ConstArrayAccessor1<Vector3D>& points,
+        ArrayAccessor1<Vector3D> result,
+        ExecutionPolicy policy = ExecutionPolicy::kParallel) const override;
+
     //! Returns divergence at given position \p x.
     double divergence(const Vector3D& x) const override;
 
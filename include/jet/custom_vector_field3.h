@@ -50,6 +50,12 @@ class CustomVectorField3 final : public VectorField3 {
     //! Returns the sampled value at given position \p x.
     Vector3D sample(const Vector3D& x) const override;
 
+    //! Samples the field at the given \p points.
+    void sample(
+        const ConstArrayAccessor1<Vector3D>& points,
+        ArrayAccessor1<Vector3D> result,
+        ExecutionPolicy policy = ExecutionPolicy::kParallel) const override;
+
     //! Returns the divergence at given position \p x.
     double divergence(const Vector3D& x) const override;
 
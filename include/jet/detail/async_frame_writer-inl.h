@@ -0,0 +1,112 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_ASYNC_FRAME_WRITER_INL_H_
+#define INCLUDE_JET_DETAIL_ASYNC_FRAME_WRITER_INL_H_
+
+#include <jet/macros.h>
+
+namespace jet {
+
+template <typename T>
+AsyncFrameWriter<T>::AsyncFrameWriter(const WriteFunction& writeFunction,
+                                      size_t maxNumberOfPendingFrames)
+    : _writeFunction(writeFunction) {
+    JET_THROW_INVALID_ARG_IF(maxNumberOfPendingFrames == 0);
+
+    for (size_t i = 0; i < maxNumberOfPendingFrames; ++i) {
+        _buffers.emplace_back(new T());
+        _freeBuffers.push_back(_buffers.back().get());
+    }
+
+    _thread = std::thread(&AsyncFrameWriter::run, this);
+}
+
+template <typename T>
+AsyncFrameWriter<T>::~AsyncFrameWriter() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _frameQueued.notify_one();
+    _thread.join();
+}
+
+template <typename T>
+size_t AsyncFrameWriter<T>::maxNumberOfPendingFrames() const {
+    return _buffers.size();
+}
+
+template <typename T>
+size_t AsyncFrameWriter<T>::numberOfPendingFrames() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _buffers.size() - _freeBuffers.size();
+}
+
+template <typename T>
+void AsyncFrameWriter<T>::write(const Frame& frame,
+                                const SnapshotFunction& snapshotFunction) {
+    T* buffer;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _bufferFreed.wait(lock, [this] { return !_freeBuffers.empty(); });
+        buffer = _freeBuffers.back();
+        _freeBuffers.pop_back();
+    }
+
+    // The buffer is owned by this thread until it is queued, so the
+    // snapshot is taken without holding the lock. If the snapshot fails, the
+    // buffer goes back to the pool so that flush() does not wait for it.
+    try {
+        snapshotFunction(frame, buffer);
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _freeBuffers.push_back(buffer);
+        }
+        _bufferFreed.notify_all();
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pendingFrames.emplace_back(frame, buffer);
+    }
+    _frameQueued.notify_one();
+}
+
+template <typename T>
+void AsyncFrameWriter<T>::flush() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _bufferFreed.wait(
+        lock, [this] { return _freeBuffers.size() == _buffers.size(); });
+}
+
+template <typename T>
+void AsyncFrameWriter<T>::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _frameQueued.wait(
+            lock, [this] { return _isStopping || !_pendingFrames.empty(); });
+        if (_pendingFrames.empty()) {
+            break;
+        }
+
+        const std::pair<Frame, T*> pendingFrame = _pendingFrames.front();
+        _pendingFrames.pop_front();
+
+        lock.unlock();
+        _writeFunction(pendingFrame.first, *pendingFrame.second);
+        lock.lock();
+
+        _freeBuffers.push_back(pendingFrame.second);
+        _bufferFreed.notify_all();
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_ASYNC_FRAME_WRITER_INL_H_
@@ -10,29 +10,55 @@
 #include <jet/bvh2.h>
 #include <jet/constants.h>
 #include <jet/math_utils.h>
+#include <jet/parallel.h>
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <numeric>
 
 namespace jet {
 
+namespace internal {
+
+// Number of centroid bins per axis for the SAH builder
+const size_t kBvh2NumSahBins = 16;
+
+// Subtrees with fewer items than this are built serially.
+const size_t kBvh2MinParallelBuildItems = 1024;
+
+// Returns the half perimeter of the box, which is the 2-D analogue of the
+// surface area.
+inline double bvh2HalfPerimeter(const BoundingBox2D& box) {
+    if (box.lowerCorner.x > box.upperCorner.x) {
+        return 0.0;
+    }
+
+    const Vector2D d = box.upperCorner - box.lowerCorner;
+    return d.x + d.y;
+}
+
+}  // namespace internal
+
 template <typename T>
 Bvh2<T>::Node::Node() : flags(0) {
-    child = kMaxSize;
+    child = std::numeric_limits<uint32_t>::max();
+    setBound(BoundingBox2D());
 }
 
 template <typename T>
 void Bvh2<T>::Node::initLeaf(size_t it, const BoundingBox2D& b) {
     flags = 2;
-    item = it;
-    bound = b;
+    item = static_cast<uint32_t>(it);
+    setBound(b);
 }
 
 template <typename T>
 void Bvh2<T>::Node::initInternal(uint8_t axis, size_t c,
                                  const BoundingBox2D& b) {
     flags = axis;
-    child = c;
-    bound = b;
+    child = static_cast<uint32_t>(c);
+    setBound(b);
 }
 
 template <typename T>
@@ -40,6 +66,21 @@ bool Bvh2<T>::Node::isLeaf() const {
     return flags == 2;
 }
 
+template <typename T>
+BoundingBox2D Bvh2<T>::Node::bound() const {
+    return BoundingBox2D(Vector2D(lower[0], lower[1]),
+                         Vector2D(upper[0], upper[1]));
+}
+
+template <typename T>
+void Bvh2<T>::Node::setBound(const BoundingBox2D& b) {
+    // Round outward so that the node bound contains the original one.
+    for (int i = 0; i < 2; ++i) {
+        lower[i] = floorToFloat(b.lowerCorner[i]);
+        upper[i] = ceilToFloat(b.upperCorner[i]);
+    }
+}
+
 //
 
 template <typename T>
@@ -47,16 +88,21 @@ Bvh2<T>::Bvh2() {}
 
 template <typename T>
 void Bvh2<T>::build(const std::vector<T>& items,
-                    const std::vector<BoundingBox2D>& itemsBounds) {
+                    const std::vector<BoundingBox2D>& itemsBounds,
+                    BvhBuildMethod method) {
+    JET_THROW_INVALID_ARG_IF(items.size() != itemsBounds.size());
+    JET_THROW_INVALID_ARG_IF(items.size() >
+                             std::numeric_limits<uint32_t>::max() / 2);
+
     _items = items;
     _itemBounds = itemsBounds;
+    _bound = BoundingBox2D();
+    _nodes.clear();
 
     if (_items.empty()) {
         return;
     }
 
-    _nodes.clear();
-
     for (size_t i = 0; i < _items.size(); ++i) {
         _bound.merge(_itemBounds[i]);
     }
@@ -64,7 +110,45 @@ void Bvh2<T>::build(const std::vector<T>& items,
     std::vector<size_t> itemIndices(_items.size());
     std::iota(std::begin(itemIndices), std::end(itemIndices), 0);
 
-    build(0, itemIndices.data(), _items.size(), 0);
+    if (method == BvhBuildMethod::kSah) {
+        std::vector<Vector2D> centroids(_items.size());
+        parallelFor(kZeroSize, _items.size(), [&](size_t i) {
+            centroids[i] = _itemBounds[i].midPoint();
+        });
+
+        // A tree with single-item leaves has 2n - 1 nodes, which lets the
+        // subtrees write to their own ranges in parallel.
+        _nodes.resize(2 * _items.size() - 1);
+        buildSah(0, itemIndices.data(), _items.size(), centroids);
+    } else {
+        build(0, itemIndices.data(), _items.size(), 0);
+    }
+}
+
+template <typename T>
+void Bvh2<T>::refit(const std::vector<BoundingBox2D>& itemsBounds) {
+    JET_THROW_INVALID_ARG_IF(itemsBounds.size() != _items.size());
+
+    _itemBounds = itemsBounds;
+    _bound = BoundingBox2D();
+    for (const auto& b : _itemBounds) {
+        _bound.merge(b);
+    }
+
+    // Children are always stored after their parent.
+    for (size_t i = _nodes.size(); i > 0; --i) {
+        Node& node = _nodes[i - 1];
+        if (node.isLeaf()) {
+            node.setBound(_itemBounds[node.item]);
+        } else {
+            const Node& left = _nodes[i];
+            const Node& right = _nodes[node.child];
+            for (int a = 0; a < 2; ++a) {
+                node.lower[a] = std::min(left.lower[a], right.lower[a]);
+                node.upper[a] = std::max(left.upper[a], right.upper[a]);
+            }
+        }
+    }
 }
 
 template <typename T>
@@ -116,8 +200,8 @@ inline NearestNeighborQueryResult2<T> Bvh2<T>::nearest(
             // identical to pt. This will make distMinLeftSqr and
             // distMinRightSqr zero, meaning that such a box will have higher
             // priority.
-            Vector2D closestLeft = left->bound.clamp(pt);
-            Vector2D closestRight = right->bound.clamp(pt);
+            Vector2D closestLeft = left->bound().clamp(pt);
+            Vector2D closestRight = right->bound().clamp(pt);
 
             double distMinLeftSqr = closestLeft.distanceSquaredTo(pt);
             double distMinRightSqr = closestRight.distanceSquaredTo(pt);
@@ -191,12 +275,12 @@ inline bool Bvh2<T>::intersects(const BoundingBox2D& box,
         } else {
             // get node children pointers for box
             const Node* firstChild = node + 1;
-            const Node* secondChild = (Node*)&_nodes[node->child];
+            const Node* secondChild = &_nodes[node->child];
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.overlaps(box)) {
+            if (!firstChild->bound().overlaps(box)) {
                 node = secondChild;
-            } else if (!secondChild->bound.overlaps(box)) {
+            } else if (!secondChild->bound().overlaps(box)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -245,16 +329,16 @@ inline bool Bvh2<T>::intersects(const Ray2D& ray,
             const Node* secondChild;
             if (ray.direction[node->flags] > 0.0) {
                 firstChild = node + 1;
-                secondChild = (Node*)&_nodes[node->child];
+                secondChild = &_nodes[node->child];
             } else {
-                firstChild = (Node*)&_nodes[node->child];
+                firstChild = &_nodes[node->child];
                 secondChild = node + 1;
             }
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.intersects(ray)) {
+            if (!firstChild->bound().intersects(ray)) {
                 node = secondChild;
-            } else if (!secondChild->bound.intersects(ray)) {
+            } else if (!secondChild->bound().intersects(ray)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -301,12 +385,12 @@ inline void Bvh2<T>::forEachIntersectingItem(
         } else {
             // get node children pointers for box
             const Node* firstChild = node + 1;
-            const Node* secondChild = (Node*)&_nodes[node->child];
+            const Node* secondChild = &_nodes[node->child];
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.overlaps(box)) {
+            if (!firstChild->bound().overlaps(box)) {
                 node = secondChild;
-            } else if (!secondChild->bound.overlaps(box)) {
+            } else if (!secondChild->bound().overlaps(box)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -354,16 +438,16 @@ inline void Bvh2<T>::forEachIntersectingItem(
             const Node* secondChild;
             if (ray.direction[node->flags] > 0.0) {
                 firstChild = node + 1;
-                secondChild = (Node*)&_nodes[node->child];
+                secondChild = &_nodes[node->child];
             } else {
-                firstChild = (Node*)&_nodes[node->child];
+                firstChild = &_nodes[node->child];
                 secondChild = node + 1;
             }
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.intersects(ray)) {
+            if (!firstChild->bound().intersects(ray)) {
                 node = secondChild;
-            } else if (!secondChild->bound.intersects(ray)) {
+            } else if (!secondChild->bound().intersects(ray)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -416,16 +500,16 @@ inline ClosestIntersectionQueryResult2<T> Bvh2<T>::closestIntersection(
             const Node* secondChild;
             if (ray.direction[node->flags] > 0.0) {
                 firstChild = node + 1;
-                secondChild = (Node*)&_nodes[node->child];
+                secondChild = &_nodes[node->child];
             } else {
-                firstChild = (Node*)&_nodes[node->child];
+                firstChild = &_nodes[node->child];
                 secondChild = node + 1;
             }
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.intersects(ray)) {
+            if (!firstChild->bound().intersects(ray)) {
                 node = secondChild;
-            } else if (!secondChild->bound.intersects(ray)) {
+            } else if (!secondChild->bound().intersects(ray)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -517,6 +601,121 @@ size_t Bvh2<T>::build(size_t nodeIndex, size_t* itemIndices, size_t nItems,
     return std::max(d0, d1);
 }
 
+template <typename T>
+void Bvh2<T>::buildSah(size_t nodeIndex, size_t* itemIndices, size_t nItems,
+                       const std::vector<Vector2D>& centroids) {
+    using internal::kBvh2NumSahBins;
+
+    if (nItems == 1) {
+        _nodes[nodeIndex].initLeaf(itemIndices[0], _itemBounds[itemIndices[0]]);
+        return;
+    }
+
+    BoundingBox2D nodeBound;
+    BoundingBox2D centroidBound;
+    for (size_t i = 0; i < nItems; ++i) {
+        nodeBound.merge(_itemBounds[itemIndices[i]]);
+        centroidBound.merge(centroids[itemIndices[i]]);
+    }
+
+    // Find the bin boundary with the lowest SAH cost along each axis.
+    uint8_t axis = 0;
+    size_t split = 0;
+    double bestCost = kMaxD;
+    const Vector2D extent =
+        centroidBound.upperCorner - centroidBound.lowerCorner;
+    for (uint8_t a = 0; a < 2; ++a) {
+        if (!(extent[a] > 0.0)) {
+            continue;
+        }
+
+        std::array<size_t, kBvh2NumSahBins> counts;
+        std::array<BoundingBox2D, kBvh2NumSahBins> bounds;
+        counts.fill(0);
+
+        const double scale = kBvh2NumSahBins / extent[a];
+        for (size_t i = 0; i < nItems; ++i) {
+            const size_t idx = itemIndices[i];
+            const size_t b = std::min(
+                static_cast<size_t>(
+                    (centroids[idx][a] - centroidBound.lowerCorner[a]) * scale),
+                kBvh2NumSahBins - 1);
+            ++counts[b];
+            bounds[b].merge(_itemBounds[idx]);
+        }
+
+        // Sweep from the right to get the costs of the right sides.
+        std::array<double, kBvh2NumSahBins> rightCosts;
+        BoundingBox2D rightBound;
+        size_t rightCount = 0;
+        for (size_t b = kBvh2NumSahBins - 1; b > 0; --b) {
+            rightBound.merge(bounds[b]);
+            rightCount += counts[b];
+            rightCosts[b] =
+                rightCount * internal::bvh2HalfPerimeter(rightBound);
+        }
+
+        BoundingBox2D leftBound;
+        size_t leftCount = 0;
+        for (size_t b = 1; b < kBvh2NumSahBins; ++b) {
+            leftBound.merge(bounds[b - 1]);
+            leftCount += counts[b - 1];
+            if (leftCount == 0 || leftCount == nItems) {
+                continue;
+            }
+
+            const double cost =
+                leftCount * internal::bvh2HalfPerimeter(leftBound) +
+                rightCosts[b];
+            if (cost < bestCost) {
+                bestCost = cost;
+                axis = a;
+                split = b;
+            }
+        }
+    }
+
+    size_t midPoint;
+    if (split > 0) {
+        const double lower = centroidBound.lowerCorner[axis];
+        const double scale = kBvh2NumSahBins / extent[axis];
+        midPoint = static_cast<size_t>(
+            std::partition(itemIndices, itemIndices + nItems,
+                           [&](size_t idx) {
+                               const size_t b = std::min(
+                                   static_cast<size_t>(
+                                       (centroids[idx][axis] - lower) * scale),
+                                   kBvh2NumSahBins - 1);
+                               return b < split;
+                           }) -
+            itemIndices);
+    } else {
+        // All the centroids are at the same position.
+        const Vector2D d = nodeBound.upperCorner - nodeBound.lowerCorner;
+        axis = (d.x > d.y) ? 0 : 1;
+        midPoint = nItems / 2;
+    }
+
+    const size_t rightIndex = nodeIndex + 2 * midPoint;
+    _nodes[nodeIndex].initInternal(axis, rightIndex, nodeBound);
+
+    auto buildChild = [&](size_t c) {
+        if (c == 0) {
+            buildSah(nodeIndex + 1, itemIndices, midPoint, centroids);
+        } else {
+            buildSah(rightIndex, itemIndices + midPoint, nItems - midPoint,
+                     centroids);
+        }
+    };
+
+    if (nItems >= internal::kBvh2MinParallelBuildItems) {
+        parallelFor(kZeroSize, static_cast<size_t>(2), buildChild);
+    } else {
+        buildChild(0);
+        buildChild(1);
+    }
+}
+
 template <typename T>
 size_t Bvh2<T>::qsplit(size_t* itemIndices, size_t numItems, double pivot,
                        uint8_t axis) {
@@ -10,29 +10,54 @@
 #include <jet/bvh3.h>
 #include <jet/constants.h>
 #include <jet/math_utils.h>
+#include <jet/parallel.h>
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <numeric>
 
 namespace jet {
 
+namespace internal {
+
+// Number of centroid bins per axis for the SAH builder
+const size_t kBvh3NumSahBins = 16;
+
+// Subtrees with fewer items than this are built serially.
+const size_t kBvh3MinParallelBuildItems = 1024;
+
+// Returns the half surface area of the box.
+inline double bvh3HalfArea(const BoundingBox3D& box) {
+    if (box.lowerCorner.x > box.upperCorner.x) {
+        return 0.0;
+    }
+
+    const Vector3D d = box.upperCorner - box.lowerCorner;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+}  // namespace internal
+
 template <typename T>
 Bvh3<T>::Node::Node() : flags(0) {
-    child = kMaxSize;
+    child = std::numeric_limits<uint32_t>::max();
+    setBound(BoundingBox3D());
 }
 
 template <typename T>
 void Bvh3<T>::Node::initLeaf(size_t it, const BoundingBox3D& b) {
     flags = 3;
-    item = it;
-    bound = b;
+    item = static_cast<uint32_t>(it);
+    setBound(b);
 }
 
 template <typename T>
 void Bvh3<T>::Node::initInternal(uint8_t axis, size_t c,
                                  const BoundingBox3D& b) {
     flags = axis;
-    child = c;
-    bound = b;
+    child = static_cast<uint32_t>(c);
+    setBound(b);
 }
 
 template <typename T>
@@ -40,6 +65,21 @@ bool Bvh3<T>::Node::isLeaf() const {
     return flags == 3;
 }
 
+template <typename T>
+BoundingBox3D Bvh3<T>::Node::bound() const {
+    return BoundingBox3D(Vector3D(lower[0], lower[1], lower[2]),
+                         Vector3D(upper[0], upper[1], upper[2]));
+}
+
+template <typename T>
+void Bvh3<T>::Node::setBound(const BoundingBox3D& b) {
+    // Round outward so that the node bound contains the original one.
+    for (int i = 0; i < 3; ++i) {
+        lower[i] = floorToFloat(b.lowerCorner[i]);
+        upper[i] = ceilToFloat(b.upperCorner[i]);
+    }
+}
+
 //
 
 template <typename T>
@@ -47,16 +87,21 @@ Bvh3<T>::Bvh3() {}
 
 template <typename T>
 void Bvh3<T>::build(const std::vector<T>& items,
-                    const std::vector<BoundingBox3D>& itemsBounds) {
+                    const std::vector<BoundingBox3D>& itemsBounds,
+                    BvhBuildMethod method) {
+    JET_THROW_INVALID_ARG_IF(items.size() != itemsBounds.size());
+    JET_THROW_INVALID_ARG_IF(items.size() >
+                             std::numeric_limits<uint32_t>::max() / 2);
+
     _items = items;
     _itemBounds = itemsBounds;
+    _bound = BoundingBox3D();
+    _nodes.clear();
 
     if (_items.empty()) {
         return;
     }
 
-    _nodes.clear();
-
     for (size_t i = 0; i < _items.size(); ++i) {
         _bound.merge(_itemBounds[i]);
     }
@@ -64,7 +109,45 @@ void Bvh3<T>::build(const std::vector<T>& items,
     std::vector<size_t> itemIndices(_items.size());
     std::iota(std::begin(itemIndices), std::end(itemIndices), 0);
 
-    build(0, itemIndices.data(), _items.size(), 0);
+    if (method == BvhBuildMethod::kSah) {
+        std::vector<Vector3D> centroids(_items.size());
+        parallelFor(kZeroSize, _items.size(), [&](size_t i) {
+            centroids[i] = _itemBounds[i].midPoint();
+        });
+
+        // A tree with single-item leaves has 2n - 1 nodes, which lets the
+        // subtrees write to their own ranges in parallel.
+        _nodes.resize(2 * _items.size() - 1);
+        buildSah(0, itemIndices.data(), _items.size(), centroids);
+    } else {
+        build(0, itemIndices.data(), _items.size(), 0);
+    }
+}
+
+template <typename T>
+void Bvh3<T>::refit(const std::vector<BoundingBox3D>& itemsBounds) {
+    JET_THROW_INVALID_ARG_IF(itemsBounds.size() != _items.size());
+
+    _itemBounds = itemsBounds;
+    _bound = BoundingBox3D();
+    for (const auto& b : _itemBounds) {
+        _bound.merge(b);
+    }
+
+    // Children are always stored after their parent.
+    for (size_t i = _nodes.size(); i > 0; --i) {
+        Node& node = _nodes[i - 1];
+        if (node.isLeaf()) {
+            node.setBound(_itemBounds[node.item]);
+        } else {
+            const Node& left = _nodes[i];
+            const Node& right = _nodes[node.child];
+            for (int a = 0; a < 3; ++a) {
+                node.lower[a] = std::min(left.lower[a], right.lower[a]);
+                node.upper[a] = std::max(left.upper[a], right.upper[a]);
+            }
+        }
+    }
 }
 
 template <typename T>
@@ -116,8 +199,8 @@ inline NearestNeighborQueryResult3<T> Bvh3<T>::nearest(
             // identical to pt. This will make distMinLeftSqr and
             // distMinRightSqr zero, meaning that such a box will have higher
             // priority.
-            Vector3D closestLeft = left->bound.clamp(pt);
-            Vector3D closestRight = right->bound.clamp(pt);
+            Vector3D closestLeft = left->bound().clamp(pt);
+            Vector3D closestRight = right->bound().clamp(pt);
 
             double distMinLeftSqr = closestLeft.distanceSquaredTo(pt);
             double distMinRightSqr = closestRight.distanceSquaredTo(pt);
@@ -191,12 +274,12 @@ inline bool Bvh3<T>::intersects(const BoundingBox3D& box,
         } else {
             // get node children pointers for box
             const Node* firstChild = node + 1;
-            const Node* secondChild = (Node*)&_nodes[node->child];
+            const Node* secondChild = &_nodes[node->child];
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.overlaps(box)) {
+            if (!firstChild->bound().overlaps(box)) {
                 node = secondChild;
-            } else if (!secondChild->bound.overlaps(box)) {
+            } else if (!secondChild->bound().overlaps(box)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -245,16 +328,16 @@ inline bool Bvh3<T>::intersects(const Ray3D& ray,
             const Node* secondChild;
             if (ray.direction[node->flags] > 0.0) {
                 firstChild = node + 1;
-                secondChild = (Node*)&_nodes[node->child];
+                secondChild = &_nodes[node->child];
             } else {
-                firstChild = (Node*)&_nodes[node->child];
+                firstChild = &_nodes[node->child];
                 secondChild = node + 1;
             }
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.intersects(ray)) {
+            if (!firstChild->bound().intersects(ray)) {
                 node = secondChild;
-            } else if (!secondChild->bound.intersects(ray)) {
+            } else if (!secondChild->bound().intersects(ray)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -301,12 +384,12 @@ inline void Bvh3<T>::forEachIntersectingItem(
         } else {
             // get node children pointers for box
             const Node* firstChild = node + 1;
-            const Node* secondChild = (Node*)&_nodes[node->child];
+            const Node* secondChild = &_nodes[node->child];
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.overlaps(box)) {
+            if (!firstChild->bound().overlaps(box)) {
                 node = secondChild;
-            } else if (!secondChild->bound.overlaps(box)) {
+            } else if (!secondChild->bound().overlaps(box)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -354,16 +437,16 @@ inline void Bvh3<T>::forEachIntersectingItem(
             const Node* secondChild;
             if (ray.direction[node->flags] > 0.0) {
                 firstChild = node + 1;
-                secondChild = (Node*)&_nodes[node->child];
+                secondChild = &_nodes[node->child];
             } else {
-                firstChild = (Node*)&_nodes[node->child];
+                firstChild = &_nodes[node->child];
                 secondChild = node + 1;
             }
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.intersects(ray)) {
+            if (!firstChild->bound().intersects(ray)) {
                 node = secondChild;
-            } else if (!secondChild->bound.intersects(ray)) {
+            } else if (!secondChild->bound().intersects(ray)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -416,16 +499,16 @@ inline ClosestIntersectionQueryResult3<T> Bvh3<T>::closestIntersection(
             const Node* secondChild;
             if (ray.direction[node->flags] > 0.0) {
                 firstChild = node + 1;
-                secondChild = (Node*)&_nodes[node->child];
+                secondChild = &_nodes[node->child];
             } else {
-                firstChild = (Node*)&_nodes[node->child];
+                firstChild = &_nodes[node->child];
                 secondChild = node + 1;
             }
 
             // advance to next child node, possibly enqueue other child
-            if (!firstChild->bound.intersects(ray)) {
+            if (!firstChild->bound().intersects(ray)) {
                 node = secondChild;
-            } else if (!secondChild->bound.intersects(ray)) {
+            } else if (!secondChild->bound().intersects(ray)) {
                 node = firstChild;
             } else {
                 // enqueue secondChild in todo stack
@@ -517,6 +600,123 @@ size_t Bvh3<T>::build(size_t nodeIndex, size_t* itemIndices, size_t nItems,
     return std::max(d0, d1);
 }
 
+template <typename T>
+void Bvh3<T>::buildSah(size_t nodeIndex, size_t* itemIndices, size_t nItems,
+                       const std::vector<Vector3D>& centroids) {
+    using internal::kBvh3NumSahBins;
+
+    if (nItems == 1) {
+        _nodes[nodeIndex].initLeaf(itemIndices[0], _itemBounds[itemIndices[0]]);
+        return;
+    }
+
+    BoundingBox3D nodeBound;
+    BoundingBox3D centroidBound;
+    for (size_t i = 0; i < nItems; ++i) {
+        nodeBound.merge(_itemBounds[itemIndices[i]]);
+        centroidBound.merge(centroids[itemIndices[i]]);
+    }
+
+    // Find the bin boundary with the lowest SAH cost along each axis.
+    uint8_t axis = 0;
+    size_t split = 0;
+    double bestCost = kMaxD;
+    const Vector3D extent =
+        centroidBound.upperCorner - centroidBound.lowerCorner;
+    for (uint8_t a = 0; a < 3; ++a) {
+        if (!(extent[a] > 0.0)) {
+            continue;
+        }
+
+        std::array<size_t, kBvh3NumSahBins> counts;
+        std::array<BoundingBox3D, kBvh3NumSahBins> bounds;
+        counts.fill(0);
+
+        const double scale = kBvh3NumSahBins / extent[a];
+        for (size_t i = 0; i < nItems; ++i) {
+            const size_t idx = itemIndices[i];
+            const size_t b = std::min(
+                static_cast<size_t>(
+                    (centroids[idx][a] - centroidBound.lowerCorner[a]) * scale),
+                kBvh3NumSahBins - 1);
+            ++counts[b];
+            bounds[b].merge(_itemBounds[idx]);
+        }
+
+        // Sweep from the right to get the costs of the right sides.
+        std::array<double, kBvh3NumSahBins> rightCosts;
+        BoundingBox3D rightBound;
+        size_t rightCount = 0;
+        for (size_t b = kBvh3NumSahBins - 1; b > 0; --b) {
+            rightBound.merge(bounds[b]);
+            rightCount += counts[b];
+            rightCosts[b] = rightCount * internal::bvh3HalfArea(rightBound);
+        }
+
+        BoundingBox3D leftBound;
+        size_t leftCount = 0;
+        for (size_t b = 1; b < kBvh3NumSahBins; ++b) {
+            leftBound.merge(bounds[b - 1]);
+            leftCount += counts[b - 1];
+            if (leftCount == 0 || leftCount == nItems) {
+                continue;
+            }
+
+            const double cost =
+                leftCount * internal::bvh3HalfArea(leftBound) + rightCosts[b];
+            if (cost < bestCost) {
+                bestCost = cost;
+                axis = a;
+                split = b;
+            }
+        }
+    }
+
+    size_t midPoint;
+    if (split > 0) {
+        const double lower = centroidBound.lowerCorner[axis];
+        const double scale = kBvh3NumSahBins / extent[axis];
+        midPoint = static_cast<size_t>(
+            std::partition(itemIndices, itemIndices + nItems,
+                           [&](size_t idx) {
+                               const size_t b = std::min(
+                                   static_cast<size_t>(
+                                       (centroids[idx][axis] - lower) * scale),
+                                   kBvh3NumSahBins - 1);
+                               return b < split;
+                           }) -
+            itemIndices);
+    } else {
+        // All the centroids are at the same position.
+        const Vector3D d = nodeBound.upperCorner - nodeBound.lowerCorner;
+        if (d.x > d.y && d.x > d.z) {
+            axis = 0;
+        } else {
+            axis = (d.y > d.z) ? 1 : 2;
+        }
+        midPoint = nItems / 2;
+    }
+
+    const size_t rightIndex = nodeIndex + 2 * midPoint;
+    _nodes[nodeIndex].initInternal(axis, rightIndex, nodeBound);
+
+    auto buildChild = [&](size_t c) {
+        if (c == 0) {
+            buildSah(nodeIndex + 1, itemIndices, midPoint, centroids);
+        } else {
+            buildSah(rightIndex, itemIndices + midPoint, nItems - midPoint,
+                     centroids);
+        }
+    };
+
+    if (nItems >= internal::kBvh3MinParallelBuildItems) {
+        parallelFor(kZeroSize, static_cast<size_t>(2), buildChild);
+    } else {
+        buildChild(0);
+        buildChild(1);
+    }
+}
+
 template <typename T>
 size_t Bvh3<T>::qsplit(size_t* itemIndices, size_t numItems, double pivot,
                        uint8_t axis) {
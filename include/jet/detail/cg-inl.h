@@ -123,6 +123,148 @@ void cg(
         lastResidualNorm);
 }
 
+template <typename BlasType>
+void cgFused(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm) {
+    // Clear
+    BlasType::set(0, q);
+
+    // r = b - Ax
+    BlasType::residual(A, *x, b, r);
+
+    // d = r
+    BlasType::set(*r, d);
+
+    // sigmaNew = r.r
+    double sigmaNew = BlasType::dot(*r, *r);
+
+    unsigned int iter = 0;
+    bool trigger = false;
+    while (sigmaNew > square(tolerance) && iter < maxNumberOfIterations) {
+        // q = Ad, alpha = sigmaNew/d.q
+        double alpha = sigmaNew / BlasType::mvmDot(A, *d, q);
+
+        // sigmaOld = sigmaNew
+        double sigmaOld = sigmaNew;
+
+        // if i is divisible by 50...
+        if (trigger || (iter % 50 == 0 && iter > 0)) {
+            // x = x + alpha*d
+            BlasType::axpy(alpha, *d, *x, x);
+
+            // r = b - Ax, sigmaNew = r.r
+            BlasType::residual(A, *x, b, r);
+            sigmaNew = BlasType::dot(*r, *r);
+            trigger = false;
+        } else {
+            // x = x + alpha*d, r = r - alpha*q, sigmaNew = r.r
+            sigmaNew = BlasType::axpyAxpyDot(alpha, *d, *q, x, r);
+        }
+
+        if (sigmaNew > sigmaOld) {
+            trigger = true;
+        }
+
+        // beta = sigmaNew/sigmaOld
+        double beta = sigmaNew / sigmaOld;
+
+        // d = r + beta*d
+        BlasType::axpy(beta, *d, *r, d);
+
+        ++iter;
+    }
+
+    *lastNumberOfIterations = iter;
+
+    // std::fabs(sigmaNew) - Workaround for negative zero
+    *lastResidualNorm = std::sqrt(std::fabs(sigmaNew));
+}
+
+template <
+    typename BlasType,
+    typename PrecondType>
+void pcgFused(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    PrecondType* M,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm) {
+    // Clear
+    BlasType::set(0, q);
+    BlasType::set(0, s);
+
+    // r = b - Ax
+    BlasType::residual(A, *x, b, r);
+
+    // d = M^-1r
+    M->solve(*r, d);
+
+    // sigmaNew = r.d
+    double sigmaNew = BlasType::dot(*r, *d);
+
+    unsigned int iter = 0;
+    bool trigger = false;
+    while (sigmaNew > square(tolerance) && iter < maxNumberOfIterations) {
+        // q = Ad, alpha = sigmaNew/d.q
+        double alpha = sigmaNew / BlasType::mvmDot(A, *d, q);
+
+        // if i is divisible by 50...
+        if (trigger || (iter % 50 == 0 && iter > 0)) {
+            // x = x + alpha*d
+            BlasType::axpy(alpha, *d, *x, x);
+
+            // r = b - Ax
+            BlasType::residual(A, *x, b, r);
+            trigger = false;
+        } else {
+            // x = x + alpha*d, r = r - alpha*q
+            BlasType::axpyAxpyDot(alpha, *d, *q, x, r);
+        }
+
+        // s = M^-1r
+        M->solve(*r, s);
+
+        // sigmaOld = sigmaNew
+        double sigmaOld = sigmaNew;
+
+        // sigmaNew = r.s
+        sigmaNew = BlasType::dot(*r, *s);
+
+        if (sigmaNew > sigmaOld) {
+            trigger = true;
+        }
+
+        // beta = sigmaNew/sigmaOld
+        double beta = sigmaNew / sigmaOld;
+
+        // d = s + beta*d
+        BlasType::axpy(beta, *d, *s, d);
+
+        ++iter;
+    }
+
+    *lastNumberOfIterations = iter;
+
+    // std::fabs(sigmaNew) - Workaround for negative zero
+    *lastResidualNorm = std::sqrt(std::fabs(sigmaNew));
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_CG_INL_H_
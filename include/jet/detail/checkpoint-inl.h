@@ -0,0 +1,96 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_CHECKPOINT_INL_H_
+#define INCLUDE_JET_DETAIL_CHECKPOINT_INL_H_
+
+#include <jet/macros.h>
+
+#include <cstring>
+#include <sstream>
+
+namespace jet {
+
+template <typename T>
+void Checkpoint::setValue(const std::string& name, const T& value) {
+    std::vector<uint8_t>* buffer = chunkBuffer(name);
+    buffer->resize(sizeof(T));
+    std::memcpy(buffer->data(), &value, sizeof(T));
+}
+
+template <typename T>
+bool Checkpoint::getValue(const std::string& name, T* value) const {
+    auto iter = _chunks.find(name);
+    if (iter == _chunks.end()) {
+        return false;
+    }
+
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        iter->second.size() != sizeof(T),
+        "Checkpoint chunk " + name + " has unexpected size.");
+
+    std::memcpy(static_cast<void*>(value), iter->second.data(), sizeof(T));
+    return true;
+}
+
+template <typename T>
+void Checkpoint::setArray(const std::string& name,
+                          const ConstArrayAccessor1<T>& array) {
+    std::vector<uint8_t>* buffer = chunkBuffer(name);
+    buffer->resize(array.size() * sizeof(T));
+    if (array.size() > 0) {
+        std::memcpy(buffer->data(), array.data(), buffer->size());
+    }
+}
+
+template <typename T>
+bool Checkpoint::getArray(const std::string& name,
+                          std::vector<T>* array) const {
+    auto iter = _chunks.find(name);
+    if (iter == _chunks.end()) {
+        return false;
+    }
+
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        iter->second.size() % sizeof(T) != 0,
+        "Checkpoint chunk " + name + " has unexpected size.");
+
+    array->resize(iter->second.size() / sizeof(T));
+    if (!array->empty()) {
+        std::memcpy(static_cast<void*>(array->data()), iter->second.data(),
+                    iter->second.size());
+    }
+    return true;
+}
+
+template <typename RandomEngine>
+void Checkpoint::setRandomEngine(const std::string& name,
+                                 const RandomEngine& engine) {
+    std::ostringstream state;
+    state << engine;
+    const std::string text = state.str();
+    chunkBuffer(name)->assign(text.begin(), text.end());
+}
+
+template <typename RandomEngine>
+bool Checkpoint::getRandomEngine(const std::string& name,
+                                 RandomEngine* engine) const {
+    auto iter = _chunks.find(name);
+    if (iter == _chunks.end()) {
+        return false;
+    }
+
+    std::istringstream state(
+        std::string(iter->second.begin(), iter->second.end()));
+    state >> *engine;
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        state.fail(), "Checkpoint chunk " + name + " is not a random engine.");
+    return true;
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_CHECKPOINT_INL_H_
@@ -0,0 +1,262 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_FDM_LINEAR_SYSTEM3_INL_H_
+#define INCLUDE_JET_DETAIL_FDM_LINEAR_SYSTEM3_INL_H_
+
+#include <jet/macros.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+
+#include <cmath>
+
+namespace jet {
+
+namespace internal {
+
+// Accumulates the products in four independent partial sums so that the
+// compiler can keep them in vector registers.
+template <typename T>
+double fdmDotRange(const T* a, const T* b, size_t begin, size_t end) {
+    double sum0 = 0.0;
+    double sum1 = 0.0;
+    double sum2 = 0.0;
+    double sum3 = 0.0;
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        sum0 += static_cast<double>(a[i] * b[i]);
+        sum1 += static_cast<double>(a[i + 1] * b[i + 1]);
+        sum2 += static_cast<double>(a[i + 2] * b[i + 2]);
+        sum3 += static_cast<double>(a[i + 3] * b[i + 3]);
+    }
+    for (; i < end; ++i) {
+        sum0 += static_cast<double>(a[i] * b[i]);
+    }
+
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+template <typename T>
+double fdmParallelDot(const T* a, const T* b, size_t n) {
+    return parallelReduce(
+        kZeroSize, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            return init + fdmDotRange(a, b, begin, end);
+        },
+        [](double x, double y) { return x + y; });
+}
+
+template <typename T>
+double fdmParallelAbsMax(const T* v, size_t n) {
+    return parallelReduce(
+        kZeroSize, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            for (size_t i = begin; i < end; ++i) {
+                init = absmax(init, static_cast<double>(v[i]));
+            }
+            return init;
+        },
+        [](double x, double y) { return absmax(x, y); });
+}
+
+// Computes x = a * p + x and r = -a * q + r, and returns r.r.
+template <typename T>
+double fdmAxpyAxpyDot(double a, const T* p, const T* q, T* x, T* r,
+                      size_t n) {
+    const T s = static_cast<T>(a);
+    return parallelReduce(
+        kZeroSize, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            for (size_t i = begin; i < end; ++i) {
+                x[i] += s * p[i];
+                r[i] -= s * q[i];
+                init += static_cast<double>(r[i] * r[i]);
+            }
+            return init;
+        },
+        [](double x, double y) { return x + y; });
+}
+
+// Returns the (i, j, k)-th element of m * v.
+template <typename T>
+inline T fdmMultiplyRow(const Array3<FdmMatrixRow3T<T>>& m,
+                        const Array3<T>& v, size_t i, size_t j, size_t k) {
+    const Size3 size = m.size();
+    return m(i, j, k).center * v(i, j, k) +
+           ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k) : T(0)) +
+           ((i + 1 < size.x) ? m(i, j, k).right * v(i + 1, j, k) : T(0)) +
+           ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k) : T(0)) +
+           ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k) : T(0)) +
+           ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1) : T(0)) +
+           ((k + 1 < size.z) ? m(i, j, k).front * v(i, j, k + 1) : T(0));
+}
+
+}  // namespace internal
+
+template <typename T>
+void FdmBlas3T<T>::set(ScalarType s, VectorType* result) {
+    result->set(s);
+}
+
+template <typename T>
+void FdmBlas3T<T>::set(const VectorType& v, VectorType* result) {
+    result->set(v);
+}
+
+template <typename T>
+void FdmBlas3T<T>::set(ScalarType s, MatrixType* result) {
+    FdmMatrixRow3T<T> row;
+    row.center = row.right = row.up = row.front = s;
+    result->set(row);
+}
+
+template <typename T>
+void FdmBlas3T<T>::set(const MatrixType& m, MatrixType* result) {
+    result->set(m);
+}
+
+template <typename T>
+double FdmBlas3T<T>::dot(const VectorType& a, const VectorType& b) {
+    Size3 size = a.size();
+
+    JET_THROW_INVALID_ARG_IF(size != b.size());
+
+    return internal::fdmParallelDot(a.data(), b.data(),
+                                    size.x * size.y * size.z);
+}
+
+template <typename T>
+void FdmBlas3T<T>::axpy(double a, const VectorType& x, const VectorType& y,
+                        VectorType* result) {
+    Size3 size = x.size();
+
+    JET_THROW_INVALID_ARG_IF(size != y.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    const T s = static_cast<T>(a);
+    x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*result)(i, j, k) = s * x(i, j, k) + y(i, j, k);
+    });
+}
+
+template <typename T>
+void FdmBlas3T<T>::mvm(const MatrixType& m, const VectorType& v,
+                       VectorType* result) {
+    Size3 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != v.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    m.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*result)(i, j, k) = internal::fdmMultiplyRow(m, v, i, j, k);
+    });
+}
+
+template <typename T>
+void FdmBlas3T<T>::residual(const MatrixType& a, const VectorType& x,
+                            const VectorType& b, VectorType* result) {
+    Size3 size = a.size();
+
+    JET_THROW_INVALID_ARG_IF(size != x.size());
+    JET_THROW_INVALID_ARG_IF(size != b.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    a.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*result)(i, j, k) =
+            b(i, j, k) - a(i, j, k).center * x(i, j, k) -
+            ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : T(0)) -
+            ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : T(0)) -
+            ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : T(0)) -
+            ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : T(0)) -
+            ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : T(0)) -
+            ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : T(0));
+    });
+}
+
+template <typename T>
+double FdmBlas3T<T>::mvmDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result) {
+    Size3 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != v.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    return parallelReduce(
+        kZeroSize, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < size.y; ++j) {
+                    for (size_t i = 0; i < size.x; ++i) {
+                        const T mv = internal::fdmMultiplyRow(m, v, i, j, k);
+                        (*result)(i, j, k) = mv;
+                        init += static_cast<double>(v(i, j, k) * mv);
+                    }
+                }
+            }
+            return init;
+        },
+        [](double a, double b) { return a + b; });
+}
+
+template <typename T>
+double FdmBlas3T<T>::axpyAxpyDot(double a, const VectorType& p,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r) {
+    Size3 size = p.size();
+
+    JET_THROW_INVALID_ARG_IF(size != q.size());
+    JET_THROW_INVALID_ARG_IF(size != x->size());
+    JET_THROW_INVALID_ARG_IF(size != r->size());
+
+    return internal::fdmAxpyAxpyDot(a, p.data(), q.data(), x->data(),
+                                    r->data(), size.x * size.y * size.z);
+}
+
+template <typename T>
+double FdmBlas3T<T>::l2Norm(const VectorType& v) {
+    return std::sqrt(dot(v, v));
+}
+
+template <typename T>
+double FdmBlas3T<T>::lInfNorm(const VectorType& v) {
+    Size3 size = v.size();
+
+    return std::fabs(
+        internal::fdmParallelAbsMax(v.data(), size.x * size.y * size.z));
+}
+
+template <typename T>
+template <typename U>
+void FdmBlas3T<T>::convert(const Array3<U>& v, VectorType* result) {
+    result->resize(v.size());
+
+    const U* src = v.data();
+    T* dst = result->data();
+    parallelFor(kZeroSize, v.size().x * v.size().y * v.size().z,
+                [&](size_t i) { dst[i] = static_cast<T>(src[i]); });
+}
+
+template <typename T>
+template <typename U>
+void FdmBlas3T<T>::convert(const Array3<FdmMatrixRow3T<U>>& m,
+                           MatrixType* result) {
+    result->resize(m.size());
+
+    const FdmMatrixRow3T<U>* src = m.data();
+    FdmMatrixRow3T<T>* dst = result->data();
+    parallelFor(kZeroSize, m.size().x * m.size().y * m.size().z,
+                [&](size_t i) {
+                    dst[i].center = static_cast<T>(src[i].center);
+                    dst[i].right = static_cast<T>(src[i].right);
+                    dst[i].up = static_cast<T>(src[i].up);
+                    dst[i].front = static_cast<T>(src[i].front);
+                });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_FDM_LINEAR_SYSTEM3_INL_H_
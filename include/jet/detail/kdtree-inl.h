@@ -66,6 +66,20 @@ template <typename T, size_t K>
 void KdTree<T, K>::forEachNearbyPoint(
     const Point& origin, T radius,
     const std::function<void(size_t, const Point&)>& callback) const {
+    visitNearbyPoints(origin, radius,
+                      [&callback](size_t i, const Point& pt, T) {
+                          callback(i, pt);
+                      });
+}
+
+template <typename T, size_t K>
+template <typename Visitor>
+void KdTree<T, K>::visitNearbyPoints(const Point& origin, T radius,
+                                     const Visitor& visitor) const {
+    if (_nodes.empty()) {
+        return;
+    }
+
     const T r2 = radius * radius;
 
     // prepare to traverse the tree for sphere
@@ -77,9 +91,11 @@ void KdTree<T, K>::forEachNearbyPoint(
     const Node* node = _nodes.data();
 
     while (node != nullptr) {
-        if (node->item != kMaxSize &&
-            (node->point - origin).lengthSquared() <= r2) {
-            callback(node->item, node->point);
+        if (node->item != kMaxSize) {
+            const T d2 = (node->point - origin).lengthSquared();
+            if (d2 <= r2) {
+                visitor(node->item, node->point, d2);
+            }
         }
 
         if (node->isLeaf()) {
@@ -260,6 +260,32 @@ inline T monotonicCatmullRom(
     return a3 * cubic(f) + a2 * square(f) + a1 * f + a0;
 }
 
+inline float floorToFloat(double x) {
+    if (x < -std::numeric_limits<float>::max()) {
+        return -std::numeric_limits<float>::infinity();
+    }
+
+    float f = static_cast<float>(std::min<double>(
+        x, std::numeric_limits<float>::max()));
+    if (static_cast<double>(f) > x) {
+        f = std::nextafter(f, -std::numeric_limits<float>::infinity());
+    }
+    return f;
+}
+
+inline float ceilToFloat(double x) {
+    if (x > std::numeric_limits<float>::max()) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    float f = static_cast<float>(std::max<double>(
+        x, -std::numeric_limits<float>::max()));
+    if (static_cast<double>(f) < x) {
+        f = std::nextafter(f, std::numeric_limits<float>::infinity());
+    }
+    return f;
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_MATH_UTILS_INL_H_
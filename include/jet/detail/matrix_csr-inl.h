@@ -400,11 +400,21 @@ const T* const MatrixCsr<T>::nonZeroData() const {
     return _nonZeros.data();
 }
 
+template <typename T>
+size_t* MatrixCsr<T>::rowPointersData() {
+    return _rowPointers.data();
+}
+
 template <typename T>
 const size_t* const MatrixCsr<T>::rowPointersData() const {
     return _rowPointers.data();
 }
 
+template <typename T>
+size_t* MatrixCsr<T>::columnIndicesData() {
+    return _columnIndices.data();
+}
+
 template <typename T>
 const size_t* const MatrixCsr<T>::columnIndicesData() const {
     return _columnIndices.data();
@@ -11,6 +11,7 @@
 #include <jet/macros.h>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <future>
 #include <vector>
@@ -21,6 +22,7 @@
 #include <tbb/parallel_sort.h>
 #include <tbb/task.h>
 #elif defined(JET_TASKING_CPP11THREADS)
+#include <jet/thread_pool.h>
 #include <thread>
 #endif
 
@@ -47,8 +49,7 @@ inline void schedule(TASK_T&& fcn) {
         LocalTBBTask(std::forward<TASK_T>(fcn));
     tbb::task::enqueue(*tbb_node);
 #elif defined(JET_TASKING_CPP11THREADS)
-    std::thread thread(fcn);
-    thread.detach();
+    ThreadPool::defaultPool().schedule(std::forward<TASK_T>(fcn));
 #else  // OpenMP or Serial --> synchronous!
     fcn();
 #endif
@@ -73,6 +74,63 @@ inline auto async(TASK_T&& fcn) -> std::future<operator_return_t<TASK_T>> {
     return future;
 }
 
+// Waits for the future. With the thread pool backend, the waiting thread keeps
+// executing pending tasks so that nested tasks cannot starve the pool.
+template <typename T>
+inline void wait(const std::future<T>& future) {
+    if (!future.valid()) {
+        return;
+    }
+
+#ifdef JET_TASKING_CPP11THREADS
+    ThreadPool& pool = ThreadPool::defaultPool();
+    while (future.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+        if (!pool.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+#else
+    future.wait();
+#endif
+}
+
+#ifdef JET_TASKING_CPP11THREADS
+// Number of chunks handed out per thread. Having more chunks than threads lets
+// idle threads pick up the remaining work when the loop body is uneven.
+const size_t kNumChunksPerThread = 8;
+
+// Returns the number of threads to use for the given policy.
+inline unsigned int numThreadsForPolicy(ExecutionPolicy policy) {
+    return (policy == ExecutionPolicy::kParallel) ? maxNumberOfThreads() : 1;
+}
+
+// Returns the chunk size for splitting n items over numThreads threads.
+inline size_t chunkSize(size_t n, unsigned int numThreads) {
+    const size_t maxNumChunks =
+        (numThreads > 1) ? kNumChunksPerThread * numThreads : 1;
+    return std::max(n / maxNumChunks, kOneSize);
+}
+
+// Splits [start, end) into chunks of given size and invokes
+// func(chunkIndex, chunkBegin, chunkEnd) for each of them using the default
+// thread pool.
+template <typename IndexType, typename Function>
+void forEachChunk(IndexType start, IndexType end, size_t grain,
+                  const Function& func) {
+    const size_t n = static_cast<size_t>(end - start);
+    const size_t numChunks = (n + grain - 1) / grain;
+
+    ThreadPool::defaultPool().forEachChunk(numChunks, [&](size_t c) {
+        IndexType k1 = start + static_cast<IndexType>(c * grain);
+        IndexType k2 = (c + 1 == numChunks)
+                           ? end
+                           : start + static_cast<IndexType>((c + 1) * grain);
+        func(c, k1, k2);
+    });
+}
+#endif
+
 // Adopted from:
 // Radenski, A.
 // Shared Memory, Message Passing, and Hybrid Merge Sorts for Standalone and
@@ -141,9 +199,7 @@ void parallelMergeSort(RandomIterator a, size_t size, RandomIterator2 temp,
 
         // Wait for jobs to finish
         for (auto& f : pool) {
-            if (f.valid()) {
-                f.wait();
-            }
+            internal::wait(f);
         }
 
         merge(a, size, temp, compareFunction);
@@ -182,47 +238,17 @@ void parallelFor(IndexType start, IndexType end, const Function& func,
         }
     }
 
-#elif JET_TASKING_CPP11THREADS
-    // Estimate number of threads in the pool
-    unsigned int numThreadsHint = maxNumberOfThreads();
-    const unsigned int numThreads =
-        (policy == ExecutionPolicy::kParallel)
-            ? (numThreadsHint == 0u ? 8u : numThreadsHint)
-            : 1;
-
-    // Size of a slice for the range functions
-    IndexType n = end - start + 1;
-    IndexType slice =
-        (IndexType)std::round(n / static_cast<double>(numThreads));
-    slice = std::max(slice, IndexType(1));
-
-    // [Helper] Inner loop
-    auto launchRange = [&func](IndexType k1, IndexType k2) {
-        for (IndexType k = k1; k < k2; k++) {
-            func(k);
-        }
-    };
-
-    // Create pool and launch jobs
-    std::vector<std::thread> pool;
-    pool.reserve(numThreads);
-    IndexType i1 = start;
-    IndexType i2 = std::min(start + slice, end);
-    for (unsigned int i = 0; i + 1 < numThreads && i1 < end; ++i) {
-        pool.emplace_back(launchRange, i1, i2);
-        i1 = i2;
-        i2 = std::min(i2 + slice, end);
-    }
-    if (i1 < end) {
-        pool.emplace_back(launchRange, i1, end);
-    }
-
-    // Wait for jobs to finish
-    for (std::thread& t : pool) {
-        if (t.joinable()) {
-            t.join();
-        }
-    }
+#elif defined(JET_TASKING_CPP11THREADS)
+    const size_t n = static_cast<size_t>(end - start);
+    const size_t grain =
+        internal::chunkSize(n, internal::numThreadsForPolicy(policy));
+
+    internal::forEachChunk(start, end, grain,
+                           [&func](size_t, IndexType k1, IndexType k2) {
+                               for (IndexType k = k1; k < k2; ++k) {
+                                   func(k);
+                               }
+                           });
 #else
 
 #ifdef JET_TASKING_OPENMP
@@ -266,6 +292,15 @@ void parallelRangeFor(IndexType start, IndexType end, const Function& func,
         func(start, end);
     }
 
+#elif defined(JET_TASKING_CPP11THREADS)
+    const size_t n = static_cast<size_t>(end - start);
+    const size_t grain =
+        internal::chunkSize(n, internal::numThreadsForPolicy(policy));
+
+    internal::forEachChunk(
+        start, end, grain,
+        [&func](size_t, IndexType k1, IndexType k2) { func(k1, k2); });
+
 #else
     // Estimate number of threads in the pool
     unsigned int numThreadsHint = maxNumberOfThreads();
@@ -379,6 +414,28 @@ Value parallelReduce(IndexType start, IndexType end, const Value& identity,
         return func(start, end, identity);
     }
 
+#elif defined(JET_TASKING_CPP11THREADS)
+    const size_t n = static_cast<size_t>(end - start);
+    const size_t grain =
+        internal::chunkSize(n, internal::numThreadsForPolicy(policy));
+
+    // One result per chunk, gathered in chunk order so that the result does
+    // not depend on which thread processed which chunk.
+    std::vector<Value> results((n + grain - 1) / grain, identity);
+
+    internal::forEachChunk(
+        start, end, grain,
+        [&](size_t c, IndexType k1, IndexType k2) {
+            results[c] = func(k1, k2, identity);
+        });
+
+    Value finalResult = identity;
+    for (const Value& val : results) {
+        finalResult = reduce(val, finalResult);
+    }
+
+    return finalResult;
+
 #else
     // Estimate number of threads in the pool
     unsigned int numThreadsHint = maxNumberOfThreads();
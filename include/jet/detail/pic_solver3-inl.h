@@ -0,0 +1,34 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_PIC_SOLVER3_INL_H_
+#define INCLUDE_JET_DETAIL_PIC_SOLVER3_INL_H_
+
+#include <jet/parallel.h>
+
+namespace jet {
+
+template <typename Callback>
+void PicSolver3::parallelForEachParticleInSlabs(const Callback& func) const {
+    if (_slabStarts.empty()) {
+        return;
+    }
+
+    const size_t numberOfSlabs = _slabStarts.size() - 1;
+    for (size_t color = 0; color < 3; ++color) {
+        const size_t numberOfSlabsInColor = (numberOfSlabs + 2 - color) / 3;
+        parallelFor(kZeroSize, numberOfSlabsInColor, [&](size_t c) {
+            const size_t s = 3 * c + color;
+            for (size_t k = _slabStarts[s]; k < _slabStarts[s + 1]; ++k) {
+                func(_slabParticles[k]);
+            }
+        });
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_PIC_SOLVER3_INL_H_
@@ -0,0 +1,42 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_HASH_GRID_SEARCHER3_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_HASH_GRID_SEARCHER3_INL_H_
+
+namespace jet {
+
+template <typename Visitor>
+void PointHashGridSearcher3::visitNearbyPoints(const Vector3D& origin,
+                                               double radius,
+                                               const Visitor& visitor) const {
+    if (_buckets.empty()) {
+        return;
+    }
+
+    size_t nearbyKeys[8];
+    getNearbyKeys(origin, nearbyKeys);
+
+    const double queryRadiusSquared = radius * radius;
+
+    for (int i = 0; i < 8; i++) {
+        const auto& bucket = _buckets[nearbyKeys[i]];
+        size_t numberOfPointsInBucket = bucket.size();
+
+        for (size_t j = 0; j < numberOfPointsInBucket; ++j) {
+            size_t pointIndex = bucket[j];
+            const Vector3D& point = _points[pointIndex];
+            double rSquared = (point - origin).lengthSquared();
+            if (rSquared <= queryRadiusSquared) {
+                visitor(pointIndex, point, rSquared);
+            }
+        }
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_POINT_HASH_GRID_SEARCHER3_INL_H_
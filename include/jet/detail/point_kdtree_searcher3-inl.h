@@ -0,0 +1,21 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_KDTREE_SEARCHER3_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_KDTREE_SEARCHER3_INL_H_
+
+namespace jet {
+
+template <typename Visitor>
+void PointKdTreeSearcher3::visitNearbyPoints(const Vector3D& origin,
+                                             double radius,
+                                             const Visitor& visitor) const {
+    _tree.visitNearbyPoints(origin, radius, visitor);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_POINT_KDTREE_SEARCHER3_INL_H_
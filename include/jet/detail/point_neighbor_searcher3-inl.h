@@ -0,0 +1,90 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_NEIGHBOR_SEARCHER3_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_NEIGHBOR_SEARCHER3_INL_H_
+
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace jet {
+
+namespace internal {
+
+// Number of origins whose query results are gathered in one buffer
+constexpr size_t kNearbyPointQueryChunkSize = 256;
+
+}  // namespace internal
+
+template <typename Searcher>
+void PointNeighborSearcher3::buildNearbyPointLists(
+    const Searcher& searcher, const ConstArrayAccessor1<Vector3D>& origins,
+    double radius, ParticleNeighborLists* lists,
+    std::vector<double>* distancesSquared, NearbyPointBuffers* buffers) {
+    NearbyPointBuffers localBuffers;
+    if (buffers == nullptr) {
+        buffers = &localBuffers;
+    }
+
+    const size_t n = origins.size();
+    const size_t chunkSize = internal::kNearbyPointQueryChunkSize;
+    const size_t numberOfChunks = (n + chunkSize - 1) / chunkSize;
+
+    // Run the queries once, gathering the results of each chunk of origins
+    // into its own buffer.
+    std::vector<std::vector<size_t>>& chunkIndices = buffers->chunkIndices;
+    std::vector<std::vector<double>>& chunkDistances = buffers->chunkDistances;
+    std::vector<size_t>& offsets = buffers->offsets;
+    chunkIndices.resize(numberOfChunks);
+    chunkDistances.resize(numberOfChunks);
+    offsets.resize(n + 1);
+    offsets[0] = 0;
+    parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+        std::vector<size_t>& indices = chunkIndices[c];
+        std::vector<double>& distances = chunkDistances[c];
+        indices.clear();
+        distances.clear();
+        const size_t end = std::min(n, (c + 1) * chunkSize);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            const size_t count = indices.size();
+            searcher.visitNearbyPoints(
+                origins[i], radius,
+                [&](size_t j, const Vector3D&, double distanceSquared) {
+                    indices.push_back(j);
+                    distances.push_back(distanceSquared);
+                });
+            offsets[i + 1] = indices.size() - count;
+        }
+    });
+
+    for (size_t i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    if (distancesSquared != nullptr) {
+        distancesSquared->resize(offsets[n]);
+    }
+
+    // Copy the gathered results to the compressed lists.
+    lists->build(
+        n, [&](size_t i) { return offsets[i + 1] - offsets[i]; },
+        [&](size_t i, size_t* neighbors) {
+            const size_t c = i / chunkSize;
+            const size_t first = offsets[i] - offsets[c * chunkSize];
+            const size_t count = offsets[i + 1] - offsets[i];
+            std::copy_n(chunkIndices[c].data() + first, count, neighbors);
+            if (distancesSquared != nullptr) {
+                std::copy_n(chunkDistances[c].data() + first, count,
+                            distancesSquared->data() + offsets[i]);
+            }
+        });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_POINT_NEIGHBOR_SEARCHER3_INL_H_
@@ -0,0 +1,41 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_PARALLEL_HASH_GRID_SEARCHER3_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_PARALLEL_HASH_GRID_SEARCHER3_INL_H_
+
+namespace jet {
+
+template <typename Visitor>
+void PointParallelHashGridSearcher3::visitNearbyPoints(
+    const Vector3D& origin, double radius, const Visitor& visitor) const {
+    size_t nearbyKeys[8];
+    getNearbyKeys(origin, nearbyKeys);
+
+    const double queryRadiusSquared = radius * radius;
+
+    for (int i = 0; i < 8; i++) {
+        size_t nearbyKey = nearbyKeys[i];
+        size_t start = _startIndexTable[nearbyKey];
+        size_t end = _endIndexTable[nearbyKey];
+
+        // Empty bucket -- continue to next bucket
+        if (start == kMaxSize) {
+            continue;
+        }
+
+        for (size_t j = start; j < end; ++j) {
+            double distanceSquared = (_points[j] - origin).lengthSquared();
+            if (distanceSquared <= queryRadiusSquared) {
+                visitor(_sortedIndices[j], _points[j], distanceSquared);
+            }
+        }
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_POINT_PARALLEL_HASH_GRID_SEARCHER3_INL_H_
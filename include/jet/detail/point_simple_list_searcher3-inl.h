@@ -0,0 +1,27 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_SIMPLE_LIST_SEARCHER3_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_SIMPLE_LIST_SEARCHER3_INL_H_
+
+namespace jet {
+
+template <typename Visitor>
+void PointSimpleListSearcher3::visitNearbyPoints(
+    const Vector3D& origin, double radius, const Visitor& visitor) const {
+    double radiusSquared = radius * radius;
+    for (size_t i = 0; i < _points.size(); ++i) {
+        Vector3D r = _points[i] - origin;
+        double distanceSquared = r.dot(r);
+        if (distanceSquared <= radiusSquared) {
+            visitor(i, _points[i], distanceSquared);
+        }
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_POINT_SIMPLE_LIST_SEARCHER3_INL_H_
@@ -238,6 +238,19 @@ class FaceCenteredGrid3 final : public VectorGrid3 {
     //! Returns sampled value at given position \p x.
     Vector3D sample(const Vector3D& x) const override;
 
+    //!
+    //! \brief Samples the grid at the given \p points.
+    //!
+    //! Along each axis, the faces are either at the cell corners or at the cell
+    //! centers. This function computes the cell indices and weights of both
+    //! once per point and shares them across the u, v and w components, so
+    //! that a point needs six index lookups instead of nine.
+    //!
+    void sample(
+        const ConstArrayAccessor1<Vector3D>& points,
+        ArrayAccessor1<Vector3D> result,
+        ExecutionPolicy policy = ExecutionPolicy::kParallel) const override;
+
     //! Returns divergence at given position \p x.
     double divergence(const Vector3D& x) const override;
 
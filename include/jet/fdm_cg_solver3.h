@@ -46,13 +46,11 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     FdmVector3 _r;
     FdmVector3 _d;
     FdmVector3 _q;
-    FdmVector3 _s;
 
     // Compressed vectors
     VectorND _rComp;
     VectorND _dComp;
     VectorND _qComp;
-    VectorND _sComp;
 
     void clearUncompressedVectors();
     void clearCompressedVectors();
@@ -49,6 +49,11 @@ class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
     static void relax(const FdmMatrix3& A, const FdmVector3& b,
                       double sorFactor, FdmVector3* x);
 
+    //! Performs single natural Gauss-Seidel relaxation step in single
+    //! precision.
+    static void relax(const FdmMatrix3F& A, const FdmVector3F& b,
+                      double sorFactor, FdmVector3F* x);
+
     //! \brief Performs single natural Gauss-Seidel relaxation step for
     //!        compressed sys.
     static void relax(const MatrixCsrD& A, const VectorND& b, double sorFactor,
@@ -58,6 +63,11 @@ class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
     static void relaxRedBlack(const FdmMatrix3& A, const FdmVector3& b,
                               double sorFactor, FdmVector3* x);
 
+    //! Performs single Red-Black Gauss-Seidel relaxation step in single
+    //! precision.
+    static void relaxRedBlack(const FdmMatrix3F& A, const FdmVector3F& b,
+                              double sorFactor, FdmVector3F* x);
+
  private:
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
@@ -12,29 +12,48 @@
 #include <jet/matrix_csr.h>
 #include <jet/vector_n.h>
 
+#include <functional>
+
 namespace jet {
 
-//! The row of FdmMatrix3 where row corresponds to (i, j, k) grid point.
-struct FdmMatrixRow3 {
+//!
+//! \brief The row of FdmMatrix3 where row corresponds to (i, j, k) grid point.
+//!
+//! \tparam T - Element type (float or double).
+//!
+template <typename T>
+struct FdmMatrixRow3T {
     //! Diagonal component of the matrix (row, row).
-    double center = 0.0;
+    T center = 0;
 
     //! Off-diagonal element where colum refers to (i+1, j, k) grid point.
-    double right = 0.0;
+    T right = 0;
 
     //! Off-diagonal element where column refers to (i, j+1, k) grid point.
-    double up = 0.0;
+    T up = 0;
 
     //! OFf-diagonal element where column refers to (i, j, k+1) grid point.
-    double front = 0.0;
+    T front = 0;
 };
 
+//! Double-precision row of FdmMatrix3.
+typedef FdmMatrixRow3T<double> FdmMatrixRow3;
+
+//! Single-precision row of FdmMatrix3F.
+typedef FdmMatrixRow3T<float> FdmMatrixRow3F;
+
 //! Vector type for 3-D finite differencing.
 typedef Array3<double> FdmVector3;
 
+//! Single-precision vector type for 3-D finite differencing.
+typedef Array3<float> FdmVector3F;
+
 //! Matrix type for 3-D finite differencing.
 typedef Array3<FdmMatrixRow3> FdmMatrix3;
 
+//! Single-precision matrix type for 3-D finite differencing.
+typedef Array3<FdmMatrixRow3F> FdmMatrix3F;
+
 //! Linear system (Ax=b) for 3-D finite differencing.
 struct FdmLinearSystem3 {
     //! System matrix.
@@ -64,15 +83,47 @@ struct FdmCompressedLinearSystem3 {
     //! RHS vector.
     VectorND b;
 
+    //! Row index of each grid point, or kMaxSize if the point has no row.
+    Array3<size_t> coordToIndex;
+
     //! Clears all the data.
     void clear();
+
+    //!
+    //! \brief Builds the rows and the 7-point stencil sparsity pattern.
+    //!
+    //! The active grid points are numbered in the (i, j, k) iteration order,
+    //! and each row gets the entries for itself and its active 6-neighbors in
+    //! increasing column order: (i, j, k - 1), (i, j - 1, k), (i - 1, j, k),
+    //! (i, j, k), (i + 1, j, k), (i, j + 1, k), and (i, j, k + 1). Both the
+    //! numbering and the pattern are built in parallel. If the active points
+    //! are the same as the previous call, the pattern is kept as is and only
+    //! the values need to be refreshed. In both cases, \p b is resized to the
+    //! number of rows and \p x keeps its values if the size is unchanged.
+    //!
+    //! \param[in] size     The grid size.
+    //! \param[in] isActive Returns true if the grid point has a row.
+    //!
+    //! \return True if the sparsity pattern has changed.
+    //!
+    bool buildPattern(
+        const Size3& size,
+        const std::function<bool(size_t, size_t, size_t)>& isActive);
 };
 
-//! BLAS operator wrapper for 3-D finite differencing.
-struct FdmBlas3 {
-    typedef double ScalarType;
-    typedef FdmVector3 VectorType;
-    typedef FdmMatrix3 MatrixType;
+//!
+//! \brief BLAS operator wrapper for 3-D finite differencing.
+//!
+//! The reductions such as dot products are accumulated in double precision
+//! for both element types.
+//!
+//! \tparam T - Element type (float or double).
+//!
+template <typename T>
+struct FdmBlas3T {
+    typedef T ScalarType;
+    typedef Array3<T> VectorType;
+    typedef Array3<FdmMatrixRow3T<T>> MatrixType;
 
     //! Sets entire element of given vector \p result with scalar \p s.
     static void set(ScalarType s, VectorType* result);
@@ -102,13 +153,47 @@ struct FdmBlas3 {
     static void residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
 
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the \p result in a single pass.
+    static double mvmDot(const MatrixType& m, const VectorType& v,
+                         VectorType* result);
+
+    //! Performs \p x = a * \p p + \p x and \p r = -a * \p q + \p r in a
+    //! single pass and returns the dot product of the updated \p r itself.
+    static double axpyAxpyDot(double a, const VectorType& p,
+                              const VectorType& q, VectorType* x,
+                              VectorType* r);
+
     //! Returns L2-norm of the given vector \p v.
-    static ScalarType l2Norm(const VectorType& v);
+    static double l2Norm(const VectorType& v);
 
     //! Returns Linf-norm of the given vector \p v.
-    static ScalarType lInfNorm(const VectorType& v);
+    static double lInfNorm(const VectorType& v);
+
+    //!
+    //! \brief Copies the vector \p v of other precision to \p result.
+    //!
+    //! The \p result is resized to \p v if needed.
+    //!
+    template <typename U>
+    static void convert(const Array3<U>& v, VectorType* result);
+
+    //!
+    //! \brief Copies the matrix \p m of other precision to \p result.
+    //!
+    //! The \p result is resized to \p m if needed.
+    //!
+    template <typename U>
+    static void convert(const Array3<FdmMatrixRow3T<U>>& m,
+                        MatrixType* result);
 };
 
+//! Double-precision BLAS operator wrapper for 3-D finite differencing.
+typedef FdmBlas3T<double> FdmBlas3;
+
+//! Single-precision BLAS operator wrapper for 3-D finite differencing.
+typedef FdmBlas3T<float> FdmBlas3F;
+
 //! BLAS operator wrapper for compressed 3-D finite differencing.
 struct FdmCompressedBlas3 {
     typedef double ScalarType;
@@ -143,6 +228,17 @@ struct FdmCompressedBlas3 {
     static void residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
 
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the \p result in a single pass.
+    static double mvmDot(const MatrixType& m, const VectorType& v,
+                         VectorType* result);
+
+    //! Performs \p x = a * \p p + \p x and \p r = -a * \p q + \p r in a
+    //! single pass and returns the dot product of the updated \p r itself.
+    static double axpyAxpyDot(double a, const VectorType& p,
+                              const VectorType& q, VectorType* x,
+                              VectorType* r);
+
     //! Returns L2-norm of the given vector \p v.
     static ScalarType l2Norm(const VectorType& v);
 
@@ -152,4 +248,6 @@ struct FdmCompressedBlas3 {
 
 }  // namespace jet
 
+#include "detail/fdm_linear_system3-inl.h"
+
 #endif  // INCLUDE_JET_FDM_LINEAR_SYSTEM3_H_
@@ -19,6 +19,12 @@ typedef MgMatrix<FdmBlas3> FdmMgMatrix3;
 //! Multigrid-style 3-D FDM vector.
 typedef MgVector<FdmBlas3> FdmMgVector3;
 
+//! Single-precision multigrid-style 3-D FDM matrix.
+typedef MgMatrix<FdmBlas3F> FdmMgMatrix3F;
+
+//! Single-precision multigrid-style 3-D FDM vector.
+typedef MgVector<FdmBlas3F> FdmMgVector3F;
+
 //! Multigrid-syle 3-D linear system.
 struct FdmMgLinearSystem3 {
     //! The system matrix.
@@ -63,6 +69,12 @@ class FdmMgUtils3 {
     //! Corrects given coarser grid to the finer grid.
     static void correct(const FdmVector3 &coarser, FdmVector3 *finer);
 
+    //! Restricts given single-precision finer grid to the coarser grid.
+    static void restrict(const FdmVector3F &finer, FdmVector3F *coarser);
+
+    //! Corrects given single-precision coarser grid to the finer grid.
+    static void correct(const FdmVector3F &coarser, FdmVector3F *finer);
+
     //! Resizes the array with the coarsest resolution and number of levels.
     template <typename T>
     static void resizeArrayWithCoarsest(const Size3 &coarsestResolution,
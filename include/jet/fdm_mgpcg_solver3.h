@@ -20,6 +20,21 @@ namespace jet {
 //!      grids." Proceedings of the 2010 ACM SIGGRAPH/Eurographics Symposium on
 //!      Computer Animation. Eurographics Association, 2010.
 //!
+//! If the single-precision preconditioner is enabled, the V-cycle runs on a
+//! float copy of the multigrid system while the CG iterations stay in double
+//! precision. The preconditioner only needs to approximate the inverse, so
+//! this halves the memory traffic of the V-cycles without changing the
+//! accuracy of the converged solution. This is a mixed-precision
+//! preconditioner only: the system itself is still assembled and stored in
+//! double precision.
+//!
+//! The V-cycle vectors are allocated at the beginning of each solve and
+//! released at the end. The float matrices are kept between the solves, so
+//! they are allocated only when the resolution changes. Since the solver
+//! cannot tell whether the caller has reassembled the system, their values
+//! are still refreshed from the double matrices once per solve, which costs
+//! a single pass over the matrices against the many passes of the V-cycles.
+//!
 class FdmMgpcgSolver3 final : public FdmMgSolver3 {
  public:
     //!
@@ -32,13 +47,18 @@ class FdmMgpcgSolver3 final : public FdmMgSolver3 {
     //! \param numberOfCoarsestIter - Number of iterations at the coarsest grid.
     //! \param numberOfFinalIter - Number of final iterations.
     //! \param maxTolerance - Number of max residual tolerance.
+    //! \param sorFactor - SOR factor of the relaxation.
+    //! \param useRedBlackOrdering - True if red-black ordering is enabled.
+    //! \param useSinglePrecisionPreconditioner - True if the V-cycle
+    //!        preconditioner runs in single precision.
     FdmMgpcgSolver3(unsigned int numberOfCgIter, size_t maxNumberOfLevels,
                     unsigned int numberOfRestrictionIter = 5,
                     unsigned int numberOfCorrectionIter = 5,
                     unsigned int numberOfCoarsestIter = 20,
                     unsigned int numberOfFinalIter = 20,
                     double maxTolerance = 1e-9, double sorFactor = 1.5,
-                    bool useRedBlackOrdering = false);
+                    bool useRedBlackOrdering = false,
+                    bool useSinglePrecisionPreconditioner = false);
 
     //! Solves the given linear system.
     bool solve(FdmMgLinearSystem3* system) override;
@@ -55,20 +75,39 @@ class FdmMgpcgSolver3 final : public FdmMgSolver3 {
     //! Returns the last residual after the Jacobi iterations.
     double lastResidual() const;
 
+    //! Returns true if the preconditioner runs in single precision.
+    bool useSinglePrecisionPreconditioner() const;
+
  private:
     struct Preconditioner final {
         FdmMgLinearSystem3* system;
         MgParameters<FdmBlas3> mgParams;
+        FdmMgVector3 mgX;
+        FdmMgVector3 mgB;
+        FdmMgVector3 mgBuffer;
+
+        bool useSinglePrecision = false;
+        MgParameters<FdmBlas3F> mgParamsF;
+        FdmMgMatrix3F mgAF;
+        FdmMgVector3F mgXF;
+        FdmMgVector3F mgBF;
+        FdmMgVector3F mgBufferF;
 
         void build(FdmMgLinearSystem3* system, MgParameters<FdmBlas3> mgParams);
 
+        void buildSinglePrecision(FdmMgLinearSystem3* system,
+                                  MgParameters<FdmBlas3F> mgParams);
+
         void solve(const FdmVector3& b, FdmVector3* x);
+
+        void clear();
     };
 
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
     double _tolerance;
     double _lastResidualNorm;
+    bool _useSinglePrecisionPreconditioner;
 
     FdmVector3 _r;
     FdmVector3 _d;
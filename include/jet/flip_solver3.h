@@ -57,6 +57,12 @@ class FlipSolver3 : public PicSolver3 {
     static Builder builder();
 
  protected:
+    //! Stores the PIC blending factor to the checkpoint.
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the PIC blending factor from the checkpoint.
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //! Transfers velocity field from particles to grids.
     void transferFromParticlesToGrids() override;
 
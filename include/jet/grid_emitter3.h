@@ -8,9 +8,11 @@
 #define INCLUDE_JET_GRID_EMITTER3_H_
 
 #include <jet/animation.h>
+#include <jet/checkpoint.h>
 #include <jet/implicit_surface3.h>
 #include <jet/scalar_grid3.h>
 
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -51,6 +53,24 @@ class GridEmitter3 {
     //!
     void setOnBeginUpdateCallback(const OnBeginUpdateCallback& callback);
 
+    //!
+    //! \brief      Stores the state of the emitter to the checkpoint.
+    //!
+    //! Emitters that change over the course of the simulation, such as
+    //! one-shot emitters or emitters with random number generators, store
+    //! their state in the chunks whose names start with \p prefix. The
+    //! default implementation stores nothing.
+    //!
+    //! \param[in]  prefix     The prefix of the chunk names.
+    //! \param      checkpoint The checkpoint to store the state.
+    //!
+    virtual void saveCheckpoint(const std::string& prefix,
+                                Checkpoint* checkpoint) const;
+
+    //! Restores the state of the emitter from the checkpoint.
+    virtual void loadCheckpoint(const std::string& prefix,
+                                const Checkpoint& checkpoint);
+
  protected:
     virtual void onUpdate(double currentTimeInSeconds,
                           double timeIntervalInSeconds) = 0;
@@ -8,6 +8,7 @@
 #define INCLUDE_JET_GRID_EMITTER_SET3_H_
 
 #include <jet/grid_emitter3.h>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -29,6 +30,14 @@ class GridEmitterSet3 final : public GridEmitter3 {
     //! Destructor.
     virtual ~GridEmitterSet3();
 
+    //! Stores the state of the sub-emitters to the checkpoint.
+    void saveCheckpoint(const std::string& prefix,
+                        Checkpoint* checkpoint) const override;
+
+    //! Restores the state of the sub-emitters from the checkpoint.
+    void loadCheckpoint(const std::string& prefix,
+                        const Checkpoint& checkpoint) override;
+
     //! Adds sub-emitter.
     void addEmitter(const GridEmitter3Ptr& emitter);
 
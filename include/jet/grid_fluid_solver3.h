@@ -18,6 +18,8 @@
 #include <jet/grid_system_data3.h>
 #include <jet/physics_animation.h>
 
+#include <vector>
+
 namespace jet {
 
 //!
@@ -191,6 +193,23 @@ class GridFluidSolver3 : public PhysicsAnimation {
     //! Called when advancing a single time-step.
     void onAdvanceTimeStep(double timeIntervalInSeconds) override;
 
+    //!
+    //! \brief Stores the parameters, the grid data and the state of the
+    //!     collider and the emitter to the checkpoint.
+    //!
+    //! Each data layer is stored as a separate chunk so that the grids can be
+    //! restored in place without replacing the grid objects that the
+    //! emitters may refer to.
+    //!
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //!
+    //! \brief Restores the state stored by GridFluidSolver3::onSaveCheckpoint.
+    //!
+    //! Throws if the grid resolution of the checkpoint does not match.
+    //!
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //!
     //! \brief Returns the required sub-time-steps for given time interval.
     //!
@@ -229,6 +248,15 @@ class GridFluidSolver3 : public PhysicsAnimation {
     //! Computes the advection term using the advection solver.
     virtual void computeAdvection(double timeIntervalInSeconds);
 
+    //!
+    //! \brief Returns true if computeAdvection should advect the scalar data.
+    //!
+    //! A derived solver can return false for the advectable scalar data at
+    //! \p index to advect it by itself, for instance only within a narrow
+    //! band. By default, all the advectable scalar data are advected.
+    //!
+    virtual bool shouldAdvectScalarData(size_t index) const;
+
     //!
     //! \breif Returns the signed-distance representation of the fluid.
     //!
@@ -281,6 +309,9 @@ class GridFluidSolver3 : public PhysicsAnimation {
     GridPressureSolver3Ptr _pressureSolver;
     GridBoundaryConditionSolver3Ptr _boundaryConditionSolver;
 
+    std::vector<ScalarGrid3Ptr> _scalarDataBuffers;
+    std::vector<VectorGrid3Ptr> _vectorDataBuffers;
+
     void beginAdvanceTimeStep(double timeIntervalInSeconds);
 
     void endAdvanceTimeStep(double timeIntervalInSeconds);
@@ -160,6 +160,12 @@ class GridSmokeSolver3 : public GridFluidSolver3 {
     static Builder builder();
 
  protected:
+    //! Stores the smoke parameters to the checkpoint.
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the smoke parameters from the checkpoint.
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     void onEndAdvanceTimeStep(double timeIntervalInSeconds) override;
 
     void computeExternalForces(double timeIntervalInSeconds) override;
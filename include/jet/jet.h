@@ -26,6 +26,7 @@
 #include <jet/array_samplers2.h>
 #include <jet/array_samplers3.h>
 #include <jet/array_utils.h>
+#include <jet/async_frame_writer.h>
 #include <jet/bcc_lattice_point_generator.h>
 #include <jet/blas.h>
 #include <jet/bounding_box.h>
@@ -35,11 +36,13 @@
 #include <jet/box3.h>
 #include <jet/bvh2.h>
 #include <jet/bvh3.h>
+#include <jet/bvh_build_method.h>
 #include <jet/cell_centered_scalar_grid2.h>
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/cell_centered_vector_grid2.h>
 #include <jet/cell_centered_vector_grid3.h>
 #include <jet/cg.h>
+#include <jet/checkpoint.h>
 #include <jet/collider2.h>
 #include <jet/collider3.h>
 #include <jet/collider_set2.h>
@@ -65,6 +68,7 @@
 #include <jet/eno_level_set_solver3.h>
 #include <jet/face_centered_grid2.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
 #include <jet/fcc_lattice_point_generator.h>
 #include <jet/fdm_cg_solver2.h>
 #include <jet/fdm_cg_solver3.h>
@@ -158,10 +162,12 @@
 #include <jet/nearest_neighbor_query_engine3.h>
 #include <jet/octree.h>
 #include <jet/parallel.h>
+#include <jet/particle_cache3.h>
 #include <jet/particle_emitter2.h>
 #include <jet/particle_emitter3.h>
 #include <jet/particle_emitter_set2.h>
 #include <jet/particle_emitter_set3.h>
+#include <jet/particle_neighbor_lists.h>
 #include <jet/particle_system_data2.h>
 #include <jet/particle_system_data3.h>
 #include <jet/particle_system_solver2.h>
@@ -212,6 +218,7 @@
 #include <jet/size.h>
 #include <jet/size2.h>
 #include <jet/size3.h>
+#include <jet/soa_vector_array3.h>
 #include <jet/sph_kernels2.h>
 #include <jet/sph_kernels3.h>
 #include <jet/sph_points_to_implicit2.h>
@@ -231,6 +238,7 @@
 #include <jet/surface_to_implicit2.h>
 #include <jet/surface_to_implicit3.h>
 #include <jet/svd.h>
+#include <jet/thread_pool.h>
 #include <jet/timer.h>
 #include <jet/transform2.h>
 #include <jet/transform3.h>
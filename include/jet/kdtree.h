@@ -78,6 +78,22 @@ class KdTree final {
         const Point& origin, T radius,
         const std::function<void(size_t, const Point&)>& callback) const;
 
+    //!
+    //! \brief      Invokes the visitor for each nearby point around the origin
+    //!             within given radius.
+    //!
+    //! Unlike forEachNearbyPoint, the visitor is inlined into the traversal and
+    //! also receives the squared distance to the point, as in
+    //! visitor(index, point, distanceSquared).
+    //!
+    //! \param[in]  origin  The origin position.
+    //! \param[in]  radius  The search radius.
+    //! \param[in]  visitor The visitor function object.
+    //!
+    template <typename Visitor>
+    void visitNearbyPoints(const Point& origin, T radius,
+                           const Visitor& visitor) const;
+
     //!
     //! Returns true if there are any nearby points for given origin within
     //! radius.
@@ -10,6 +10,9 @@
 #include <jet/grid_fluid_solver3.h>
 #include <jet/level_set_solver3.h>
 
+#include <array>
+#include <vector>
+
 namespace jet {
 
 //!
@@ -45,7 +48,13 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3 {
     //! Returns the level set solver.
     LevelSetSolver3Ptr levelSetSolver() const;
 
-    //! Sets the level set solver.
+    //!
+    //! \brief Sets the level set solver.
+    //!
+    //! If the solver is FastSweepingLevelSetSolver3, it also extrapolates the
+    //! velocity field to the air. Otherwise, FmmLevelSetSolver3 is used for
+    //! the extrapolation.
+    //!
     void setLevelSetSolver(const LevelSetSolver3Ptr& newSolver);
 
     //! Sets minimum reinitialization distance.
@@ -65,6 +74,36 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3 {
     //!
     void setIsGlobalCompensationEnabled(bool isEnabled);
 
+    //! Returns the half width of the narrow band in number of cells.
+    double narrowBandWidth() const;
+
+    //!
+    //! \brief Sets the half width of the narrow band in number of cells.
+    //!
+    //! When \p widthInCells is positive, the solver keeps the list of the data
+    //! points closer to the interface than the width and only advects the
+    //! signed-distance field at those points. Reinitialization and velocity
+    //! extrapolation are limited to the same distance, and the field outside
+    //! the band is clamped to plus or minus the width. So that the interface
+    //! cannot leave the band within a time-step, the band is at least one
+    //! cell wider than the max CFL number, whichever width is set here.
+    //!
+    //! The band is updated by growing the band of the previous time-step as
+    //! far as the interface could have moved since, so the cost scales with
+    //! the band instead of the grid. The band is rebuilt from the whole grid
+    //! if an emitter is set, since the emitter can change the field anywhere.
+    //! When the signed-distance field is modified outside the solver, call
+    //! this function again to rebuild the band.
+    //!
+    //! Zero, which is the default, disables the narrow band. Negative widths
+    //! are treated as zero, and widths between zero and one cell are
+    //! rejected.
+    //!
+    void setNarrowBandWidth(double widthInCells);
+
+    //! Returns the data points in the narrow band of the last advection.
+    const std::vector<Point3UI>& narrowBandDataPoints() const;
+
     //!
     //! \brief Returns liquid volume measured by smeared Heaviside function.
     //!
@@ -83,9 +122,18 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3 {
     //! Called at the end of the time-step.
     void onEndAdvanceTimeStep(double timeIntervalInSeconds) override;
 
+    //! Stores the level set parameters to the checkpoint.
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the level set parameters from the checkpoint.
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //! Customizes advection step.
     void computeAdvection(double timeIntervalInSeconds) override;
 
+    //! Excludes the signed-distance field when the narrow band is enabled.
+    bool shouldAdvectScalarData(size_t index) const override;
+
     //!
     //! \brief Returns fluid region as a signed-distance field.
     //!
@@ -101,12 +149,33 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3 {
     double _minReinitializeDistance = 10.0;
     bool _isGlobalCompensationEnabled = false;
     double _lastKnownVolume = 0.0;
+    double _narrowBandWidth = 0.0;
+    std::vector<Point3UI> _narrowBandDataPoints;
+    double _lastNarrowBandWidth = 0.0;
+    double _narrowBandDrift = 0.0;
+    Array3<char> _narrowBandMarker;
+    std::array<Array3<char>, 3> _narrowBandFaceMarkers;
 
     void reinitialize(double currentCfl);
 
+    double maxLevelSetDistance(double currentCfl) const;
+
+    double narrowBandWidthInCells(double currentCfl) const;
+
+    void updateNarrowBand(double currentCfl);
+
+    void dilateNarrowBand(size_t numberOfLayers,
+                          std::vector<Point3UI>* dataPoints);
+
+    void advectNarrowBand(double timeIntervalInSeconds);
+
+    void clampToNarrowBand(double currentCfl);
+
     void extrapolateVelocityToAir(double currentCfl);
 
-    void addVolume(double volDiff);
+    void extrapolateVelocityToAirInNarrowBand(double currentCfl);
+
+    double addVolume(double volDiff);
 };
 
 //! Shared pointer type for the LevelSetLiquidSolver3.
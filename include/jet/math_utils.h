@@ -232,6 +232,21 @@ template <typename T>
 inline T monotonicCatmullRom(const T& f0, const T& f1, const T& f2, const T& f3,
                              T t);
 
+//!
+//! \brief      Returns the largest float which is less than or equal to \p x.
+//!
+//! Values below the float range map to negative infinity.
+//!
+inline float floorToFloat(double x);
+
+//!
+//! \brief      Returns the smallest float which is greater than or equal to
+//!             \p x.
+//!
+//! Values above the float range map to positive infinity.
+//!
+inline float ceilToFloat(double x);
+
 }  // namespace jet
 
 #include "detail/math_utils-inl.h"
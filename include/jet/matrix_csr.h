@@ -273,9 +273,15 @@ class MatrixCsr final : public MatrixExpression<T, MatrixCsr<T>> {
     //! Returns constant pointer of the non-zero elements data.
     const T* const nonZeroData() const;
 
+    //! Returns pointer of the row pointers data.
+    size_t* rowPointersData();
+
     //! Returns constant pointer of the row pointers data.
     const size_t* const rowPointersData() const;
 
+    //! Returns pointer of the column indices data.
+    size_t* columnIndicesData();
+
     //! Returns constant pointer of the column indices data.
     const size_t* const columnIndicesData() const;
 
@@ -0,0 +1,181 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_PARTICLE_CACHE3_H_
+#define INCLUDE_JET_PARTICLE_CACHE3_H_
+
+#include <jet/array1.h>
+#include <jet/particle_system_data3.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jet {
+
+//! Encoding of the channel blocks in a particle cache file.
+enum class ParticleCacheEncoding : uint32_t {
+    //! Stores the values as they are laid out in memory.
+    kRaw = 0,
+
+    //! Stores each component as a 16-bit fixed-point number between the
+    //! minimum and maximum of the channel. The error is at most 1/131070 of
+    //! the range of the channel.
+    kQuantized16 = 1
+};
+
+//!
+//! \brief 3-D particle cache writer.
+//!
+//! The particle cache stores one frame of ParticleSystemData3 in a binary
+//! file. The file has a header, a table of channels and one block for every
+//! scalar and vector data of the particles, including the positions,
+//! velocities and forces, and one for the particle IDs. The blocks are aligned
+//! so that ParticleCache3 can map the file and hand out the raw channels
+//! without copying them.
+//!
+//! The writer streams the channels to the file in chunks directly from the
+//! particle arrays, so it does not build the whole frame in memory.
+//!
+class ParticleCacheWriter3 final {
+ public:
+    //! Constructs a writer with given channel encoding.
+    explicit ParticleCacheWriter3(
+        ParticleCacheEncoding encoding = ParticleCacheEncoding::kRaw);
+
+    //! Returns the channel encoding.
+    ParticleCacheEncoding encoding() const;
+
+    //! Sets the channel encoding.
+    void setEncoding(ParticleCacheEncoding encoding);
+
+    //!
+    //! \brief Writes the particles to the file.
+    //!
+    //! \param[in] particles The particles to write.
+    //! \param[in] filename  The name of the cache file.
+    //!
+    //! \return False if the file could not be written.
+    //!
+    bool write(const ParticleSystemData3& particles,
+               const std::string& filename) const;
+
+ private:
+    ParticleCacheEncoding _encoding;
+};
+
+//!
+//! \brief 3-D particle cache reader.
+//!
+//! This class maps a file written by ParticleCacheWriter3 into memory and
+//! exposes its channels as array accessors. The raw channels point into the
+//! mapped file, so reading a frame does not copy the particles and only the
+//! pages that are accessed are loaded. The quantized channels are decoded
+//! into memory when the file is opened. The accessors are valid until the
+//! cache is closed or destroyed.
+//!
+class ParticleCache3 final {
+ public:
+    //! Constructs an empty cache.
+    ParticleCache3();
+
+    //! Opens the cache file with given name.
+    explicit ParticleCache3(const std::string& filename);
+
+    ParticleCache3(const ParticleCache3&) = delete;
+
+    //! Closes the cache file.
+    ~ParticleCache3();
+
+    ParticleCache3& operator=(const ParticleCache3&) = delete;
+
+    //!
+    //! \brief Opens the cache file with given name.
+    //!
+    //! \return False if the file could not be mapped or is not a particle
+    //!     cache file. The cache is empty in that case.
+    //!
+    bool open(const std::string& filename);
+
+    //! Closes the cache file.
+    void close();
+
+    //! Returns true if a cache file is open.
+    bool isOpen() const;
+
+    //! Returns the number of particles.
+    size_t numberOfParticles() const;
+
+    //! Returns the number of scalar data layers.
+    size_t numberOfScalarData() const;
+
+    //! Returns the number of vector data layers.
+    size_t numberOfVectorData() const;
+
+    //! Returns the radius of the particles.
+    double radius() const;
+
+    //! Returns the mass of the particles.
+    double mass() const;
+
+    //! Returns the position array.
+    ConstArrayAccessor1<Vector3D> positions() const;
+
+    //! Returns the velocity array.
+    ConstArrayAccessor1<Vector3D> velocities() const;
+
+    //! Returns the force array.
+    ConstArrayAccessor1<Vector3D> forces() const;
+
+    //! Returns the scalar data at given index.
+    ConstArrayAccessor1<double> scalarDataAt(size_t idx) const;
+
+    //! Returns the vector data at given index.
+    ConstArrayAccessor1<Vector3D> vectorDataAt(size_t idx) const;
+
+    //! Returns the particle ID array.
+    ConstArrayAccessor1<size_t> particleIds() const;
+
+    //! Returns the ID for the next new particle when the cache was written.
+    size_t nextParticleId() const;
+
+    //!
+    //! \brief Copies the cache to the particles.
+    //!
+    //! The particles are resized and get more data layers if they have fewer
+    //! than the cache. The layers that the cache does not have are kept. The
+    //! particle IDs and the ID for the next new particle are restored, so the
+    //! particles added later keep getting unique IDs.
+    //!
+    void copyTo(ParticleSystemData3* particles) const;
+
+ private:
+    struct FileMapping;
+
+    std::unique_ptr<FileMapping> _mapping;
+    size_t _numberOfParticles = 0;
+    double _radius = 0.0;
+    double _mass = 0.0;
+    size_t _positionIdx = 0;
+    size_t _velocityIdx = 0;
+    size_t _forceIdx = 0;
+    size_t _nextParticleId = 0;
+    std::vector<ConstArrayAccessor1<double>> _scalarDataList;
+    std::vector<ConstArrayAccessor1<Vector3D>> _vectorDataList;
+    const size_t* _particleIds = nullptr;
+    std::vector<Array1<double>> _decodedScalarDataList;
+    std::vector<Array1<Vector3D>> _decodedVectorDataList;
+
+    bool readChannels();
+};
+
+//! Shared pointer for the ParticleCache3 type.
+typedef std::shared_ptr<ParticleCache3> ParticleCache3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_PARTICLE_CACHE3_H_
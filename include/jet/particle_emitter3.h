@@ -8,7 +8,9 @@
 #define INCLUDE_JET_PARTICLE_EMITTER3_H_
 
 #include <jet/animation.h>
+#include <jet/checkpoint.h>
 #include <jet/particle_system_data3.h>
+#include <string>
 
 namespace jet {
 
@@ -54,6 +56,24 @@ class ParticleEmitter3 {
     //!
     void setOnBeginUpdateCallback(const OnBeginUpdateCallback& callback);
 
+    //!
+    //! \brief      Stores the state of the emitter to the checkpoint.
+    //!
+    //! Emitters that change over the course of the simulation, such as
+    //! one-shot emitters or emitters with random number generators, store
+    //! their state in the chunks whose names start with \p prefix. The
+    //! default implementation stores nothing.
+    //!
+    //! \param[in]  prefix     The prefix of the chunk names.
+    //! \param      checkpoint The checkpoint to store the state.
+    //!
+    virtual void saveCheckpoint(const std::string& prefix,
+                                Checkpoint* checkpoint) const;
+
+    //! Restores the state of the emitter from the checkpoint.
+    virtual void loadCheckpoint(const std::string& prefix,
+                                const Checkpoint& checkpoint);
+
  protected:
     //! Called when ParticleEmitter3::setTarget is executed.
     virtual void onSetTarget(const ParticleSystemData3Ptr& particles);
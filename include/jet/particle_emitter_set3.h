@@ -8,6 +8,7 @@
 #define INCLUDE_JET_PARTICLE_EMITTER_SET3_H_
 
 #include <jet/particle_emitter3.h>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -30,6 +31,14 @@ class ParticleEmitterSet3 final : public ParticleEmitter3 {
     //! Destructor.
     virtual ~ParticleEmitterSet3();
 
+    //! Stores the state of the sub-emitters to the checkpoint.
+    void saveCheckpoint(const std::string& prefix,
+                        Checkpoint* checkpoint) const override;
+
+    //! Restores the state of the sub-emitters from the checkpoint.
+    void loadCheckpoint(const std::string& prefix,
+                        const Checkpoint& checkpoint) override;
+
     //! Adds sub-emitter.
     void addEmitter(const ParticleEmitter3Ptr& emitter);
 
@@ -0,0 +1,92 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_PARTICLE_NEIGHBOR_LISTS_H_
+#define INCLUDE_JET_PARTICLE_NEIGHBOR_LISTS_H_
+
+#include <jet/array_accessor1.h>
+
+#include <functional>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Compressed (CSR) particle neighbor lists.
+//!
+//! This class stores the neighbor indices of all the particles in a single
+//! flat array. The neighbors of the i-th particle are stored in the range
+//! [offsets()[i], offsets()[i + 1]) of indices(). The lists can be built in
+//! parallel using two passes: counting the neighbors per particle, and then
+//! filling the indices after a prefix sum of the counts.
+//!
+class ParticleNeighborLists {
+ public:
+    //!
+    //! \brief Callback function for counting the neighbors of a particle.
+    //!
+    //! The callback takes the particle index and returns its number of
+    //! neighbors.
+    //!
+    typedef std::function<size_t(size_t)> CountCallback;
+
+    //!
+    //! \brief Callback function for writing the neighbors of a particle.
+    //!
+    //! The callback takes the particle index and the output buffer which has
+    //! the capacity returned from CountCallback for the same particle.
+    //!
+    typedef std::function<void(size_t, size_t*)> FillCallback;
+
+    //! Constructs empty neighbor lists.
+    ParticleNeighborLists();
+
+    //! Constructs neighbor lists from the nested vectors.
+    explicit ParticleNeighborLists(
+        const std::vector<std::vector<size_t>>& lists);
+
+    //! Returns the number of particles.
+    size_t size() const;
+
+    //! Returns true if there is no list.
+    bool empty() const;
+
+    //! Returns the neighbor indices of the i-th particle.
+    ConstArrayAccessor1<size_t> operator[](size_t i) const;
+
+    //! Returns the number of neighbors of the i-th particle.
+    size_t numberOfNeighbors(size_t i) const;
+
+    //! Returns the offsets array with size() + 1 entries.
+    ConstArrayAccessor1<size_t> offsets() const;
+
+    //! Returns the flat neighbor index array.
+    ConstArrayAccessor1<size_t> indices() const;
+
+    //! Clears the lists.
+    void clear();
+
+    //!
+    //! \brief Builds the lists for given number of particles in parallel.
+    //!
+    //! \param[in] numberOfParticles The number of particles.
+    //! \param[in] countCallback     Neighbor counting callback.
+    //! \param[in] fillCallback      Neighbor writing callback.
+    //!
+    void build(size_t numberOfParticles, const CountCallback& countCallback,
+               const FillCallback& fillCallback);
+
+    //! Converts the lists to nested vectors.
+    std::vector<std::vector<size_t>> toNestedVectors() const;
+
+ private:
+    std::vector<size_t> _offsets;
+    std::vector<size_t> _indices;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_PARTICLE_NEIGHBOR_LISTS_H_
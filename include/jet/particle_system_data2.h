@@ -9,6 +9,7 @@
 
 #include <jet/array1.h>
 #include <jet/point_neighbor_searcher2.h>
+#include <jet/particle_neighbor_lists.h>
 #include <jet/serialization.h>
 
 #include <memory>
@@ -140,6 +141,31 @@ class ParticleSystemData2 : public Serializable {
     //! Returns custom vector data layer at given index (mutable).
     ArrayAccessor1<Vector2D> vectorDataAt(size_t idx);
 
+    //!
+    //! \brief      Returns the particle ID array.
+    //!
+    //! Each particle gets a unique ID when it is added to the data structure.
+    //! The ID stays the same when the particles are reordered, so it can be
+    //! used for correlating the particles across the frames.
+    //!
+    ConstArrayAccessor1<size_t> particleIds() const;
+
+    //! Returns the ID which will be assigned to the next new particle.
+    size_t nextParticleId() const;
+
+    //!
+    //! \brief      Restores the particle IDs.
+    //!
+    //! This function replaces the IDs of the current particles and the ID for
+    //! the next new particle, for instance, when the particles are loaded from
+    //! a cache. The number of the IDs should match the number of particles.
+    //!
+    //! \param[in]  ids            The particle IDs.
+    //! \param[in]  nextParticleId The ID for the next new particle.
+    //!
+    void setParticleIds(const ConstArrayAccessor1<size_t>& ids,
+                        size_t nextParticleId);
+
     //!
     //! \brief      Adds a particle to the data structure.
     //!
@@ -197,17 +223,55 @@ class ParticleSystemData2 : public Serializable {
     //! \brief      Returns neighbor lists.
     //!
     //! This function returns neighbor lists which is available after calling
-    //! PointParallelHashGridSearcher2::buildNeighborLists. Each list stores
-    //! indices of the neighbors.
+    //! ParticleSystemData2::buildNeighborLists. The lists are stored in a
+    //! single flat (CSR) array, and neighborLists()[i] returns the indices of
+    //! the neighbors of the i-th particle.
     //!
     //! \return     Neighbor lists.
     //!
-    const std::vector<std::vector<size_t>>& neighborLists() const;
+    const ParticleNeighborLists& neighborLists() const;
+
+    //!
+    //! \brief      Reorders the particles with given order.
+    //!
+    //! This function moves the old particle order[i] to the new index i for
+    //! all the data layers including the particle IDs. The order should be a
+    //! permutation of the particle indices. If the neighbor lists are
+    //! available, the lists are remapped to the new indices as well. However,
+    //! this will invalidate neighbor searcher. It is users responsibility to
+    //! call ParticleSystemData2::buildNeighborSearcher to refresh the searcher.
+    //!
+    //! \param[in]  order   The old index of each new particle.
+    //!
+    void reorderParticles(const ConstArrayAccessor1<size_t>& order);
+
+    //!
+    //! \brief      Sorts the particles along the Morton (Z-order) curve.
+    //!
+    //! This function sorts the particles by the Morton code of the grid cells
+    //! they belong to, so that the particles close in space are also close in
+    //! memory. Neighbor gathers and particle-to-grid transfers then access
+    //! the memory more coherently. See
+    //! ParticleSystemData2::reorderParticles for the invalidated data.
+    //!
+    //! \param[in]  cellSize    The size of the grid cell.
+    //! \param[out] order       Optional output for the applied order.
+    //!
+    void sortParticlesSpatially(
+        double cellSize, Array1<size_t>* order = nullptr);
 
     //! Builds neighbor searcher with given search radius.
     void buildNeighborSearcher(double maxSearchRadius);
 
-    //! Builds neighbor lists with given search radius.
+    //!
+    //! \brief      Builds neighbor lists with given search radius.
+    //!
+    //! The lists are built in parallel with two passes: the first pass counts
+    //! the neighbors of each particle, and the second pass writes the
+    //! neighbor indices into the preallocated flat array.
+    //!
+    //! \param[in]  maxSearchRadius Search radius.
+    //!
     void buildNeighborLists(double maxSearchRadius);
 
     //! Serializes this particle system data to the buffer.
@@ -239,11 +303,14 @@ class ParticleSystemData2 : public Serializable {
     size_t _velocityIdx;
     size_t _forceIdx;
 
+    Array1<size_t> _particleIds;
+    size_t _nextParticleId = 0;
+
     std::vector<ScalarData> _scalarDataList;
     std::vector<VectorData> _vectorDataList;
 
     PointNeighborSearcher2Ptr _neighborSearcher;
-    std::vector<std::vector<size_t>> _neighborLists;
+    ParticleNeighborLists _neighborLists;
 };
 
 //! Shared pointer type of ParticleSystemData2.
@@ -111,6 +111,21 @@ class ParticleSystemSolver2 : public PhysicsAnimation {
     //!
     void setWind(const VectorField2Ptr& newWind);
 
+    //! Returns the interval of the spatial particle sorting in time-steps.
+    unsigned int spatialSortingInterval() const;
+
+    //!
+    //! \brief      Sets the interval of the spatial particle sorting.
+    //!
+    //! When the interval is positive, the solver sorts the particles along
+    //! the Morton curve (see ParticleSystemData2::sortParticlesSpatially)
+    //! every given number of time-steps, right after the emission. Zero
+    //! disables the sorting, which is the default.
+    //!
+    //! \param[in]  newInterval The new interval in time-steps.
+    //!
+    void setSpatialSortingInterval(unsigned int newInterval);
+
     //! Returns builder fox ParticleSystemSolver2.
     static Builder builder();
 
@@ -146,6 +161,8 @@ class ParticleSystemSolver2 : public PhysicsAnimation {
     double _dragCoefficient = 1e-4;
     double _restitutionCoefficient = 0.0;
     Vector2D _gravity = Vector2D(0.0, kGravity);
+    unsigned int _spatialSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSorting = 0;
 
     ParticleSystemData2Ptr _particleSystemData;
     ParticleSystemData2::VectorData _newPositions;
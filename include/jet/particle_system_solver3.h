@@ -111,6 +111,21 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     //!
     void setWind(const VectorField3Ptr& newWind);
 
+    //! Returns the interval of the spatial particle sorting in time-steps.
+    unsigned int spatialSortingInterval() const;
+
+    //!
+    //! \brief      Sets the interval of the spatial particle sorting.
+    //!
+    //! When the interval is positive, the solver sorts the particles along
+    //! the Morton curve (see ParticleSystemData3::sortParticlesSpatially)
+    //! every given number of time-steps, right after the emission. Zero
+    //! disables the sorting, which is the default.
+    //!
+    //! \param[in]  newInterval The new interval in time-steps.
+    //!
+    void setSpatialSortingInterval(unsigned int newInterval);
+
     //! Returns builder fox ParticleSystemSolver3.
     static Builder builder();
 
@@ -121,6 +136,12 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     //! Called to advane a single time-step.
     void onAdvanceTimeStep(double timeStepInSeconds) override;
 
+    //! Stores the particles and the solver state to the checkpoint.
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the particles and the solver state from the checkpoint.
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //! Accumulates forces applied to the particles.
     virtual void accumulateForces(double timeStepInSeconds);
 
@@ -146,6 +167,8 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     double _dragCoefficient = 1e-4;
     double _restitutionCoefficient = 0.0;
     Vector3D _gravity = Vector3D(0.0, kGravity, 0.0);
+    unsigned int _spatialSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSorting = 0;
 
     ParticleSystemData3Ptr _particleSystemData;
     ParticleSystemData3::VectorData _newPositions;
@@ -61,6 +61,12 @@ class PciSphSolver3 : public SphSolver3 {
     static Builder builder();
 
  protected:
+    //! Stores the PCISPH parameters to the checkpoint.
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the PCISPH parameters from the checkpoint.
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //! Accumulates the pressure force to the forces array in the particle
     //! system.
     void accumulatePressureForce(double timeIntervalInSeconds) override;
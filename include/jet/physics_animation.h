@@ -8,6 +8,7 @@
 #define INCLUDE_JET_PHYSICS_ANIMATION_H_
 
 #include <jet/animation.h>
+#include <jet/checkpoint.h>
 
 namespace jet {
 
@@ -94,6 +95,34 @@ class PhysicsAnimation : public Animation {
     //!
     double currentTimeInSeconds() const;
 
+    //!
+    //! \brief      Stores the state of the simulation to the checkpoint.
+    //!
+    //! This function copies the current frame and time, the parameters, the
+    //! data and the internal buffers that are needed to continue the
+    //! simulation into the checkpoint. It only copies the state in memory, so
+    //! the checkpoint can be written to the disk with Checkpoint::save on
+    //! another thread while the simulation continues (see AsyncFrameWriter).
+    //! Objects that are set from outside, such as surfaces and custom fields,
+    //! are not stored, except for the state of the emitters and colliders.
+    //!
+    //! \param[out] checkpoint The checkpoint to store the state.
+    //!
+    void saveCheckpoint(Checkpoint* checkpoint) const;
+
+    //!
+    //! \brief      Restores the state of the simulation from the checkpoint.
+    //!
+    //! The animation should be built the same way as the one that stored the
+    //! checkpoint, including its emitters and colliders. The data layers are
+    //! restored in place, so the grids and particles that are shared with
+    //! other objects stay valid. The next update() continues from the stored
+    //! frame.
+    //!
+    //! \param[in]  checkpoint The checkpoint to restore the state from.
+    //!
+    void loadCheckpoint(const Checkpoint& checkpoint);
+
  protected:
     //!
     //! \brief      Called when a single time-step should be advanced.
@@ -132,6 +161,26 @@ class PhysicsAnimation : public Animation {
     //!
     virtual void onInitialize();
 
+    //!
+    //! \brief      Called when the state is stored to the checkpoint.
+    //!
+    //! Inheriting classes should override this function to store their own
+    //! state after calling the function of the parent class.
+    //!
+    //! \param[out] checkpoint The checkpoint to store the state.
+    //!
+    virtual void onSaveCheckpoint(Checkpoint* checkpoint) const;
+
+    //!
+    //! \brief      Called when the state is restored from the checkpoint.
+    //!
+    //! Inheriting classes should override this function to restore their own
+    //! state after calling the function of the parent class.
+    //!
+    //! \param[in]  checkpoint The checkpoint to restore the state from.
+    //!
+    virtual void onLoadCheckpoint(const Checkpoint& checkpoint);
+
  private:
     Frame _currentFrame;
     bool _isUsingFixedSubTimeSteps = true;
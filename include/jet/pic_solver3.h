@@ -11,6 +11,8 @@
 #include <jet/particle_emitter3.h>
 #include <jet/particle_system_data3.h>
 
+#include <vector>
+
 namespace jet {
 
 //!
@@ -51,6 +53,21 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Sets the particle emitter.
     void setParticleEmitter(const ParticleEmitter3Ptr& newEmitter);
 
+    //! Returns the interval of the spatial particle sorting in time-steps.
+    unsigned int spatialSortingInterval() const;
+
+    //!
+    //! \brief      Sets the interval of the spatial particle sorting.
+    //!
+    //! When the interval is positive, the solver sorts the particles along
+    //! the Morton curve of the grid cells every given number of time-steps,
+    //! so that the particle-to-grid transfer accesses the memory coherently.
+    //! Zero disables the sorting, which is the default.
+    //!
+    //! \param[in]  newInterval The new interval in time-steps.
+    //!
+    void setSpatialSortingInterval(unsigned int newInterval);
+
     //! Returns builder fox PicSolver3.
     static Builder builder();
 
@@ -62,6 +79,12 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Initializes the simulator.
     void onInitialize() override;
 
+    //! Stores the particles and the emitter state to the checkpoint.
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the particles and the emitter state from the checkpoint.
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //! Invoked before a simulation time-step begins.
     void onBeginAdvanceTimeStep(double timeIntervalInSeconds) override;
 
@@ -80,16 +103,62 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Moves particles.
     virtual void moveParticles(double timeIntervalInSeconds);
 
+    //!
+    //! \brief      Invoked after the particles are sorted spatially.
+    //!
+    //! Subclasses which store their own per-particle data should reorder the
+    //! data with given order, where the new i-th particle was the order[i]-th
+    //! particle before the sorting.
+    //!
+    //! \param[in]  order   The old index of each new particle.
+    //!
+    virtual void onParticlesSorted(const ConstArrayAccessor1<size_t>& order);
+
+    //!
+    //! \brief      Bins the particles by the z-index of the grid cell they
+    //!             are in.
+    //!
+    //! Call this once per transfer before parallelForEachParticleInSlabs.
+    //! The bins are valid until the particles move. Both the counting and
+    //! the scatter of the sort run in parallel over chunks of particles.
+    //!
+    void binParticlesToSlabs();
+
+    //!
+    //! \brief      Invokes given function for each particle in parallel,
+    //!             grouped by the cell slabs from binParticlesToSlabs.
+    //!
+    //! A particle in the cell slab k splats to the grid points with z-index
+    //! from k - 1 to k + 1 for any of the face-centered components, so the
+    //! same bins serve all the components. Every third slab is processed in
+    //! parallel at a time, while the particles in a slab are processed
+    //! serially in the index order. Since the slabs processed at the same
+    //! time do not share any grid point, the function can scatter to the
+    //! grid without synchronization, and the summation order at each grid
+    //! point is independent of the number of threads.
+    //!
+    //! \param[in]  func    The function taking the particle index.
+    //!
+    template <typename Callback>
+    void parallelForEachParticleInSlabs(const Callback& func) const;
+
  private:
     size_t _signedDistanceFieldId;
     ParticleSystemData3Ptr _particles;
     ParticleEmitter3Ptr _particleEmitter;
+    unsigned int _spatialSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSorting = 0;
+    std::vector<size_t> _particleSlabs;
+    std::vector<size_t> _slabStarts;
+    std::vector<size_t> _slabParticles;
 
     void extrapolateVelocityToAir();
 
     void buildSignedDistanceField();
 
     void updateParticleEmitter(double timeIntervalInSeconds);
+
+    void sortParticlesSpatially();
 };
 
 //! Shared pointer type for the PicSolver3.
@@ -111,4 +180,6 @@ class PicSolver3::Builder final
 
 }  // namespace jet
 
+#include "detail/pic_solver3-inl.h"
+
 #endif  // INCLUDE_JET_PIC_SOLVER3_H_
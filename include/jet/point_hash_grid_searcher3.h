@@ -77,6 +77,22 @@ class PointHashGridSearcher3 final : public PointNeighborSearcher3 {
         double radius,
         const ForEachNearbyPointFunc& callback) const override;
 
+    //!
+    //! \brief      Invokes the visitor for each nearby point around the origin
+    //!             within given radius.
+    //!
+    //! This is the non-virtual version of forEachNearbyPoint which can be
+    //! inlined when the concrete searcher type is known. The visitor is
+    //! invoked as visitor(index, point, distanceSquared).
+    //!
+    //! \param[in]  origin  The origin position.
+    //! \param[in]  radius  The search radius.
+    //! \param[in]  visitor The visitor function object.
+    //!
+    template <typename Visitor>
+    void visitNearbyPoints(const Vector3D& origin, double radius,
+                           const Visitor& visitor) const;
+
     //!
     //! Returns true if there are any nearby points for given origin within
     //! radius.
@@ -89,6 +105,21 @@ class PointHashGridSearcher3 final : public PointNeighborSearcher3 {
     bool hasNearbyPoint(
         const Vector3D& origin, double radius) const override;
 
+    //!
+    //! \brief      Finds the nearby points of each origin within given radius.
+    //!
+    //! \param[in]  origins          The origin positions.
+    //! \param[in]  radius           The search radius.
+    //! \param[out] lists            The nearby point lists.
+    //! \param[out] distancesSquared The squared distances (optional).
+    //! \param      buffers          The scratch buffers (optional).
+    //!
+    void findNearbyPoints(
+        const ConstArrayAccessor1<Vector3D>& origins, double radius,
+        ParticleNeighborLists* lists,
+        std::vector<double>* distancesSquared = nullptr,
+        NearbyPointBuffers* buffers = nullptr) const override;
+
     //!
     //! \brief      Adds a single point to the hash grid.
     //!
@@ -193,4 +224,6 @@ class PointHashGridSearcher3::Builder final
 
 }  // namespace jet
 
+#include "detail/point_hash_grid_searcher3-inl.h"
+
 #endif  // INCLUDE_JET_POINT_HASH_GRID_SEARCHER3_H_
@@ -8,6 +8,7 @@
 #define INCLUDE_JET_POINT_NEIGHBOR_SEARCHER3_H_
 
 #include <jet/array_accessor1.h>
+#include <jet/particle_neighbor_lists.h>
 #include <jet/serialization.h>
 #include <jet/vector3.h>
 #include <functional>
@@ -69,6 +70,49 @@ class PointNeighborSearcher3 : public Serializable {
     virtual bool hasNearbyPoint(
         const Vector3D& origin, double radius) const = 0;
 
+    //!
+    //! \brief Scratch buffers of findNearbyPoints.
+    //!
+    //! The query results are gathered per chunk of origins before they are
+    //! copied to the compressed lists. Passing the same buffers to repeated
+    //! calls keeps their capacity, so the gathering does not allocate.
+    //!
+    struct NearbyPointBuffers {
+        //! Nearby point indices gathered per chunk of origins.
+        std::vector<std::vector<size_t>> chunkIndices;
+
+        //! Squared distances gathered per chunk of origins.
+        std::vector<std::vector<double>> chunkDistances;
+
+        //! Offsets of the results of each origin.
+        std::vector<size_t> offsets;
+    };
+
+    //!
+    //! \brief      Finds the nearby points of each origin within given radius.
+    //!
+    //! This function runs the queries for all the origins in parallel with a
+    //! single virtual call, and stores the results in compressed lists. The
+    //! indices of the points near origins[i] are stored in (*lists)[i]. If
+    //! \p distancesSquared is not null, the squared distances to the points
+    //! are stored in the same layout as lists->indices(). The output vectors
+    //! and \p buffers keep their capacity, so calling this function
+    //! repeatedly with the same buffers and a similar number of results does
+    //! not reallocate them. If \p buffers is null, temporary buffers are
+    //! allocated for the call.
+    //!
+    //! \param[in]  origins          The origin positions.
+    //! \param[in]  radius           The search radius.
+    //! \param[out] lists            The nearby point lists.
+    //! \param[out] distancesSquared The squared distances (optional).
+    //! \param      buffers          The scratch buffers (optional).
+    //!
+    virtual void findNearbyPoints(
+        const ConstArrayAccessor1<Vector3D>& origins, double radius,
+        ParticleNeighborLists* lists,
+        std::vector<double>* distancesSquared = nullptr,
+        NearbyPointBuffers* buffers = nullptr) const;
+
     //!
     //! \brief      Creates a new instance of the object with same properties
     //!             than original.
@@ -76,6 +120,21 @@ class PointNeighborSearcher3 : public Serializable {
     //! \return     Copy of this object.
     //!
     virtual std::shared_ptr<PointNeighborSearcher3> clone() const = 0;
+
+ protected:
+    //!
+    //! \brief      Builds the nearby point lists using the visitor query of
+    //!             given searcher.
+    //!
+    //! This is the common implementation of findNearbyPoints. The searcher
+    //! should provide visitNearbyPoints(origin, radius, visitor) which invokes
+    //! visitor(index, point, distanceSquared) for each nearby point.
+    //!
+    template <typename Searcher>
+    static void buildNearbyPointLists(
+        const Searcher& searcher, const ConstArrayAccessor1<Vector3D>& origins,
+        double radius, ParticleNeighborLists* lists,
+        std::vector<double>* distancesSquared, NearbyPointBuffers* buffers);
 };
 
 //! Shared pointer for the PointNeighborSearcher3 type.
@@ -99,5 +158,7 @@ typedef std::shared_ptr<PointNeighborSearcherBuilder3>
 
 }  // namespace jet
 
+#include "detail/point_neighbor_searcher3-inl.h"
+
 #endif  // INCLUDE_JET_POINT_NEIGHBOR_SEARCHER3_H_
 
@@ -64,7 +64,11 @@ class PointParallelHashGridSearcher2 final : public PointNeighborSearcher2 {
     //!
     //! \brief Builds internal acceleration structure for given points list.
     //!
-    //! This function builds the hash grid for given points in parallel.
+    //! This function builds the hash grid for given points in parallel. When
+    //! called again, the function reuses the allocated tables and starts from
+    //! the previous sorted order, so rebuilding for slightly moved points only
+    //! costs a linear-time counting sort (or no sort at all if no point has
+    //! changed its bucket).
     //!
     //! \param[in]  points The points to be added.
     //!
@@ -167,6 +171,12 @@ class PointParallelHashGridSearcher2 final : public PointNeighborSearcher2 {
     //!
     const std::vector<size_t>& sortedIndices() const;
 
+    //! Returns the grid spacing of the hash grid.
+    double gridSpacing() const;
+
+    //! Returns the resolution of the hash grid.
+    Size2 resolution() const;
+
     //!
     //! Returns the hash value for given 2-D bucket index.
     //!
@@ -64,7 +64,11 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3 {
     //!
     //! \brief Builds internal acceleration structure for given points list.
     //!
-    //! This function builds the hash grid for given points in parallel.
+    //! This function builds the hash grid for given points in parallel. When
+    //! called again, the function reuses the allocated tables and starts from
+    //! the previous sorted order, so rebuilding for slightly moved points only
+    //! costs a linear-time counting sort (or no sort at all if no point has
+    //! changed its bucket).
     //!
     //! \param[in]  points The points to be added.
     //!
@@ -83,6 +87,22 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3 {
         double radius,
         const ForEachNearbyPointFunc& callback) const override;
 
+    //!
+    //! \brief      Invokes the visitor for each nearby point around the origin
+    //!             within given radius.
+    //!
+    //! This is the non-virtual version of forEachNearbyPoint which can be
+    //! inlined when the concrete searcher type is known. The visitor is
+    //! invoked as visitor(index, point, distanceSquared).
+    //!
+    //! \param[in]  origin  The origin position.
+    //! \param[in]  radius  The search radius.
+    //! \param[in]  visitor The visitor function object.
+    //!
+    template <typename Visitor>
+    void visitNearbyPoints(const Vector3D& origin, double radius,
+                           const Visitor& visitor) const;
+
     //!
     //! Returns true if there are any nearby points for given origin within
     //! radius.
@@ -95,6 +115,21 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3 {
     bool hasNearbyPoint(
         const Vector3D& origin, double radius) const override;
 
+    //!
+    //! \brief      Finds the nearby points of each origin within given radius.
+    //!
+    //! \param[in]  origins          The origin positions.
+    //! \param[in]  radius           The search radius.
+    //! \param[out] lists            The nearby point lists.
+    //! \param[out] distancesSquared The squared distances (optional).
+    //! \param      buffers          The scratch buffers (optional).
+    //!
+    void findNearbyPoints(
+        const ConstArrayAccessor1<Vector3D>& origins, double radius,
+        ParticleNeighborLists* lists,
+        std::vector<double>* distancesSquared = nullptr,
+        NearbyPointBuffers* buffers = nullptr) const override;
+
     //!
     //! \brief      Returns the hash key list.
     //!
@@ -167,6 +202,12 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3 {
     //!
     const std::vector<size_t>& sortedIndices() const;
 
+    //! Returns the grid spacing of the hash grid.
+    double gridSpacing() const;
+
+    //! Returns the resolution of the hash grid.
+    Size3 resolution() const;
+
     //!
     //! Returns the hash value for given 3-D bucket index.
     //!
@@ -256,4 +297,6 @@ class PointParallelHashGridSearcher3::Builder final
 
 }  // namespace jet
 
+#include "detail/point_parallel_hash_grid_searcher3-inl.h"
+
 #endif  // INCLUDE_JET_POINT_PARALLEL_HASH_GRID_SEARCHER3_H_
@@ -10,6 +10,7 @@
 #include <jet/particle_emitter3.h>
 #include <limits>
 #include <random>
+#include <string>
 
 namespace jet {
 
@@ -59,6 +60,15 @@ class PointParticleEmitter3 final : public ParticleEmitter3 {
     //! Sets max number of particles to be emitted.
     void setMaxNumberOfParticles(size_t maxNumberOfParticles);
 
+    //! Stores the random number generator state and the emission count to
+    //! the checkpoint.
+    void saveCheckpoint(const std::string& prefix,
+                        Checkpoint* checkpoint) const override;
+
+    //! Restores the random number generator state and the emission count.
+    void loadCheckpoint(const std::string& prefix,
+                        const Checkpoint& checkpoint) override;
+
     //! Returns builder fox PointParticleEmitter3.
     static Builder builder();
 
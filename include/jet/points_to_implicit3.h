@@ -8,9 +8,11 @@
 #define INCLUDE_JET_POINTS_TO_IMPLICIT3_H_
 
 #include <jet/array_accessor1.h>
+#include <jet/level_set_solver3.h>
 #include <jet/scalar_grid3.h>
 #include <jet/vector3.h>
 
+#include <functional>
 #include <memory>
 
 namespace jet {
@@ -27,6 +29,82 @@ class PointsToImplicit3 {
     //! Converts the given points to implicit surface scalar field.
     virtual void convert(const ConstArrayAccessor1<Vector3D>& points,
                          ScalarGrid3* output) const = 0;
+
+    //! Returns true if the narrow-band evaluation mode is enabled.
+    bool isNarrowBandEnabled() const;
+
+    //!
+    //! \brief Enables or disables the narrow-band evaluation mode.
+    //!
+    //! In the narrow-band mode, the implicit function is evaluated only at
+    //! the grid points in the blocks which are within the kernel radius of
+    //! any input point, and the rest of the grid gets the far-field value
+    //! directly. When the output is a signed-distance field, the
+    //! reinitialization also runs only within the band, and the distances
+    //! are clamped to the kernel radius.
+    //!
+    void setIsNarrowBandEnabled(bool isEnabled);
+
+    //! Returns the level set solver for the reinitialization.
+    const LevelSetSolver3Ptr& levelSetSolver() const;
+
+    //!
+    //! \brief Sets the level set solver for the reinitialization.
+    //!
+    //! If the solver is null (default), FmmLevelSetSolver3 is used.
+    //!
+    void setLevelSetSolver(const LevelSetSolver3Ptr& solver);
+
+ protected:
+    //!
+    //! \brief Evaluates the implicit function at the grid data points.
+    //!
+    //! \param[in] points   The input points.
+    //! \param[in] radius   The radius beyond which the function is constant.
+    //! \param[in] farValue The function value beyond the radius.
+    //! \param[in] func     The implicit function.
+    //! \param     output   The output grid.
+    //!
+    void evaluate(const ConstArrayAccessor1<Vector3D>& points, double radius,
+                  double farValue,
+                  const std::function<double(const Vector3D&)>& func,
+                  ScalarGrid3* output) const;
+
+    //!
+    //! \brief Evaluates the implicit function at the grid data points in
+    //!        batches.
+    //!
+    //! Same as evaluate, but the function is called with a batch of
+    //! positions and writes the values for all of them, as in
+    //! func(positions, values). The grid points are passed slab by slab, so
+    //! the function can run its own parallel batched queries.
+    //!
+    //! \param[in] points   The input points.
+    //! \param[in] radius   The radius beyond which the function is constant.
+    //! \param[in] farValue The function value beyond the radius.
+    //! \param[in] func     The batched implicit function.
+    //! \param     output   The output grid.
+    //!
+    void evaluateInBatches(
+        const ConstArrayAccessor1<Vector3D>& points, double radius,
+        double farValue,
+        const std::function<void(const ConstArrayAccessor1<Vector3D>&,
+                                 ArrayAccessor1<double>)>& func,
+        ScalarGrid3* output) const;
+
+    //!
+    //! \brief Reinitializes the evaluated field to signed-distance field.
+    //!
+    //! \param[in] input     The evaluated implicit field.
+    //! \param[in] bandWidth The band width for the narrow-band mode.
+    //! \param     output    The output signed-distance field.
+    //!
+    void reinitialize(const ScalarGrid3& input, double bandWidth,
+                      ScalarGrid3* output) const;
+
+ private:
+    bool _isNarrowBandEnabled = false;
+    LevelSetSolver3Ptr _levelSetSolver;
 };
 
 //! Shared pointer for the PointsToImplicit3 type.
@@ -9,6 +9,7 @@
 
 #include <jet/collider3.h>
 #include <jet/quaternion.h>
+#include <jet/scalar_grid3.h>
 
 namespace jet {
 
@@ -18,6 +19,12 @@ namespace jet {
 //! This class implements 3-D rigid body collider. The collider can only take
 //! rigid body motion with linear and rotational velocities.
 //!
+//! Optionally, the surface can be baked into a signed-distance field in the
+//! local frame of the surface. Since the body only moves rigidly, the cached
+//! field stays valid under any change of the surface transform, and the
+//! signed-distance and closest-point queries become transformed lookups in
+//! the cached field instead of the surface queries.
+//!
 class RigidBodyCollider3 final : public Collider3 {
  public:
     class Builder;
@@ -40,8 +47,55 @@ class RigidBodyCollider3 final : public Collider3 {
     //! Returns the velocity of the collider at given \p point.
     Vector3D velocityAt(const Vector3D& point) const override;
 
+    //! Returns the signed distance from the surface to given \p point.
+    double signedDistance(const Vector3D& point) const override;
+
+    //! Stores the velocities and the base collider state to the checkpoint.
+    void saveCheckpoint(const std::string& prefix,
+                        Checkpoint* checkpoint) const override;
+
+    //! Restores the velocities and the base collider state.
+    void loadCheckpoint(const std::string& prefix,
+                        const Checkpoint& checkpoint) override;
+
+    //! Returns the grid spacing of the cached SDF, or zero if not cached.
+    double sdfCacheGridSpacing() const;
+
+    //!
+    //! \brief Sets the grid spacing of the cached SDF and bakes the surface.
+    //!
+    //! Zero (default) disables the cache, and unbounded surfaces are never
+    //! cached. Within the cached region, which is the local bounding box of
+    //! the surface with a few cells of margin, the queries are trilinear
+    //! interpolations of the baked distances. Outside of it, the distance to
+    //! the region is added to the boundary value.
+    //!
+    void setSdfCacheGridSpacing(double gridSpacing);
+
+    //!
+    //! \brief Rebakes the cached SDF from the surface.
+    //!
+    //! Call this function when the geometry of the surface has changed. The
+    //! transform changes do not require rebaking.
+    //!
+    void updateSdfCache();
+
     //! Returns builder fox RigidBodyCollider3.
     static Builder builder();
+
+ protected:
+    //! Outputs closest point's information.
+    void getClosestPoint(
+        const Surface3Ptr& surface,
+        const Vector3D& queryPoint,
+        ColliderQueryResult* result) const override;
+
+ private:
+    double _sdfCacheGridSpacing = 0.0;
+    ScalarGrid3Ptr _sdfCache;
+    BoundingBox3D _sdfCacheBounds;
+
+    double sampleSdfCache(const Vector3D& pointInLocal) const;
 };
 
 //! Shared pointer for the RigidBodyCollider3 type.
@@ -62,6 +116,9 @@ class RigidBodyCollider3::Builder final {
     //! Returns builder with angular velocity.
     Builder& withAngularVelocity(const Vector3D& angularVelocity);
 
+    //! Returns builder with the grid spacing of the cached SDF.
+    Builder& withSdfCacheGridSpacing(double gridSpacing);
+
     //! Builds RigidBodyCollider3.
     RigidBodyCollider3 build() const;
 
@@ -72,6 +129,7 @@ class RigidBodyCollider3::Builder final {
     Surface3Ptr _surface;
     Vector3D _linearVelocity{0, 0, 0};
     Vector3D _angularVelocity{0, 0, 0};
+    double _sdfCacheGridSpacing = 0.0;
 };
 
 }  // namespace jet
@@ -9,6 +9,7 @@
 
 #include <jet/advection_solver3.h>
 #include <limits>
+#include <vector>
 
 namespace jet {
 
@@ -52,6 +53,30 @@ class SemiLagrangian3 : public AdvectionSolver3 {
                 const ScalarField3& boundarySdf = ConstantScalarField3(
                     std::numeric_limits<double>::max())) final;
 
+    //!
+    //! \brief Computes semi-Langian for the listed data points of given
+    //! scalar grid.
+    //!
+    //! This function computes the same semi-Lagrangian update as the scalar
+    //! grid version of SemiLagrangian3::advect, but only for the data points
+    //! of \p output listed in \p dataPoints. The other data points are left
+    //! unchanged.
+    //!
+    //! \param input Input scalar grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param dataPoints Indices of the data points to update.
+    //! \param output Output scalar grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advectDataPoints(const ScalarGrid3& input, const VectorField3& flow,
+                          double dt, const std::vector<Point3UI>& dataPoints,
+                          ScalarGrid3* output,
+                          const ScalarField3& boundarySdf =
+                              ConstantScalarField3(
+                                  std::numeric_limits<double>::max())) final;
+
     //!
     //! \brief Computes semi-Langian for given collocated vector grid.
     //!
@@ -99,6 +124,67 @@ class SemiLagrangian3 : public AdvectionSolver3 {
                 const ScalarField3& boundarySdf = ConstantScalarField3(
                     std::numeric_limits<double>::max())) final;
 
+    //!
+    //! \brief Computes semi-Langian for multiple scalar grids at once.
+    //!
+    //! The grids in \p outputs are grouped by their data point positions. For
+    //! each group, the departure points are traced once and all the grids in
+    //! the group are sampled from them, so adding a grid to the batch only
+    //! adds the sampling cost.
+    //!
+    //! \param inputs Input scalar grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param outputs Output scalar grids, one for each input grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(const std::vector<const ScalarGrid3*>& inputs,
+                const VectorField3& flow, double dt,
+                const std::vector<ScalarGrid3*>& outputs,
+                const ScalarField3& boundarySdf = ConstantScalarField3(
+                    std::numeric_limits<double>::max())) final;
+
+    //!
+    //! \brief Computes semi-Langian for multiple collocated vector grids at
+    //! once.
+    //!
+    //! This function traces the departure points once for each group of grids
+    //! with the same data point positions.
+    //!
+    //! \param inputs Input vector grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param outputs Output vector grids, one for each input grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(const std::vector<const CollocatedVectorGrid3*>& inputs,
+                const VectorField3& flow, double dt,
+                const std::vector<CollocatedVectorGrid3*>& outputs,
+                const ScalarField3& boundarySdf = ConstantScalarField3(
+                    std::numeric_limits<double>::max())) final;
+
+    //!
+    //! \brief Computes semi-Langian for multiple face-centered vector grids at
+    //! once.
+    //!
+    //! This function traces the departure points of the u, v and w faces once
+    //! for each group of grids with the same shape.
+    //!
+    //! \param inputs Input vector grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param outputs Output vector grids, one for each input grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(const std::vector<const FaceCenteredGrid3*>& inputs,
+                const VectorField3& flow, double dt,
+                const std::vector<FaceCenteredGrid3*>& outputs,
+                const ScalarField3& boundarySdf = ConstantScalarField3(
+                    std::numeric_limits<double>::max())) final;
+
  protected:
     //!
     //! \brief Returns spatial interpolation function object for given scalar
@@ -135,10 +221,6 @@ class SemiLagrangian3 : public AdvectionSolver3 {
     //!
     virtual std::function<Vector3D(const Vector3D&)> getVectorSamplerFunc(
         const FaceCenteredGrid3& input) const;
-
- private:
-    Vector3D backTrace(const VectorField3& flow, double dt, double h,
-                       const Vector3D& pt0, const ScalarField3& boundarySdf);
 };
 
 typedef std::shared_ptr<SemiLagrangian3> SemiLagrangian3Ptr;
@@ -0,0 +1,110 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SOA_VECTOR_ARRAY3_H_
+#define INCLUDE_JET_SOA_VECTOR_ARRAY3_H_
+
+#include <jet/array_accessor1.h>
+#include <jet/vector3.h>
+
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief 3-D vector array with structure-of-arrays layout.
+//!
+//! This class stores the x, y, and z components of the vectors in separate
+//! arrays, each aligned to kAlignment bytes. Compared to Array1<Vector3D>,
+//! the components of consecutive vectors are contiguous, so SIMD loops can
+//! load and gather them directly. The particle data in ParticleSystemData3 is
+//! kept in the array-of-structures layout, and the copyFrom and copyTo
+//! functions convert between the two layouts for the passes which run on
+//! this layout.
+//!
+class SoaVectorArray3 {
+ public:
+    //! Alignment of each component array in bytes.
+    static constexpr size_t kAlignment = 32;
+
+    //! Constructs an empty array.
+    SoaVectorArray3();
+
+    //! Constructs an array with given size filled with zero vectors.
+    explicit SoaVectorArray3(size_t size);
+
+    //! Copy constructor.
+    SoaVectorArray3(const SoaVectorArray3& other);
+
+    //! Move constructor.
+    SoaVectorArray3(SoaVectorArray3&& other);
+
+    //! Returns the number of vectors.
+    size_t size() const;
+
+    //! Resizes the array. The new vectors are initialized to zero.
+    void resize(size_t size);
+
+    //! Returns the x components.
+    double* x();
+
+    //! Returns the x components.
+    const double* x() const;
+
+    //! Returns the y components.
+    double* y();
+
+    //! Returns the y components.
+    const double* y() const;
+
+    //! Returns the z components.
+    double* z();
+
+    //! Returns the z components.
+    const double* z() const;
+
+    //! Returns the i-th vector.
+    Vector3D operator[](size_t i) const;
+
+    //! Sets the i-th vector.
+    void set(size_t i, const Vector3D& value);
+
+    //! Copies from the other array.
+    void set(const SoaVectorArray3& other);
+
+    //!
+    //! \brief Resizes to the input array and copies its vectors in parallel.
+    //!
+    //! \param[in] input The vectors in array-of-structures layout.
+    //!
+    void copyFrom(const ConstArrayAccessor1<Vector3D>& input);
+
+    //!
+    //! \brief Copies the vectors to the output array in parallel.
+    //!
+    //! \param[out] output The output array which should have the same size.
+    //!
+    void copyTo(ArrayAccessor1<Vector3D> output) const;
+
+    //! Copies from the other array.
+    SoaVectorArray3& operator=(const SoaVectorArray3& other);
+
+    //! Moves the other array.
+    SoaVectorArray3& operator=(SoaVectorArray3&& other);
+
+ private:
+    size_t _size = 0;
+    size_t _stride = 0;
+    std::vector<double> _buffer;
+
+    double* channel(size_t axis);
+
+    const double* channel(size_t axis) const;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_SOA_VECTOR_ARRAY3_H_
@@ -9,6 +9,7 @@
 
 #include <jet/constants.h>
 #include <jet/particle_system_solver3.h>
+#include <jet/soa_vector_array3.h>
 #include <jet/sph_system_data3.h>
 
 namespace jet {
@@ -125,6 +126,12 @@ class SphSolver3 : public ParticleSystemSolver3 {
     unsigned int numberOfSubTimeSteps(
         double timeIntervalInSeconds) const override;
 
+    //! Stores the SPH parameters to the checkpoint.
+    void onSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the SPH parameters from the checkpoint.
+    void onLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //! Accumulates the force to the forces array in the particle system.
     void accumulateForces(double timeStepInSeconds) override;
 
@@ -182,6 +189,15 @@ class SphSolver3 : public ParticleSystemSolver3 {
 
     //! Scales the max allowed time-step.
     double _timeStepLimitScale = 1.0;
+
+    //! Particle positions in SoA layout for the force kernels.
+    SoaVectorArray3 _soaPositions;
+
+    //! Particle velocities in SoA layout for the force kernels.
+    SoaVectorArray3 _soaVelocities;
+
+    //! Per-particle coefficients for the force kernels.
+    Array1<double> _forceCoefficients;
 };
 
 //! Shared pointer type for the SphSolver3.
@@ -139,6 +139,32 @@ class SphSystemData3 : public ParticleSystemData3 {
     Vector3D interpolate(const Vector3D& origin,
                          const ConstArrayAccessor1<Vector3D>& values) const;
 
+    //!
+    //! \brief Interpolates the values at the given origin points.
+    //!
+    //! This function computes the same value with the single-origin version
+    //! for each origin, but runs the neighbor queries in batches which avoids
+    //! the per-neighbor callback dispatch.
+    //!
+    //! \param[in]  origins The origin points.
+    //! \param[in]  values  The data array matching the particle layout.
+    //! \param[out] results The interpolated values for each origin.
+    //!
+    void interpolate(const ConstArrayAccessor1<Vector3D>& origins,
+                     const ConstArrayAccessor1<double>& values,
+                     ArrayAccessor1<double> results) const;
+
+    //!
+    //! \brief Interpolates the vector values at the given origin points.
+    //!
+    //! \param[in]  origins The origin points.
+    //! \param[in]  values  The data array matching the particle layout.
+    //! \param[out] results The interpolated values for each origin.
+    //!
+    void interpolate(const ConstArrayAccessor1<Vector3D>& origins,
+                     const ConstArrayAccessor1<Vector3D>& values,
+                     ArrayAccessor1<Vector3D> results) const;
+
     //! Returns the gradient of the given values at i-th particle.
     Vector3D gradientAt(size_t i,
                         const ConstArrayAccessor1<double>& values) const;
@@ -187,8 +213,21 @@ class SphSystemData3 : public ParticleSystemData3 {
 
     size_t _densityIdx;
 
+    //! Buffers of the batched neighbor queries, which are reused between
+    //! the calls. Thus, the batched queries of the same object should not
+    //! run concurrently.
+    mutable ParticleNeighborLists _batchNeighborLists;
+    mutable std::vector<double> _batchDistancesSquared;
+    mutable PointNeighborSearcher3::NearbyPointBuffers _batchQueryBuffers;
+
     //! Computes the mass based on the target density and spacing.
     void computeMass();
+
+    //! Invokes func(i, neighbors, distancesSquared) for each origin in
+    //! parallel using the batched neighbor queries.
+    template <typename Func>
+    void forEachNeighborBatch(const ConstArrayAccessor1<Vector3D>& origins,
+                              double radius, const Func& func) const;
 };
 
 //! Shared pointer for the SphSystemData3 type.
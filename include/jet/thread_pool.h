@@ -0,0 +1,118 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_THREAD_POOL_H_
+#define INCLUDE_JET_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Persistent work-stealing thread pool.
+//!
+//! This class keeps a fixed set of worker threads alive for the lifetime of
+//! the pool. Each worker owns a task deque; a worker pops its own tasks in LIFO
+//! order and steals from the other workers in FIFO order when it runs out of
+//! work. The thread that waits for a parallel loop also executes pending tasks
+//! instead of blocking, so nested parallel loops cannot deadlock the pool.
+//!
+//! The pool backs the parallel primitives in parallel.h when Jet is built with
+//! the C++11 thread tasking system.
+//!
+class ThreadPool {
+ public:
+    //! Task type.
+    typedef std::function<void()> Task;
+
+    //! Constructs a pool with given number of worker threads.
+    explicit ThreadPool(unsigned int numberOfWorkers);
+
+    //! Joins all the worker threads after finishing the queued tasks.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //! Returns the number of worker threads.
+    unsigned int numberOfWorkers() const;
+
+    //!
+    //! \brief Changes the number of worker threads.
+    //!
+    //! Pending tasks are finished before the workers are replaced. This
+    //! function should not be called while other threads are submitting work
+    //! to the pool.
+    //!
+    void resize(unsigned int numberOfWorkers);
+
+    //!
+    //! \brief Enqueues a task to be executed asynchronously.
+    //!
+    //! If the pool has no worker threads, the task is executed immediately on
+    //! the calling thread.
+    //!
+    void schedule(Task task);
+
+    //!
+    //! \brief Invokes \p func for each chunk index in [0, numberOfChunks).
+    //!
+    //! Chunks are handed out dynamically to the calling thread and up to
+    //! numberOfWorkers() workers. The function returns when every chunk has
+    //! been processed.
+    //!
+    void forEachChunk(size_t numberOfChunks,
+                      const std::function<void(size_t)>& func);
+
+    //!
+    //! \brief Runs one pending task on the calling thread if there is any.
+    //!
+    //! \return True if a task has been executed.
+    //!
+    bool runPendingTask();
+
+    //! Returns the default pool shared by the parallel primitives.
+    static ThreadPool& defaultPool();
+
+ private:
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUp;
+    std::atomic<size_t> _numQueuedTasks;
+    std::atomic<size_t> _numRunningTasks;
+    std::atomic<size_t> _nextQueue;
+    bool _stop = false;
+
+    void startWorkers(unsigned int numberOfWorkers);
+
+    void stopWorkers();
+
+    void workerLoop(size_t index);
+
+    bool popTask(size_t index, Task* task);
+
+    bool stealTask(size_t thiefIndex, Task* task);
+
+    void push(size_t index, Task&& task);
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_THREAD_POOL_H_
@@ -49,7 +49,8 @@ namespace jet {
 //! values of the areas that are farther from the mesh surface will be
 //! approximated using fast sweeping method. The sign of the signed-distance
 //! field is determined by assuming the boundig box of the output scalar grid
-//! is the exterior of the mesh.
+//! is the exterior of the mesh. All the stages, including the exact band
+//! evaluation, the sweeps, and the sign evaluation, run in parallel.
 //!
 //! This function is a port of Christopher Batty's SDFGen software.
 //!
@@ -7,7 +7,9 @@
 #ifndef INCLUDE_JET_VECTOR_FIELD3_H_
 #define INCLUDE_JET_VECTOR_FIELD3_H_
 
+#include <jet/array_accessor1.h>
 #include <jet/field3.h>
+#include <jet/parallel.h>
 #include <jet/vector3.h>
 #include <functional>
 #include <memory>
@@ -26,6 +28,24 @@ class VectorField3 : public Field3 {
     //! Returns sampled value at given position \p x.
     virtual Vector3D sample(const Vector3D& x) const = 0;
 
+    //!
+    //! \brief Samples the field at the given \p points.
+    //!
+    //! This function writes the sampled value at points[i] to result[i]. The
+    //! default implementation calls sample(x) for each point. The grids
+    //! override it to share the per-point index and weight computation and to
+    //! avoid the virtual call per sample, so the hot loops which sample many
+    //! points, such as the grid-to-particle transfer, should prefer it.
+    //!
+    //! \param[in]  points The sampling positions.
+    //! \param[out] result The sampled values with the same size as \p points.
+    //! \param[in]  policy The execution policy (parallel or serial).
+    //!
+    virtual void sample(
+        const ConstArrayAccessor1<Vector3D>& points,
+        ArrayAccessor1<Vector3D> result,
+        ExecutionPolicy policy = ExecutionPolicy::kParallel) const;
+
     //! Returns divergence at given position \p x.
     virtual double divergence(const Vector3D& x) const;
 
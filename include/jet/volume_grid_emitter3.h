@@ -11,6 +11,7 @@
 #include <jet/scalar_grid3.h>
 #include <jet/vector_grid3.h>
 
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -96,6 +97,14 @@ class VolumeGridEmitter3 final : public GridEmitter3 {
     //! Returns true if this emits only once.
     bool isOneShot() const;
 
+    //! Stores whether the one-shot emission has happened to the checkpoint.
+    void saveCheckpoint(const std::string& prefix,
+                        Checkpoint* checkpoint) const override;
+
+    //! Restores whether the one-shot emission has happened.
+    void loadCheckpoint(const std::string& prefix,
+                        const Checkpoint& checkpoint) override;
+
     //! Returns builder fox VolumeGridEmitter3.
     static Builder builder();
 
@@ -14,6 +14,7 @@
 #include <limits>
 #include <memory>
 #include <random>
+#include <string>
 
 namespace jet {
 
@@ -116,6 +117,15 @@ class VolumeParticleEmitter3 final : public ParticleEmitter3 {
     //! Returns the initial velocity of the particles.
     void setInitialVelocity(const Vector3D& newInitialVel);
 
+    //! Stores the random number generator state and the emission count to
+    //! the checkpoint.
+    void saveCheckpoint(const std::string& prefix,
+                        Checkpoint* checkpoint) const override;
+
+    //! Restores the random number generator state and the emission count.
+    void loadCheckpoint(const std::string& prefix,
+                        const Checkpoint& checkpoint) override;
+
     //! Returns builder fox VolumeParticleEmitter3.
     static Builder builder();
 
@@ -6,7 +6,7 @@ export NUM_JOBS=1
 
 mkdir build
 cd build
-cmake ..
+cmake .. ${CMAKE_OPTIONS}
 make
 bin/unit_tests
 
@@ -38,12 +38,12 @@ void saveTriangleMesh(const TriangleMesh3& mesh, const std::string& rootDir,
     }
 }
 
-void triangulateAndSave(const ScalarGrid3Ptr& sdf, const std::string& rootDir,
+void triangulateAndSave(const ScalarGrid3& sdf, const std::string& rootDir,
                         int frameCnt) {
     TriangleMesh3 mesh;
     int flag = kDirectionAll & ~kDirectionDown;
-    marchingCubes(sdf->constDataAccessor(), sdf->gridSpacing(),
-                  sdf->dataOrigin(), &mesh, 0.0, flag);
+    marchingCubes(sdf.constDataAccessor(), sdf.gridSpacing(), sdf.dataOrigin(),
+                  &mesh, 0.0, flag);
     saveTriangleMesh(mesh, rootDir, frameCnt);
 }
 
@@ -65,12 +65,23 @@ void printInfo(const LevelSetLiquidSolver3Ptr& solver) {
 void runSimulation(const std::string& rootDir,
                    const LevelSetLiquidSolver3Ptr& solver, int numberOfFrames,
                    double fps) {
-    auto sdf = solver->signedDistanceField();
+    auto sdf = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
+        solver->signedDistanceField());
+
+    // Triangulate and write the frames on a background thread while the next
+    // one is being simulated.
+    AsyncFrameWriter<CellCenteredScalarGrid3> writer(
+        [&](const Frame& frame, const CellCenteredScalarGrid3& snapshot) {
+            triangulateAndSave(snapshot, rootDir, frame.index);
+        });
 
     for (Frame frame(0, 1.0 / fps); frame.index < numberOfFrames; ++frame) {
         solver->update(frame);
 
-        triangulateAndSave(sdf, rootDir, frame.index);
+        writer.write(frame,
+                     [&](const Frame&, CellCenteredScalarGrid3* snapshot) {
+                         snapshot->set(*sdf);
+                     });
     }
 }
 
@@ -60,9 +60,10 @@ void triangulateAndSave(const ScalarGrid3& sdf,
     }
 }
 
-void particlesToObj(const Array1<Vector3D>& positions, const Size3& resolution,
-                    const Vector3D& gridSpacing, const Vector3D& origin,
-                    double kernelRadius, const std::string& method,
+void particlesToObj(const ConstArrayAccessor1<Vector3D>& positions,
+                    const Size3& resolution, const Vector3D& gridSpacing,
+                    const Vector3D& origin, double kernelRadius,
+                    const std::string& method, bool isNarrowBandEnabled,
                     const std::string& objFilename) {
     PointsToImplicit3Ptr converter;
     if (method == kSpherical) {
@@ -79,6 +80,7 @@ void particlesToObj(const Array1<Vector3D>& positions, const Size3& resolution,
             kernelRadius, sAnisoCutOffDensity, sAnisoPositionSmoothingFactor,
             sAnisoMinNumNeighbors, false);
     }
+    converter->setIsNarrowBandEnabled(isNarrowBandEnabled);
 
     VertexCenteredScalarGrid3 sdf(resolution, gridSpacing, origin);
     printInfo(resolution, sdf.boundingBox(), gridSpacing, positions.size(),
@@ -98,6 +100,7 @@ int main(int argc, char* argv[]) {
     Vector3D origin;
     std::string method = "anisotropic";
     double kernelRadius = 0.2;
+    bool isNarrowBandEnabled = false;
 
     std::string strResolution;
     std::string strGridSpacing;
@@ -122,7 +125,9 @@ int main(int argc, char* argv[]) {
             "followed by optional method-dependent parameters (default is "
             "anisotropic)") |
         clara::Opt(kernelRadius, "kernelRadius")["-k"]["--kernel"](
-            "interpolation kernel radius (default is 0.2)");
+            "interpolation kernel radius (default is 0.2)") |
+        clara::Opt(isNarrowBandEnabled)["-b"]["--narrow_band"](
+            "evaluate the kernels only near the particles");
 
     auto result = parser.parse(clara::Args(argc, argv));
     if (!result) {
@@ -219,23 +224,30 @@ int main(int argc, char* argv[]) {
         exit(EXIT_FAILURE);
     }
 
-    // Read particle positions
+    // Map the particle cache if the input is one. Otherwise, read the
+    // serialized particle positions.
+    ParticleCache3 cache;
     Array1<Vector3D> positions;
-    std::ifstream positionFile(inputFilename.c_str(), std::ifstream::binary);
-    if (positionFile) {
-        std::vector<uint8_t> buffer(
-            (std::istreambuf_iterator<char>(positionFile)),
-            (std::istreambuf_iterator<char>()));
-        deserialize(buffer, &positions);
-        positionFile.close();
-    } else {
-        printf("Cannot read file %s.\n", inputFilename.c_str());
-        exit(EXIT_FAILURE);
+    if (!cache.open(inputFilename)) {
+        std::ifstream positionFile(inputFilename.c_str(),
+                                   std::ifstream::binary);
+        if (positionFile) {
+            std::vector<uint8_t> buffer(
+                (std::istreambuf_iterator<char>(positionFile)),
+                (std::istreambuf_iterator<char>()));
+            deserialize(buffer, &positions);
+            positionFile.close();
+        } else {
+            printf("Cannot read file %s.\n", inputFilename.c_str());
+            exit(EXIT_FAILURE);
+        }
     }
 
     // Run marching cube and save it to the disk
-    particlesToObj(positions, resolution, gridSpacing, origin, kernelRadius,
-                   method, outputFilename);
+    particlesToObj(
+        cache.isOpen() ? cache.positions() : positions.constAccessor(),
+        resolution, gridSpacing, origin, kernelRadius, method,
+        isNarrowBandEnabled, outputFilename);
 
     return EXIT_SUCCESS;
 }
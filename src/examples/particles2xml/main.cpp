@@ -22,7 +22,7 @@ void printInfo(size_t numberOfParticles) {
     printf("Number of particles: %zu\n", numberOfParticles);
 }
 
-void particlesToXml(const Array1<Vector3D>& positions,
+void particlesToXml(const ConstArrayAccessor1<Vector3D>& positions,
                     const std::string& xmlFilename) {
     printInfo(positions.size());
 
@@ -85,22 +85,29 @@ int main(int argc, char* argv[]) {
         exit(EXIT_FAILURE);
     }
 
-    // Read particle positions
+    // Map the particle cache if the input is one. Otherwise, read the
+    // serialized particle positions.
+    ParticleCache3 cache;
     Array1<Vector3D> positions;
-    std::ifstream positionFile(inputFilename.c_str(), std::ifstream::binary);
-    if (positionFile) {
-        std::vector<uint8_t> buffer(
-            (std::istreambuf_iterator<char>(positionFile)),
-            (std::istreambuf_iterator<char>()));
-        deserialize(buffer, &positions);
-        positionFile.close();
-    } else {
-        printf("Cannot read file %s.\n", inputFilename.c_str());
-        exit(EXIT_FAILURE);
+    if (!cache.open(inputFilename)) {
+        std::ifstream positionFile(inputFilename.c_str(),
+                                   std::ifstream::binary);
+        if (positionFile) {
+            std::vector<uint8_t> buffer(
+                (std::istreambuf_iterator<char>(positionFile)),
+                (std::istreambuf_iterator<char>()));
+            deserialize(buffer, &positions);
+            positionFile.close();
+        } else {
+            printf("Cannot read file %s.\n", inputFilename.c_str());
+            exit(EXIT_FAILURE);
+        }
     }
 
     // Run marching cube and save it to the disk
-    particlesToXml(positions, outputFilename);
+    particlesToXml(
+        cache.isOpen() ? cache.positions() : positions.constAccessor(),
+        outputFilename);
 
     return EXIT_SUCCESS;
 }
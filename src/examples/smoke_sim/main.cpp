@@ -36,7 +36,7 @@ inline float smoothStep(float edge0, float edge1, float x) {
 }
 
 // Export density field to Mitsuba volume file.
-void saveVolumeAsVol(const ScalarGrid3Ptr& density, const std::string& rootDir,
+void saveVolumeAsVol(const ScalarGrid3& density, const std::string& rootDir,
                      int frameCnt) {
     char basename[256];
     snprintf(basename, sizeof(basename), "frame_%06d.vol", frameCnt);
@@ -55,11 +55,11 @@ void saveVolumeAsVol(const ScalarGrid3Ptr& density, const std::string& rootDir,
         header[3] = 3;
         int32_t* encoding = reinterpret_cast<int32_t*>(header + 4);
         encoding[0] = 1;  // 32-bit float
-        encoding[1] = static_cast<int32_t>(density->dataSize().x);
-        encoding[2] = static_cast<int32_t>(density->dataSize().y);
-        encoding[3] = static_cast<int32_t>(density->dataSize().z);
+        encoding[1] = static_cast<int32_t>(density.dataSize().x);
+        encoding[2] = static_cast<int32_t>(density.dataSize().y);
+        encoding[3] = static_cast<int32_t>(density.dataSize().z);
         encoding[4] = 1;  // number of channels
-        BoundingBox3D domain = density->boundingBox();
+        BoundingBox3D domain = density.boundingBox();
         float* bbox = reinterpret_cast<float*>(encoding + 5);
         bbox[0] = static_cast<float>(domain.lowerCorner.x);
         bbox[1] = static_cast<float>(domain.lowerCorner.y);
@@ -70,9 +70,9 @@ void saveVolumeAsVol(const ScalarGrid3Ptr& density, const std::string& rootDir,
 
         file.write(header, sizeof(header));
 
-        Array3<float> data(density->dataSize());
+        Array3<float> data(density.dataSize());
         data.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-            float d = static_cast<float>((*density)(i, j, k));
+            float d = static_cast<float>(density(i, j, k));
 
             // Blur the edge for less-noisy rendering
             if (i < kEdgeBlur) {
@@ -107,7 +107,7 @@ void saveVolumeAsVol(const ScalarGrid3Ptr& density, const std::string& rootDir,
     }
 }
 
-void saveVolumeAsTga(const ScalarGrid3Ptr& density, const std::string& rootDir,
+void saveVolumeAsTga(const ScalarGrid3& density, const std::string& rootDir,
                      int frameCnt) {
     char basename[256];
     snprintf(basename, sizeof(basename), "frame_%06d.tga", frameCnt);
@@ -116,7 +116,7 @@ void saveVolumeAsTga(const ScalarGrid3Ptr& density, const std::string& rootDir,
     if (file) {
         printf("Writing %s...\n", filename.c_str());
 
-        Size3 dataSize = density->dataSize();
+        Size3 dataSize = density.dataSize();
 
         std::array<char, 18> header;
         header.fill(0);
@@ -137,7 +137,7 @@ void saveVolumeAsTga(const ScalarGrid3Ptr& density, const std::string& rootDir,
         hdrImg.parallelForEachIndex([&](size_t i, size_t j) {
             double sum = 0.0;
             for (size_t k = 0; k < dataSize.z; ++k) {
-                sum += (*density)(i, j, k);
+                sum += density(i, j, k);
             }
             hdrImg(i, j) = kTgaScale * sum / static_cast<double>(dataSize.z);
         });
@@ -173,16 +173,27 @@ void printInfo(const GridSmokeSolver3Ptr& solver) {
 void runSimulation(const std::string& rootDir,
                    const GridSmokeSolver3Ptr& solver, int numberOfFrames,
                    const std::string& format, double fps) {
-    auto density = solver->smokeDensity();
+    auto density = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
+        solver->smokeDensity());
+
+    // Write the frames on a background thread while the next one is being
+    // simulated.
+    AsyncFrameWriter<CellCenteredScalarGrid3> writer(
+        [&](const Frame& frame, const CellCenteredScalarGrid3& snapshot) {
+            if (format == "vol") {
+                saveVolumeAsVol(snapshot, rootDir, frame.index);
+            } else if (format == "tga") {
+                saveVolumeAsTga(snapshot, rootDir, frame.index);
+            }
+        });
 
     for (Frame frame(0, 1.0 / fps); frame.index < numberOfFrames; ++frame) {
         solver->update(frame);
 
-        if (format == "vol") {
-            saveVolumeAsVol(density, rootDir, frame.index);
-        } else if (format == "tga") {
-            saveVolumeAsTga(density, rootDir, frame.index);
-        }
+        writer.write(frame,
+                     [&](const Frame&, CellCenteredScalarGrid3* snapshot) {
+                         snapshot->set(*density);
+                     });
     }
 }
 
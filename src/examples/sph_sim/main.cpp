@@ -26,11 +26,9 @@
 
 using namespace jet;
 
-void saveParticleAsPos(const ParticleSystemData3Ptr& particles,
+void saveParticleAsPos(const ParticleSystemData3& particles,
                        const std::string& rootDir, int frameCnt) {
-    Array1<Vector3D> positions(particles->numberOfParticles());
-    copyRange1(particles->positions(), particles->numberOfParticles(),
-               &positions);
+    ConstArrayAccessor1<Vector3D> positions = particles.positions();
     char basename[256];
     snprintf(basename, sizeof(basename), "frame_%06d.pos", frameCnt);
     std::string filename = pystring::os::path::join(rootDir, basename);
@@ -38,17 +36,15 @@ void saveParticleAsPos(const ParticleSystemData3Ptr& particles,
     if (file) {
         printf("Writing %s...\n", filename.c_str());
         std::vector<uint8_t> buffer;
-        serialize(positions.constAccessor(), &buffer);
+        serialize(positions, &buffer);
         file.write(reinterpret_cast<char*>(buffer.data()), buffer.size());
         file.close();
     }
 }
 
-void saveParticleAsXyz(const ParticleSystemData3Ptr& particles,
+void saveParticleAsXyz(const ParticleSystemData3& particles,
                        const std::string& rootDir, int frameCnt) {
-    Array1<Vector3D> positions(particles->numberOfParticles());
-    copyRange1(particles->positions(), particles->numberOfParticles(),
-               &positions);
+    ConstArrayAccessor1<Vector3D> positions = particles.positions();
     char basename[256];
     snprintf(basename, sizeof(basename), "frame_%06d.xyz", frameCnt);
     std::string filename = pystring::os::path::join(rootDir, basename);
@@ -56,12 +52,24 @@ void saveParticleAsXyz(const ParticleSystemData3Ptr& particles,
     if (file) {
         printf("Writing %s...\n", filename.c_str());
         for (const auto& pt : positions) {
-            file << pt.x << ' ' << pt.y << ' ' << pt.z << std::endl;
+            file << pt.x << ' ' << pt.y << ' ' << pt.z << '\n';
         }
         file.close();
     }
 }
 
+void saveParticleAsCache(const ParticleSystemData3& particles,
+                         const std::string& rootDir, int frameCnt) {
+    char basename[256];
+    snprintf(basename, sizeof(basename), "frame_%06d.pcache", frameCnt);
+    std::string filename = pystring::os::path::join(rootDir, basename);
+    printf("Writing %s...\n", filename.c_str());
+    ParticleCacheWriter3 writer;
+    if (!writer.write(particles, filename)) {
+        fprintf(stderr, "Failed to write file %s\n", filename.c_str());
+    }
+}
+
 void printInfo(const SphSolver3Ptr& solver) {
     auto particles = solver->sphSystemData();
     printf("Number of particles: %zu\n", particles->numberOfParticles());
@@ -71,13 +79,24 @@ void runSimulation(const std::string& rootDir, const SphSolver3Ptr& solver,
                    int numberOfFrames, const std::string& format, double fps) {
     auto particles = solver->sphSystemData();
 
+    // Write the frames on a background thread while the next one is being
+    // simulated.
+    AsyncFrameWriter<ParticleSystemData3> writer(
+        [&](const Frame& frame, const ParticleSystemData3& snapshot) {
+            if (format == "xyz") {
+                saveParticleAsXyz(snapshot, rootDir, frame.index);
+            } else if (format == "pos") {
+                saveParticleAsPos(snapshot, rootDir, frame.index);
+            } else if (format == "cache") {
+                saveParticleAsCache(snapshot, rootDir, frame.index);
+            }
+        });
+
     for (Frame frame(0, 1.0 / fps); frame.index < numberOfFrames; ++frame) {
         solver->update(frame);
-        if (format == "xyz") {
-            saveParticleAsXyz(particles, rootDir, frame.index);
-        } else if (format == "pos") {
-            saveParticleAsPos(particles, rootDir, frame.index);
-        }
+        writer.write(frame, [&](const Frame&, ParticleSystemData3* snapshot) {
+            snapshot->copyDataFrom(*particles);
+        });
     }
 }
 
@@ -306,7 +325,7 @@ int main(int argc, char* argv[]) {
         clara::Opt(outputDir, "outputDir")["-o"]["--output"](
             "output directory name (default is " APP_NAME "_output)") |
         clara::Opt(format, "format")["-m"]["--format"](
-            "particle output format (xyz or pos. default is xyz)");
+            "particle output format (xyz, pos or cache. default is xyz)");
 
     auto result = parser.parse(clara::Args(argc, argv));
     if (!result) {
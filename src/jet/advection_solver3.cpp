@@ -6,6 +6,7 @@
 
 #include <pch.h>
 #include <jet/advection_solver3.h>
+#include <jet/parallel.h>
 #include <limits>
 
 using namespace jet;
@@ -16,6 +17,24 @@ AdvectionSolver3::AdvectionSolver3() {
 AdvectionSolver3::~AdvectionSolver3() {
 }
 
+void AdvectionSolver3::advectDataPoints(
+    const ScalarGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<Point3UI>& dataPoints,
+    ScalarGrid3* output,
+    const ScalarField3& boundarySdf) {
+    auto temp = output->clone();
+    advect(input, flow, dt, temp.get(), boundarySdf);
+
+    auto tempDataAcc = temp->constDataAccessor();
+    auto outputDataAcc = output->dataAccessor();
+    parallelFor(kZeroSize, dataPoints.size(), [&](size_t n) {
+        const Point3UI& pt = dataPoints[n];
+        outputDataAcc(pt.x, pt.y, pt.z) = tempDataAcc(pt.x, pt.y, pt.z);
+    });
+}
+
 void AdvectionSolver3::advect(
     const CollocatedVectorGrid3& source,
     const VectorField3& flow,
@@ -41,3 +60,42 @@ void AdvectionSolver3::advect(
     UNUSED_VARIABLE(target);
     UNUSED_VARIABLE(boundarySdf);
 }
+
+void AdvectionSolver3::advect(
+    const std::vector<const ScalarGrid3*>& inputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<ScalarGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(inputs.size() != outputs.size());
+
+    for (size_t n = 0; n < inputs.size(); ++n) {
+        advect(*inputs[n], flow, dt, outputs[n], boundarySdf);
+    }
+}
+
+void AdvectionSolver3::advect(
+    const std::vector<const CollocatedVectorGrid3*>& inputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<CollocatedVectorGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(inputs.size() != outputs.size());
+
+    for (size_t n = 0; n < inputs.size(); ++n) {
+        advect(*inputs[n], flow, dt, outputs[n], boundarySdf);
+    }
+}
+
+void AdvectionSolver3::advect(
+    const std::vector<const FaceCenteredGrid3*>& inputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<FaceCenteredGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(inputs.size() != outputs.size());
+
+    for (size_t n = 0; n < inputs.size(); ++n) {
+        advect(*inputs[n], flow, dt, outputs[n], boundarySdf);
+    }
+}
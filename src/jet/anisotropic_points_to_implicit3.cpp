@@ -7,7 +7,6 @@
 #include <pch.h>
 
 #include <jet/anisotropic_points_to_implicit3.h>
-#include <jet/fmm_level_set_solver3.h>
 #include <jet/point_kdtree_searcher3.h>
 #include <jet/sph_kernels3.h>
 #include <jet/sph_system_data3.h>
@@ -103,13 +102,13 @@ void AnisotropicPointsToImplicit3::convert(
         Vector3D xMean;
         double wSum = 0.0;
         size_t numNeighbors = 0;
-        const auto getXMean = [&](size_t, const Vector3D& xj) {
-            const double wj = wij((x - xj).length(), r);
+        const auto getXMean = [&](size_t, const Vector3D& xj, double d2) {
+            const double wj = wij(std::sqrt(d2), r);
             wSum += wj;
             xMean += wj * xj;
             ++numNeighbors;
         };
-        meanNeighborSearcher->forEachNearbyPoint(x, r, getXMean);
+        meanNeighborSearcher->visitNearbyPoints(x, r, getXMean);
 
         JET_ASSERT(wSum > 0.0);
         xMean /= wSum;
@@ -126,12 +125,12 @@ void AnisotropicPointsToImplicit3::convert(
             // perfectly lined up.
             auto cov = Matrix3x3D::makeScaleMatrix(h * h, h * h, h * h);
             wSum = 0.0;
-            const auto getCov = [&](size_t, const Vector3D& xj) {
+            const auto getCov = [&](size_t, const Vector3D& xj, double) {
                 const double wj = wij((xMean - xj).length(), r);
                 wSum += wj;
                 cov += wj * vvt(xj - xMean);
             };
-            meanNeighborSearcher->forEachNearbyPoint(x, r, getCov);
+            meanNeighborSearcher->visitNearbyPoints(x, r, getCov);
 
             cov /= wSum;
 
@@ -176,22 +175,24 @@ void AnisotropicPointsToImplicit3::convert(
 
     // Compute SDF
     auto temp = output->clone();
-    temp->fill([&](const Vector3D& x) {
-        double sum = 0.0;
-        meanNeighborSearcher2.forEachNearbyPoint(
-            x, r, [&](size_t i, const Vector3D& neighborPosition) {
-                sum += m / d[i] *
-                       w(neighborPosition - x, gs[i], gs[i].determinant());
-            });
-
-        return _cutOffDensity - sum;
-    });
+    evaluate(xMeans.constAccessor(), r, _cutOffDensity,
+             [&](const Vector3D& x) {
+                 double sum = 0.0;
+                 meanNeighborSearcher2.visitNearbyPoints(
+                     x, r, [&](size_t i, const Vector3D& neighborPosition,
+                               double) {
+                         sum += m / d[i] * w(neighborPosition - x, gs[i],
+                                             gs[i].determinant());
+                     });
+
+                 return _cutOffDensity - sum;
+             },
+             temp.get());
 
     JET_INFO << "Computed SDF.";
 
     if (_isOutputSdf) {
-        FmmLevelSetSolver3 solver;
-        solver.reinitialize(*temp, kMaxD, output);
+        reinitialize(*temp, r, output);
 
         JET_INFO << "Completed einitialization.";
     } else {
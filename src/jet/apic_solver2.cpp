@@ -58,7 +58,8 @@ void ApicSolver2::transferFromParticlesToGrids() {
         flow->gridSpacing(),
         flow->vOrigin());
 
-    for (size_t i = 0; i < numberOfParticles; ++i) {
+    binParticlesToSlabs();
+    parallelForEachParticleInSlabs([&](size_t i) {
         std::array<Point2UI, 4> indices;
         std::array<double, 4> weights;
 
@@ -75,6 +76,11 @@ void ApicSolver2::transferFromParticlesToGrids() {
             uWeight(indices[j]) += weights[j];
             _uMarkers(indices[j]) = 1;
         }
+    });
+
+    parallelForEachParticleInSlabs([&](size_t i) {
+        std::array<Point2UI, 4> indices;
+        std::array<double, 4> weights;
 
         auto vPosClamped = positions[i];
         vPosClamped.x = clamp(
@@ -89,7 +95,7 @@ void ApicSolver2::transferFromParticlesToGrids() {
             vWeight(indices[j]) += weights[j];
             _vMarkers(indices[j]) = 1;
         }
-    }
+    });
 
     uWeight.parallelForEachIndex([&](size_t i, size_t j) {
         if (uWeight(i, j) > 0.0) {
@@ -157,6 +163,24 @@ void ApicSolver2::transferFromGridsToParticles() {
     });
 }
 
+void ApicSolver2::onParticlesSorted(
+    const ConstArrayAccessor1<size_t>& order) {
+    // Particles emitted after the last grid-to-particle transfer have no
+    // affine velocity yet.
+    const size_t n = order.size();
+    Array1<Vector2D> newCX(n);
+    Array1<Vector2D> newCY(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        const size_t j = order[i];
+        if (j < _cX.size()) {
+            newCX[i] = _cX[j];
+            newCY[i] = _cY[j];
+        }
+    });
+    _cX.swap(newCX);
+    _cY.swap(newCY);
+}
+
 ApicSolver2::Builder ApicSolver2::builder() {
     return Builder();
 }
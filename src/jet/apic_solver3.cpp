@@ -7,8 +7,25 @@
 #include <pch.h>
 #include <jet/apic_solver3.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 using namespace jet;
 
+namespace {
+
+void loadAffineVelocity(const std::string& name, const Checkpoint& checkpoint,
+                        Array1<Vector3D>* c) {
+    std::vector<Vector3D> data;
+    if (checkpoint.getArray(name, &data)) {
+        c->resize(data.size());
+        std::copy(data.begin(), data.end(), c->begin());
+    }
+}
+
+}  // namespace
+
 ApicSolver3::ApicSolver3()
 : ApicSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {
 }
@@ -23,6 +40,22 @@ ApicSolver3::ApicSolver3(
 ApicSolver3::~ApicSolver3() {
 }
 
+void ApicSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    PicSolver3::onSaveCheckpoint(checkpoint);
+
+    checkpoint->setArray("ApicSolver3/cX", _cX.constAccessor());
+    checkpoint->setArray("ApicSolver3/cY", _cY.constAccessor());
+    checkpoint->setArray("ApicSolver3/cZ", _cZ.constAccessor());
+}
+
+void ApicSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    PicSolver3::onLoadCheckpoint(checkpoint);
+
+    loadAffineVelocity("ApicSolver3/cX", checkpoint, &_cX);
+    loadAffineVelocity("ApicSolver3/cY", checkpoint, &_cY);
+    loadAffineVelocity("ApicSolver3/cZ", checkpoint, &_cZ);
+}
+
 void ApicSolver3::transferFromParticlesToGrids() {
     auto flow = gridSystemData()->velocity();
     const auto particles = particleSystemData();
@@ -69,7 +102,8 @@ void ApicSolver3::transferFromParticlesToGrids() {
         flow->gridSpacing(),
         flow->wOrigin());
 
-    for (size_t i = 0; i < numberOfParticles; ++i) {
+    binParticlesToSlabs();
+    parallelForEachParticleInSlabs([&](size_t i) {
         std::array<Point3UI, 8> indices;
         std::array<double, 8> weights;
 
@@ -90,6 +124,11 @@ void ApicSolver3::transferFromParticlesToGrids() {
             uWeight(indices[j]) += weights[j];
             _uMarkers(indices[j]) = 1;
         }
+    });
+
+    parallelForEachParticleInSlabs([&](size_t i) {
+        std::array<Point3UI, 8> indices;
+        std::array<double, 8> weights;
 
         auto vPosClamped = positions[i];
         vPosClamped.x = clamp(
@@ -108,6 +147,11 @@ void ApicSolver3::transferFromParticlesToGrids() {
             vWeight(indices[j]) += weights[j];
             _vMarkers(indices[j]) = 1;
         }
+    });
+
+    parallelForEachParticleInSlabs([&](size_t i) {
+        std::array<Point3UI, 8> indices;
+        std::array<double, 8> weights;
 
         auto wPosClamped = positions[i];
         wPosClamped.x = clamp(
@@ -126,7 +170,7 @@ void ApicSolver3::transferFromParticlesToGrids() {
             wWeight(indices[j]) += weights[j];
             _wMarkers(indices[j]) = 1;
         }
-    }
+    });
 
     uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
         if (uWeight(i, j, k) > 0.0) {
@@ -228,6 +272,27 @@ void ApicSolver3::transferFromGridsToParticles() {
     });
 }
 
+void ApicSolver3::onParticlesSorted(
+    const ConstArrayAccessor1<size_t>& order) {
+    // Particles emitted after the last grid-to-particle transfer have no
+    // affine velocity yet.
+    const size_t n = order.size();
+    Array1<Vector3D> newCX(n);
+    Array1<Vector3D> newCY(n);
+    Array1<Vector3D> newCZ(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        const size_t j = order[i];
+        if (j < _cX.size()) {
+            newCX[i] = _cX[j];
+            newCY[i] = _cY[j];
+            newCZ[i] = _cZ[j];
+        }
+    });
+    _cX.swap(newCX);
+    _cY.swap(newCY);
+    _cZ.swap(newCZ);
+}
+
 ApicSolver3::Builder ApicSolver3::builder() {
     return Builder();
 }
@@ -0,0 +1,195 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/checkpoint.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace jet;
+
+namespace {
+
+// The file starts with FileHeader, followed by the chunks. Each chunk has a
+// ChunkHeader, the name and the data. All the values are stored in the byte
+// order of the machine which wrote the file.
+const char kMagic[8] = {'J', 'E', 'T', 'C', 'K', 'P', 'T', '\0'};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numberOfChunks;
+};
+
+struct ChunkHeader {
+    uint64_t nameSize;
+    uint64_t dataSize;
+};
+
+FileHeader makeFileHeader(size_t numberOfChunks) {
+    FileHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = Checkpoint::kVersion;
+    header.numberOfChunks = static_cast<uint32_t>(numberOfChunks);
+    return header;
+}
+
+}  // namespace
+
+const uint32_t Checkpoint::kVersion = 1;
+
+Checkpoint::Checkpoint() {}
+
+size_t Checkpoint::numberOfChunks() const { return _chunks.size(); }
+
+bool Checkpoint::hasChunk(const std::string& name) const {
+    return _chunks.find(name) != _chunks.end();
+}
+
+const std::vector<uint8_t>& Checkpoint::chunk(const std::string& name) const {
+    auto iter = _chunks.find(name);
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        iter == _chunks.end(), "Checkpoint chunk " + name + " does not exist.");
+    return iter->second;
+}
+
+void Checkpoint::setChunk(const std::string& name,
+                          const std::vector<uint8_t>& data) {
+    *chunkBuffer(name) = data;
+}
+
+void Checkpoint::clear() { _chunks.clear(); }
+
+void Checkpoint::setData(const std::string& name, const Serializable& data) {
+    data.serialize(chunkBuffer(name));
+}
+
+bool Checkpoint::getData(const std::string& name, Serializable* data) const {
+    auto iter = _chunks.find(name);
+    if (iter == _chunks.end()) {
+        return false;
+    }
+
+    data->deserialize(iter->second);
+    return true;
+}
+
+void Checkpoint::serialize(std::vector<uint8_t>* buffer) const {
+    size_t size = sizeof(FileHeader);
+    for (const auto& chunk : _chunks) {
+        size += sizeof(ChunkHeader) + chunk.first.size() + chunk.second.size();
+    }
+    buffer->resize(size);
+
+    uint8_t* dst = buffer->data();
+    const FileHeader header = makeFileHeader(_chunks.size());
+    std::memcpy(dst, &header, sizeof(header));
+    dst += sizeof(header);
+
+    for (const auto& chunk : _chunks) {
+        const ChunkHeader chunkHeader = {
+            static_cast<uint64_t>(chunk.first.size()),
+            static_cast<uint64_t>(chunk.second.size())};
+        std::memcpy(dst, &chunkHeader, sizeof(chunkHeader));
+        dst += sizeof(chunkHeader);
+        std::memcpy(dst, chunk.first.data(), chunk.first.size());
+        dst += chunk.first.size();
+        if (!chunk.second.empty()) {
+            std::memcpy(dst, chunk.second.data(), chunk.second.size());
+            dst += chunk.second.size();
+        }
+    }
+}
+
+void Checkpoint::deserialize(const std::vector<uint8_t>& buffer) {
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        !readChunks(buffer.data(), buffer.size()),
+        "Buffer is not a valid checkpoint.");
+}
+
+bool Checkpoint::save(const std::string& filename) const {
+    std::ofstream file(filename.c_str(), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    const FileHeader header = makeFileHeader(_chunks.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& chunk : _chunks) {
+        const ChunkHeader chunkHeader = {
+            static_cast<uint64_t>(chunk.first.size()),
+            static_cast<uint64_t>(chunk.second.size())};
+        file.write(reinterpret_cast<const char*>(&chunkHeader),
+                   sizeof(chunkHeader));
+        file.write(chunk.first.data(),
+                   static_cast<std::streamsize>(chunk.first.size()));
+        file.write(reinterpret_cast<const char*>(chunk.second.data()),
+                   static_cast<std::streamsize>(chunk.second.size()));
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool Checkpoint::load(const std::string& filename) {
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file) {
+        clear();
+        return false;
+    }
+
+    const std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)),
+                                      (std::istreambuf_iterator<char>()));
+    return readChunks(buffer.data(), buffer.size());
+}
+
+std::vector<uint8_t>* Checkpoint::chunkBuffer(const std::string& name) {
+    return &_chunks[name];
+}
+
+bool Checkpoint::readChunks(const uint8_t* data, size_t size) {
+    clear();
+
+    FileHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion) {
+        return false;
+    }
+
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.numberOfChunks; ++i) {
+        ChunkHeader chunkHeader;
+        if (size - offset < sizeof(chunkHeader)) {
+            clear();
+            return false;
+        }
+        std::memcpy(&chunkHeader, data + offset, sizeof(chunkHeader));
+        offset += sizeof(chunkHeader);
+
+        if (chunkHeader.nameSize > size - offset ||
+            chunkHeader.dataSize > size - offset - chunkHeader.nameSize) {
+            clear();
+            return false;
+        }
+
+        const std::string name(reinterpret_cast<const char*>(data + offset),
+                               static_cast<size_t>(chunkHeader.nameSize));
+        offset += static_cast<size_t>(chunkHeader.nameSize);
+
+        _chunks[name].assign(data + offset,
+                             data + offset + chunkHeader.dataSize);
+        offset += static_cast<size_t>(chunkHeader.dataSize);
+    }
+
+    return true;
+}
@@ -7,6 +7,7 @@
 #include <pch.h>
 
 #include <jet/collider3.h>
+#include <jet/surface_to_implicit3.h>
 
 #include <algorithm>
 
@@ -75,8 +76,17 @@ void Collider3::setFrictionCoefficient(double newFrictionCoeffient) {
 
 const Surface3Ptr& Collider3::surface() const { return _surface; }
 
+double Collider3::signedDistance(const Vector3D& point) const {
+    return _implicitSurface->signedDistance(point);
+}
+
 void Collider3::setSurface(const Surface3Ptr& newSurface) {
     _surface = newSurface;
+
+    _implicitSurface = std::dynamic_pointer_cast<ImplicitSurface3>(_surface);
+    if (_implicitSurface == nullptr && _surface != nullptr) {
+        _implicitSurface = std::make_shared<SurfaceToImplicit3>(_surface);
+    }
 }
 
 void Collider3::getClosestPoint(const Surface3Ptr& surface,
@@ -110,3 +120,24 @@ void Collider3::setOnBeginUpdateCallback(
     const OnBeginUpdateCallback& callback) {
     _onUpdateCallback = callback;
 }
+
+void Collider3::saveCheckpoint(const std::string& prefix,
+                               Checkpoint* checkpoint) const {
+    checkpoint->setValue(prefix + "frictionCoefficient", _frictionCoeffient);
+    checkpoint->setValue(prefix + "translation",
+                         _surface->transform.translation());
+    checkpoint->setValue(prefix + "orientation",
+                         _surface->transform.orientation());
+}
+
+void Collider3::loadCheckpoint(const std::string& prefix,
+                               const Checkpoint& checkpoint) {
+    checkpoint.getValue(prefix + "frictionCoefficient", &_frictionCoeffient);
+
+    Vector3D translation = _surface->transform.translation();
+    QuaternionD orientation = _surface->transform.orientation();
+    checkpoint.getValue(prefix + "translation", &translation);
+    checkpoint.getValue(prefix + "orientation", &orientation);
+    _surface->transform.setTranslation(translation);
+    _surface->transform.setOrientation(orientation);
+}
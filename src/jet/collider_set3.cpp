@@ -6,6 +6,7 @@
 
 #include <pch.h>
 #include <jet/collider_set3.h>
+#include <string>
 #include <vector>
 
 using namespace jet;
@@ -37,6 +38,24 @@ Vector3D ColliderSet3::velocityAt(const Vector3D& point) const {
     }
 }
 
+void ColliderSet3::saveCheckpoint(const std::string& prefix,
+                                  Checkpoint* checkpoint) const {
+    Collider3::saveCheckpoint(prefix, checkpoint);
+    for (size_t i = 0; i < _colliders.size(); ++i) {
+        _colliders[i]->saveCheckpoint(prefix + std::to_string(i) + "/",
+                                      checkpoint);
+    }
+}
+
+void ColliderSet3::loadCheckpoint(const std::string& prefix,
+                                  const Checkpoint& checkpoint) {
+    Collider3::loadCheckpoint(prefix, checkpoint);
+    for (size_t i = 0; i < _colliders.size(); ++i) {
+        _colliders[i]->loadCheckpoint(prefix + std::to_string(i) + "/",
+                                      checkpoint);
+    }
+}
+
 void ColliderSet3::addCollider(const Collider3Ptr& collider) {
     auto surfaceSet = std::dynamic_pointer_cast<SurfaceSet3>(surface());
     _colliders.push_back(collider);
@@ -86,7 +86,17 @@ Vector3D CollocatedVectorGrid3::curlAtDataPoint(
 }
 
 Vector3D CollocatedVectorGrid3::sample(const Vector3D& x) const {
-    return _sampler(x);
+    return _linearSampler(x);
+}
+
+void CollocatedVectorGrid3::sample(const ConstArrayAccessor1<Vector3D>& points,
+                                   ArrayAccessor1<Vector3D> result,
+                                   ExecutionPolicy policy) const {
+    JET_THROW_INVALID_ARG_IF(points.size() != result.size());
+
+    parallelFor(kZeroSize, points.size(), [&](size_t i) {
+        result[i] = _linearSampler(points[i]);
+    }, policy);
 }
 
 double CollocatedVectorGrid3::divergence(const Vector3D& x) const {
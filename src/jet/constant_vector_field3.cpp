@@ -6,6 +6,7 @@
 
 #include <pch.h>
 #include <jet/constant_vector_field3.h>
+#include <jet/parallel.h>
 
 using namespace jet;
 
@@ -19,6 +20,14 @@ Vector3D ConstantVectorField3::sample(const Vector3D& x) const {
     return _value;
 }
 
+void ConstantVectorField3::sample(const ConstArrayAccessor1<Vector3D>& points,
+                                  ArrayAccessor1<Vector3D> result,
+                                  ExecutionPolicy policy) const {
+    JET_THROW_INVALID_ARG_IF(points.size() != result.size());
+
+    parallelFill(result.begin(), result.end(), _value, policy);
+}
+
 std::function<Vector3D(const Vector3D&)> ConstantVectorField3::sampler() const {
     return [this](const Vector3D&) -> Vector3D {
         return _value;
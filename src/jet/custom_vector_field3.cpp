@@ -6,6 +6,7 @@
 
 #include <pch.h>
 #include <jet/custom_vector_field3.h>
+#include <jet/parallel.h>
 
 using namespace jet;
 
@@ -38,6 +39,16 @@ Vector3D CustomVectorField3::sample(const Vector3D& x) const {
     return _customFunction(x);
 }
 
+void CustomVectorField3::sample(const ConstArrayAccessor1<Vector3D>& points,
+                                ArrayAccessor1<Vector3D> result,
+                                ExecutionPolicy policy) const {
+    JET_THROW_INVALID_ARG_IF(points.size() != result.size());
+
+    parallelFor(kZeroSize, points.size(), [&](size_t i) {
+        result[i] = _customFunction(points[i]);
+    }, policy);
+}
+
 double CustomVectorField3::divergence(const Vector3D& x) const {
     if (_customDivergenceFunction) {
         return _customDivergenceFunction(x);
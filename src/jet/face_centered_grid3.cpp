@@ -17,6 +17,36 @@
 
 using namespace jet;
 
+namespace {
+
+// Index and weight of a position along one axis of the face data.
+struct AxisCoordinate {
+    ssize_t i;
+    ssize_t ip1;
+    double f;
+};
+
+// Clamps the same way as LinearArraySampler3 does.
+inline AxisCoordinate getAxisCoordinate(double x, double origin,
+                                        double gridSpacing, ssize_t size) {
+    AxisCoordinate c;
+    getBarycentric((x - origin) / gridSpacing, 0, size - 1, &c.i, &c.f);
+    c.ip1 = std::min(c.i + 1, size - 1);
+    return c;
+}
+
+inline double interpolate(const Array3<double>& data,
+                          const AxisCoordinate& x, const AxisCoordinate& y,
+                          const AxisCoordinate& z) {
+    return trilerp(data(x.i, y.i, z.i), data(x.ip1, y.i, z.i),
+                   data(x.i, y.ip1, z.i), data(x.ip1, y.ip1, z.i),
+                   data(x.i, y.i, z.ip1), data(x.ip1, y.i, z.ip1),
+                   data(x.i, y.ip1, z.ip1), data(x.ip1, y.ip1, z.ip1), x.f,
+                   y.f, z.f);
+}
+
+}  // namespace
+
 FaceCenteredGrid3::FaceCenteredGrid3()
     : _dataOriginU(0.0, 0.5, 0.5),
       _dataOriginV(0.5, 0.0, 0.5),
@@ -333,7 +363,38 @@ void FaceCenteredGrid3::parallelForEachWIndex(
 }
 
 Vector3D FaceCenteredGrid3::sample(const Vector3D& x) const {
-    return _sampler(x);
+    const Vector3D& h = gridSpacing();
+
+    // Cell-corner coordinates. The origins are the same as the ones of the
+    // component samplers so that the result matches them bit by bit.
+    const AxisCoordinate xNode = getAxisCoordinate(
+        x.x, _dataOriginU.x, h.x, static_cast<ssize_t>(_dataU.width()));
+    const AxisCoordinate yNode = getAxisCoordinate(
+        x.y, _dataOriginV.y, h.y, static_cast<ssize_t>(_dataV.height()));
+    const AxisCoordinate zNode = getAxisCoordinate(
+        x.z, _dataOriginW.z, h.z, static_cast<ssize_t>(_dataW.depth()));
+
+    // Cell-center coordinates
+    const AxisCoordinate xCenter = getAxisCoordinate(
+        x.x, _dataOriginV.x, h.x, static_cast<ssize_t>(_dataV.width()));
+    const AxisCoordinate yCenter = getAxisCoordinate(
+        x.y, _dataOriginU.y, h.y, static_cast<ssize_t>(_dataU.height()));
+    const AxisCoordinate zCenter = getAxisCoordinate(
+        x.z, _dataOriginU.z, h.z, static_cast<ssize_t>(_dataU.depth()));
+
+    return Vector3D(interpolate(_dataU, xNode, yCenter, zCenter),
+                    interpolate(_dataV, xCenter, yNode, zCenter),
+                    interpolate(_dataW, xCenter, yCenter, zNode));
+}
+
+void FaceCenteredGrid3::sample(const ConstArrayAccessor1<Vector3D>& points,
+                               ArrayAccessor1<Vector3D> result,
+                               ExecutionPolicy policy) const {
+    JET_THROW_INVALID_ARG_IF(points.size() != result.size());
+
+    parallelFor(kZeroSize, points.size(), [&](size_t i) {
+        result[i] = FaceCenteredGrid3::sample(points[i]);
+    }, policy);
 }
 
 std::function<Vector3D(const Vector3D&)> FaceCenteredGrid3::sampler() const {
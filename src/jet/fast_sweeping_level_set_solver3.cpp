@@ -0,0 +1,445 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <sweeping_tiles3.h>
+
+#include <jet/fast_sweeping_level_set_solver3.h>
+#include <jet/fdm_utils.h>
+#include <jet/level_set_utils.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+// Dilates the active tiles by given number of tiles along each axis.
+void dilateTiles(size_t radius, Array3<char>* active) {
+    const Size3 n = active->size();
+    for (size_t axis = 0; axis < 3; ++axis) {
+        Array3<char> prev(*active);
+        active->parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            Point3UI idx(i, j, k);
+            const size_t c = idx[axis];
+            const size_t begin = (c > radius) ? c - radius : 0;
+            const size_t end = std::min(c + radius + 1, n[axis]);
+            for (size_t m = begin; m < end; ++m) {
+                idx[axis] = m;
+                if (prev(idx.x, idx.y, idx.z)) {
+                    (*active)(i, j, k) = 1;
+                    return;
+                }
+            }
+        });
+    }
+}
+
+// Returns the distance to the interface from a grid point next to it by
+// linearly interpolating the crossings along each axis.
+double distanceNearInterface(const ConstArrayAccessor3<double>& phi,
+                             const Vector3D& gridSpacing, size_t i, size_t j,
+                             size_t k) {
+    const Size3 size = phi.size();
+    const double center = phi(i, j, k);
+    const bool isInside = isInsideSdf(center);
+    const double absCenter = std::fabs(center);
+
+    // Distance to the crossing toward the neighbor, or kMaxD if the neighbor
+    // is on the same side of the interface.
+    auto crossing = [&](double h, size_t ni, size_t nj, size_t nk) {
+        const double neighbor = phi(ni, nj, nk);
+        if (isInsideSdf(neighbor) == isInside) {
+            return kMaxD;
+        }
+        return h * absCenter / (absCenter + std::fabs(neighbor));
+    };
+
+    Vector3D dist(kMaxD, kMaxD, kMaxD);
+    if (i > 0) {
+        dist.x = std::min(dist.x, crossing(gridSpacing.x, i - 1, j, k));
+    }
+    if (i + 1 < size.x) {
+        dist.x = std::min(dist.x, crossing(gridSpacing.x, i + 1, j, k));
+    }
+    if (j > 0) {
+        dist.y = std::min(dist.y, crossing(gridSpacing.y, i, j - 1, k));
+    }
+    if (j + 1 < size.y) {
+        dist.y = std::min(dist.y, crossing(gridSpacing.y, i, j + 1, k));
+    }
+    if (k > 0) {
+        dist.z = std::min(dist.z, crossing(gridSpacing.z, i, j, k - 1));
+    }
+    if (k + 1 < size.z) {
+        dist.z = std::min(dist.z, crossing(gridSpacing.z, i, j, k + 1));
+    }
+
+    double denom = 0.0;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        if (dist[axis] < kMaxD) {
+            denom += 1.0 / square(std::max(dist[axis], kEpsilonD));
+        }
+    }
+
+    return 1.0 / std::sqrt(denom);
+}
+
+// Solves the first-order upwind discretization of |grad(d)| = 1 from the
+// smallest neighbor distance along each axis.
+double solveEikonal(double phiX, double phiY, double phiZ,
+                    const Vector3D& gridSpacing) {
+    std::array<std::pair<double, double>, 3> terms = {
+        {std::make_pair(phiX, gridSpacing.x),
+         std::make_pair(phiY, gridSpacing.y),
+         std::make_pair(phiZ, gridSpacing.z)}};
+    if (terms[1].first < terms[0].first) {
+        std::swap(terms[0], terms[1]);
+    }
+    if (terms[2].first < terms[1].first) {
+        std::swap(terms[1], terms[2]);
+        if (terms[1].first < terms[0].first) {
+            std::swap(terms[0], terms[1]);
+        }
+    }
+
+    if (terms[0].first >= kMaxD) {
+        return kMaxD;
+    }
+
+    double solution = terms[0].first + terms[0].second;
+    double a = 0.0;
+    double b = 0.0;
+    double c = -1.0;
+    for (size_t n = 0; n < 3; ++n) {
+        const double phi = terms[n].first;
+        if (n > 0 && solution <= phi) {
+            break;
+        }
+
+        const double invHSqr = 1.0 / square(terms[n].second);
+        a += invHSqr;
+        b -= phi * invHSqr;
+        c += square(phi) * invHSqr;
+
+        const double det = b * b - a * c;
+        if (n > 0 && det >= 0.0) {
+            solution = (-b + std::sqrt(det)) / a;
+        }
+    }
+
+    return solution;
+}
+
+}  // namespace
+
+FastSweepingLevelSetSolver3::FastSweepingLevelSetSolver3(
+    unsigned int maxNumberOfIterations)
+    : _maxNumberOfIterations(maxNumberOfIterations) {}
+
+unsigned int FastSweepingLevelSetSolver3::maxNumberOfIterations() const {
+    return _maxNumberOfIterations;
+}
+
+void FastSweepingLevelSetSolver3::setMaxNumberOfIterations(
+    unsigned int numberOfIterations) {
+    _maxNumberOfIterations = numberOfIterations;
+}
+
+void FastSweepingLevelSetSolver3::reinitialize(const ScalarGrid3& inputSdf,
+                                               double maxDistance,
+                                               ScalarGrid3* outputSdf) {
+    JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
+
+    const Size3 size = inputSdf.dataSize();
+    const Vector3D gridSpacing = inputSdf.gridSpacing();
+    const double minSpacing = min3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+    const auto input = inputSdf.constDataAccessor();
+    auto output = outputSdf->dataAccessor();
+
+    // Unsigned distances. The points next to the interface are fixed with the
+    // geometric estimates, and the others start from infinity.
+    Array3<double> dist(size, kMaxD);
+    Array3<char> isFixed(size, 0);
+    SweepingTiles3 tiles(size);
+    Array3<char>& activeTiles = tiles.active();
+
+    dist.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const bool isInside = isInsideSdf(input(i, j, k));
+        if ((i > 0 && isInsideSdf(input(i - 1, j, k)) != isInside) ||
+            (i + 1 < size.x && isInsideSdf(input(i + 1, j, k)) != isInside) ||
+            (j > 0 && isInsideSdf(input(i, j - 1, k)) != isInside) ||
+            (j + 1 < size.y && isInsideSdf(input(i, j + 1, k)) != isInside) ||
+            (k > 0 && isInsideSdf(input(i, j, k - 1)) != isInside) ||
+            (k + 1 < size.z && isInsideSdf(input(i, j, k + 1)) != isInside)) {
+            dist(i, j, k) = distanceNearInterface(input, gridSpacing, i, j, k);
+            isFixed(i, j, k) = 1;
+        }
+    });
+
+    isFixed.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (isFixed(i, j, k)) {
+            activeTiles(i / kSweepingTileSize, j / kSweepingTileSize,
+                        k / kSweepingTileSize) = 1;
+        }
+    });
+
+    // Restrict the sweeps to the tiles within the max distance.
+    const double bandInTiles = maxDistance / (minSpacing * kSweepingTileSize);
+    const size_t maxSize = std::max(size.x, std::max(size.y, size.z));
+    const size_t tileRadius =
+        (bandInTiles * kSweepingTileSize >= static_cast<double>(maxSize))
+            ? maxSize / kSweepingTileSize + 1
+            : static_cast<size_t>(std::ceil(bandInTiles));
+    dilateTiles(tileRadius, &activeTiles);
+
+    // A sweep without any change means that the solution has converged.
+    tiles.unlockAll();
+    bool isChanged = true;
+    for (unsigned int iter = 0; iter < _maxNumberOfIterations && isChanged;
+         ++iter) {
+        for (int direction = 0; direction < 8 && isChanged; ++direction) {
+            isChanged = tiles.sweep(direction, [&](size_t i, size_t j,
+                                                   size_t k) {
+                if (isFixed(i, j, k)) {
+                    return false;
+                }
+
+                const double phiX = std::min(
+                    (i > 0) ? dist(i - 1, j, k) : kMaxD,
+                    (i + 1 < size.x) ? dist(i + 1, j, k) : kMaxD);
+                const double phiY = std::min(
+                    (j > 0) ? dist(i, j - 1, k) : kMaxD,
+                    (j + 1 < size.y) ? dist(i, j + 1, k) : kMaxD);
+                const double phiZ = std::min(
+                    (k > 0) ? dist(i, j, k - 1) : kMaxD,
+                    (k + 1 < size.z) ? dist(i, j, k + 1) : kMaxD);
+
+                // The solution is larger than the smallest neighbor, so skip
+                // the points which cannot improve or would end up beyond the
+                // max distance.
+                const double phiMin = min3(phiX, phiY, phiZ);
+                if (phiMin >= dist(i, j, k) || phiMin >= maxDistance) {
+                    return false;
+                }
+
+                const double d = solveEikonal(phiX, phiY, phiZ, gridSpacing);
+                if (d < dist(i, j, k)) {
+                    const bool isUpdated =
+                        dist(i, j, k) - d > kEpsilonD * minSpacing;
+                    dist(i, j, k) = d;
+                    return isUpdated;
+                }
+                return false;
+            });
+        }
+    }
+
+    // Beyond the max distance, keep the input as FmmLevelSetSolver3 does.
+    dist.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (dist(i, j, k) <= maxDistance) {
+            output(i, j, k) =
+                isInsideSdf(input(i, j, k)) ? -dist(i, j, k) : dist(i, j, k);
+        } else {
+            output(i, j, k) = input(i, j, k);
+        }
+    });
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(const ScalarGrid3& input,
+                                              const ScalarField3& sdf,
+                                              double maxDistance,
+                                              ScalarGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    Array3<double> sdfGrid(input.dataSize());
+    auto pos = input.dataPosition();
+    sdfGrid.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.sample(pos(i, j, k));
+    });
+
+    extrapolate(input.constDataAccessor(), sdfGrid.constAccessor(),
+                input.gridSpacing(), maxDistance, output->dataAccessor());
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(
+    const CollocatedVectorGrid3& input, const ScalarField3& sdf,
+    double maxDistance, CollocatedVectorGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    Array3<double> sdfGrid(input.dataSize());
+    auto pos = input.dataPosition();
+    sdfGrid.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.sample(pos(i, j, k));
+    });
+
+    const Vector3D gridSpacing = input.gridSpacing();
+
+    Array3<double> u(input.dataSize());
+    Array3<double> u0(input.dataSize());
+    Array3<double> v(input.dataSize());
+    Array3<double> v0(input.dataSize());
+    Array3<double> w(input.dataSize());
+    Array3<double> w0(input.dataSize());
+
+    input.parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        u(i, j, k) = input(i, j, k).x;
+        v(i, j, k) = input(i, j, k).y;
+        w(i, j, k) = input(i, j, k).z;
+    });
+
+    extrapolate(u, sdfGrid.constAccessor(), gridSpacing, maxDistance, u0);
+
+    extrapolate(v, sdfGrid.constAccessor(), gridSpacing, maxDistance, v0);
+
+    extrapolate(w, sdfGrid.constAccessor(), gridSpacing, maxDistance, w0);
+
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        (*output)(i, j, k).x = u0(i, j, k);
+        (*output)(i, j, k).y = v0(i, j, k);
+        (*output)(i, j, k).z = w0(i, j, k);
+    });
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(const FaceCenteredGrid3& input,
+                                              const ScalarField3& sdf,
+                                              double maxDistance,
+                                              FaceCenteredGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    const Vector3D gridSpacing = input.gridSpacing();
+
+    auto u = input.uConstAccessor();
+    auto uPos = input.uPosition();
+    Array3<double> sdfAtU(u.size());
+    input.parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtU(i, j, k) = sdf.sample(uPos(i, j, k));
+    });
+
+    extrapolate(u, sdfAtU, gridSpacing, maxDistance, output->uAccessor());
+
+    auto v = input.vConstAccessor();
+    auto vPos = input.vPosition();
+    Array3<double> sdfAtV(v.size());
+    input.parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtV(i, j, k) = sdf.sample(vPos(i, j, k));
+    });
+
+    extrapolate(v, sdfAtV, gridSpacing, maxDistance, output->vAccessor());
+
+    auto w = input.wConstAccessor();
+    auto wPos = input.wPosition();
+    Array3<double> sdfAtW(w.size());
+    input.parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtW(i, j, k) = sdf.sample(wPos(i, j, k));
+    });
+
+    extrapolate(w, sdfAtW, gridSpacing, maxDistance, output->wAccessor());
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(
+    const ConstArrayAccessor3<double>& input,
+    const ConstArrayAccessor3<double>& sdf, const Vector3D& gridSpacing,
+    double maxDistance, ArrayAccessor3<double> output) {
+    const Size3 size = input.size();
+    const Vector3D invGridSpacing = 1.0 / gridSpacing;
+
+    // Points inside the SDF are known. The others within the max distance are
+    // filled from their known neighbors with smaller SDF values.
+    Array3<char> isKnown(size, 0);
+    SweepingTiles3 tiles(size);
+    Array3<char>& activeTiles = tiles.active();
+
+    isKnown.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (isInsideSdf(sdf(i, j, k))) {
+            isKnown(i, j, k) = 1;
+        }
+        output(i, j, k) = input(i, j, k);
+    });
+
+    isKnown.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (!isKnown(i, j, k) && sdf(i, j, k) <= maxDistance) {
+            activeTiles(i / kSweepingTileSize, j / kSweepingTileSize,
+                        k / kSweepingTileSize) = 1;
+        }
+    });
+
+    tiles.unlockAll();
+    bool isChanged = true;
+    for (unsigned int iter = 0; iter < _maxNumberOfIterations && isChanged;
+         ++iter) {
+        for (int direction = 0; direction < 8 && isChanged; ++direction) {
+            isChanged = tiles.sweep(direction, [&](size_t i, size_t j,
+                                                   size_t k) {
+                const double center = sdf(i, j, k);
+                if (isInsideSdf(center) || center > maxDistance) {
+                    return false;
+                }
+
+                Vector3D grad = gradient3(sdf, gridSpacing, i, j, k);
+                if (grad.lengthSquared() > 0.0) {
+                    grad.normalize();
+                }
+
+                double sum = 0.0;
+                double count = 0.0;
+                auto accumulate = [&](size_t ni, size_t nj, size_t nk,
+                                      double weight) {
+                    if (isKnown(ni, nj, nk) && sdf(ni, nj, nk) < center) {
+                        // If gradient is zero, then just assign 1 to weight
+                        if (weight < kEpsilonD) {
+                            weight = 1.0;
+                        }
+
+                        sum += weight * output(ni, nj, nk);
+                        count += weight;
+                    }
+                };
+
+                if (i > 0) {
+                    accumulate(i - 1, j, k,
+                               std::max(grad.x, 0.0) * invGridSpacing.x);
+                }
+                if (i + 1 < size.x) {
+                    accumulate(i + 1, j, k,
+                               -std::min(grad.x, 0.0) * invGridSpacing.x);
+                }
+                if (j > 0) {
+                    accumulate(i, j - 1, k,
+                               std::max(grad.y, 0.0) * invGridSpacing.y);
+                }
+                if (j + 1 < size.y) {
+                    accumulate(i, j + 1, k,
+                               -std::min(grad.y, 0.0) * invGridSpacing.y);
+                }
+                if (k > 0) {
+                    accumulate(i, j, k - 1,
+                               std::max(grad.z, 0.0) * invGridSpacing.z);
+                }
+                if (k + 1 < size.z) {
+                    accumulate(i, j, k + 1,
+                               -std::min(grad.z, 0.0) * invGridSpacing.z);
+                }
+
+                if (count == 0.0) {
+                    return false;
+                }
+
+                const double value = sum / count;
+                const bool isUpdated =
+                    !isKnown(i, j, k) || value != output(i, j, k);
+                output(i, j, k) = value;
+                isKnown(i, j, k) = 1;
+                return isUpdated;
+            });
+        }
+    }
+}
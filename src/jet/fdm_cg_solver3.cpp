@@ -31,16 +31,15 @@ bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
     _r.resize(size);
     _d.resize(size);
     _q.resize(size);
-    _s.resize(size);
 
     system->x.set(0.0);
     _r.set(0.0);
     _d.set(0.0);
     _q.set(0.0);
-    _s.set(0.0);
 
-    cg<FdmBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance, &solution,
-                 &_r, &_d, &_q, &_s, &_lastNumberOfIterations, &_lastResidual);
+    cgFused<FdmBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance,
+                      &solution, &_r, &_d, &_q, &_lastNumberOfIterations,
+                      &_lastResidual);
 
     return _lastResidual <= _tolerance ||
            _lastNumberOfIterations < _maxNumberOfIterations;
@@ -57,17 +56,16 @@ bool FdmCgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
     _rComp.resize(size);
     _dComp.resize(size);
     _qComp.resize(size);
-    _sComp.resize(size);
 
     system->x.set(0.0);
     _rComp.set(0.0);
     _dComp.set(0.0);
     _qComp.set(0.0);
-    _sComp.set(0.0);
 
-    cg<FdmCompressedBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance,
-                           &solution, &_rComp, &_dComp, &_qComp, &_sComp,
-                           &_lastNumberOfIterations, &_lastResidual);
+    cgFused<FdmCompressedBlas3>(matrix, rhs, _maxNumberOfIterations,
+                                _tolerance, &solution, &_rComp, &_dComp,
+                                &_qComp, &_lastNumberOfIterations,
+                                &_lastResidual);
 
     return _lastResidual <= _tolerance ||
            _lastNumberOfIterations < _maxNumberOfIterations;
@@ -89,12 +87,10 @@ void FdmCgSolver3::clearUncompressedVectors() {
     _r.clear();
     _d.clear();
     _q.clear();
-    _s.clear();
 }
 
 void FdmCgSolver3::clearCompressedVectors() {
     _rComp.clear();
     _dComp.clear();
     _qComp.clear();
-    _sComp.clear();
 }
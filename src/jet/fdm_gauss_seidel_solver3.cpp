@@ -11,6 +11,106 @@
 
 using namespace jet;
 
+namespace {
+
+template <typename T>
+void relaxNatural(const Array3<FdmMatrixRow3T<T>>& A, const Array3<T>& b,
+                  double sorFactor_, Array3<T>* x_) {
+    Size3 size = A.size();
+    Array3<T>& x = *x_;
+    const T sorFactor = static_cast<T>(sorFactor_);
+
+    A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        T r =
+            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : T(0)) +
+            ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : T(0)) +
+            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : T(0)) +
+            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : T(0)) +
+            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : T(0)) +
+            ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : T(0));
+
+        x(i, j, k) = (T(1) - sorFactor) * x(i, j, k) +
+                     sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+    });
+}
+
+template <typename T>
+void relaxRedBlackOrdering(const Array3<FdmMatrixRow3T<T>>& A,
+                           const Array3<T>& b, double sorFactor_,
+                           Array3<T>* x_) {
+    Size3 size = A.size();
+    Array3<T>& x = *x_;
+    const T sorFactor = static_cast<T>(sorFactor_);
+
+    // Red update
+    parallelRangeFor(
+        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+            size_t kBegin, size_t kEnd) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    size_t i = (j + k) % 2 + iBegin;  // i.e. (0, 0, 0)
+                    for (; i < iEnd; i += 2) {
+                        T r =
+                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
+                                     : T(0)) +
+                            ((i + 1 < size.x)
+                                 ? A(i, j, k).right * x(i + 1, j, k)
+                                 : T(0)) +
+                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
+                                     : T(0)) +
+                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
+                                              : T(0)) +
+                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
+                                     : T(0)) +
+                            ((k + 1 < size.z)
+                                 ? A(i, j, k).front * x(i, j, k + 1)
+                                 : T(0));
+
+                        x(i, j, k) =
+                            (T(1) - sorFactor) * x(i, j, k) +
+                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+                    }
+                }
+            }
+        });
+
+    // Black update
+    parallelRangeFor(
+        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+            size_t kBegin, size_t kEnd) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    size_t i = 1 - (j + k) % 2 + iBegin;  // i.e. (1, 1, 1)
+                    for (; i < iEnd; i += 2) {
+                        T r =
+                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
+                                     : T(0)) +
+                            ((i + 1 < size.x)
+                                 ? A(i, j, k).right * x(i + 1, j, k)
+                                 : T(0)) +
+                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
+                                     : T(0)) +
+                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
+                                              : T(0)) +
+                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
+                                     : T(0)) +
+                            ((k + 1 < size.z)
+                                 ? A(i, j, k).front * x(i, j, k + 1)
+                                 : T(0));
+
+                        x(i, j, k) =
+                            (T(1) - sorFactor) * x(i, j, k) +
+                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+                    }
+                }
+            }
+        });
+}
+
+}  // namespace
+
 FdmGaussSeidelSolver3::FdmGaussSeidelSolver3(unsigned int maxNumberOfIterations,
                                              unsigned int residualCheckInterval,
                                              double tolerance, double sorFactor,
@@ -100,25 +200,6 @@ bool FdmGaussSeidelSolver3::useRedBlackOrdering() const {
     return _useRedBlackOrdering;
 }
 
-void FdmGaussSeidelSolver3::relax(const FdmMatrix3& A, const FdmVector3& b,
-                                  double sorFactor, FdmVector3* x_) {
-    Size3 size = A.size();
-    FdmVector3& x = *x_;
-
-    A.forEachIndex([&](size_t i, size_t j, size_t k) {
-        double r =
-            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0) +
-            ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0) +
-            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
-            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : 0.0) +
-            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0) +
-            ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
-
-        x(i, j, k) = (1.0 - sorFactor) * x(i, j, k) +
-                     sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
-    });
-}
-
 void FdmGaussSeidelSolver3::relax(const MatrixCsrD& A, const VectorND& b,
                                   double sorFactor, VectorND* x_) {
     const auto rp = A.rowPointersBegin();
@@ -147,77 +228,26 @@ void FdmGaussSeidelSolver3::relax(const MatrixCsrD& A, const VectorND& b,
     });
 }
 
-void FdmGaussSeidelSolver3::relaxRedBlack(const FdmMatrix3& A,
-                                          const FdmVector3& b, double sorFactor,
-                                          FdmVector3* x_) {
-    Size3 size = A.size();
-    FdmVector3& x = *x_;
-
-    // Red update
-    parallelRangeFor(
-        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
-            size_t kBegin, size_t kEnd) {
-            for (size_t k = kBegin; k < kEnd; ++k) {
-                for (size_t j = jBegin; j < jEnd; ++j) {
-                    size_t i = (j + k) % 2 + iBegin;  // i.e. (0, 0, 0)
-                    for (; i < iEnd; i += 2) {
-                        double r =
-                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
-                                     : 0.0) +
-                            ((i + 1 < size.x)
-                                 ? A(i, j, k).right * x(i + 1, j, k)
-                                 : 0.0) +
-                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
-                                     : 0.0) +
-                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
-                                              : 0.0) +
-                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
-                                     : 0.0) +
-                            ((k + 1 < size.z)
-                                 ? A(i, j, k).front * x(i, j, k + 1)
-                                 : 0.0);
+void FdmGaussSeidelSolver3::relax(const FdmMatrix3& A, const FdmVector3& b,
+                                  double sorFactor, FdmVector3* x) {
+    relaxNatural(A, b, sorFactor, x);
+}
 
-                        x(i, j, k) =
-                            (1.0 - sorFactor) * x(i, j, k) +
-                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
-                    }
-                }
-            }
-        });
+void FdmGaussSeidelSolver3::relax(const FdmMatrix3F& A, const FdmVector3F& b,
+                                  double sorFactor, FdmVector3F* x) {
+    relaxNatural(A, b, sorFactor, x);
+}
 
-    // Black update
-    parallelRangeFor(
-        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
-            size_t kBegin, size_t kEnd) {
-            for (size_t k = kBegin; k < kEnd; ++k) {
-                for (size_t j = jBegin; j < jEnd; ++j) {
-                    size_t i = 1 - (j + k) % 2 + iBegin;  // i.e. (1, 1, 1)
-                    for (; i < iEnd; i += 2) {
-                        double r =
-                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
-                                     : 0.0) +
-                            ((i + 1 < size.x)
-                                 ? A(i, j, k).right * x(i + 1, j, k)
-                                 : 0.0) +
-                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
-                                     : 0.0) +
-                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
-                                              : 0.0) +
-                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
-                                     : 0.0) +
-                            ((k + 1 < size.z)
-                                 ? A(i, j, k).front * x(i, j, k + 1)
-                                 : 0.0);
+void FdmGaussSeidelSolver3::relaxRedBlack(const FdmMatrix3& A,
+                                          const FdmVector3& b, double sorFactor,
+                                          FdmVector3* x) {
+    relaxRedBlackOrdering(A, b, sorFactor, x);
+}
 
-                        x(i, j, k) =
-                            (1.0 - sorFactor) * x(i, j, k) +
-                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
-                    }
-                }
-            }
-        });
+void FdmGaussSeidelSolver3::relaxRedBlack(const FdmMatrix3F& A,
+                                          const FdmVector3F& b,
+                                          double sorFactor, FdmVector3F* x) {
+    relaxRedBlackOrdering(A, b, sorFactor, x);
 }
 
 void FdmGaussSeidelSolver3::clearUncompressedVectors() { _residual.clear(); }
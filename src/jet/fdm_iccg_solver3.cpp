@@ -7,10 +7,69 @@
 #include <jet/cg.h>
 #include <jet/constants.h>
 #include <jet/fdm_iccg_solver3.h>
+#include <jet/parallel.h>
 #include <pch.h>
 
+#include <algorithm>
+
 using namespace jet;
 
+namespace {
+
+// MIC(0) falls back to the diagonal when the modified pivot drops below this
+// fraction of it.
+const double kMicSafetyFactor = 0.25;
+
+// Number of consecutive x-lines along the y-axis swept as a single task
+const size_t kWavefrontBlockSize = 8;
+
+// Invokes func(j, k) for each x-line of the grid in the lexicographic
+// dependency order. Line (j, k) only depends on the lines (j - 1, k) and
+// (j, k - 1) during the forward sweep (and (j + 1, k) and (j, k + 1) during
+// the backward sweep). The lines are grouped into blocks along the y-axis
+// for locality, and the blocks on the same anti-diagonal are processed in
+// parallel without changing the result.
+template <typename Callback>
+void forEachLineInWavefront(const Size3& size, bool isBackward,
+                            const Callback& func) {
+    if (size.x == 0 || size.y == 0 || size.z == 0) {
+        return;
+    }
+
+    const size_t numberOfBlocks =
+        (size.y + kWavefrontBlockSize - 1) / kWavefrontBlockSize;
+    const size_t numberOfLevels = numberOfBlocks + size.z - 1;
+    for (size_t l = 0; l < numberOfLevels; ++l) {
+        const size_t level = isBackward ? numberOfLevels - 1 - l : l;
+        const size_t kBegin =
+            (level >= numberOfBlocks) ? level - numberOfBlocks + 1 : 0;
+        const size_t kEnd = std::min(level, size.z - 1) + 1;
+        parallelFor(kBegin, kEnd, [&](size_t k) {
+            const size_t jBegin = (level - k) * kWavefrontBlockSize;
+            const size_t jEnd = std::min(jBegin + kWavefrontBlockSize, size.y);
+            if (isBackward) {
+                for (size_t j = jEnd; j > jBegin; --j) {
+                    func(j - 1, k);
+                }
+            } else {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    func(j, k);
+                }
+            }
+        });
+    }
+}
+
+double invertPivot(double diagonal, double pivot, double tuningFactor) {
+    if (tuningFactor > 0.0 && pivot < kMicSafetyFactor * diagonal) {
+        pivot = diagonal;
+    }
+
+    return (std::fabs(pivot) > 0.0) ? 1.0 / pivot : 0.0;
+}
+
+}  // namespace
+
 void FdmIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
     Size3 size = matrix.size();
     A = matrix.constAccessor();
@@ -18,19 +77,33 @@ void FdmIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
     d.resize(size, 0.0);
     y.resize(size, 0.0);
 
-    matrix.forEachIndex([&](size_t i, size_t j, size_t k) {
-        double denom =
-            matrix(i, j, k).center -
-            ((i > 0) ? square(matrix(i - 1, j, k).right) * d(i - 1, j, k)
-                     : 0.0) -
-            ((j > 0) ? square(matrix(i, j - 1, k).up) * d(i, j - 1, k) : 0.0) -
-            ((k > 0) ? square(matrix(i, j, k - 1).front) * d(i, j, k - 1)
-                     : 0.0);
-
-        if (std::fabs(denom) > 0.0) {
-            d(i, j, k) = 1.0 / denom;
-        } else {
-            d(i, j, k) = 0.0;
+    // With the tuning factor tau, the fill-ins dropped by IC(0) are
+    // compensated on the diagonal so that the row sums are preserved (MIC).
+    const double tau = tuningFactor;
+    forEachLineInWavefront(size, false, [&](size_t j, size_t k) {
+        for (size_t i = 0; i < size.x; ++i) {
+            double pivot = A(i, j, k).center;
+
+            if (i > 0) {
+                const FdmMatrixRow3& row = A(i - 1, j, k);
+                pivot -= (square(row.right) +
+                          tau * row.right * (row.up + row.front)) *
+                         d(i - 1, j, k);
+            }
+            if (j > 0) {
+                const FdmMatrixRow3& row = A(i, j - 1, k);
+                pivot -= (square(row.up) +
+                          tau * row.up * (row.right + row.front)) *
+                         d(i, j - 1, k);
+            }
+            if (k > 0) {
+                const FdmMatrixRow3& row = A(i, j, k - 1);
+                pivot -= (square(row.front) +
+                          tau * row.front * (row.right + row.up)) *
+                         d(i, j, k - 1);
+            }
+
+            d(i, j, k) = invertPivot(A(i, j, k).center, pivot, tau);
         }
     });
 }
@@ -41,32 +114,58 @@ void FdmIccgSolver3::Preconditioner::solve(const FdmVector3& b, FdmVector3* x) {
     ssize_t sy = static_cast<ssize_t>(size.y);
     ssize_t sz = static_cast<ssize_t>(size.z);
 
-    b.forEachIndex([&](size_t i, size_t j, size_t k) {
-        y(i, j, k) = (b(i, j, k) -
-                      ((i > 0) ? A(i - 1, j, k).right * y(i - 1, j, k) : 0.0) -
-                      ((j > 0) ? A(i, j - 1, k).up * y(i, j - 1, k) : 0.0) -
-                      ((k > 0) ? A(i, j, k - 1).front * y(i, j, k - 1) : 0.0)) *
-                     d(i, j, k);
+    forEachLineInWavefront(size, false, [&](size_t j, size_t k) {
+        for (size_t i = 0; i < size.x; ++i) {
+            y(i, j, k) =
+                (b(i, j, k) -
+                 ((i > 0) ? A(i - 1, j, k).right * y(i - 1, j, k) : 0.0) -
+                 ((j > 0) ? A(i, j - 1, k).up * y(i, j - 1, k) : 0.0) -
+                 ((k > 0) ? A(i, j, k - 1).front * y(i, j, k - 1) : 0.0)) *
+                d(i, j, k);
+        }
     });
 
-    for (ssize_t k = sz - 1; k >= 0; --k) {
-        for (ssize_t j = sy - 1; j >= 0; --j) {
-            for (ssize_t i = sx - 1; i >= 0; --i) {
-                (*x)(i, j, k) =
-                    (y(i, j, k) -
-                     ((i + 1 < sx) ? A(i, j, k).right * (*x)(i + 1, j, k)
-                                   : 0.0) -
-                     ((j + 1 < sy) ? A(i, j, k).up * (*x)(i, j + 1, k) : 0.0) -
-                     ((k + 1 < sz) ? A(i, j, k).front * (*x)(i, j, k + 1)
-                                   : 0.0)) *
-                    d(i, j, k);
-            }
+    forEachLineInWavefront(size, true, [&](size_t jj, size_t kk) {
+        const ssize_t j = static_cast<ssize_t>(jj);
+        const ssize_t k = static_cast<ssize_t>(kk);
+        for (ssize_t i = sx - 1; i >= 0; --i) {
+            (*x)(i, j, k) =
+                (y(i, j, k) -
+                 ((i + 1 < sx) ? A(i, j, k).right * (*x)(i + 1, j, k) : 0.0) -
+                 ((j + 1 < sy) ? A(i, j, k).up * (*x)(i, j + 1, k) : 0.0) -
+                 ((k + 1 < sz) ? A(i, j, k).front * (*x)(i, j, k + 1)
+                               : 0.0)) *
+                d(i, j, k);
         }
-    }
+    });
 }
 
 //
 
+template <typename Callback>
+void FdmIccgSolver3::PreconditionerCompressed::forEachRowInLevels(
+    bool isBackward, const Callback& func) const {
+    const size_t numberOfLevels = levelOffsets.size() - 1;
+    for (size_t l = 0; l < numberOfLevels; ++l) {
+        const size_t level = isBackward ? numberOfLevels - 1 - l : l;
+        parallelFor(levelOffsets[level], levelOffsets[level + 1],
+                    [&](size_t r) {
+                        const size_t run = levelRuns[r];
+                        const size_t begin = runOffsets[run];
+                        const size_t end = runOffsets[run + 1];
+                        if (isBackward) {
+                            for (size_t i = end; i > begin; --i) {
+                                func(i - 1);
+                            }
+                        } else {
+                            for (size_t i = begin; i < end; ++i) {
+                                func(i);
+                            }
+                        }
+                    });
+    }
+}
+
 void FdmIccgSolver3::PreconditionerCompressed::build(const MatrixCsrD& matrix) {
     size_t size = matrix.cols();
     A = &matrix;
@@ -78,43 +177,98 @@ void FdmIccgSolver3::PreconditionerCompressed::build(const MatrixCsrD& matrix) {
     const auto ci = A->columnIndicesBegin();
     const auto nnz = A->nonZeroBegin();
 
-    d.forEachIndex([&](size_t i) {
-        const size_t rowBegin = rp[i];
-        const size_t rowEnd = rp[i + 1];
+    // Level scheduling over runs of consecutive rows where each row depends
+    // on its predecessor (x-lines for FDM matrices). Each run is placed one
+    // level above its deepest dependency outside the run, so the runs in the
+    // same level can be swept in parallel while keeping the access pattern
+    // sequential within each run.
+    runOffsets.clear();
+    std::vector<size_t> runLevels;
+    std::vector<size_t> rowRuns(size);
+    size_t numberOfLevels = 0;
+    for (size_t i = 0; i < size; ++i) {
+        bool dependsOnPrevRow = false;
+        for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+            if (i > 0 && ci[jj] == i - 1) {
+                dependsOnPrevRow = true;
+            }
+        }
+
+        if (!dependsOnPrevRow) {
+            runOffsets.push_back(i);
+            runLevels.push_back(0);
+        }
 
-        double denom = 0.0;
-        for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
+        rowRuns[i] = runLevels.size() - 1;
+        size_t& level = runLevels.back();
+        const size_t runBegin = runOffsets.back();
+        for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+            const size_t j = ci[jj];
+            if (j < runBegin) {
+                level = std::max(level, runLevels[rowRuns[j]] + 1);
+            }
+        }
+        numberOfLevels = std::max(numberOfLevels, level + 1);
+    }
+    runOffsets.push_back(size);
+
+    const size_t numberOfRuns = runLevels.size();
+    levelOffsets.assign(numberOfLevels + 1, 0);
+    for (size_t r = 0; r < numberOfRuns; ++r) {
+        ++levelOffsets[runLevels[r] + 1];
+    }
+    for (size_t l = 0; l < numberOfLevels; ++l) {
+        levelOffsets[l + 1] += levelOffsets[l];
+    }
+
+    levelRuns.resize(numberOfRuns);
+    std::vector<size_t> cursor(levelOffsets.begin(), levelOffsets.end() - 1);
+    for (size_t r = 0; r < numberOfRuns; ++r) {
+        levelRuns[cursor[runLevels[r]]++] = r;
+    }
+
+    // Sums of the strictly upper entries per row for the MIC compensation
+    const double tau = tuningFactor;
+    std::vector<double> upperSums(size, 0.0);
+    if (tau > 0.0) {
+        parallelFor(kZeroSize, size, [&](size_t i) {
+            for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+                if (ci[jj] > i) {
+                    upperSums[i] += nnz[jj];
+                }
+            }
+        });
+    }
+
+    forEachRowInLevels(false, [&](size_t i) {
+        double diagonal = 0.0;
+        double pivot = 0.0;
+        for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
             size_t j = ci[jj];
 
             if (j == i) {
-                denom += nnz[jj];
+                diagonal = nnz[jj];
+                pivot += nnz[jj];
             } else if (j < i) {
-                denom -= square(nnz[jj]) * d[j];
+                pivot -= (square(nnz[jj]) +
+                          tau * nnz[jj] * (upperSums[j] - nnz[jj])) *
+                         d[j];
             }
         }
 
-        if (std::fabs(denom) > 0.0) {
-            d[i] = 1.0 / denom;
-        } else {
-            d[i] = 0.0;
-        }
+        d[i] = invertPivot(diagonal, pivot, tau);
     });
 }
 
 void FdmIccgSolver3::PreconditionerCompressed::solve(const VectorND& b,
                                                      VectorND* x) {
-    const ssize_t size = static_cast<ssize_t>(b.size());
-
     const auto rp = A->rowPointersBegin();
     const auto ci = A->columnIndicesBegin();
     const auto nnz = A->nonZeroBegin();
 
-    b.forEachIndex([&](size_t i) {
-        const size_t rowBegin = rp[i];
-        const size_t rowEnd = rp[i + 1];
-
+    forEachRowInLevels(false, [&](size_t i) {
         double sum = b[i];
-        for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
+        for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
             size_t j = ci[jj];
 
             if (j < i) {
@@ -125,13 +279,10 @@ void FdmIccgSolver3::PreconditionerCompressed::solve(const VectorND& b,
         y[i] = sum * d[i];
     });
 
-    for (ssize_t i = size - 1; i >= 0; --i) {
-        const size_t rowBegin = rp[i];
-        const size_t rowEnd = rp[i + 1];
-
+    forEachRowInLevels(true, [&](size_t i) {
         double sum = y[i];
-        for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
-            ssize_t j = static_cast<ssize_t>(ci[jj]);
+        for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+            size_t j = ci[jj];
 
             if (j > i) {
                 sum -= nnz[jj] * (*x)[j];
@@ -139,17 +290,19 @@ void FdmIccgSolver3::PreconditionerCompressed::solve(const VectorND& b,
         }
 
         (*x)[i] = sum * d[i];
-    }
+    });
 }
 
 //
 
 FdmIccgSolver3::FdmIccgSolver3(unsigned int maxNumberOfIterations,
-                               double tolerance)
+                               double tolerance, double micTuningFactor)
     : _maxNumberOfIterations(maxNumberOfIterations),
       _lastNumberOfIterations(0),
       _tolerance(tolerance),
-      _lastResidualNorm(kMaxD) {}
+      _lastResidualNorm(kMaxD) {
+    setMicTuningFactor(micTuningFactor);
+}
 
 bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
     FdmMatrix3& matrix = system->A;
@@ -173,9 +326,10 @@ bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
     _q.set(0.0);
     _s.set(0.0);
 
+    _precond.tuningFactor = _micTuningFactor;
     _precond.build(matrix);
 
-    pcg<FdmBlas3, Preconditioner>(
+    pcgFused<FdmBlas3, Preconditioner>(
         matrix, rhs, _maxNumberOfIterations, _tolerance, &_precond, &solution,
         &_r, &_d, &_q, &_s, &_lastNumberOfIterations, &_lastResidualNorm);
 
@@ -205,9 +359,10 @@ bool FdmIccgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
     _qComp.set(0.0);
     _sComp.set(0.0);
 
+    _precondComp.tuningFactor = _micTuningFactor;
     _precondComp.build(matrix);
 
-    pcg<FdmCompressedBlas3, PreconditionerCompressed>(
+    pcgFused<FdmCompressedBlas3, PreconditionerCompressed>(
         matrix, rhs, _maxNumberOfIterations, _tolerance, &_precondComp,
         &solution, &_rComp, &_dComp, &_qComp, &_sComp, &_lastNumberOfIterations,
         &_lastResidualNorm);
@@ -231,6 +386,13 @@ double FdmIccgSolver3::tolerance() const { return _tolerance; }
 
 double FdmIccgSolver3::lastResidual() const { return _lastResidualNorm; }
 
+double FdmIccgSolver3::micTuningFactor() const { return _micTuningFactor; }
+
+void FdmIccgSolver3::setMicTuningFactor(double factor) {
+    JET_THROW_INVALID_ARG_IF(factor < 0.0 || factor > 1.0);
+    _micTuningFactor = factor;
+}
+
 void FdmIccgSolver3::clearUncompressedVectors() {
     _r.clear();
     _d.clear();
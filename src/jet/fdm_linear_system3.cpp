@@ -10,8 +10,42 @@
 #include <jet/math_utils.h>
 #include <jet/parallel.h>
 
+#include <atomic>
+#include <vector>
+
 using namespace jet;
 
+namespace {
+
+// Invokes func(column) for the entries of the 7-point stencil row of the
+// (i, j, k) grid point in increasing column order.
+template <typename Callback>
+void forEachStencilEntry(const Array3<size_t>& coordToIndex, size_t i,
+                         size_t j, size_t k, const Callback& func) {
+    const Size3 size = coordToIndex.size();
+    if (k > 0 && coordToIndex(i, j, k - 1) != kMaxSize) {
+        func(coordToIndex(i, j, k - 1));
+    }
+    if (j > 0 && coordToIndex(i, j - 1, k) != kMaxSize) {
+        func(coordToIndex(i, j - 1, k));
+    }
+    if (i > 0 && coordToIndex(i - 1, j, k) != kMaxSize) {
+        func(coordToIndex(i - 1, j, k));
+    }
+    func(coordToIndex(i, j, k));
+    if (i + 1 < size.x && coordToIndex(i + 1, j, k) != kMaxSize) {
+        func(coordToIndex(i + 1, j, k));
+    }
+    if (j + 1 < size.y && coordToIndex(i, j + 1, k) != kMaxSize) {
+        func(coordToIndex(i, j + 1, k));
+    }
+    if (k + 1 < size.z && coordToIndex(i, j, k + 1) != kMaxSize) {
+        func(coordToIndex(i, j, k + 1));
+    }
+}
+
+}  // namespace
+
 void FdmLinearSystem3::clear() {
     A.clear();
     x.clear();
@@ -30,107 +64,104 @@ void FdmCompressedLinearSystem3::clear() {
     A.clear();
     x.clear();
     b.clear();
+    coordToIndex.clear();
 }
 
-//
-
-void FdmBlas3::set(double s, FdmVector3* result) { result->set(s); }
-
-void FdmBlas3::set(const FdmVector3& v, FdmVector3* result) { result->set(v); }
-
-void FdmBlas3::set(double s, FdmMatrix3* result) {
-    FdmMatrixRow3 row;
-    row.center = row.right = row.up = row.front = s;
-    result->set(row);
-}
-
-void FdmBlas3::set(const FdmMatrix3& m, FdmMatrix3* result) { result->set(m); }
-
-double FdmBlas3::dot(const FdmVector3& a, const FdmVector3& b) {
-    Size3 size = a.size();
-
-    JET_THROW_INVALID_ARG_IF(size != b.size());
-
-    double result = 0.0;
+bool FdmCompressedLinearSystem3::buildPattern(
+    const Size3& size,
+    const std::function<bool(size_t, size_t, size_t)>& isActive) {
+    const bool isSameSize = (coordToIndex.size() == size);
+    if (!isSameSize) {
+        coordToIndex.resize(size);
+    }
 
-    for (size_t k = 0; k < size.z; ++k) {
+    // Number the active points within each slab while checking if any point
+    // has changed its state.
+    std::vector<size_t> slabOffsets(size.z + 1, 0);
+    std::atomic<bool> isChanged(!isSameSize);
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        size_t numRows = 0;
+        bool isSlabChanged = false;
         for (size_t j = 0; j < size.y; ++j) {
             for (size_t i = 0; i < size.x; ++i) {
-                result += a(i, j, k) * b(i, j, k);
+                size_t& index = coordToIndex(i, j, k);
+                const bool isRow = isActive(i, j, k);
+                isSlabChanged |= (isRow != (index != kMaxSize));
+                index = isRow ? numRows++ : kMaxSize;
             }
         }
-    }
-
-    return result;
-}
-
-void FdmBlas3::axpy(double a, const FdmVector3& x, const FdmVector3& y,
-                    FdmVector3* result) {
-    Size3 size = x.size();
-
-    JET_THROW_INVALID_ARG_IF(size != y.size());
-    JET_THROW_INVALID_ARG_IF(size != result->size());
-
-    x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        (*result)(i, j, k) = a * x(i, j, k) + y(i, j, k);
+        slabOffsets[k + 1] = numRows;
+        if (isSlabChanged) {
+            isChanged = true;
+        }
     });
-}
 
-void FdmBlas3::mvm(const FdmMatrix3& m, const FdmVector3& v,
-                   FdmVector3* result) {
-    Size3 size = m.size();
-
-    JET_THROW_INVALID_ARG_IF(size != v.size());
-    JET_THROW_INVALID_ARG_IF(size != result->size());
-
-    m.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        (*result)(i, j, k) =
-            m(i, j, k).center * v(i, j, k) +
-            ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k) : 0.0) +
-            ((i + 1 < size.x) ? m(i, j, k).right * v(i + 1, j, k) : 0.0) +
-            ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k) : 0.0) +
-            ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k) : 0.0) +
-            ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1) : 0.0) +
-            ((k + 1 < size.z) ? m(i, j, k).front * v(i, j, k + 1) : 0.0);
-    });
-}
+    for (size_t k = 0; k < size.z; ++k) {
+        slabOffsets[k + 1] += slabOffsets[k];
+    }
 
-void FdmBlas3::residual(const FdmMatrix3& a, const FdmVector3& x,
-                        const FdmVector3& b, FdmVector3* result) {
-    Size3 size = a.size();
-
-    JET_THROW_INVALID_ARG_IF(size != x.size());
-    JET_THROW_INVALID_ARG_IF(size != b.size());
-    JET_THROW_INVALID_ARG_IF(size != result->size());
-
-    a.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        (*result)(i, j, k) =
-            b(i, j, k) - a(i, j, k).center * x(i, j, k) -
-            ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : 0.0) -
-            ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : 0.0) -
-            ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : 0.0) -
-            ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : 0.0) -
-            ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : 0.0) -
-            ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : 0.0);
+    const size_t numRows = slabOffsets[size.z];
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        const size_t offset = slabOffsets[k];
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                size_t& index = coordToIndex(i, j, k);
+                if (index != kMaxSize) {
+                    index += offset;
+                }
+            }
+        }
     });
-}
 
-double FdmBlas3::l2Norm(const FdmVector3& v) { return std::sqrt(dot(v, v)); }
+    b.resize(numRows);
+    x.resize(numRows, 0.0);
 
-double FdmBlas3::lInfNorm(const FdmVector3& v) {
-    Size3 size = v.size();
+    if (!isChanged && A.rows() == numRows) {
+        return false;
+    }
 
-    double result = 0.0;
+    // Count the non-zeros of each slab, and then write the column indices
+    // after the prefix sum of the counts.
+    std::vector<size_t> slabNonZeros(size.z + 1, 0);
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        size_t numNonZeros = 0;
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                if (coordToIndex(i, j, k) != kMaxSize) {
+                    forEachStencilEntry(coordToIndex, i, j, k,
+                                        [&](size_t) { ++numNonZeros; });
+                }
+            }
+        }
+        slabNonZeros[k + 1] = numNonZeros;
+    });
 
     for (size_t k = 0; k < size.z; ++k) {
+        slabNonZeros[k + 1] += slabNonZeros[k];
+    }
+
+    A.reserve(numRows, numRows, slabNonZeros[size.z]);
+    size_t* rowPointers = A.rowPointersData();
+    size_t* columnIndices = A.columnIndicesData();
+    rowPointers[0] = 0;
+
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        size_t offset = slabNonZeros[k];
         for (size_t j = 0; j < size.y; ++j) {
             for (size_t i = 0; i < size.x; ++i) {
-                result = absmax(result, v(i, j, k));
+                const size_t row = coordToIndex(i, j, k);
+                if (row != kMaxSize) {
+                    forEachStencilEntry(coordToIndex, i, j, k,
+                                        [&](size_t column) {
+                                            columnIndices[offset++] = column;
+                                        });
+                    rowPointers[row + 1] = offset;
+                }
             }
         }
-    }
+    });
 
-    return std::fabs(result);
+    return true;
 }
 
 //
@@ -148,12 +179,18 @@ void FdmCompressedBlas3::set(const MatrixCsrD& m, MatrixCsrD* result) {
 }
 
 double FdmCompressedBlas3::dot(const VectorND& a, const VectorND& b) {
-    return a.dot(b);
+    JET_THROW_INVALID_ARG_IF(a.size() != b.size());
+
+    return internal::fdmParallelDot(a.data(), b.data(), a.size());
 }
 
 void FdmCompressedBlas3::axpy(double a, const VectorND& x, const VectorND& y,
                               VectorND* result) {
-    *result = a * x + y;
+    JET_THROW_INVALID_ARG_IF(x.size() != y.size());
+
+    result->resize(x.size());
+    x.parallelForEachIndex(
+        [&](size_t i) { (*result)[i] = a * x[i] + y[i]; });
 }
 
 void FdmCompressedBlas3::mvm(const MatrixCsrD& m, const VectorND& v,
@@ -198,10 +235,49 @@ void FdmCompressedBlas3::residual(const MatrixCsrD& a, const VectorND& x,
     });
 }
 
+double FdmCompressedBlas3::mvmDot(const MatrixCsrD& m, const VectorND& v,
+                                  VectorND* result) {
+    const auto rp = m.rowPointersBegin();
+    const auto ci = m.columnIndicesBegin();
+    const auto nnz = m.nonZeroBegin();
+
+    return parallelReduce(
+        kZeroSize, v.size(), 0.0,
+        [&](size_t iBegin, size_t iEnd, double init) {
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                const size_t rowBegin = rp[i];
+                const size_t rowEnd = rp[i + 1];
+
+                double sum = 0.0;
+
+                for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
+                    size_t j = ci[jj];
+                    sum += nnz[jj] * v[j];
+                }
+
+                (*result)[i] = sum;
+                init += v[i] * sum;
+            }
+            return init;
+        },
+        [](double a, double b) { return a + b; });
+}
+
+double FdmCompressedBlas3::axpyAxpyDot(double a, const VectorND& p,
+                                       const VectorND& q, VectorND* x,
+                                       VectorND* r) {
+    JET_THROW_INVALID_ARG_IF(p.size() != q.size());
+    JET_THROW_INVALID_ARG_IF(p.size() != x->size());
+    JET_THROW_INVALID_ARG_IF(p.size() != r->size());
+
+    return internal::fdmAxpyAxpyDot(a, p.data(), q.data(), x->data(),
+                                    r->data(), p.size());
+}
+
 double FdmCompressedBlas3::l2Norm(const VectorND& v) {
-    return std::sqrt(v.dot(v));
+    return std::sqrt(dot(v, v));
 }
 
 double FdmCompressedBlas3::lInfNorm(const VectorND& v) {
-    return std::fabs(v.absmax());
+    return std::fabs(internal::fdmParallelAbsMax(v.data(), v.size()));
 }
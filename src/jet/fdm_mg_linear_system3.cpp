@@ -10,37 +10,10 @@
 
 using namespace jet;
 
-//
-
-void FdmMgLinearSystem3::clear() {
-    A.levels.clear();
-    x.levels.clear();
-    b.levels.clear();
-}
-
-size_t FdmMgLinearSystem3::numberOfLevels() const { return A.levels.size(); }
-
-void FdmMgLinearSystem3::resizeWithCoarsest(const Size3 &coarsestResolution,
-                                            size_t numberOfLevels) {
-    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
-                                         &A.levels);
-    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
-                                         &x.levels);
-    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
-                                         &b.levels);
-}
-
-void FdmMgLinearSystem3::resizeWithFinest(const Size3 &finestResolution,
-                                          size_t maxNumberOfLevels) {
-    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
-                                       &A.levels);
-    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
-                                       &x.levels);
-    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
-                                       &b.levels);
-}
+namespace {
 
-void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
+template <typename T>
+void restrictVector(const Array3<T> &finer, Array3<T> *coarser) {
     JET_ASSERT(finer.size().x == 2 * coarser->size().x);
     JET_ASSERT(finer.size().y == 2 * coarser->size().y);
     JET_ASSERT(finer.size().z == 2 * coarser->size().z);
@@ -49,7 +22,7 @@ void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
     //  1/8   3/8   3/8   1/8
     //           to
     // -----|-----*-----|-----
-    static const std::array<double, 4> kernel = {{0.125, 0.375, 0.375, 0.125}};
+    static const std::array<T, 4> kernel = {{0.125, 0.375, 0.375, 0.125}};
 
     const Size3 n = coarser->size();
     parallelRangeFor(
@@ -79,11 +52,11 @@ void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
                         iIndices[2] = 2 * i + 1;
                         iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
 
-                        double sum = 0.0;
+                        T sum = 0;
                         for (size_t z = 0; z < 4; ++z) {
                             for (size_t y = 0; y < 4; ++y) {
                                 for (size_t x = 0; x < 4; ++x) {
-                                    double w =
+                                    T w =
                                         kernel[x] * kernel[y] * kernel[z];
                                     sum += w * finer(iIndices[x], jIndices[y],
                                                      kIndices[z]);
@@ -97,7 +70,8 @@ void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
         });
 }
 
-void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
+template <typename T>
+void correctVector(const Array3<T> &coarser, Array3<T> *finer) {
     JET_ASSERT(finer->size().x == 2 * coarser.size().x);
     JET_ASSERT(finer->size().y == 2 * coarser.size().y);
     JET_ASSERT(finer->size().z == 2 * coarser.size().z);
@@ -117,9 +91,9 @@ void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
                         std::array<size_t, 2> iIndices;
                         std::array<size_t, 2> jIndices;
                         std::array<size_t, 2> kIndices;
-                        std::array<double, 2> iWeights;
-                        std::array<double, 2> jWeights;
-                        std::array<double, 2> kWeights;
+                        std::array<T, 2> iWeights;
+                        std::array<T, 2> jWeights;
+                        std::array<T, 2> kWeights;
 
                         const size_t ci = i / 2;
                         const size_t cj = j / 2;
@@ -128,43 +102,43 @@ void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
                         if (i % 2 == 0) {
                             iIndices[0] = (i > 1) ? ci - 1 : ci;
                             iIndices[1] = ci;
-                            iWeights[0] = 0.25;
-                            iWeights[1] = 0.75;
+                            iWeights[0] = T(0.25);
+                            iWeights[1] = T(0.75);
                         } else {
                             iIndices[0] = ci;
                             iIndices[1] = (i + 1 < n.x) ? ci + 1 : ci;
-                            iWeights[0] = 0.75;
-                            iWeights[1] = 0.25;
+                            iWeights[0] = T(0.75);
+                            iWeights[1] = T(0.25);
                         }
 
                         if (j % 2 == 0) {
                             jIndices[0] = (j > 1) ? cj - 1 : cj;
                             jIndices[1] = cj;
-                            jWeights[0] = 0.25;
-                            jWeights[1] = 0.75;
+                            jWeights[0] = T(0.25);
+                            jWeights[1] = T(0.75);
                         } else {
                             jIndices[0] = cj;
                             jIndices[1] = (j + 1 < n.y) ? cj + 1 : cj;
-                            jWeights[0] = 0.75;
-                            jWeights[1] = 0.25;
+                            jWeights[0] = T(0.75);
+                            jWeights[1] = T(0.25);
                         }
 
                         if (k % 2 == 0) {
                             kIndices[0] = (k > 1) ? ck - 1 : ck;
                             kIndices[1] = ck;
-                            kWeights[0] = 0.25;
-                            kWeights[1] = 0.75;
+                            kWeights[0] = T(0.25);
+                            kWeights[1] = T(0.75);
                         } else {
                             kIndices[0] = ck;
                             kIndices[1] = (k + 1 < n.y) ? ck + 1 : ck;
-                            kWeights[0] = 0.75;
-                            kWeights[1] = 0.25;
+                            kWeights[0] = T(0.75);
+                            kWeights[1] = T(0.25);
                         }
 
                         for (size_t z = 0; z < 2; ++z) {
                             for (size_t y = 0; y < 2; ++y) {
                                 for (size_t x = 0; x < 2; ++x) {
-                                    double w = iWeights[x] * jWeights[y] *
+                                    T w = iWeights[x] * jWeights[y] *
                                                kWeights[z] *
                                                coarser(iIndices[x], jIndices[y],
                                                        kIndices[z]);
@@ -177,3 +151,51 @@ void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
             }
         });
 }
+
+}  // namespace
+
+//
+
+void FdmMgLinearSystem3::clear() {
+    A.levels.clear();
+    x.levels.clear();
+    b.levels.clear();
+}
+
+size_t FdmMgLinearSystem3::numberOfLevels() const { return A.levels.size(); }
+
+void FdmMgLinearSystem3::resizeWithCoarsest(const Size3 &coarsestResolution,
+                                            size_t numberOfLevels) {
+    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &A.levels);
+    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &x.levels);
+    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &b.levels);
+}
+
+void FdmMgLinearSystem3::resizeWithFinest(const Size3 &finestResolution,
+                                          size_t maxNumberOfLevels) {
+    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &A.levels);
+    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &x.levels);
+    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &b.levels);
+}
+
+void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
+    restrictVector(finer, coarser);
+}
+
+void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
+    correctVector(coarser, finer);
+}
+
+void FdmMgUtils3::restrict(const FdmVector3F &finer, FdmVector3F *coarser) {
+    restrictVector(finer, coarser);
+}
+
+void FdmMgUtils3::correct(const FdmVector3F &coarser, FdmVector3F *finer) {
+    correctVector(coarser, finer);
+}
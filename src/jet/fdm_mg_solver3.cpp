@@ -48,8 +48,12 @@ FdmMgSolver3::FdmMgSolver3(size_t maxNumberOfLevels,
             }
         };
     }
-    _mgParams.restrictFunc = FdmMgUtils3::restrict;
-    _mgParams.correctFunc = FdmMgUtils3::correct;
+    _mgParams.restrictFunc = [](const FdmVector3& finer, FdmVector3* coarser) {
+        FdmMgUtils3::restrict(finer, coarser);
+    };
+    _mgParams.correctFunc = [](const FdmVector3& coarser, FdmVector3* finer) {
+        FdmMgUtils3::correct(coarser, finer);
+    };
 
     _sorFactor = sorFactor;
     _useRedBlackOrdering = useRedBlackOrdering;
@@ -7,23 +7,106 @@
 #include <pch.h>
 
 #include <jet/cg.h>
+#include <jet/fdm_gauss_seidel_solver3.h>
 #include <jet/fdm_mgpcg_solver3.h>
 #include <jet/mg.h>
 
 using namespace jet;
 
+namespace {
+
+// Returns the Multigrid parameters for the single-precision system with the
+// same iteration counts and relaxation as the given parameters.
+MgParameters<FdmBlas3F> makeSinglePrecisionParams(
+    const MgParameters<FdmBlas3>& params, double sorFactor,
+    bool useRedBlackOrdering) {
+    MgParameters<FdmBlas3F> paramsF;
+    paramsF.maxNumberOfLevels = params.maxNumberOfLevels;
+    paramsF.numberOfRestrictionIter = params.numberOfRestrictionIter;
+    paramsF.numberOfCorrectionIter = params.numberOfCorrectionIter;
+    paramsF.numberOfCoarsestIter = params.numberOfCoarsestIter;
+    paramsF.numberOfFinalIter = params.numberOfFinalIter;
+    paramsF.maxTolerance = params.maxTolerance;
+    paramsF.relaxFunc = [sorFactor, useRedBlackOrdering](
+        const FdmMatrix3F& A, const FdmVector3F& b,
+        unsigned int numberOfIterations, double maxTolerance, FdmVector3F* x,
+        FdmVector3F* buffer) {
+        UNUSED_VARIABLE(buffer);
+        UNUSED_VARIABLE(maxTolerance);
+
+        for (unsigned int iter = 0; iter < numberOfIterations; ++iter) {
+            if (useRedBlackOrdering) {
+                FdmGaussSeidelSolver3::relaxRedBlack(A, b, sorFactor, x);
+            } else {
+                FdmGaussSeidelSolver3::relax(A, b, sorFactor, x);
+            }
+        }
+    };
+    paramsF.restrictFunc = [](const FdmVector3F& finer, FdmVector3F* coarser) {
+        FdmMgUtils3::restrict(finer, coarser);
+    };
+    paramsF.correctFunc = [](const FdmVector3F& coarser, FdmVector3F* finer) {
+        FdmMgUtils3::correct(coarser, finer);
+    };
+    return paramsF;
+}
+
+}  // namespace
+
 void FdmMgpcgSolver3::Preconditioner::build(FdmMgLinearSystem3* system_,
                                             MgParameters<FdmBlas3> mgParams_) {
     system = system_;
     mgParams = mgParams_;
+    useSinglePrecision = false;
+
+    // Allocate the V-cycle vectors once per solve instead of per iteration.
+    mgX = system->x;
+    mgB = system->x;
+    mgBuffer = system->x;
+}
+
+void FdmMgpcgSolver3::Preconditioner::buildSinglePrecision(
+    FdmMgLinearSystem3* system_, MgParameters<FdmBlas3F> mgParams_) {
+    system = system_;
+    mgParamsF = mgParams_;
+    useSinglePrecision = true;
+
+    const size_t numberOfLevels = system->numberOfLevels();
+    // The float matrices are kept from the previous solve, so the conversion
+    // only reallocates them when the resolution has changed.
+    mgAF.levels.resize(numberOfLevels);
+    mgXF.levels.resize(numberOfLevels);
+    mgBF.levels.resize(numberOfLevels);
+    mgBufferF.levels.resize(numberOfLevels);
+    for (size_t l = 0; l < numberOfLevels; ++l) {
+        FdmBlas3F::convert(system->A[l], &mgAF[l]);
+        mgXF[l].resize(system->x[l].size());
+        mgBF[l].resize(system->x[l].size());
+        mgBufferF[l].resize(system->x[l].size());
+    }
+}
+
+void FdmMgpcgSolver3::Preconditioner::clear() {
+    mgX.levels.clear();
+    mgB.levels.clear();
+    mgBuffer.levels.clear();
+
+    mgXF.levels.clear();
+    mgBF.levels.clear();
+    mgBufferF.levels.clear();
 }
 
 void FdmMgpcgSolver3::Preconditioner::solve(const FdmVector3& b,
                                             FdmVector3* x) {
-    // Copy dimension
-    FdmMgVector3 mgX = system->x;
-    FdmMgVector3 mgB = system->x;
-    FdmMgVector3 mgBuffer = system->x;
+    if (useSinglePrecision) {
+        FdmBlas3F::convert(*x, &mgXF.finest());
+        FdmBlas3F::convert(b, &mgBF.finest());
+
+        mgVCycle(mgAF, mgParamsF, &mgXF, &mgBF, &mgBufferF);
+
+        FdmBlas3::convert(mgXF.finest(), x);
+        return;
+    }
 
     // Copy input to the top
     mgX.levels.front().set(*x);
@@ -41,7 +124,8 @@ FdmMgpcgSolver3::FdmMgpcgSolver3(
     unsigned int numberOfCgIter, size_t maxNumberOfLevels,
     unsigned int numberOfRestrictionIter, unsigned int numberOfCorrectionIter,
     unsigned int numberOfCoarsestIter, unsigned int numberOfFinalIter,
-    double maxTolerance, double sorFactor, bool useRedBlackOrdering)
+    double maxTolerance, double sorFactor, bool useRedBlackOrdering,
+    bool useSinglePrecisionPreconditioner)
     : FdmMgSolver3(maxNumberOfLevels, numberOfRestrictionIter,
                    numberOfCorrectionIter, numberOfCoarsestIter,
                    numberOfFinalIter, maxTolerance, sorFactor,
@@ -49,7 +133,8 @@ FdmMgpcgSolver3::FdmMgpcgSolver3(
       _maxNumberOfIterations(numberOfCgIter),
       _lastNumberOfIterations(0),
       _tolerance(maxTolerance),
-      _lastResidualNorm(kMaxD) {}
+      _lastResidualNorm(kMaxD),
+      _useSinglePrecisionPreconditioner(useSinglePrecisionPreconditioner) {}
 
 bool FdmMgpcgSolver3::solve(FdmMgLinearSystem3* system) {
     Size3 size = system->A.levels.front().size();
@@ -64,13 +149,22 @@ bool FdmMgpcgSolver3::solve(FdmMgLinearSystem3* system) {
     _q.set(0.0);
     _s.set(0.0);
 
-    _precond.build(system, params());
+    if (_useSinglePrecisionPreconditioner) {
+        _precond.buildSinglePrecision(
+            system, makeSinglePrecisionParams(params(), sorFactor(),
+                                              useRedBlackOrdering()));
+    } else {
+        _precond.build(system, params());
+    }
 
-    pcg<FdmBlas3, Preconditioner>(system->A.levels.front(),
-                                  system->b.levels.front(),
-                                  _maxNumberOfIterations, _tolerance, &_precond,
-                                  &system->x.levels.front(), &_r, &_d, &_q, &_s,
-                                  &_lastNumberOfIterations, &_lastResidualNorm);
+    pcgFused<FdmBlas3, Preconditioner>(
+        system->A.levels.front(), system->b.levels.front(),
+        _maxNumberOfIterations, _tolerance, &_precond,
+        &system->x.levels.front(), &_r, &_d, &_q, &_s,
+        &_lastNumberOfIterations, &_lastResidualNorm);
+
+    // The V-cycle vectors are rebuilt by the next solve anyway.
+    _precond.clear();
 
     JET_INFO << "Residual after solving MGPCG: " << _lastResidualNorm
              << " Number of MGPCG iterations: " << _lastNumberOfIterations;
@@ -90,3 +184,7 @@ unsigned int FdmMgpcgSolver3::lastNumberOfIterations() const {
 double FdmMgpcgSolver3::tolerance() const { return _tolerance; }
 
 double FdmMgpcgSolver3::lastResidual() const { return _lastResidualNorm; }
+
+bool FdmMgpcgSolver3::useSinglePrecisionPreconditioner() const {
+    return _useSinglePrecisionPreconditioner;
+}
@@ -24,6 +24,20 @@ void FlipSolver3::setPicBlendingFactor(double factor) {
     _picBlendingFactor = clamp(factor, 0.0, 1.0);
 }
 
+void FlipSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    PicSolver3::onSaveCheckpoint(checkpoint);
+
+    // The velocity deltas only live within a time-step, so they are not
+    // stored.
+    checkpoint->setValue("FlipSolver3/picBlendingFactor", _picBlendingFactor);
+}
+
+void FlipSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    PicSolver3::onLoadCheckpoint(checkpoint);
+
+    checkpoint.getValue("FlipSolver3/picBlendingFactor", &_picBlendingFactor);
+}
+
 void FlipSolver3::transferFromParticlesToGrids() {
     PicSolver3::transferFromParticlesToGrids();
 
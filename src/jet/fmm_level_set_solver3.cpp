@@ -548,7 +548,12 @@ void FmmLevelSetSolver3::extrapolate(const ConstArrayAccessor3<double>& input,
             break;
         }
 
-        Vector3D grad = gradient3(sdf, gridSpacing, i, j, k).normalized();
+        // Flat regions, such as the clamped part of a narrow band, have zero
+        // gradient which cannot be normalized.
+        Vector3D grad = gradient3(sdf, gridSpacing, i, j, k);
+        if (grad.lengthSquared() > 0.0) {
+            grad.normalize();
+        }
 
         double sum = 0.0;
         double count = 0.0;
@@ -240,7 +240,9 @@ struct ParticleSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
     VT_SCALARDATALIST = 14,
     VT_VECTORDATALIST = 16,
     VT_NEIGHBORSEARCHER = 18,
-    VT_NEIGHBORLISTS = 20
+    VT_NEIGHBORLISTS = 20,
+    VT_PARTICLEIDS = 22,
+    VT_NEXTPARTICLEID = 24
   };
   double radius() const {
     return GetField<double>(VT_RADIUS, 0.0);
@@ -269,6 +271,12 @@ struct ParticleSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
   const flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>> *neighborLists() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>> *>(VT_NEIGHBORLISTS);
   }
+  const flatbuffers::Vector<uint64_t> *particleIds() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_PARTICLEIDS);
+  }
+  uint64_t nextParticleId() const {
+    return GetField<uint64_t>(VT_NEXTPARTICLEID, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<double>(verifier, VT_RADIUS) &&
@@ -287,6 +295,9 @@ struct ParticleSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
            VerifyOffset(verifier, VT_NEIGHBORLISTS) &&
            verifier.Verify(neighborLists()) &&
            verifier.VerifyVectorOfTables(neighborLists()) &&
+           VerifyOffset(verifier, VT_PARTICLEIDS) &&
+           verifier.Verify(particleIds()) &&
+           VerifyField<uint64_t>(verifier, VT_NEXTPARTICLEID) &&
            verifier.EndTable();
   }
 };
@@ -321,13 +332,19 @@ struct ParticleSystemData3Builder {
   void add_neighborLists(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>>> neighborLists) {
     fbb_.AddOffset(ParticleSystemData3::VT_NEIGHBORLISTS, neighborLists);
   }
+  void add_particleIds(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> particleIds) {
+    fbb_.AddOffset(ParticleSystemData3::VT_PARTICLEIDS, particleIds);
+  }
+  void add_nextParticleId(uint64_t nextParticleId) {
+    fbb_.AddElement<uint64_t>(ParticleSystemData3::VT_NEXTPARTICLEID, nextParticleId, 0);
+  }
   ParticleSystemData3Builder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   ParticleSystemData3Builder &operator=(const ParticleSystemData3Builder &);
   flatbuffers::Offset<ParticleSystemData3> Finish() {
-    const auto end = fbb_.EndTable(start_, 9);
+    const auto end = fbb_.EndTable(start_, 11);
     auto o = flatbuffers::Offset<ParticleSystemData3>(end);
     return o;
   }
@@ -343,13 +360,17 @@ inline flatbuffers::Offset<ParticleSystemData3> CreateParticleSystemData3(
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ScalarParticleData3>>> scalarDataList = 0,
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<VectorParticleData3>>> vectorDataList = 0,
     flatbuffers::Offset<PointNeighborSearcherSerialized3> neighborSearcher = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>>> neighborLists = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>>> neighborLists = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> particleIds = 0,
+    uint64_t nextParticleId = 0) {
   ParticleSystemData3Builder builder_(_fbb);
+  builder_.add_nextParticleId(nextParticleId);
   builder_.add_forceIdx(forceIdx);
   builder_.add_velocityIdx(velocityIdx);
   builder_.add_positionIdx(positionIdx);
   builder_.add_mass(mass);
   builder_.add_radius(radius);
+  builder_.add_particleIds(particleIds);
   builder_.add_neighborLists(neighborLists);
   builder_.add_neighborSearcher(neighborSearcher);
   builder_.add_vectorDataList(vectorDataList);
@@ -367,7 +388,9 @@ inline flatbuffers::Offset<ParticleSystemData3> CreateParticleSystemData3Direct(
     const std::vector<flatbuffers::Offset<ScalarParticleData3>> *scalarDataList = nullptr,
     const std::vector<flatbuffers::Offset<VectorParticleData3>> *vectorDataList = nullptr,
     flatbuffers::Offset<PointNeighborSearcherSerialized3> neighborSearcher = 0,
-    const std::vector<flatbuffers::Offset<ParticleNeighborList3>> *neighborLists = nullptr) {
+    const std::vector<flatbuffers::Offset<ParticleNeighborList3>> *neighborLists = nullptr,
+    const std::vector<uint64_t> *particleIds = nullptr,
+    uint64_t nextParticleId = 0) {
   return jet::fbs::CreateParticleSystemData3(
       _fbb,
       radius,
@@ -378,7 +401,9 @@ inline flatbuffers::Offset<ParticleSystemData3> CreateParticleSystemData3Direct(
       scalarDataList ? _fbb.CreateVector<flatbuffers::Offset<ScalarParticleData3>>(*scalarDataList) : 0,
       vectorDataList ? _fbb.CreateVector<flatbuffers::Offset<VectorParticleData3>>(*vectorDataList) : 0,
       neighborSearcher,
-      neighborLists ? _fbb.CreateVector<flatbuffers::Offset<ParticleNeighborList3>>(*neighborLists) : 0);
+      neighborLists ? _fbb.CreateVector<flatbuffers::Offset<ParticleNeighborList3>>(*neighborLists) : 0,
+      particleIds ? _fbb.CreateVector<uint64_t>(*particleIds) : 0,
+      nextParticleId);
 }
 
 inline const jet::fbs::ParticleSystemData3 *GetParticleSystemData3(const void *buf) {
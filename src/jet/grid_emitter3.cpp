@@ -27,3 +27,15 @@ void GridEmitter3::setOnBeginUpdateCallback(
     const OnBeginUpdateCallback& callback) {
     _onBeginUpdateCallback = callback;
 }
+
+void GridEmitter3::saveCheckpoint(const std::string& prefix,
+                                  Checkpoint* checkpoint) const {
+    UNUSED_VARIABLE(prefix);
+    UNUSED_VARIABLE(checkpoint);
+}
+
+void GridEmitter3::loadCheckpoint(const std::string& prefix,
+                                  const Checkpoint& checkpoint) {
+    UNUSED_VARIABLE(prefix);
+    UNUSED_VARIABLE(checkpoint);
+}
@@ -6,6 +6,7 @@
 
 #include <pch.h>
 #include <jet/grid_emitter_set3.h>
+#include <string>
 #include <vector>
 
 using namespace jet;
@@ -23,6 +24,22 @@ GridEmitterSet3::GridEmitterSet3(
 GridEmitterSet3::~GridEmitterSet3() {
 }
 
+void GridEmitterSet3::saveCheckpoint(const std::string& prefix,
+                                     Checkpoint* checkpoint) const {
+    for (size_t i = 0; i < _emitters.size(); ++i) {
+        _emitters[i]->saveCheckpoint(prefix + std::to_string(i) + "/",
+                                     checkpoint);
+    }
+}
+
+void GridEmitterSet3::loadCheckpoint(const std::string& prefix,
+                                     const Checkpoint& checkpoint) {
+    for (size_t i = 0; i < _emitters.size(); ++i) {
+        _emitters[i]->loadCheckpoint(prefix + std::to_string(i) + "/",
+                                     checkpoint);
+    }
+}
+
 void GridEmitterSet3::addEmitter(const GridEmitter3Ptr& emitter) {
     _emitters.push_back(emitter);
 }
@@ -19,9 +19,67 @@
 #include <jet/timer.h>
 
 #include <algorithm>
+#include <string>
+#include <vector>
 
 using namespace jet;
 
+namespace {
+
+// Copies the grid into the advection buffer, cloning the grid only when the
+// buffer does not have the same data layout.
+void updateAdvectionBuffer(const ScalarGrid3& grid, ScalarGrid3Ptr* buffer) {
+    if (*buffer != nullptr && (*buffer)->hasSameShape(grid) &&
+        (*buffer)->dataSize() == grid.dataSize() &&
+        (*buffer)->dataOrigin() == grid.dataOrigin()) {
+        const Size3 size = grid.dataSize();
+        auto bufferAcc = (*buffer)->dataAccessor();
+        copyRange3(grid.constDataAccessor(), size.x, size.y, size.z,
+                   &bufferAcc);
+    } else {
+        *buffer = grid.clone();
+    }
+}
+
+void updateAdvectionBuffer(const VectorGrid3& grid, VectorGrid3Ptr* buffer) {
+    auto collocated = dynamic_cast<const CollocatedVectorGrid3*>(&grid);
+    auto collocated0 =
+        std::dynamic_pointer_cast<CollocatedVectorGrid3>(*buffer);
+    if (collocated != nullptr && collocated0 != nullptr &&
+        collocated0->hasSameShape(grid) &&
+        collocated0->dataSize() == collocated->dataSize() &&
+        collocated0->dataOrigin() == collocated->dataOrigin()) {
+        const Size3 size = collocated->dataSize();
+        auto bufferAcc = collocated0->dataAccessor();
+        copyRange3(collocated->constDataAccessor(), size.x, size.y, size.z,
+                   &bufferAcc);
+        return;
+    }
+
+    auto faceCentered = dynamic_cast<const FaceCenteredGrid3*>(&grid);
+    auto faceCentered0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(*buffer);
+    if (faceCentered != nullptr && faceCentered0 != nullptr &&
+        faceCentered0->hasSameShape(grid)) {
+        auto u0 = faceCentered0->uAccessor();
+        auto v0 = faceCentered0->vAccessor();
+        auto w0 = faceCentered0->wAccessor();
+        const Size3 uSize = faceCentered->uSize();
+        const Size3 vSize = faceCentered->vSize();
+        const Size3 wSize = faceCentered->wSize();
+        copyRange3(faceCentered->uConstAccessor(), uSize.x, uSize.y, uSize.z,
+                   &u0);
+        copyRange3(faceCentered->vConstAccessor(), vSize.x, vSize.y, vSize.z,
+                   &v0);
+        copyRange3(faceCentered->wConstAccessor(), wSize.x, wSize.y, wSize.z,
+                   &w0);
+        return;
+    }
+
+    *buffer = grid.clone();
+}
+
+}  // namespace
+
 GridFluidSolver3::GridFluidSolver3()
     : GridFluidSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {}
 
@@ -209,6 +267,93 @@ void GridFluidSolver3::onAdvanceTimeStep(double timeIntervalInSeconds) {
     endAdvanceTimeStep(timeIntervalInSeconds);
 }
 
+void GridFluidSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    PhysicsAnimation::onSaveCheckpoint(checkpoint);
+
+    checkpoint->setValue("GridFluidSolver3/gravity", _gravity);
+    checkpoint->setValue("GridFluidSolver3/viscosityCoefficient",
+                         _viscosityCoefficient);
+    checkpoint->setValue("GridFluidSolver3/maxCfl", _maxCfl);
+    checkpoint->setValue("GridFluidSolver3/useCompressedLinearSys",
+                         _useCompressedLinearSys);
+    checkpoint->setValue("GridFluidSolver3/closedDomainBoundaryFlag",
+                         _closedDomainBoundaryFlag);
+
+    checkpoint->setValue("GridFluidSolver3/resolution", _grids->resolution());
+    for (size_t i = 0; i < _grids->numberOfScalarData(); ++i) {
+        const std::string name = "GridFluidSolver3/scalarData/";
+        checkpoint->setData(name + std::to_string(i), *_grids->scalarDataAt(i));
+    }
+    for (size_t i = 0; i < _grids->numberOfVectorData(); ++i) {
+        const std::string name = "GridFluidSolver3/vectorData/";
+        checkpoint->setData(name + std::to_string(i), *_grids->vectorDataAt(i));
+    }
+    for (size_t i = 0; i < _grids->numberOfAdvectableScalarData(); ++i) {
+        const std::string name = "GridFluidSolver3/advectableScalarData/";
+        checkpoint->setData(name + std::to_string(i),
+                            *_grids->advectableScalarDataAt(i));
+    }
+    for (size_t i = 0; i < _grids->numberOfAdvectableVectorData(); ++i) {
+        const std::string name = "GridFluidSolver3/advectableVectorData/";
+        checkpoint->setData(name + std::to_string(i),
+                            *_grids->advectableVectorDataAt(i));
+    }
+
+    if (_collider != nullptr) {
+        _collider->saveCheckpoint("GridFluidSolver3/collider/", checkpoint);
+    }
+    if (_emitter != nullptr) {
+        _emitter->saveCheckpoint("GridFluidSolver3/emitter/", checkpoint);
+    }
+}
+
+void GridFluidSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    Size3 resolution = _grids->resolution();
+    checkpoint.getValue("GridFluidSolver3/resolution", &resolution);
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        resolution != _grids->resolution(),
+        "Checkpoint grid resolution does not match the solver.");
+
+    PhysicsAnimation::onLoadCheckpoint(checkpoint);
+
+    checkpoint.getValue("GridFluidSolver3/gravity", &_gravity);
+    checkpoint.getValue("GridFluidSolver3/viscosityCoefficient",
+                        &_viscosityCoefficient);
+    checkpoint.getValue("GridFluidSolver3/maxCfl", &_maxCfl);
+    checkpoint.getValue("GridFluidSolver3/useCompressedLinearSys",
+                        &_useCompressedLinearSys);
+    checkpoint.getValue("GridFluidSolver3/closedDomainBoundaryFlag",
+                        &_closedDomainBoundaryFlag);
+
+    for (size_t i = 0; i < _grids->numberOfScalarData(); ++i) {
+        const std::string name = "GridFluidSolver3/scalarData/";
+        checkpoint.getData(name + std::to_string(i),
+                           _grids->scalarDataAt(i).get());
+    }
+    for (size_t i = 0; i < _grids->numberOfVectorData(); ++i) {
+        const std::string name = "GridFluidSolver3/vectorData/";
+        checkpoint.getData(name + std::to_string(i),
+                           _grids->vectorDataAt(i).get());
+    }
+    for (size_t i = 0; i < _grids->numberOfAdvectableScalarData(); ++i) {
+        const std::string name = "GridFluidSolver3/advectableScalarData/";
+        checkpoint.getData(name + std::to_string(i),
+                           _grids->advectableScalarDataAt(i).get());
+    }
+    for (size_t i = 0; i < _grids->numberOfAdvectableVectorData(); ++i) {
+        const std::string name = "GridFluidSolver3/advectableVectorData/";
+        checkpoint.getData(name + std::to_string(i),
+                           _grids->advectableVectorDataAt(i).get());
+    }
+
+    if (_collider != nullptr) {
+        _collider->loadCheckpoint("GridFluidSolver3/collider/", checkpoint);
+    }
+    if (_emitter != nullptr) {
+        _emitter->loadCheckpoint("GridFluidSolver3/emitter/", checkpoint);
+    }
+}
+
 unsigned int GridFluidSolver3::numberOfSubTimeSteps(
     double timeIntervalInSeconds) const {
     double currentCfl = cfl(timeIntervalInSeconds);
@@ -253,61 +398,95 @@ void GridFluidSolver3::computePressure(double timeIntervalInSeconds) {
 }
 
 void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
-    auto vel = velocity();
-    if (_advectionSolver != nullptr) {
-        // Solve advections for custom scalar fields
-        size_t n = _grids->numberOfAdvectableScalarData();
-        for (size_t i = 0; i < n; ++i) {
-            auto grid = _grids->advectableScalarDataAt(i);
-            auto grid0 = grid->clone();
-            _advectionSolver->advect(*grid0, *vel, timeIntervalInSeconds,
-                                     grid.get(), *colliderSdf());
-            extrapolateIntoCollider(grid.get());
+    if (_advectionSolver == nullptr) {
+        return;
+    }
+
+    // Keep the previous values in the persistent buffers and advect the
+    // fields of each kind in one batch, so that the advection solver can
+    // share the back-traces between the fields with the same data points.
+    std::vector<const ScalarGrid3*> scalarInputs;
+    std::vector<ScalarGrid3*> scalarOutputs;
+    size_t n = _grids->numberOfAdvectableScalarData();
+    _scalarDataBuffers.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (!shouldAdvectScalarData(i)) {
+            continue;
+        }
+
+        auto grid = _grids->advectableScalarDataAt(i);
+        updateAdvectionBuffer(*grid, &_scalarDataBuffers[i]);
+        scalarInputs.push_back(_scalarDataBuffers[i].get());
+        scalarOutputs.push_back(grid.get());
+    }
+
+    std::vector<const CollocatedVectorGrid3*> collocatedInputs;
+    std::vector<CollocatedVectorGrid3*> collocatedOutputs;
+    std::vector<const FaceCenteredGrid3*> faceCenteredInputs;
+    std::vector<FaceCenteredGrid3*> faceCenteredOutputs;
+    n = _grids->numberOfAdvectableVectorData();
+    _vectorDataBuffers.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        auto grid = _grids->advectableVectorDataAt(i);
+        updateAdvectionBuffer(*grid, &_vectorDataBuffers[i]);
+        const VectorGrid3Ptr& grid0 = _vectorDataBuffers[i];
+
+        auto collocated =
+            std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
+        auto collocated0 =
+            std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid0);
+        if (collocated != nullptr && collocated0 != nullptr) {
+            collocatedInputs.push_back(collocated0.get());
+            collocatedOutputs.push_back(collocated.get());
+            continue;
         }
 
-        // Solve advections for custom vector fields
-        n = _grids->numberOfAdvectableVectorData();
-        size_t velIdx = _grids->velocityIndex();
-        for (size_t i = 0; i < n; ++i) {
-            // Handle velocity layer separately.
-            if (i == velIdx) {
-                continue;
-            }
-
-            auto grid = _grids->advectableVectorDataAt(i);
-            auto grid0 = grid->clone();
-
-            auto collocated =
-                std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
-            auto collocated0 =
-                std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid0);
-            if (collocated != nullptr) {
-                _advectionSolver->advect(*collocated0, *vel,
-                                         timeIntervalInSeconds,
-                                         collocated.get(), *colliderSdf());
-                extrapolateIntoCollider(collocated.get());
-                continue;
-            }
-
-            auto faceCentered =
-                std::dynamic_pointer_cast<FaceCenteredGrid3>(grid);
-            auto faceCentered0 =
-                std::dynamic_pointer_cast<FaceCenteredGrid3>(grid0);
-            if (faceCentered != nullptr && faceCentered0 != nullptr) {
-                _advectionSolver->advect(*faceCentered0, *vel,
-                                         timeIntervalInSeconds,
-                                         faceCentered.get(), *colliderSdf());
-                extrapolateIntoCollider(faceCentered.get());
-                continue;
-            }
+        auto faceCentered =
+            std::dynamic_pointer_cast<FaceCenteredGrid3>(grid);
+        auto faceCentered0 =
+            std::dynamic_pointer_cast<FaceCenteredGrid3>(grid0);
+        if (faceCentered != nullptr && faceCentered0 != nullptr) {
+            faceCenteredInputs.push_back(faceCentered0.get());
+            faceCenteredOutputs.push_back(faceCentered.get());
         }
+    }
 
-        // Solve velocity advection
-        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
-        _advectionSolver->advect(*vel0, *vel0, timeIntervalInSeconds, vel.get(),
-                                 *colliderSdf());
-        applyBoundaryCondition();
+    // All the fields, including the velocity itself, are carried by the
+    // velocity at the beginning of the advection.
+    auto vel = velocity();
+    auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(
+        _vectorDataBuffers[_grids->velocityIndex()]);
+    auto boundarySdf = colliderSdf();
+
+    // Solve advections for custom scalar fields
+    _advectionSolver->advect(scalarInputs, *vel0, timeIntervalInSeconds,
+                             scalarOutputs, *boundarySdf);
+    for (ScalarGrid3* grid : scalarOutputs) {
+        extrapolateIntoCollider(grid);
+    }
+
+    // Solve advections for custom vector fields and the velocity
+    _advectionSolver->advect(collocatedInputs, *vel0, timeIntervalInSeconds,
+                             collocatedOutputs, *boundarySdf);
+    for (CollocatedVectorGrid3* grid : collocatedOutputs) {
+        extrapolateIntoCollider(grid);
+    }
+
+    _advectionSolver->advect(faceCenteredInputs, *vel0,
+                             timeIntervalInSeconds, faceCenteredOutputs,
+                             *boundarySdf);
+    for (FaceCenteredGrid3* grid : faceCenteredOutputs) {
+        // The velocity is handled by the boundary condition solver.
+        if (grid != vel.get()) {
+            extrapolateIntoCollider(grid);
+        }
     }
+    applyBoundaryCondition();
+}
+
+bool GridFluidSolver3::shouldAdvectScalarData(size_t index) const {
+    UNUSED_VARIABLE(index);
+    return true;
 }
 
 ScalarField3Ptr GridFluidSolver3::fluidSdf() const {
@@ -10,7 +10,6 @@
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/grid_fractional_boundary_condition_solver3.h>
 #include <jet/level_set_utils.h>
-#include <jet/surface_to_implicit3.h>
 #include <algorithm>
 
 using namespace jet;
@@ -251,16 +250,9 @@ void GridFractionalBoundaryConditionSolver3::onColliderUpdated(
     _colliderSdf->resize(gridSize, gridSpacing, gridOrigin);
 
     if (collider() != nullptr) {
-        Surface3Ptr surface = collider()->surface();
-        ImplicitSurface3Ptr implicitSurface
-            = std::dynamic_pointer_cast<ImplicitSurface3>(surface);
-        if (implicitSurface == nullptr) {
-            implicitSurface = std::make_shared<SurfaceToImplicit3>(surface);
-        }
-
-        _colliderSdf->fill([&](const Vector3D& pt) {
-            return implicitSurface->signedDistance(pt);
-        });
+        const Collider3Ptr& col = collider();
+        _colliderSdf->fill(
+            [&](const Vector3D& pt) { return col->signedDistance(pt); });
 
         _colliderVel = CustomVectorField3::builder()
         .withFunction([&] (const Vector3D& x) {
@@ -266,7 +266,7 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
     });
 }
 
-void buildSingleSystem(MatrixCsrD* A, VectorND* x, VectorND* b,
+void buildSingleSystem(FdmCompressedLinearSystem3* system,
                        const Array3<float>& fluidSdf,
                        const Array3<float>& uWeights,
                        const Array3<float>& vWeights,
@@ -281,166 +281,176 @@ void buildSingleSystem(MatrixCsrD* A, VectorND* x, VectorND* b,
     const Vector3D invH = 1.0 / input.gridSpacing();
     const Vector3D invHSqr = invH * invH;
 
-    const auto fluidSdfAcc = fluidSdf.constAccessor();
-
-    A->clear();
-    b->clear();
-
-    size_t numRows = 0;
-    Array3<size_t> coordToIndex(size);
-    fluidSdf.forEachIndex([&](size_t i, size_t j, size_t k) {
-        const size_t cIdx = fluidSdfAcc.index(i, j, k);
-        const double centerPhi = fluidSdf[cIdx];
-
-        if (isInsideSdf(centerPhi)) {
-            coordToIndex[cIdx] = numRows++;
-        }
+    // The sparsity pattern only depends on the fluid cells, so it is rebuilt
+    // only when they change. The values are refreshed in any case.
+    system->buildPattern(size, [&](size_t i, size_t j, size_t k) {
+        return isInsideSdf(fluidSdf(i, j, k));
     });
 
-    fluidSdf.forEachIndex([&](size_t i, size_t j, size_t k) {
-        const size_t cIdx = fluidSdfAcc.index(i, j, k);
-
-        const double centerPhi = fluidSdf[cIdx];
+    const Array3<size_t>& coordToIndex = system->coordToIndex;
+    const size_t* rowPointers = system->A.rowPointersData();
+    double* nonZeros = system->A.nonZeroData();
+    VectorND& b = system->b;
 
-        if (isInsideSdf(centerPhi)) {
-            double bijk = 0.0;
-
-            std::vector<double> row(1, 0.0);
-            std::vector<size_t> colIdx(1, coordToIndex[cIdx]);
-
-            double term;
+    fluidSdf.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const size_t rowIdx = coordToIndex(i, j, k);
+        if (rowIdx == kMaxSize) {
+            return;
+        }
 
-            if (i + 1 < size.x) {
-                term = uWeights(i + 1, j, k) * invHSqr.x;
-                const double rightPhi = fluidSdf(i + 1, j, k);
-                if (isInsideSdf(rightPhi)) {
-                    row[0] += term;
-                    row.push_back(-term);
-                    colIdx.push_back(coordToIndex(i + 1, j, k));
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, rightPhi);
-                    theta = std::max(theta, 0.01);
-                    row[0] += term / theta;
-                }
-                bijk += uWeights(i + 1, j, k) * input.u(i + 1, j, k) * invH.x;
+        const double centerPhi = fluidSdf(i, j, k);
+
+        double bijk = 0.0;
+        double center = 0.0;
+        double right = 0.0;
+        double left = 0.0;
+        double up = 0.0;
+        double down = 0.0;
+        double front = 0.0;
+        double back = 0.0;
+
+        double term;
+
+        if (i + 1 < size.x) {
+            term = uWeights(i + 1, j, k) * invHSqr.x;
+            const double rightPhi = fluidSdf(i + 1, j, k);
+            if (isInsideSdf(rightPhi)) {
+                center += term;
+                right = -term;
             } else {
-                bijk += input.u(i + 1, j, k) * invH.x;
+                double theta = fractionInsideSdf(centerPhi, rightPhi);
+                theta = std::max(theta, 0.01);
+                center += term / theta;
             }
+            bijk += uWeights(i + 1, j, k) * input.u(i + 1, j, k) * invH.x;
+        } else {
+            bijk += input.u(i + 1, j, k) * invH.x;
+        }
 
-            if (i > 0) {
-                term = uWeights(i, j, k) * invHSqr.x;
-                const double leftPhi = fluidSdf(i - 1, j, k);
-                if (isInsideSdf(leftPhi)) {
-                    row[0] += term;
-                    row.push_back(-term);
-                    colIdx.push_back(coordToIndex(i - 1, j, k));
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, leftPhi);
-                    theta = std::max(theta, 0.01);
-                    row[0] += term / theta;
-                }
-                bijk -= uWeights(i, j, k) * input.u(i, j, k) * invH.x;
+        if (i > 0) {
+            term = uWeights(i, j, k) * invHSqr.x;
+            const double leftPhi = fluidSdf(i - 1, j, k);
+            if (isInsideSdf(leftPhi)) {
+                center += term;
+                left = -term;
             } else {
-                bijk -= input.u(i, j, k) * invH.x;
+                double theta = fractionInsideSdf(centerPhi, leftPhi);
+                theta = std::max(theta, 0.01);
+                center += term / theta;
             }
+            bijk -= uWeights(i, j, k) * input.u(i, j, k) * invH.x;
+        } else {
+            bijk -= input.u(i, j, k) * invH.x;
+        }
 
-            if (j + 1 < size.y) {
-                term = vWeights(i, j + 1, k) * invHSqr.y;
-                const double upPhi = fluidSdf(i, j + 1, k);
-                if (isInsideSdf(upPhi)) {
-                    row[0] += term;
-                    row.push_back(-term);
-                    colIdx.push_back(coordToIndex(i, j + 1, k));
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, upPhi);
-                    theta = std::max(theta, 0.01);
-                    row[0] += term / theta;
-                }
-                bijk += vWeights(i, j + 1, k) * input.v(i, j + 1, k) * invH.y;
+        if (j + 1 < size.y) {
+            term = vWeights(i, j + 1, k) * invHSqr.y;
+            const double upPhi = fluidSdf(i, j + 1, k);
+            if (isInsideSdf(upPhi)) {
+                center += term;
+                up = -term;
             } else {
-                bijk += input.v(i, j + 1, k) * invH.y;
+                double theta = fractionInsideSdf(centerPhi, upPhi);
+                theta = std::max(theta, 0.01);
+                center += term / theta;
             }
+            bijk += vWeights(i, j + 1, k) * input.v(i, j + 1, k) * invH.y;
+        } else {
+            bijk += input.v(i, j + 1, k) * invH.y;
+        }
 
-            if (j > 0) {
-                term = vWeights(i, j, k) * invHSqr.y;
-                const double downPhi = fluidSdf(i, j - 1, k);
-                if (isInsideSdf(downPhi)) {
-                    row[0] += term;
-                    row.push_back(-term);
-                    colIdx.push_back(coordToIndex(i, j - 1, k));
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, downPhi);
-                    theta = std::max(theta, 0.01);
-                    row[0] += term / theta;
-                }
-                bijk -= vWeights(i, j, k) * input.v(i, j, k) * invH.y;
+        if (j > 0) {
+            term = vWeights(i, j, k) * invHSqr.y;
+            const double downPhi = fluidSdf(i, j - 1, k);
+            if (isInsideSdf(downPhi)) {
+                center += term;
+                down = -term;
             } else {
-                bijk -= input.v(i, j, k) * invH.y;
+                double theta = fractionInsideSdf(centerPhi, downPhi);
+                theta = std::max(theta, 0.01);
+                center += term / theta;
             }
+            bijk -= vWeights(i, j, k) * input.v(i, j, k) * invH.y;
+        } else {
+            bijk -= input.v(i, j, k) * invH.y;
+        }
 
-            if (k + 1 < size.z) {
-                term = wWeights(i, j, k + 1) * invHSqr.z;
-                const double frontPhi = fluidSdf(i, j, k + 1);
-                if (isInsideSdf(frontPhi)) {
-                    row[0] += term;
-                    row.push_back(-term);
-                    colIdx.push_back(coordToIndex(i, j, k + 1));
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, frontPhi);
-                    theta = std::max(theta, 0.01);
-                    row[0] += term / theta;
-                }
-                bijk += wWeights(i, j, k + 1) * input.w(i, j, k + 1) * invH.z;
+        if (k + 1 < size.z) {
+            term = wWeights(i, j, k + 1) * invHSqr.z;
+            const double frontPhi = fluidSdf(i, j, k + 1);
+            if (isInsideSdf(frontPhi)) {
+                center += term;
+                front = -term;
             } else {
-                bijk += input.w(i, j, k + 1) * invH.z;
+                double theta = fractionInsideSdf(centerPhi, frontPhi);
+                theta = std::max(theta, 0.01);
+                center += term / theta;
             }
+            bijk += wWeights(i, j, k + 1) * input.w(i, j, k + 1) * invH.z;
+        } else {
+            bijk += input.w(i, j, k + 1) * invH.z;
+        }
 
-            if (k > 0) {
-                term = wWeights(i, j, k) * invHSqr.z;
-                const double backPhi = fluidSdf(i, j, k - 1);
-                if (isInsideSdf(backPhi)) {
-                    row[0] += term;
-                    row.push_back(-term);
-                    colIdx.push_back(coordToIndex(i, j, k - 1));
-                } else {
-                    double theta = fractionInsideSdf(centerPhi, backPhi);
-                    theta = std::max(theta, 0.01);
-                    row[0] += term / theta;
-                }
-                bijk -= wWeights(i, j, k) * input.w(i, j, k) * invH.z;
+        if (k > 0) {
+            term = wWeights(i, j, k) * invHSqr.z;
+            const double backPhi = fluidSdf(i, j, k - 1);
+            if (isInsideSdf(backPhi)) {
+                center += term;
+                back = -term;
             } else {
-                bijk -= input.w(i, j, k) * invH.z;
+                double theta = fractionInsideSdf(centerPhi, backPhi);
+                theta = std::max(theta, 0.01);
+                center += term / theta;
             }
+            bijk -= wWeights(i, j, k) * input.w(i, j, k) * invH.z;
+        } else {
+            bijk -= input.w(i, j, k) * invH.z;
+        }
 
-            // Accumulate contributions from the moving boundary
-            double boundaryContribution =
-                (1.0 - uWeights(i + 1, j, k)) *
-                    boundaryVel(uPos(i + 1, j, k)).x * invH.x -
-                (1.0 - uWeights(i, j, k)) * boundaryVel(uPos(i, j, k)).x *
-                    invH.x +
-                (1.0 - vWeights(i, j + 1, k)) *
-                    boundaryVel(vPos(i, j + 1, k)).y * invH.y -
-                (1.0 - vWeights(i, j, k)) * boundaryVel(vPos(i, j, k)).y *
-                    invH.y +
-                (1.0 - wWeights(i, j, k + 1)) *
-                    boundaryVel(wPos(i, j, k + 1)).z * invH.z -
-                (1.0 - wWeights(i, j, k)) * boundaryVel(wPos(i, j, k)).z *
-                    invH.z;
-            bijk += boundaryContribution;
-
-            // If row.center is near-zero, the cell is likely inside a solid
-            // boundary.
-            if (row[0] < kEpsilonD) {
-                row[0] = 1.0;
-                bijk = 0.0;
-            }
+        // Accumulate contributions from the moving boundary
+        double boundaryContribution =
+            (1.0 - uWeights(i + 1, j, k)) * boundaryVel(uPos(i + 1, j, k)).x *
+                invH.x -
+            (1.0 - uWeights(i, j, k)) * boundaryVel(uPos(i, j, k)).x * invH.x +
+            (1.0 - vWeights(i, j + 1, k)) * boundaryVel(vPos(i, j + 1, k)).y *
+                invH.y -
+            (1.0 - vWeights(i, j, k)) * boundaryVel(vPos(i, j, k)).y * invH.y +
+            (1.0 - wWeights(i, j, k + 1)) * boundaryVel(wPos(i, j, k + 1)).z *
+                invH.z -
+            (1.0 - wWeights(i, j, k)) * boundaryVel(wPos(i, j, k)).z * invH.z;
+        bijk += boundaryContribution;
+
+        // If center is near-zero, the cell is likely inside a solid
+        // boundary.
+        if (center < kEpsilonD) {
+            center = 1.0;
+            bijk = 0.0;
+        }
 
-            A->addRow(row, colIdx);
-            b->append(bijk);
+        // Write the row in the column order of the stencil.
+        double* row = nonZeros + rowPointers[rowIdx];
+        if (k > 0 && coordToIndex(i, j, k - 1) != kMaxSize) {
+            *(row++) = back;
+        }
+        if (j > 0 && coordToIndex(i, j - 1, k) != kMaxSize) {
+            *(row++) = down;
+        }
+        if (i > 0 && coordToIndex(i - 1, j, k) != kMaxSize) {
+            *(row++) = left;
+        }
+        *(row++) = center;
+        if (i + 1 < size.x && coordToIndex(i + 1, j, k) != kMaxSize) {
+            *(row++) = right;
+        }
+        if (j + 1 < size.y && coordToIndex(i, j + 1, k) != kMaxSize) {
+            *(row++) = up;
+        }
+        if (k + 1 < size.z && coordToIndex(i, j, k + 1) != kMaxSize) {
+            *row = front;
         }
-    });
 
-    x->resize(b->size(), 0.0);
+        b[rowIdx] = bijk;
+    });
 }
 
 }  // namespace
@@ -636,14 +646,13 @@ void GridFractionalSinglePhasePressureSolver3::buildWeights(
 }
 
 void GridFractionalSinglePhasePressureSolver3::decompressSolution() {
-    const auto acc = _fluidSdf[0].constAccessor();
-    _system.x.resize(acc.size());
+    const Array3<size_t>& coordToIndex = _compSystem.coordToIndex;
+    _system.x.resize(coordToIndex.size());
 
-    size_t row = 0;
-    _fluidSdf[0].forEachIndex([&](size_t i, size_t j, size_t k) {
-        if (isInsideSdf(acc(i, j, k))) {
+    _system.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const size_t row = coordToIndex(i, j, k);
+        if (row != kMaxSize) {
             _system.x(i, j, k) = _compSystem.x[row];
-            ++row;
         }
     });
 }
@@ -674,9 +683,9 @@ void GridFractionalSinglePhasePressureSolver3::buildSystem(
     const FaceCenteredGrid3* finer = &input;
     if (_mgSystemSolver == nullptr) {
         if (useCompressed) {
-            buildSingleSystem(&_compSystem.A, &_compSystem.x, &_compSystem.b,
-                              _fluidSdf[0], _uWeights[0], _vWeights[0],
-                              _wWeights[0], _boundaryVel, *finer);
+            buildSingleSystem(&_compSystem, _fluidSdf[0], _uWeights[0],
+                              _vWeights[0], _wWeights[0], _boundaryVel,
+                              *finer);
         } else {
             buildSingleSystem(&_system.A, &_system.b, _fluidSdf[0],
                               _uWeights[0], _vWeights[0], _wWeights[0],
@@ -78,96 +78,80 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
     });
 }
 
-void buildSingleSystem(MatrixCsrD* A, VectorND* x, VectorND* b,
+void buildSingleSystem(FdmCompressedLinearSystem3* system,
                        const Array3<char>& markers,
                        const FaceCenteredGrid3& input) {
     Size3 size = input.resolution();
     Vector3D invH = 1.0 / input.gridSpacing();
     Vector3D invHSqr = invH * invH;
 
-    const auto markerAcc = markers.constAccessor();
-
-    A->clear();
-    b->clear();
+    // The sparsity pattern only depends on the fluid cells, so it is rebuilt
+    // only when they change. The values are refreshed in any case.
+    system->buildPattern(size, [&](size_t i, size_t j, size_t k) {
+        return markers(i, j, k) == kFluid;
+    });
 
-    size_t numRows = 0;
-    Array3<size_t> coordToIndex(size);
-    markers.forEachIndex([&](size_t i, size_t j, size_t k) {
-        const size_t cIdx = markerAcc.index(i, j, k);
+    const Array3<size_t>& coordToIndex = system->coordToIndex;
+    const size_t* rowPointers = system->A.rowPointersData();
+    double* nonZeros = system->A.nonZeroData();
+    VectorND& b = system->b;
 
-        if (markerAcc[cIdx] == kFluid) {
-            coordToIndex[cIdx] = numRows++;
+    markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const size_t rowIdx = coordToIndex(i, j, k);
+        if (rowIdx == kMaxSize) {
+            return;
         }
-    });
 
-    markers.forEachIndex([&](size_t i, size_t j, size_t k) {
-        const size_t cIdx = markerAcc.index(i, j, k);
+        b[rowIdx] = input.divergenceAtCellCenter(i, j, k);
 
-        if (markerAcc[cIdx] == kFluid) {
-            b->append(input.divergenceAtCellCenter(i, j, k));
+        double center = 0.0;
 
-            std::vector<double> row(1, 0.0);
-            std::vector<size_t> colIdx(1, coordToIndex[cIdx]);
-
-            if (i + 1 < size.x && markers(i + 1, j, k) != kBoundary) {
-                row[0] += invHSqr.x;
-                const size_t rIdx = markerAcc.index(i + 1, j, k);
-                if (markers[rIdx] == kFluid) {
-                    row.push_back(-invHSqr.x);
-                    colIdx.push_back(coordToIndex[rIdx]);
-                }
-            }
+        if (i + 1 < size.x && markers(i + 1, j, k) != kBoundary) {
+            center += invHSqr.x;
+        }
 
-            if (i > 0 && markers(i - 1, j, k) != kBoundary) {
-                row[0] += invHSqr.x;
-                const size_t lIdx = markerAcc.index(i - 1, j, k);
-                if (markers[lIdx] == kFluid) {
-                    row.push_back(-invHSqr.x);
-                    colIdx.push_back(coordToIndex[lIdx]);
-                }
-            }
+        if (i > 0 && markers(i - 1, j, k) != kBoundary) {
+            center += invHSqr.x;
+        }
 
-            if (j + 1 < size.y && markers(i, j + 1, k) != kBoundary) {
-                row[0] += invHSqr.y;
-                const size_t uIdx = markerAcc.index(i, j + 1, k);
-                if (markers[uIdx] == kFluid) {
-                    row.push_back(-invHSqr.y);
-                    colIdx.push_back(coordToIndex[uIdx]);
-                }
-            }
+        if (j + 1 < size.y && markers(i, j + 1, k) != kBoundary) {
+            center += invHSqr.y;
+        }
 
-            if (j > 0 && markers(i, j - 1, k) != kBoundary) {
-                row[0] += invHSqr.y;
-                const size_t dIdx = markerAcc.index(i, j - 1, k);
-                if (markers[dIdx] == kFluid) {
-                    row.push_back(-invHSqr.y);
-                    colIdx.push_back(coordToIndex[dIdx]);
-                }
-            }
+        if (j > 0 && markers(i, j - 1, k) != kBoundary) {
+            center += invHSqr.y;
+        }
 
-            if (k + 1 < size.z && markers(i, j, k + 1) != kBoundary) {
-                row[0] += invHSqr.z;
-                const size_t fIdx = markerAcc.index(i, j, k + 1);
-                if (markers[fIdx] == kFluid) {
-                    row.push_back(-invHSqr.z);
-                    colIdx.push_back(coordToIndex[fIdx]);
-                }
-            }
+        if (k + 1 < size.z && markers(i, j, k + 1) != kBoundary) {
+            center += invHSqr.z;
+        }
 
-            if (k > 0 && markers(i, j, k - 1) != kBoundary) {
-                row[0] += invHSqr.z;
-                const size_t bIdx = markerAcc.index(i, j, k - 1);
-                if (markers[bIdx] == kFluid) {
-                    row.push_back(-invHSqr.z);
-                    colIdx.push_back(coordToIndex[bIdx]);
-                }
-            }
+        if (k > 0 && markers(i, j, k - 1) != kBoundary) {
+            center += invHSqr.z;
+        }
 
-            A->addRow(row, colIdx);
+        // Write the row in the column order of the stencil.
+        double* row = nonZeros + rowPointers[rowIdx];
+        if (k > 0 && markers(i, j, k - 1) == kFluid) {
+            *(row++) = -invHSqr.z;
+        }
+        if (j > 0 && markers(i, j - 1, k) == kFluid) {
+            *(row++) = -invHSqr.y;
+        }
+        if (i > 0 && markers(i - 1, j, k) == kFluid) {
+            *(row++) = -invHSqr.x;
+        }
+        *(row++) = center;
+        if (i + 1 < size.x && markers(i + 1, j, k) == kFluid) {
+            *(row++) = -invHSqr.x;
+        }
+        if (j + 1 < size.y && markers(i, j + 1, k) == kFluid) {
+            *(row++) = -invHSqr.y;
+        }
+        if (k + 1 < size.z && markers(i, j, k + 1) == kFluid) {
+            *row = -invHSqr.z;
         }
     });
-
-    x->resize(b->size(), 0.0);
 }
 
 }  // namespace
@@ -328,14 +312,13 @@ void GridSinglePhasePressureSolver3::buildMarkers(
 }
 
 void GridSinglePhasePressureSolver3::decompressSolution() {
-    const auto acc = _markers[0].constAccessor();
-    _system.x.resize(acc.size());
+    const Array3<size_t>& coordToIndex = _compSystem.coordToIndex;
+    _system.x.resize(coordToIndex.size());
 
-    size_t row = 0;
-    _markers[0].forEachIndex([&](size_t i, size_t j, size_t k) {
-        if (acc(i, j, k) == kFluid) {
+    _system.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const size_t row = coordToIndex(i, j, k);
+        if (row != kMaxSize) {
             _system.x(i, j, k) = _compSystem.x[row];
-            ++row;
         }
     });
 }
@@ -366,8 +349,7 @@ void GridSinglePhasePressureSolver3::buildSystem(const FaceCenteredGrid3& input,
     const FaceCenteredGrid3* finer = &input;
     if (_mgSystemSolver == nullptr) {
         if (useCompressed) {
-            buildSingleSystem(&_compSystem.A, &_compSystem.x, &_compSystem.b,
-                              _markers[0], *finer);
+            buildSingleSystem(&_compSystem, _markers[0], *finer);
         } else {
             buildSingleSystem(&_system.A, &_system.b, _markers[0], *finer);
         }
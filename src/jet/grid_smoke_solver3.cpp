@@ -82,6 +82,40 @@ ScalarGrid3Ptr GridSmokeSolver3::temperature() const {
     return gridSystemData()->advectableScalarDataAt(_temperatureDataId);
 }
 
+void GridSmokeSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    GridFluidSolver3::onSaveCheckpoint(checkpoint);
+
+    checkpoint->setValue("GridSmokeSolver3/smokeDiffusionCoefficient",
+                         _smokeDiffusionCoefficient);
+    checkpoint->setValue("GridSmokeSolver3/temperatureDiffusionCoefficient",
+                         _temperatureDiffusionCoefficient);
+    checkpoint->setValue("GridSmokeSolver3/buoyancySmokeDensityFactor",
+                         _buoyancySmokeDensityFactor);
+    checkpoint->setValue("GridSmokeSolver3/buoyancyTemperatureFactor",
+                         _buoyancyTemperatureFactor);
+    checkpoint->setValue("GridSmokeSolver3/smokeDecayFactor",
+                         _smokeDecayFactor);
+    checkpoint->setValue("GridSmokeSolver3/temperatureDecayFactor",
+                         _temperatureDecayFactor);
+}
+
+void GridSmokeSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    GridFluidSolver3::onLoadCheckpoint(checkpoint);
+
+    checkpoint.getValue("GridSmokeSolver3/smokeDiffusionCoefficient",
+                        &_smokeDiffusionCoefficient);
+    checkpoint.getValue("GridSmokeSolver3/temperatureDiffusionCoefficient",
+                        &_temperatureDiffusionCoefficient);
+    checkpoint.getValue("GridSmokeSolver3/buoyancySmokeDensityFactor",
+                        &_buoyancySmokeDensityFactor);
+    checkpoint.getValue("GridSmokeSolver3/buoyancyTemperatureFactor",
+                        &_buoyancyTemperatureFactor);
+    checkpoint.getValue("GridSmokeSolver3/smokeDecayFactor",
+                        &_smokeDecayFactor);
+    checkpoint.getValue("GridSmokeSolver3/temperatureDecayFactor",
+                        &_temperatureDecayFactor);
+}
+
 void GridSmokeSolver3::onEndAdvanceTimeStep(double timeIntervalInSeconds) {
     computeDiffusion(timeIntervalInSeconds);
 }
@@ -150,7 +150,7 @@ void ImplicitSurfaceSet2::buildBvh() const {
         for (size_t i = 0; i < _surfaces.size(); ++i) {
             bounds[i] = _surfaces[i]->boundingBox();
         }
-        _bvh.build(_surfaces, bounds);
+        _bvh.build(_surfaces, bounds, BvhBuildMethod::kSah);
         _bvhInvalidated = false;
     }
 }
@@ -7,15 +7,118 @@
 #include <pch.h>
 #include <jet/array_utils.h>
 #include <jet/eno_level_set_solver3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
 #include <jet/fmm_level_set_solver3.h>
 #include <jet/level_set_liquid_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/parallel.h>
 #include <jet/timer.h>
 
 #include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
 
 using namespace jet;
 
+namespace {
+
+// Extrapolates one velocity component from the liquid into the air, only at
+// the faces of the given cells. The faces are marked in the given marker as
+// liquid (1) or air (2), and each layer sets the air faces next to the
+// liquid to the average of their liquid neighbors, like extrapolateToRegion
+// does for the whole grid. The marker is cleared before returning.
+void extrapolateToAirAtFaces(const std::vector<Point3UI>& cells,
+                             const Size3& cellSize, size_t axis,
+                             const ScalarField3& sdf,
+                             const FaceCenteredGrid3::DataPositionFunc& pos,
+                             unsigned int numberOfLayers,
+                             ArrayAccessor3<double> data,
+                             Array3<char>* marker) {
+    // Each cell owns its lower face along the axis, and the last cells own
+    // the upper boundary faces as well.
+    std::vector<Point3UI> faces;
+    faces.reserve(cells.size());
+    for (const Point3UI& c : cells) {
+        faces.push_back(c);
+        if (c[axis] + 1 == cellSize[axis]) {
+            Point3UI upper = c;
+            ++upper[axis];
+            faces.push_back(upper);
+        }
+    }
+
+    Array3<char>& m = *marker;
+    if (m.size() != data.size()) {
+        m.resize(data.size(), 0);
+    }
+
+    parallelFor(kZeroSize, faces.size(), [&](size_t n) {
+        const Point3UI& f = faces[n];
+        if (isInsideSdf(sdf.sample(pos(f.x, f.y, f.z)))) {
+            m(f) = 1;
+        } else {
+            m(f) = 2;
+            data(f) = 0.0;
+        }
+    });
+
+    const Size3 size = data.size();
+    std::vector<double> values(faces.size());
+    std::vector<char> isUpdated(faces.size());
+    for (unsigned int layer = 0; layer < numberOfLayers; ++layer) {
+        parallelFor(kZeroSize, faces.size(), [&](size_t n) {
+            const Point3UI& f = faces[n];
+            isUpdated[n] = 0;
+            if (m(f) != 2) {
+                return;
+            }
+
+            double sum = 0.0;
+            unsigned int count = 0;
+            for (size_t a = 0; a < 3; ++a) {
+                Point3UI neighbor = f;
+                if (f[a] > 0) {
+                    --neighbor[a];
+                    if (m(neighbor) == 1) {
+                        sum += data(neighbor);
+                        ++count;
+                    }
+                    ++neighbor[a];
+                }
+                if (f[a] + 1 < size[a]) {
+                    ++neighbor[a];
+                    if (m(neighbor) == 1) {
+                        sum += data(neighbor);
+                        ++count;
+                    }
+                }
+            }
+
+            if (count > 0) {
+                values[n] = sum / count;
+                isUpdated[n] = 1;
+            }
+        });
+
+        bool hasUpdated = false;
+        for (size_t n = 0; n < faces.size(); ++n) {
+            if (isUpdated[n]) {
+                data(faces[n]) = values[n];
+                m(faces[n]) = 1;
+                hasUpdated = true;
+            }
+        }
+        if (!hasUpdated) {
+            break;
+        }
+    }
+
+    parallelFor(kZeroSize, faces.size(), [&](size_t n) { m(faces[n]) = 0; });
+}
+
+}  // namespace
+
 LevelSetLiquidSolver3::LevelSetLiquidSolver3()
 : LevelSetLiquidSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {
 }
@@ -55,6 +158,24 @@ void LevelSetLiquidSolver3::setIsGlobalCompensationEnabled(bool isEnabled) {
     _isGlobalCompensationEnabled = isEnabled;
 }
 
+double LevelSetLiquidSolver3::narrowBandWidth() const {
+    return _narrowBandWidth;
+}
+
+void LevelSetLiquidSolver3::setNarrowBandWidth(double widthInCells) {
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        widthInCells > 0.0 && widthInCells < 1.0,
+        "The narrow band should be at least one cell wide.");
+
+    _narrowBandWidth = std::max(widthInCells, 0.0);
+    _narrowBandDataPoints.clear();
+}
+
+const std::vector<Point3UI>&
+LevelSetLiquidSolver3::narrowBandDataPoints() const {
+    return _narrowBandDataPoints;
+}
+
 double LevelSetLiquidSolver3::computeVolume() const {
     auto sdf = signedDistanceField();
     const Vector3D gridSpacing = sdf->gridSpacing();
@@ -96,24 +217,84 @@ void LevelSetLiquidSolver3::onEndAdvanceTimeStep(double timeIntervalInSeconds) {
              << "Volume diff: " << volDiff;
 
     if (_isGlobalCompensationEnabled) {
-        addVolume(-volDiff);
+        const double shift = addVolume(-volDiff);
+
+        // The shift moves the interface away from the current band.
+        const Vector3D gridSpacing = signedDistanceField()->gridSpacing();
+        const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+        _narrowBandDrift += std::fabs(shift) / h;
 
         currentVol = computeVolume();
         JET_INFO << "Volume after global compensation: " << currentVol;
     }
+
+    if (_narrowBandWidth > 0.0) {
+        clampToNarrowBand(currentCfl);
+    }
+}
+
+void LevelSetLiquidSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    GridFluidSolver3::onSaveCheckpoint(checkpoint);
+
+    checkpoint->setValue("LevelSetLiquidSolver3/minReinitializeDistance",
+                         _minReinitializeDistance);
+    checkpoint->setValue("LevelSetLiquidSolver3/isGlobalCompensationEnabled",
+                         _isGlobalCompensationEnabled);
+    checkpoint->setValue("LevelSetLiquidSolver3/lastKnownVolume",
+                         _lastKnownVolume);
+    checkpoint->setValue("LevelSetLiquidSolver3/narrowBandWidth",
+                         _narrowBandWidth);
+}
+
+void LevelSetLiquidSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    GridFluidSolver3::onLoadCheckpoint(checkpoint);
+
+    checkpoint.getValue("LevelSetLiquidSolver3/minReinitializeDistance",
+                        &_minReinitializeDistance);
+    checkpoint.getValue("LevelSetLiquidSolver3/isGlobalCompensationEnabled",
+                        &_isGlobalCompensationEnabled);
+    checkpoint.getValue("LevelSetLiquidSolver3/lastKnownVolume",
+                        &_lastKnownVolume);
+
+    // The band is rebuilt from the restored signed-distance field.
+    double narrowBandWidth = _narrowBandWidth;
+    checkpoint.getValue("LevelSetLiquidSolver3/narrowBandWidth",
+                        &narrowBandWidth);
+    setNarrowBandWidth(narrowBandWidth);
 }
 
 void LevelSetLiquidSolver3::computeAdvection(double timeIntervalInSeconds) {
     double currentCfl = cfl(timeIntervalInSeconds);
 
     Timer timer;
-    extrapolateVelocityToAir(currentCfl);
+    if (_narrowBandWidth > 0.0) {
+        updateNarrowBand(currentCfl);
+        JET_INFO << "narrow band update took " << timer.durationInSeconds()
+                 << " seconds";
+
+        timer.reset();
+        extrapolateVelocityToAirInNarrowBand(currentCfl);
+    } else {
+        extrapolateVelocityToAir(currentCfl);
+    }
     JET_INFO << "velocity extrapolation took "
              << timer.durationInSeconds() << " seconds";
 
+    if (_narrowBandWidth > 0.0) {
+        timer.reset();
+        advectNarrowBand(timeIntervalInSeconds);
+        JET_INFO << "narrow band advection of " << _narrowBandDataPoints.size()
+                 << " data points took " << timer.durationInSeconds()
+                 << " seconds";
+    }
+
     GridFluidSolver3::computeAdvection(timeIntervalInSeconds);
 }
 
+bool LevelSetLiquidSolver3::shouldAdvectScalarData(size_t index) const {
+    return _narrowBandWidth <= 0.0 || index != _signedDistanceFieldId;
+}
+
 ScalarField3Ptr LevelSetLiquidSolver3::fluidSdf() const {
     return signedDistanceField();
 }
@@ -123,10 +304,7 @@ void LevelSetLiquidSolver3::reinitialize(double currentCfl) {
         auto sdf = signedDistanceField();
         auto sdf0 = sdf->clone();
 
-        const Vector3D gridSpacing = sdf->gridSpacing();
-        const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
-        const double maxReinitDist
-            = std::max(2.0 * currentCfl, _minReinitializeDistance) * h;
+        const double maxReinitDist = maxLevelSetDistance(currentCfl);
 
         _levelSetSolver->reinitialize(
             *sdf0, maxReinitDist, sdf.get());
@@ -134,6 +312,154 @@ void LevelSetLiquidSolver3::reinitialize(double currentCfl) {
     }
 }
 
+double LevelSetLiquidSolver3::maxLevelSetDistance(double currentCfl) const {
+    const Vector3D gridSpacing = signedDistanceField()->gridSpacing();
+    const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+    if (_narrowBandWidth > 0.0) {
+        return narrowBandWidthInCells(currentCfl) * h;
+    } else {
+        return std::max(2.0 * currentCfl, _minReinitializeDistance) * h;
+    }
+}
+
+double LevelSetLiquidSolver3::narrowBandWidthInCells(double currentCfl) const {
+    // The interface moves up to the CFL number of cells in a time-step, so
+    // the band should be wider than that. Using the max CFL as well keeps
+    // the width the same from step to step.
+    return std::max(_narrowBandWidth,
+                    std::ceil(std::max(maxCfl(), currentCfl)) + 1.0);
+}
+
+void LevelSetLiquidSolver3::updateNarrowBand(double currentCfl) {
+    auto sdf = signedDistanceField();
+    auto sdfAcc = sdf->constDataAccessor();
+    const Size3 size = sdf->dataSize();
+    const Vector3D gridSpacing = sdf->gridSpacing();
+    const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+    const double widthInCells = narrowBandWidthInCells(currentCfl);
+    const double width = widthInCells * h;
+
+    if (_narrowBandMarker.size() != size || _narrowBandDataPoints.empty() ||
+        emitter() != nullptr) {
+        // Collect the band of each z-slice in parallel, then concatenate them
+        // so that the list keeps the memory order of the grid.
+        std::vector<std::vector<Point3UI>> slices(size.z);
+        parallelFor(kZeroSize, size.z, [&](size_t k) {
+            for (size_t j = 0; j < size.y; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    if (std::fabs(sdfAcc(i, j, k)) < width) {
+                        slices[k].emplace_back(i, j, k);
+                    }
+                }
+            }
+        });
+
+        _narrowBandDataPoints.clear();
+        for (const auto& slice : slices) {
+            _narrowBandDataPoints.insert(_narrowBandDataPoints.end(),
+                                         slice.begin(), slice.end());
+        }
+        _narrowBandMarker.resize(size, 0);
+    } else {
+        // Any point of the new band is closer to the previous band than the
+        // distance the interface has moved plus the growth of the width.
+        const double growth = std::max(widthInCells - _lastNarrowBandWidth,
+                                       0.0);
+        const size_t numberOfLayers =
+            static_cast<size_t>(std::ceil(_narrowBandDrift + growth)) + 1;
+        dilateNarrowBand(numberOfLayers, &_narrowBandDataPoints);
+
+        _narrowBandDataPoints.erase(
+            std::remove_if(_narrowBandDataPoints.begin(),
+                           _narrowBandDataPoints.end(),
+                           [&](const Point3UI& pt) {
+                               return std::fabs(sdfAcc(pt)) >= width;
+                           }),
+            _narrowBandDataPoints.end());
+        std::sort(_narrowBandDataPoints.begin(), _narrowBandDataPoints.end(),
+                  [](const Point3UI& a, const Point3UI& b) {
+                      return std::make_tuple(a.z, a.y, a.x) <
+                             std::make_tuple(b.z, b.y, b.x);
+                  });
+    }
+
+    _lastNarrowBandWidth = widthInCells;
+    _narrowBandDrift = 0.0;
+}
+
+void LevelSetLiquidSolver3::dilateNarrowBand(
+    size_t numberOfLayers, std::vector<Point3UI>* dataPoints) {
+    const Size3 size = _narrowBandMarker.size();
+    std::vector<Point3UI>& points = *dataPoints;
+
+    // Grow the list layer by layer with the 26 neighbors of the last layer,
+    // so that it covers every point within the given number of cells along
+    // each axis. The marker is cleared again at the end.
+    for (const Point3UI& pt : points) {
+        _narrowBandMarker(pt) = 1;
+    }
+
+    size_t layerBegin = 0;
+    for (size_t layer = 0; layer < numberOfLayers; ++layer) {
+        const size_t layerEnd = points.size();
+        for (size_t n = layerBegin; n < layerEnd; ++n) {
+            const Point3UI pt = points[n];
+            const size_t kBegin = (pt.z > 0) ? pt.z - 1 : 0;
+            const size_t jBegin = (pt.y > 0) ? pt.y - 1 : 0;
+            const size_t iBegin = (pt.x > 0) ? pt.x - 1 : 0;
+            const size_t kEnd = std::min(pt.z + 2, size.z);
+            const size_t jEnd = std::min(pt.y + 2, size.y);
+            const size_t iEnd = std::min(pt.x + 2, size.x);
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    for (size_t i = iBegin; i < iEnd; ++i) {
+                        char& marker = _narrowBandMarker(i, j, k);
+                        if (marker == 0) {
+                            marker = 1;
+                            points.emplace_back(i, j, k);
+                        }
+                    }
+                }
+            }
+        }
+        layerBegin = layerEnd;
+    }
+
+    for (const Point3UI& pt : points) {
+        _narrowBandMarker(pt) = 0;
+    }
+}
+
+void LevelSetLiquidSolver3::advectNarrowBand(double timeIntervalInSeconds) {
+    auto solver = advectionSolver();
+    if (solver == nullptr) {
+        return;
+    }
+
+    auto sdf = signedDistanceField();
+    auto sdf0 = sdf->clone();
+    solver->advectDataPoints(*sdf0, *gridSystemData()->velocity(),
+                             timeIntervalInSeconds, _narrowBandDataPoints,
+                             sdf.get(), *colliderSdf());
+    extrapolateIntoCollider(sdf.get());
+
+    // The advection moves the interface away from the current band.
+    _narrowBandDrift += cfl(timeIntervalInSeconds);
+}
+
+void LevelSetLiquidSolver3::clampToNarrowBand(double currentCfl) {
+    auto sdf = signedDistanceField();
+    const Vector3D gridSpacing = sdf->gridSpacing();
+    const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+    const double width = narrowBandWidthInCells(currentCfl) * h;
+
+    sdf->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        double& phi = (*sdf)(i, j, k);
+        phi = clamp(phi, -width, width);
+    });
+}
+
 void LevelSetLiquidSolver3::extrapolateVelocityToAir(double currentCfl) {
     auto sdf = signedDistanceField();
     auto vel = gridSystemData()->velocity();
@@ -176,20 +502,55 @@ void LevelSetLiquidSolver3::extrapolateVelocityToAir(double currentCfl) {
         }
     });
 
-    const Vector3D gridSpacing = sdf->gridSpacing();
-    const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
-    const double maxDist
-        = std::max(2.0 * currentCfl, _minReinitializeDistance) * h;
+    const double maxDist = maxLevelSetDistance(currentCfl);
 
     JET_INFO << "Max velocity extrapolation distance: " << maxDist;
 
-    FmmLevelSetSolver3 fmmSolver;
-    fmmSolver.extrapolate(*vel, *sdf, maxDist, vel.get());
+    // The fast sweeping solver can replace the fast marching method for the
+    // extrapolation as well.
+    LevelSetSolver3Ptr extrapolationSolver =
+        std::dynamic_pointer_cast<FastSweepingLevelSetSolver3>(_levelSetSolver);
+    if (extrapolationSolver == nullptr) {
+        extrapolationSolver = std::make_shared<FmmLevelSetSolver3>();
+    }
+    extrapolationSolver->extrapolate(*vel, *sdf, maxDist, vel.get());
 
     applyBoundaryCondition();
 }
 
-void LevelSetLiquidSolver3::addVolume(double volDiff) {
+void LevelSetLiquidSolver3::extrapolateVelocityToAirInNarrowBand(
+    double currentCfl) {
+    auto sdf = signedDistanceField();
+    auto vel = gridSystemData()->velocity();
+
+    // The band advection traces back up to the CFL number of cells, so the
+    // velocity is extrapolated over that many more layers around the band.
+    std::vector<Point3UI> cells = _narrowBandDataPoints;
+    const size_t numberOfCflLayers =
+        static_cast<size_t>(std::ceil(currentCfl));
+    dilateNarrowBand(numberOfCflLayers, &cells);
+
+    const unsigned int numberOfLayers = static_cast<unsigned int>(
+        std::ceil(narrowBandWidthInCells(currentCfl)) + numberOfCflLayers);
+
+    JET_INFO << "Velocity extrapolation over " << numberOfLayers
+             << " layers around " << cells.size() << " cells";
+
+    const Size3 size = sdf->dataSize();
+    extrapolateToAirAtFaces(cells, size, 0, *sdf, vel->uPosition(),
+                            numberOfLayers, vel->uAccessor(),
+                            &_narrowBandFaceMarkers[0]);
+    extrapolateToAirAtFaces(cells, size, 1, *sdf, vel->vPosition(),
+                            numberOfLayers, vel->vAccessor(),
+                            &_narrowBandFaceMarkers[1]);
+    extrapolateToAirAtFaces(cells, size, 2, *sdf, vel->wPosition(),
+                            numberOfLayers, vel->wAccessor(),
+                            &_narrowBandFaceMarkers[2]);
+
+    applyBoundaryCondition();
+}
+
+double LevelSetLiquidSolver3::addVolume(double volDiff) {
     auto sdf = signedDistanceField();
     const Vector3D gridSpacing = sdf->gridSpacing();
     const double cellVolume = gridSpacing.x * gridSpacing.y * gridSpacing.z;
@@ -212,7 +573,11 @@ void LevelSetLiquidSolver3::addVolume(double volDiff) {
         sdf->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
             (*sdf)(i, j, k) += dist;
         });
+
+        return dist;
     }
+
+    return 0.0;
 }
 
 LevelSetLiquidSolver3::Builder LevelSetLiquidSolver3::builder() {
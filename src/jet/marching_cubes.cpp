@@ -22,13 +22,17 @@
 #include <marching_cubes_table.h>
 #include <marching_squares_table.h>
 
+#include <jet/array3.h>
 #include <jet/bounding_box2.h>
 #include <jet/bounding_box3.h>
 #include <jet/level_set_utils.h>
 #include <jet/marching_cubes.h>
+#include <jet/parallel.h>
 
+#include <algorithm>
 #include <array>
 #include <unordered_map>
+#include <vector>
 
 namespace jet {
 
@@ -254,108 +258,325 @@ static void singleSquare(
     }
 }
 
-static void singleCube(
-    const std::array<double, 8>& data,
-    const std::array<size_t, 12>& edgeIds,
-    const std::array<Vector3D, 8>& normals,
-    const BoundingBox3D& bound,
-    MarchingCubeVertexMap* vertexMap,
-    TriangleMesh3* mesh,
-    double isoValue) {
-    int itrVertex, itrEdge, itrTri;
-    int idxFlagSize = 0, idxEdgeFlags = 0;
-    int idxVertexOfTheEdge[2];
+// Number of cells along each axis of the coarse min/max blocks
+static const size_t kMarchingCubesBlockSize = 8;
+
+// Cube-local edge to (axis, i offset, j offset, k offset) of the grid edge.
+// See edgeConnection in marching_cubes_table.h for the edge ordering.
+static const int cubeEdgeToGridEdge[12][4] = {
+    {0, 0, 0, 0}, {2, 1, 0, 0}, {0, 0, 0, 1}, {2, 0, 0, 0},
+    {0, 0, 1, 0}, {2, 1, 1, 0}, {0, 0, 1, 1}, {2, 0, 1, 0},
+    {1, 0, 0, 0}, {1, 1, 0, 0}, {1, 1, 0, 1}, {1, 0, 0, 1}
+};
+
+// Cube vertex ordering to grid offsets
+static const int cubeVertexToGridPoint[8][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1},
+    {0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1}
+};
+
+// Coarse grid of blocks of cells which records whether the iso-surface can
+// pass through each block, based on the min/max of the block corners.
+class MarchingCubeBlocks {
+ public:
+    MarchingCubeBlocks(
+        const ConstArrayAccessor3<double>& grid,
+        double isoValue) {
+        const Size3 dim = grid.size();
+        _numberOfCells = Size3(dim.x - 1, dim.y - 1, dim.z - 1);
+        _hasSurface.resize(
+            numberOfBlocks(_numberOfCells.x),
+            numberOfBlocks(_numberOfCells.y),
+            numberOfBlocks(_numberOfCells.z));
+
+        _hasSurface.parallelForEachIndex([&](size_t bi, size_t bj, size_t bk) {
+            double minValue = kMaxD;
+            double maxValue = -kMaxD;
+            for (size_t k = cellBegin(bk); k <= cellEnd(bk, 2); ++k) {
+                for (size_t j = cellBegin(bj); j <= cellEnd(bj, 1); ++j) {
+                    for (size_t i = cellBegin(bi); i <= cellEnd(bi, 0); ++i) {
+                        minValue = std::min(minValue, grid(i, j, k));
+                        maxValue = std::max(maxValue, grid(i, j, k));
+                    }
+                }
+            }
 
-    Vector3D pos, pos0, pos1, normal, normal0, normal1;
-    double phi0, phi1;
-    double alpha;
-    Vector3D e[12], n[12];
+            // A cube is active only if some corners are inside (<= iso) and
+            // some are outside (> iso).
+            _hasSurface(bi, bj, bk)
+                = (minValue <= isoValue && maxValue > isoValue);
+        });
+    }
 
-    // Which vertices are inside? If i-th vertex is inside, mark '1' at i-th
-    // bit. of 'idxFlagSize'.
-    for (itrVertex = 0; itrVertex < 8; itrVertex++) {
-        if (data[itrVertex] <= isoValue) {
-            idxFlagSize |= 1 << itrVertex;
-        }
+    Size3 size() const { return _hasSurface.size(); }
+
+    bool hasSurface(size_t bi, size_t bj, size_t bk) const {
+        return _hasSurface(bi, bj, bk) != 0;
     }
 
-    // If the cube is entirely inside or outside of the surface, there is no job
-    // to be done in t1his marching-cube cell.
-    if (idxFlagSize == 0 || idxFlagSize == 255) {
-        return;
+    // Returns the block which contains the grid point p along the axis.
+    size_t pointBlock(size_t p, size_t axis) const {
+        return std::min(
+            p / kMarchingCubesBlockSize, _hasSurface.size()[axis] - 1);
     }
 
-    // If there are vertices which is inside the surface...
-    // Which edges intersect the surface? If i-th edge intersects the surface,
-    // mark '1' at i-th bit of 'itrEdgeFlags'
-    idxEdgeFlags = cubeEdgeFlags[idxFlagSize];
+    size_t cellBegin(size_t b) const {
+        return b * kMarchingCubesBlockSize;
+    }
 
-    // Find the point of intersection of the surface with each edge
-    for (itrEdge = 0; itrEdge < 12; itrEdge++) {
-        // If there is an intersection on this edge
-        if (idxEdgeFlags & (1 << itrEdge)) {
-            idxVertexOfTheEdge[0] = edgeConnection[itrEdge][0];
-            idxVertexOfTheEdge[1] = edgeConnection[itrEdge][1];
+    // Returns the end of the cells in the block, which is also the last grid
+    // point in the block.
+    size_t cellEnd(size_t b, size_t axis) const {
+        return std::min(
+            (b + 1) * kMarchingCubesBlockSize, _numberOfCells[axis]);
+    }
 
-            // cube vertex ordering to x-major ordering
-            static int indexMap[8] = {0, 1, 5, 4, 2, 3, 7, 6};
+    // Returns the end of the grid points assigned to the block. The last
+    // block along each axis also owns the last grid point.
+    size_t pointEnd(size_t b, size_t axis) const {
+        if (b + 1 == _hasSurface.size()[axis]) {
+            return _numberOfCells[axis] + 1;
+        } else {
+            return cellEnd(b, axis);
+        }
+    }
 
-            // Find the phi = 0 position
-            pos0 = bound.corner(indexMap[idxVertexOfTheEdge[0]]);
-            pos1 = bound.corner(indexMap[idxVertexOfTheEdge[1]]);
+ private:
+    Size3 _numberOfCells;
+    Array3<char> _hasSurface;
 
-            normal0 = normals[idxVertexOfTheEdge[0]];
-            normal1 = normals[idxVertexOfTheEdge[1]];
+    static size_t numberOfBlocks(size_t numberOfCells) {
+        return (numberOfCells + kMarchingCubesBlockSize - 1)
+            / kMarchingCubesBlockSize;
+    }
+};
+
+// Invokes func(axis, i, j) for each grid edge on the k-th plane of the grid
+// points which crosses the iso-surface. The x- and y-edges on the plane are
+// visited first, followed by the z-edges between the k-th and (k+1)-th
+// planes. The visiting order is fixed so that it can be used to assign
+// consecutive vertex indices.
+template <typename Callback>
+static void forEachCrossingEdgeOnPlane(
+    const ConstArrayAccessor3<double>& grid,
+    const MarchingCubeBlocks& blocks,
+    double isoValue,
+    size_t k,
+    bool includeZEdges,
+    const Callback& func) {
+    const Size3 dim = grid.size();
+    const size_t numBlocksX = blocks.size().x;
 
-            phi0 = data[idxVertexOfTheEdge[0]] - isoValue;
-            phi1 = data[idxVertexOfTheEdge[1]] - isoValue;
+    auto isCrossing = [&](double phi0, double phi1) {
+        return (phi0 <= isoValue) != (phi1 <= isoValue);
+    };
 
-            alpha = distanceToZeroLevelSet(phi0, phi1);
+    const size_t bk = blocks.pointBlock(k, 2);
+    for (size_t j = 0; j < dim.y; ++j) {
+        const size_t bj = blocks.pointBlock(j, 1);
+        for (size_t bi = 0; bi < numBlocksX; ++bi) {
+            if (!blocks.hasSurface(bi, bj, bk)) {
+                continue;
+            }
+            for (size_t i = blocks.cellBegin(bi);
+                 i < blocks.cellEnd(bi, 0); ++i) {
+                if (isCrossing(grid(i, j, k), grid(i + 1, j, k))) {
+                    func(0, i, j);
+                }
+            }
+        }
+    }
 
-            if (alpha < 0.000001) {
-                alpha = 0.000001;
+    for (size_t j = 0; j + 1 < dim.y; ++j) {
+        const size_t bj = j / kMarchingCubesBlockSize;
+        for (size_t bi = 0; bi < numBlocksX; ++bi) {
+            if (!blocks.hasSurface(bi, bj, bk)) {
+                continue;
             }
-            if (alpha > 0.999999) {
-                alpha = 0.999999;
+            for (size_t i = blocks.cellBegin(bi);
+                 i < blocks.pointEnd(bi, 0); ++i) {
+                if (isCrossing(grid(i, j, k), grid(i, j + 1, k))) {
+                    func(1, i, j);
+                }
             }
+        }
+    }
 
-            pos = (1.0 - alpha) * pos0 + alpha * pos1;
-            normal = (1.0 - alpha) * normal0 + alpha * normal1;
+    if (!includeZEdges || k + 1 >= dim.z) {
+        return;
+    }
 
-            e[itrEdge] = pos;
-            n[itrEdge] = normal;
+    const size_t bkz = k / kMarchingCubesBlockSize;
+    for (size_t j = 0; j < dim.y; ++j) {
+        const size_t bj = blocks.pointBlock(j, 1);
+        for (size_t bi = 0; bi < numBlocksX; ++bi) {
+            if (!blocks.hasSurface(bi, bj, bkz)) {
+                continue;
+            }
+            for (size_t i = blocks.cellBegin(bi);
+                 i < blocks.pointEnd(bi, 0); ++i) {
+                if (isCrossing(grid(i, j, k), grid(i, j, k + 1))) {
+                    func(2, i, j);
+                }
+            }
         }
     }
+}
+
+// Extracts the triangles from the cells in parallel. Each crossing grid edge
+// gets exactly one vertex whose index is determined by counting the crossing
+// edges per plane of the grid points, so the vertices are welded without any
+// global map and the output does not depend on the number of threads.
+static void marchCells(
+    const ConstArrayAccessor3<double>& grid,
+    const Vector3D& gridSize,
+    const Vector3D& origin,
+    TriangleMesh3* mesh,
+    double isoValue) {
+    const Size3 dim = grid.size();
+    if (dim.x < 2 || dim.y < 2 || dim.z < 2) {
+        return;
+    }
 
-    // Make triangles
-    for (itrTri = 0; itrTri < 5; ++itrTri) {
-        // If there isn't any triangle to be made, escape this loop.
-        if (triangleConnectionTable3D[idxFlagSize][3 * itrTri] < 0) {
-            break;
-        }
+    const Vector3D invGridSize = 1.0 / gridSize;
+    const MarchingCubeBlocks blocks(grid, isoValue);
+
+    // Count the crossing edges per plane and assign the vertex offsets.
+    std::vector<size_t> vertexOffsets(dim.z + 1, 0);
+    parallelFor(kZeroSize, dim.z, [&](size_t k) {
+        size_t count = 0;
+        forEachCrossingEdgeOnPlane(
+            grid, blocks, isoValue, k, true,
+            [&](size_t, size_t, size_t) { ++count; });
+        vertexOffsets[k + 1] = count;
+    });
+    for (size_t k = 0; k < dim.z; ++k) {
+        vertexOffsets[k + 1] += vertexOffsets[k];
+    }
 
-        Point3UI face;
+    const size_t numberOfVertices = vertexOffsets[dim.z];
+    Array1<Vector3D> points(numberOfVertices);
+    Array1<Vector3D> normals(numberOfVertices);
+    std::vector<std::vector<Point3UI>> slabTriangles(dim.z - 1);
+
+    // Triangulates slab k using edgeIds to store the vertex indices of the
+    // crossing edges on the lower and upper planes of the slab.
+    auto marchSlab = [&](size_t k, std::vector<size_t> (&edgeIds)[2][3]) {
+        // Computes the vertex on the crossing edge starting from (i, j, kk).
+        auto computeVertex = [&](size_t vId, size_t axis, size_t i, size_t j,
+                                 size_t kk) {
+            const size_t i1 = (axis == 0) ? i + 1 : i;
+            const size_t j1 = (axis == 1) ? j + 1 : j;
+            const size_t k1 = (axis == 2) ? kk + 1 : kk;
+
+            double alpha = distanceToZeroLevelSet(
+                grid(i, j, kk) - isoValue, grid(i1, j1, k1) - isoValue);
+            alpha = clamp(alpha, 0.000001, 0.999999);
+
+            const Vector3D pos0 = origin + gridSize * Vector3D(i, j, kk);
+            const Vector3D pos1 = origin + gridSize * Vector3D(i1, j1, k1);
+            const Vector3D normal0 = grad(grid, i, j, kk, invGridSize);
+            const Vector3D normal1 = grad(grid, i1, j1, k1, invGridSize);
+
+            points[vId] = (1.0 - alpha) * pos0 + alpha * pos1;
+            normals[vId] = safeNormalize(
+                (1.0 - alpha) * normal0 + alpha * normal1);
+        };
+
+        // Number the edges of the lower plane and compute their vertices.
+        size_t vId = vertexOffsets[k];
+        forEachCrossingEdgeOnPlane(
+            grid, blocks, isoValue, k, true,
+            [&](size_t axis, size_t i, size_t j) {
+                edgeIds[0][axis][i + dim.x * j] = vId;
+                computeVertex(vId++, axis, i, j, k);
+            });
+
+        // Number the x- and y-edges of the upper plane which come first in
+        // the visiting order of that plane. The vertices are computed by the
+        // next slab, except for the last plane.
+        const bool isLastSlab = (k + 2 == dim.z);
+        vId = vertexOffsets[k + 1];
+        forEachCrossingEdgeOnPlane(
+            grid, blocks, isoValue, k + 1, false,
+            [&](size_t axis, size_t i, size_t j) {
+                edgeIds[1][axis][i + dim.x * j] = vId;
+                if (isLastSlab) {
+                    computeVertex(vId, axis, i, j, k + 1);
+                }
+                ++vId;
+            });
+
+        std::vector<Point3UI>& triangles = slabTriangles[k];
+        const size_t bk = k / kMarchingCubesBlockSize;
+        for (size_t j = 0; j + 1 < dim.y; ++j) {
+            const size_t bj = j / kMarchingCubesBlockSize;
+            for (size_t bi = 0; bi < blocks.size().x; ++bi) {
+                if (!blocks.hasSurface(bi, bj, bk)) {
+                    continue;
+                }
 
-        for (int j = 0; j < 3; j++) {
-            int k = 3 * itrTri + j;
-            MarchingCubeVertexHashKey vKey
-                = edgeIds[triangleConnectionTable3D[idxFlagSize][k]];
-            MarchingCubeVertexId vId;
-            if (queryVertexId(*vertexMap, vKey, &vId)) {
-                face[j] = vId;
-            } else {
-                // If vertex does not exist from the map
-                face[j] = mesh->numberOfPoints();
-                mesh->addNormal(
-                    safeNormalize(
-                        n[triangleConnectionTable3D[idxFlagSize][k]]));
-                mesh->addPoint(
-                    e[triangleConnectionTable3D[idxFlagSize][k]]);
-                mesh->addUv(Vector2D());
-                vertexMap->insert(std::make_pair(vKey, face[j]));
+                for (size_t i = blocks.cellBegin(bi);
+                     i < blocks.cellEnd(bi, 0); ++i) {
+                    // Which vertices are inside? If i-th vertex is inside,
+                    // mark '1' at i-th bit.
+                    int idxFlagSize = 0;
+                    for (int v = 0; v < 8; ++v) {
+                        const int* o = cubeVertexToGridPoint[v];
+                        if (grid(i + o[0], j + o[1], k + o[2]) <= isoValue) {
+                            idxFlagSize |= 1 << v;
+                        }
+                    }
+
+                    if (idxFlagSize == 0 || idxFlagSize == 255) {
+                        continue;
+                    }
+
+                    const int* table = triangleConnectionTable3D[idxFlagSize];
+                    for (int t = 0; t < 5 && table[3 * t] >= 0; ++t) {
+                        Point3UI face;
+                        for (int v = 0; v < 3; ++v) {
+                            const int* e = cubeEdgeToGridEdge[table[3 * t + v]];
+                            face[v] = edgeIds[e[3]][e[0]][
+                                (i + e[1]) + dim.x * (j + e[2])];
+                        }
+                        triangles.push_back(face);
+                    }
+                }
             }
         }
-        mesh->addPointUvNormalTriangle(face, face, face);
+    };
+
+    // The edge buffers are allocated once per range of slabs. The entries of
+    // the edges which do not cross the surface are never read, so they are
+    // not reset between the slabs.
+    const size_t planeSize = dim.x * dim.y;
+    parallelRangeFor(kZeroSize, dim.z - 1, [&](size_t kBegin, size_t kEnd) {
+        std::vector<size_t> edgeIds[2][3];
+        for (int plane = 0; plane < 2; ++plane) {
+            for (int axis = 0; axis < 3; ++axis) {
+                edgeIds[plane][axis].resize(planeSize);
+            }
+        }
+
+        for (size_t k = kBegin; k < kEnd; ++k) {
+            marchSlab(k, edgeIds);
+        }
+    });
+
+    // Deterministic compaction into the mesh in the slab order
+    const size_t base = mesh->numberOfPoints();
+    for (size_t v = 0; v < numberOfVertices; ++v) {
+        mesh->addPoint(points[v]);
+        mesh->addNormal(normals[v]);
+        mesh->addUv(Vector2D());
+    }
+
+    for (const auto& triangles : slabTriangles) {
+        for (const Point3UI& tri : triangles) {
+            Point3UI face(tri.x + base, tri.y + base, tri.z + base);
+            mesh->addPointUvNormalTriangle(face, face, face);
+        }
     }
 }
 
@@ -369,7 +590,6 @@ void marchingCubes(
     MarchingCubeVertexMap vertexMap;
 
     const Size3 dim = grid.size();
-    const Vector3D invGridSize = 1.0 / gridSize;
 
     auto pos = [origin, gridSize](ssize_t i, ssize_t j, ssize_t k) {
         return origin + gridSize * Vector3D({i, j, k});
@@ -379,53 +599,9 @@ void marchingCubes(
     ssize_t dimy = static_cast<ssize_t>(dim.y);
     ssize_t dimz = static_cast<ssize_t>(dim.z);
 
-    for (ssize_t k = 0; k < dimz - 1; ++k) {
-        for (ssize_t j = 0; j < dimy - 1; ++j) {
-            for (ssize_t i = 0; i < dimx - 1; ++i) {
-                std::array<double, 8> data;
-                std::array<size_t, 12> edgeIds;
-                std::array<Vector3D, 8>  normals;
-                BoundingBox3D bound;
-
-                data[0] = grid(i, j, k);
-                data[1] = grid(i + 1, j, k);
-                data[4] = grid(i, j + 1, k);
-                data[5] = grid(i + 1, j + 1, k);
-                data[3] = grid(i, j, k + 1);
-                data[2] = grid(i + 1, j, k + 1);
-                data[7] = grid(i, j + 1, k + 1);
-                data[6] = grid(i + 1, j + 1, k + 1);
-
-                normals[0] = grad(grid, i, j, k, invGridSize);
-                normals[1] = grad(grid, i + 1, j, k, invGridSize);
-                normals[4] = grad(grid, i, j + 1, k, invGridSize);
-                normals[5] = grad(grid, i + 1, j + 1, k, invGridSize);
-                normals[3] = grad(grid, i, j, k + 1, invGridSize);
-                normals[2] = grad(grid, i + 1, j, k + 1, invGridSize);
-                normals[7] = grad(grid, i, j + 1, k + 1, invGridSize);
-                normals[6] = grad(grid, i + 1, j + 1, k + 1, invGridSize);
-
-                for (int e = 0; e < 12; e++) {
-                    edgeIds[e] = globalEdgeId(i, j, k, dim, e);
-                }
-
-                bound.lowerCorner = pos(i, j, k);
-                bound.upperCorner = pos(i + 1, j + 1, k + 1);
-
-                singleCube(
-                    data,
-                    edgeIds,
-                    normals,
-                    bound,
-                    &vertexMap,
-                    mesh,
-                    isoValue);
-            }  // i
-        }  // j
-    }  // k
+    marchCells(grid, gridSize, origin, mesh, isoValue);
 
     // Construct boundaries parallel to x-y plane
-    vertexMap.clear();
     if (bndFlag
         & (kDirectionBack | kDirectionFront)) {
         for (ssize_t j = 0; j < dimy-1; ++j) {
@@ -14,6 +14,8 @@
 # include <tbb/task_scheduler_init.h>
 #elif defined(JET_TASKING_OPENMP)
 # include <omp.h>
+#elif defined(JET_TASKING_CPP11THREADS)
+# include <jet/thread_pool.h>
 #endif
 
 static unsigned int sMaxNumberOfThreads = std::thread::hardware_concurrency();
@@ -31,6 +33,9 @@ void setMaxNumberOfThreads(unsigned int numThreads) {
     }
 #elif defined(JET_TASKING_OPENMP)
     omp_set_num_threads(numThreads);
+#elif defined(JET_TASKING_CPP11THREADS)
+    // The calling thread also works on parallel loops, hence one less worker.
+    ThreadPool::defaultPool().resize(std::max(numThreads, 1u) - 1);
 #endif
     sMaxNumberOfThreads = std::max(numThreads, 1u);
 }
@@ -0,0 +1,547 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/array_utils.h>
+#include <jet/constants.h>
+#include <jet/math_utils.h>
+#include <jet/particle_cache3.h>
+
+#ifdef JET_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+using namespace jet;
+
+namespace {
+
+// The file starts with FileHeader, followed by a ChannelHeader for every
+// scalar data, vector data and the particle IDs in that order. The channel
+// blocks follow the table, each aligned to kBlockAlignment bytes. All the
+// values are stored in the byte order of the machine which wrote the file.
+const char kMagic[8] = {'J', 'E', 'T', 'P', 'C', 'A', '3', '\0'};
+const uint32_t kVersion = 1;
+const uint64_t kBlockAlignment = 64;
+const size_t kChunkSize = 1 << 16;  // Values per quantized chunk
+const double kQuantizationLevels = 65535.0;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t numberOfParticles;
+    uint32_t numberOfScalarData;
+    uint32_t numberOfVectorData;
+    uint32_t positionIdx;
+    uint32_t velocityIdx;
+    uint32_t forceIdx;
+    uint32_t padding;
+    double radius;
+    double mass;
+    uint64_t nextParticleId;
+};
+
+struct ChannelHeader {
+    uint32_t numberOfComponents;
+    uint32_t encoding;
+    uint64_t offset;
+    uint64_t size;
+    double lower[3];
+    double upper[3];
+};
+
+static_assert(sizeof(Vector3D) == 3 * sizeof(double),
+              "Vector3D should be packed to be mapped from the cache");
+static_assert(sizeof(size_t) == sizeof(uint64_t),
+              "Particle IDs are mapped as 64-bit integers");
+
+uint64_t alignBlock(uint64_t offset) {
+    return (offset + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+}
+
+// Finds the vector data layer that shares the storage with the given array.
+size_t findVectorData(const ParticleSystemData3& particles,
+                      const ConstArrayAccessor1<Vector3D>& data,
+                      size_t fallback) {
+    if (particles.numberOfParticles() == 0) {
+        return fallback;
+    }
+    for (size_t i = 0; i < particles.numberOfVectorData(); ++i) {
+        if (particles.vectorDataAt(i).data() == data.data()) {
+            return i;
+        }
+    }
+    return fallback;
+}
+
+void computeBounds(const double* values, size_t numberOfValues,
+                   uint32_t numberOfComponents, ChannelHeader* channel) {
+    for (uint32_t c = 0; c < numberOfComponents; ++c) {
+        double lower = kMaxD;
+        double upper = -kMaxD;
+        for (size_t i = c; i < numberOfValues; i += numberOfComponents) {
+            lower = std::min(lower, values[i]);
+            upper = std::max(upper, values[i]);
+        }
+        channel->lower[c] = (lower <= upper) ? lower : 0.0;
+        channel->upper[c] = (lower <= upper) ? upper : 0.0;
+    }
+}
+
+void writePadding(std::ofstream* file, uint64_t size) {
+    static const char zeros[kBlockAlignment] = {};
+    file->write(zeros, static_cast<std::streamsize>(size));
+}
+
+void writeChannel(const double* values, size_t numberOfValues,
+                  const ChannelHeader& channel, std::ofstream* file) {
+    if (channel.encoding ==
+        static_cast<uint32_t>(ParticleCacheEncoding::kRaw)) {
+        file->write(reinterpret_cast<const char*>(values),
+                    static_cast<std::streamsize>(channel.size));
+        return;
+    }
+
+    double scales[3];
+    for (uint32_t c = 0; c < channel.numberOfComponents; ++c) {
+        const double range = channel.upper[c] - channel.lower[c];
+        scales[c] = (range > 0.0) ? kQuantizationLevels / range : 0.0;
+    }
+
+    std::vector<uint16_t> chunk;
+    chunk.reserve(kChunkSize * channel.numberOfComponents);
+    for (size_t begin = 0; begin < numberOfValues;
+         begin += chunk.capacity()) {
+        const size_t end =
+            std::min(begin + chunk.capacity(), numberOfValues);
+        chunk.clear();
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t c = i % channel.numberOfComponents;
+            const double q = (values[i] - channel.lower[c]) * scales[c];
+            chunk.push_back(
+                std::isfinite(q) ? static_cast<uint16_t>(clamp(
+                                       std::round(q), 0.0, kQuantizationLevels))
+                                 : 0);
+        }
+        file->write(reinterpret_cast<const char*>(chunk.data()),
+                    static_cast<std::streamsize>(chunk.size() *
+                                                 sizeof(uint16_t)));
+    }
+}
+
+template <typename T>
+void decodeChannel(const uint8_t* block, const ChannelHeader& channel,
+                   Array1<T>* decoded) {
+    double* values = reinterpret_cast<double*>(decoded->data());
+    const size_t numberOfValues = decoded->size() * channel.numberOfComponents;
+
+    double steps[3];
+    for (uint32_t c = 0; c < channel.numberOfComponents; ++c) {
+        steps[c] =
+            (channel.upper[c] - channel.lower[c]) / kQuantizationLevels;
+    }
+
+    for (size_t i = 0; i < numberOfValues; ++i) {
+        const uint32_t c = i % channel.numberOfComponents;
+        uint16_t q;
+        std::memcpy(&q, block + i * sizeof(uint16_t), sizeof(uint16_t));
+        values[i] = channel.lower[c] + q * steps[c];
+    }
+}
+
+}  // namespace
+
+ParticleCacheWriter3::ParticleCacheWriter3(ParticleCacheEncoding encoding)
+    : _encoding(encoding) {}
+
+ParticleCacheEncoding ParticleCacheWriter3::encoding() const {
+    return _encoding;
+}
+
+void ParticleCacheWriter3::setEncoding(ParticleCacheEncoding encoding) {
+    _encoding = encoding;
+}
+
+bool ParticleCacheWriter3::write(const ParticleSystemData3& particles,
+                                 const std::string& filename) const {
+    const size_t n = particles.numberOfParticles();
+    const size_t numberOfScalarData = particles.numberOfScalarData();
+    const size_t numberOfVectorData = particles.numberOfVectorData();
+
+    FileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.numberOfParticles = n;
+    header.numberOfScalarData = static_cast<uint32_t>(numberOfScalarData);
+    header.numberOfVectorData = static_cast<uint32_t>(numberOfVectorData);
+    header.positionIdx = static_cast<uint32_t>(
+        findVectorData(particles, particles.positions(), 0));
+    header.velocityIdx = static_cast<uint32_t>(
+        findVectorData(particles, particles.velocities(), 1));
+    header.forceIdx = static_cast<uint32_t>(
+        findVectorData(particles, particles.forces(), 2));
+    header.radius = particles.radius();
+    header.mass = particles.mass();
+    header.nextParticleId = particles.nextParticleId();
+
+    // Lay out the channel blocks.
+    std::vector<const double*> values;
+    std::vector<ChannelHeader> channels;
+    const size_t valueSize =
+        (_encoding == ParticleCacheEncoding::kRaw) ? sizeof(double)
+                                                   : sizeof(uint16_t);
+    auto addChannel = [&](const double* data, uint32_t numberOfComponents) {
+        ChannelHeader channel = {};
+        channel.numberOfComponents = numberOfComponents;
+        channel.encoding = static_cast<uint32_t>(_encoding);
+        channel.size = n * numberOfComponents * valueSize;
+        if (_encoding != ParticleCacheEncoding::kRaw) {
+            computeBounds(data, n * numberOfComponents, numberOfComponents,
+                          &channel);
+        }
+        values.push_back(data);
+        channels.push_back(channel);
+    };
+    for (size_t i = 0; i < numberOfScalarData; ++i) {
+        addChannel(particles.scalarDataAt(i).data(), 1);
+    }
+    for (size_t i = 0; i < numberOfVectorData; ++i) {
+        addChannel(reinterpret_cast<const double*>(
+                       particles.vectorDataAt(i).data()),
+                   3);
+    }
+
+    // The IDs are always stored as they are.
+    ChannelHeader idChannel = {};
+    idChannel.numberOfComponents = 1;
+    idChannel.encoding = static_cast<uint32_t>(ParticleCacheEncoding::kRaw);
+    idChannel.size = n * sizeof(uint64_t);
+    channels.push_back(idChannel);
+
+    uint64_t offset = alignBlock(sizeof(FileHeader) +
+                                 channels.size() * sizeof(ChannelHeader));
+    for (auto& channel : channels) {
+        channel.offset = offset;
+        offset = alignBlock(offset + channel.size);
+    }
+
+    std::ofstream file(filename.c_str(), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(channels.data()),
+               static_cast<std::streamsize>(channels.size() *
+                                            sizeof(ChannelHeader)));
+
+    uint64_t position =
+        sizeof(FileHeader) + channels.size() * sizeof(ChannelHeader);
+    for (size_t c = 0; c < channels.size(); ++c) {
+        writePadding(&file, channels[c].offset - position);
+
+        if (c < values.size()) {
+            writeChannel(values[c], n * channels[c].numberOfComponents,
+                         channels[c], &file);
+        } else {
+            file.write(
+                reinterpret_cast<const char*>(particles.particleIds().data()),
+                static_cast<std::streamsize>(channels[c].size));
+        }
+
+        position = channels[c].offset + channels[c].size;
+    }
+    writePadding(&file, alignBlock(position) - position);
+
+    return static_cast<bool>(file);
+}
+
+struct ParticleCache3::FileMapping {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef JET_WINDOWS
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    ~FileMapping() {
+#ifdef JET_WINDOWS
+        if (data != nullptr) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+#else
+        if (data != nullptr) {
+            munmap(const_cast<uint8_t*>(data), size);
+        }
+#endif
+    }
+
+    bool map(const std::string& filename) {
+#ifdef JET_WINDOWS
+        file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                           nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                           nullptr);
+        LARGE_INTEGER fileSize;
+        if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) ||
+            fileSize.QuadPart == 0) {
+            return false;
+        }
+        mapping =
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            return false;
+        }
+        data = static_cast<const uint8_t*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = static_cast<size_t>(fileSize.QuadPart);
+        return data != nullptr;
+#else
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat status;
+        if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(status.st_size),
+                            PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        data = static_cast<const uint8_t*>(mapped);
+        size = static_cast<size_t>(status.st_size);
+        return true;
+#endif
+    }
+};
+
+ParticleCache3::ParticleCache3() {}
+
+ParticleCache3::ParticleCache3(const std::string& filename) {
+    open(filename);
+}
+
+ParticleCache3::~ParticleCache3() {}
+
+bool ParticleCache3::open(const std::string& filename) {
+    close();
+
+    _mapping.reset(new FileMapping());
+    if (!_mapping->map(filename) || !readChannels()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ParticleCache3::close() {
+    _scalarDataList.clear();
+    _vectorDataList.clear();
+    _decodedScalarDataList.clear();
+    _decodedVectorDataList.clear();
+    _particleIds = nullptr;
+    _numberOfParticles = 0;
+    _radius = 0.0;
+    _mass = 0.0;
+    _positionIdx = 0;
+    _velocityIdx = 0;
+    _forceIdx = 0;
+    _nextParticleId = 0;
+    _mapping.reset();
+}
+
+bool ParticleCache3::isOpen() const { return _mapping != nullptr; }
+
+size_t ParticleCache3::numberOfParticles() const { return _numberOfParticles; }
+
+size_t ParticleCache3::numberOfScalarData() const {
+    return _scalarDataList.size();
+}
+
+size_t ParticleCache3::numberOfVectorData() const {
+    return _vectorDataList.size();
+}
+
+double ParticleCache3::radius() const { return _radius; }
+
+double ParticleCache3::mass() const { return _mass; }
+
+ConstArrayAccessor1<Vector3D> ParticleCache3::positions() const {
+    return vectorDataAt(_positionIdx);
+}
+
+ConstArrayAccessor1<Vector3D> ParticleCache3::velocities() const {
+    return vectorDataAt(_velocityIdx);
+}
+
+ConstArrayAccessor1<Vector3D> ParticleCache3::forces() const {
+    return vectorDataAt(_forceIdx);
+}
+
+ConstArrayAccessor1<double> ParticleCache3::scalarDataAt(size_t idx) const {
+    return _scalarDataList[idx];
+}
+
+ConstArrayAccessor1<Vector3D> ParticleCache3::vectorDataAt(size_t idx) const {
+    return _vectorDataList[idx];
+}
+
+ConstArrayAccessor1<size_t> ParticleCache3::particleIds() const {
+    return ConstArrayAccessor1<size_t>(_numberOfParticles, _particleIds);
+}
+
+size_t ParticleCache3::nextParticleId() const { return _nextParticleId; }
+
+void ParticleCache3::copyTo(ParticleSystemData3* particles) const {
+    particles->resize(_numberOfParticles);
+    particles->setRadius(_radius);
+    particles->setMass(_mass);
+
+    while (particles->numberOfScalarData() < numberOfScalarData()) {
+        particles->addScalarData();
+    }
+    while (particles->numberOfVectorData() < numberOfVectorData()) {
+        particles->addVectorData();
+    }
+
+    for (size_t i = 0; i < numberOfScalarData(); ++i) {
+        auto dst = particles->scalarDataAt(i);
+        copyRange1(scalarDataAt(i), _numberOfParticles, &dst);
+    }
+    for (size_t i = 0; i < numberOfVectorData(); ++i) {
+        auto dst = particles->vectorDataAt(i);
+        copyRange1(vectorDataAt(i), _numberOfParticles, &dst);
+    }
+
+    particles->setParticleIds(particleIds(), _nextParticleId);
+}
+
+bool ParticleCache3::readChannels() {
+    const uint8_t* data = _mapping->data;
+    const size_t fileSize = _mapping->size;
+
+    FileHeader header;
+    if (fileSize < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion ||
+        header.positionIdx >= header.numberOfVectorData ||
+        header.velocityIdx >= header.numberOfVectorData ||
+        header.forceIdx >= header.numberOfVectorData) {
+        return false;
+    }
+
+    // Check each count against the channel table which fits in the file
+    // before summing them, so that a corrupted header can neither overflow
+    // the sum nor make the reservations below huge.
+    const size_t n = static_cast<size_t>(header.numberOfParticles);
+    const size_t maxNumberOfChannels =
+        (fileSize - sizeof(header)) / sizeof(ChannelHeader);
+    const size_t numberOfScalarData =
+        static_cast<size_t>(header.numberOfScalarData);
+    const size_t numberOfVectorData =
+        static_cast<size_t>(header.numberOfVectorData);
+    if (numberOfScalarData >= maxNumberOfChannels ||
+        numberOfVectorData >= maxNumberOfChannels - numberOfScalarData) {
+        return false;
+    }
+    const size_t numberOfChannels =
+        numberOfScalarData + numberOfVectorData + 1;
+    std::vector<ChannelHeader> channels(numberOfChannels);
+    std::memcpy(channels.data(), data + sizeof(header),
+                numberOfChannels * sizeof(ChannelHeader));
+
+    for (size_t c = 0; c < numberOfChannels; ++c) {
+        const ChannelHeader& channel = channels[c];
+        const uint32_t expectedComponents =
+            (c < numberOfScalarData ||
+             c + 1 == numberOfChannels) ? 1 : 3;
+        const bool isRaw = channel.encoding ==
+            static_cast<uint32_t>(ParticleCacheEncoding::kRaw);
+        const bool isQuantized = channel.encoding ==
+            static_cast<uint32_t>(ParticleCacheEncoding::kQuantized16);
+        const size_t valueSize = isRaw ? sizeof(double) : sizeof(uint16_t);
+        if (channel.numberOfComponents != expectedComponents ||
+            !(isRaw || (isQuantized && c + 1 != numberOfChannels)) ||
+            channel.offset % kBlockAlignment != 0 ||
+            channel.offset > fileSize ||
+            channel.size > fileSize - channel.offset ||
+            channel.size % (expectedComponents * valueSize) != 0 ||
+            channel.size / (expectedComponents * valueSize) != n) {
+            return false;
+        }
+    }
+
+    _numberOfParticles = n;
+    _radius = header.radius;
+    _mass = header.mass;
+    _positionIdx = header.positionIdx;
+    _velocityIdx = header.velocityIdx;
+    _forceIdx = header.forceIdx;
+    _nextParticleId = static_cast<size_t>(header.nextParticleId);
+
+    // Reserve the decoded arrays up front so that the accessors stay valid.
+    _decodedScalarDataList.reserve(numberOfScalarData);
+    _decodedVectorDataList.reserve(numberOfVectorData);
+
+    for (size_t c = 0; c < numberOfScalarData; ++c) {
+        const ChannelHeader& channel = channels[c];
+        const uint8_t* block = data + channel.offset;
+        if (channel.encoding ==
+            static_cast<uint32_t>(ParticleCacheEncoding::kRaw)) {
+            _scalarDataList.emplace_back(
+                n, reinterpret_cast<const double*>(block));
+        } else {
+            _decodedScalarDataList.emplace_back(n);
+            decodeChannel(block, channel, &_decodedScalarDataList.back());
+            _scalarDataList.push_back(
+                _decodedScalarDataList.back().constAccessor());
+        }
+    }
+
+    for (size_t c = numberOfScalarData; c + 1 < numberOfChannels; ++c) {
+        const ChannelHeader& channel = channels[c];
+        const uint8_t* block = data + channel.offset;
+        if (channel.encoding ==
+            static_cast<uint32_t>(ParticleCacheEncoding::kRaw)) {
+            _vectorDataList.emplace_back(
+                n, reinterpret_cast<const Vector3D*>(block));
+        } else {
+            _decodedVectorDataList.emplace_back(n);
+            decodeChannel(block, channel, &_decodedVectorDataList.back());
+            _vectorDataList.push_back(
+                _decodedVectorDataList.back().constAccessor());
+        }
+    }
+
+    _particleIds =
+        reinterpret_cast<const size_t*>(data + channels.back().offset);
+
+    return true;
+}
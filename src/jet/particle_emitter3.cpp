@@ -49,4 +49,16 @@ void ParticleEmitter3::setOnBeginUpdateCallback(
     _onBeginUpdateCallback = callback;
 }
 
+void ParticleEmitter3::saveCheckpoint(const std::string& prefix,
+                                      Checkpoint* checkpoint) const {
+    UNUSED_VARIABLE(prefix);
+    UNUSED_VARIABLE(checkpoint);
+}
+
+void ParticleEmitter3::loadCheckpoint(const std::string& prefix,
+                                      const Checkpoint& checkpoint) {
+    UNUSED_VARIABLE(prefix);
+    UNUSED_VARIABLE(checkpoint);
+}
+
 }  // namespace jet
@@ -6,6 +6,7 @@
 
 #include <pch.h>
 #include <jet/particle_emitter_set3.h>
+#include <string>
 #include <vector>
 
 using namespace jet;
@@ -21,6 +22,22 @@ ParticleEmitterSet3::ParticleEmitterSet3(
 ParticleEmitterSet3::~ParticleEmitterSet3() {
 }
 
+void ParticleEmitterSet3::saveCheckpoint(const std::string& prefix,
+                                         Checkpoint* checkpoint) const {
+    for (size_t i = 0; i < _emitters.size(); ++i) {
+        _emitters[i]->saveCheckpoint(prefix + std::to_string(i) + "/",
+                                     checkpoint);
+    }
+}
+
+void ParticleEmitterSet3::loadCheckpoint(const std::string& prefix,
+                                         const Checkpoint& checkpoint) {
+    for (size_t i = 0; i < _emitters.size(); ++i) {
+        _emitters[i]->loadCheckpoint(prefix + std::to_string(i) + "/",
+                                     checkpoint);
+    }
+}
+
 void ParticleEmitterSet3::addEmitter(const ParticleEmitter3Ptr& emitter) {
     _emitters.push_back(emitter);
 }
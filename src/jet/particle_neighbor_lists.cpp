@@ -0,0 +1,83 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/parallel.h>
+#include <jet/particle_neighbor_lists.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+ParticleNeighborLists::ParticleNeighborLists() : _offsets(1, 0) {}
+
+ParticleNeighborLists::ParticleNeighborLists(
+    const std::vector<std::vector<size_t>>& lists)
+    : _offsets(1, 0) {
+    _offsets.reserve(lists.size() + 1);
+    for (const auto& list : lists) {
+        _indices.insert(_indices.end(), list.begin(), list.end());
+        _offsets.push_back(_indices.size());
+    }
+}
+
+size_t ParticleNeighborLists::size() const { return _offsets.size() - 1; }
+
+bool ParticleNeighborLists::empty() const { return size() == 0; }
+
+ConstArrayAccessor1<size_t> ParticleNeighborLists::operator[](size_t i) const {
+    return ConstArrayAccessor1<size_t>(_offsets[i + 1] - _offsets[i],
+                                       _indices.data() + _offsets[i]);
+}
+
+size_t ParticleNeighborLists::numberOfNeighbors(size_t i) const {
+    return _offsets[i + 1] - _offsets[i];
+}
+
+ConstArrayAccessor1<size_t> ParticleNeighborLists::offsets() const {
+    return ConstArrayAccessor1<size_t>(_offsets.size(), _offsets.data());
+}
+
+ConstArrayAccessor1<size_t> ParticleNeighborLists::indices() const {
+    return ConstArrayAccessor1<size_t>(_indices.size(), _indices.data());
+}
+
+void ParticleNeighborLists::clear() {
+    _offsets.assign(1, 0);
+    _indices.clear();
+}
+
+void ParticleNeighborLists::build(size_t numberOfParticles,
+                                  const CountCallback& countCallback,
+                                  const FillCallback& fillCallback) {
+    // Pass 1: count the neighbors of each particle
+    _offsets.resize(numberOfParticles + 1);
+    _offsets[0] = 0;
+    parallelFor(kZeroSize, numberOfParticles,
+                [&](size_t i) { _offsets[i + 1] = countCallback(i); });
+
+    // Exclusive prefix sum of the counts
+    for (size_t i = 0; i < numberOfParticles; ++i) {
+        _offsets[i + 1] += _offsets[i];
+    }
+
+    // Pass 2: write the neighbors to their slots
+    _indices.resize(_offsets[numberOfParticles]);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        fillCallback(i, _indices.data() + _offsets[i]);
+    });
+}
+
+std::vector<std::vector<size_t>> ParticleNeighborLists::toNestedVectors()
+    const {
+    std::vector<std::vector<size_t>> lists(size());
+    for (size_t i = 0; i < size(); ++i) {
+        auto neighbors = (*this)[i];
+        lists[i].assign(neighbors.begin(), neighbors.end());
+    }
+    return lists;
+}
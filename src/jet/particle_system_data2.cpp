@@ -14,6 +14,7 @@
 #include <fbs_helpers.h>
 #include <generated/particle_system_data2_generated.h>
 
+#include <jet/bounding_box2.h>
 #include <jet/parallel.h>
 #include <jet/particle_system_data2.h>
 #include <jet/point_parallel_hash_grid_searcher2.h>
@@ -26,6 +27,31 @@ using namespace jet;
 
 static const size_t kDefaultHashGridResolution = 64;
 
+static const uint64_t kMaxMortonCell = 0xffffffffULL;
+
+// Spreads the lower 32 bits so that there is a zero bit between them.
+static uint64_t expandBitsForMorton(uint64_t x) {
+    x &= kMaxMortonCell;
+    x = (x | x << 16) & 0x0000ffff0000ffffULL;
+    x = (x | x << 8) & 0x00ff00ff00ff00ffULL;
+    x = (x | x << 4) & 0x0f0f0f0f0f0f0f0fULL;
+    x = (x | x << 2) & 0x3333333333333333ULL;
+    x = (x | x << 1) & 0x5555555555555555ULL;
+    return x;
+}
+
+static uint64_t mortonCode(
+    const Vector2D& pt, const Vector2D& origin, double cellSize) {
+    auto cell = [&](double x, double o) {
+        double c = std::floor((x - o) / cellSize);
+        return static_cast<uint64_t>(
+            clamp(c, 0.0, static_cast<double>(kMaxMortonCell)));
+    };
+
+    return expandBitsForMorton(cell(pt.x, origin.x))
+        | (expandBitsForMorton(cell(pt.y, origin.y)) << 1);
+}
+
 ParticleSystemData2::ParticleSystemData2()
 : ParticleSystemData2(0) {
 }
@@ -54,6 +80,13 @@ ParticleSystemData2::~ParticleSystemData2() {
 void ParticleSystemData2::resize(size_t newNumberOfParticles) {
     _numberOfParticles = newNumberOfParticles;
 
+    // New particles get new IDs
+    const size_t oldNumberOfParticles = _particleIds.size();
+    _particleIds.resize(newNumberOfParticles);
+    for (size_t i = oldNumberOfParticles; i < newNumberOfParticles; ++i) {
+        _particleIds[i] = _nextParticleId++;
+    }
+
     for (auto& attr : _scalarDataList) {
         attr.resize(newNumberOfParticles, 0.0);
     }
@@ -137,6 +170,26 @@ ArrayAccessor1<Vector2D> ParticleSystemData2::vectorDataAt(size_t idx) {
     return _vectorDataList[idx].accessor();
 }
 
+ConstArrayAccessor1<size_t> ParticleSystemData2::particleIds() const {
+    return _particleIds.constAccessor();
+}
+
+size_t ParticleSystemData2::nextParticleId() const {
+    return _nextParticleId;
+}
+
+void ParticleSystemData2::setParticleIds(
+    const ConstArrayAccessor1<size_t>& ids,
+    size_t nextParticleId) {
+    JET_THROW_INVALID_ARG_IF(ids.size() != _numberOfParticles);
+
+    _particleIds.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        _particleIds[i] = ids[i];
+    }
+    _nextParticleId = nextParticleId;
+}
+
 void ParticleSystemData2::addParticle(
     const Vector2D& newPosition,
     const Vector2D& newVelocity,
@@ -199,19 +252,128 @@ void ParticleSystemData2::setNeighborSearcher(
     _neighborSearcher = newNeighborSearcher;
 }
 
-const std::vector<std::vector<size_t>>&
-ParticleSystemData2::neighborLists() const {
+const ParticleNeighborLists& ParticleSystemData2::neighborLists() const {
     return _neighborLists;
 }
 
+void ParticleSystemData2::reorderParticles(
+    const ConstArrayAccessor1<size_t>& order) {
+    const size_t n = numberOfParticles();
+    JET_THROW_INVALID_ARG_IF(order.size() != n);
+
+    // Gather each data layer in the new order
+    Array1<size_t> newParticleIds(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        newParticleIds[i] = _particleIds[order[i]];
+    });
+    _particleIds.swap(newParticleIds);
+
+    ScalarData newScalarData(n);
+    for (auto& attr : _scalarDataList) {
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            newScalarData[i] = attr[order[i]];
+        });
+        attr.swap(newScalarData);
+    }
+
+    VectorData newVectorData(n);
+    for (auto& attr : _vectorDataList) {
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            newVectorData[i] = attr[order[i]];
+        });
+        attr.swap(newVectorData);
+    }
+
+    // Remap the neighbor lists if they are built for the current particles
+    if (_neighborLists.size() == n && n > 0) {
+        Array1<size_t> newIndices(n);
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            newIndices[order[i]] = i;
+        });
+
+        ParticleNeighborLists oldNeighborLists;
+        std::swap(oldNeighborLists, _neighborLists);
+        _neighborLists.build(
+            n,
+            [&](size_t i) {
+                return oldNeighborLists.numberOfNeighbors(order[i]);
+            },
+            [&](size_t i, size_t* neighbors) {
+                for (size_t j : oldNeighborLists[order[i]]) {
+                    *(neighbors++) = newIndices[j];
+                }
+            });
+    }
+}
+
+void ParticleSystemData2::sortParticlesSpatially(
+    double cellSize, Array1<size_t>* order) {
+    JET_THROW_INVALID_ARG_IF(cellSize <= 0.0);
+
+    Timer timer;
+
+    const size_t n = numberOfParticles();
+    auto points = positions();
+
+    // Compute the Morton codes relative to the lower corner of the particles
+    BoundingBox2D bbox = parallelReduce(
+        kZeroSize, n, BoundingBox2D(),
+        [&](size_t iBegin, size_t iEnd, BoundingBox2D init) {
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                init.merge(points[i]);
+            }
+            return init;
+        },
+        [](BoundingBox2D a, const BoundingBox2D& b) {
+            a.merge(b);
+            return a;
+        });
+
+    // Sorting the (code, index) pairs keeps the relative order of the
+    // particles within the same cell.
+    std::vector<std::pair<uint64_t, size_t>> codes(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        codes[i] = std::make_pair(
+            mortonCode(points[i], bbox.lowerCorner, cellSize), i);
+    });
+    parallelSort(codes.begin(), codes.end());
+
+    Array1<size_t> newOrder(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        newOrder[i] = codes[i].second;
+    });
+
+    reorderParticles(newOrder.constAccessor());
+
+    if (order != nullptr) {
+        order->swap(newOrder);
+    }
+
+    JET_INFO << "Sorting particles spatially took: "
+             << timer.durationInSeconds()
+             << " seconds";
+}
+
 void ParticleSystemData2::buildNeighborSearcher(double maxSearchRadius) {
     Timer timer;
 
-    // Use PointParallelHashGridSearcher2 by default
-    _neighborSearcher = std::make_shared<PointParallelHashGridSearcher2>(
+    // Use PointParallelHashGridSearcher2 by default. If the current searcher
+    // already has the same settings, reuse it so that its tables and the
+    // previous point ordering are kept.
+    const double gridSpacing = 2.0 * maxSearchRadius;
+    const Size2 defaultResolution(
         kDefaultHashGridResolution,
-        kDefaultHashGridResolution,
-        2.0 * maxSearchRadius);
+        kDefaultHashGridResolution);
+    auto searcher =
+        std::dynamic_pointer_cast<PointParallelHashGridSearcher2>(
+            _neighborSearcher);
+    if (searcher == nullptr || searcher->gridSpacing() != gridSpacing ||
+        searcher->resolution() != defaultResolution) {
+        _neighborSearcher = std::make_shared<PointParallelHashGridSearcher2>(
+            kDefaultHashGridResolution,
+            kDefaultHashGridResolution,
+            gridSpacing);
+    }
 
     _neighborSearcher->build(positions());
 
@@ -223,22 +385,28 @@ void ParticleSystemData2::buildNeighborSearcher(double maxSearchRadius) {
 void ParticleSystemData2::buildNeighborLists(double maxSearchRadius) {
     Timer timer;
 
-    _neighborLists.resize(numberOfParticles());
-
     auto points = positions();
-    for (size_t i = 0; i < numberOfParticles(); ++i) {
-        Vector2D origin = points[i];
-        _neighborLists[i].clear();
-
-        _neighborSearcher->forEachNearbyPoint(
-            origin,
-            maxSearchRadius,
-            [&](size_t j, const Vector2D&) {
-                if (i != j) {
-                    _neighborLists[i].push_back(j);
-                }
-            });
-    }
+
+    _neighborLists.build(
+        numberOfParticles(),
+        [&](size_t i) {
+            size_t count = 0;
+            _neighborSearcher->forEachNearbyPoint(
+                points[i], maxSearchRadius, [&](size_t j, const Vector2D&) {
+                    if (i != j) {
+                        ++count;
+                    }
+                });
+            return count;
+        },
+        [&](size_t i, size_t* neighbors) {
+            _neighborSearcher->forEachNearbyPoint(
+                points[i], maxSearchRadius, [&](size_t j, const Vector2D&) {
+                    if (i != j) {
+                        *(neighbors++) = j;
+                    }
+                });
+        });
 
     JET_INFO << "Building neighbor list took: "
              << timer.durationInSeconds()
@@ -272,6 +440,8 @@ void ParticleSystemData2::set(const ParticleSystemData2& other) {
     _velocityIdx = other._velocityIdx;
     _forceIdx = other._forceIdx;
     _numberOfParticles = other._numberOfParticles;
+    _particleIds = other._particleIds;
+    _nextParticleId = other._nextParticleId;
 
     for (auto& attr : other._scalarDataList) {
         _scalarDataList.emplace_back(attr);
@@ -334,7 +504,8 @@ void ParticleSystemData2::serializeParticleSystemData(
 
     // Copy neighbor lists
     std::vector<flatbuffers::Offset<fbs::ParticleNeighborList2>> neighborLists;
-    for (const auto& neighbors : _neighborLists) {
+    for (size_t i = 0; i < _neighborLists.size(); ++i) {
+        auto neighbors = _neighborLists[i];
         std::vector<uint64_t> neighbors64(neighbors.begin(), neighbors.end());
         flatbuffers::Offset<fbs::ParticleNeighborList2> fbsNeighborList
             = fbs::CreateParticleNeighborList2(
@@ -345,6 +516,12 @@ void ParticleSystemData2::serializeParticleSystemData(
 
     auto fbsNeighborLists = builder->CreateVector(neighborLists);
 
+    // Copy particle IDs
+    std::vector<uint64_t> particleIds64(
+        _particleIds.begin(), _particleIds.end());
+    auto fbsParticleIds =
+        builder->CreateVector(particleIds64.data(), particleIds64.size());
+
     // Copy the searcher
     *fbsParticleSystemData = fbs::CreateParticleSystemData2(
         *builder,
@@ -356,7 +533,9 @@ void ParticleSystemData2::serializeParticleSystemData(
         fbsScalarDataList,
         fbsVectorDataList,
         fbsNeighborSearcher,
-        fbsNeighborLists);
+        fbsNeighborLists,
+        fbsParticleIds,
+        _nextParticleId);
 }
 
 void ParticleSystemData2::deserializeParticleSystemData(
@@ -398,6 +577,23 @@ void ParticleSystemData2::deserializeParticleSystemData(
 
     _numberOfParticles = _vectorDataList[0].size();
 
+    // Copy particle IDs. Data without the IDs gets the sequential IDs.
+    auto fbsParticleIds = fbsParticleSystemData->particleIds();
+    _particleIds.resize(_numberOfParticles);
+    if (fbsParticleIds != nullptr
+        && fbsParticleIds->size() == _numberOfParticles) {
+        for (uint32_t i = 0; i < fbsParticleIds->size(); ++i) {
+            _particleIds[i] = static_cast<size_t>(fbsParticleIds->Get(i));
+        }
+        _nextParticleId
+            = static_cast<size_t>(fbsParticleSystemData->nextParticleId());
+    } else {
+        for (size_t i = 0; i < _numberOfParticles; ++i) {
+            _particleIds[i] = i;
+        }
+        _nextParticleId = _numberOfParticles;
+    }
+
     // Copy neighbor searcher
     auto fbsNeighborSearcher = fbsParticleSystemData->neighborSearcher();
     _neighborSearcher
@@ -410,16 +606,17 @@ void ParticleSystemData2::deserializeParticleSystemData(
 
     // Copy neighbor list
     auto fbsNeighborLists = fbsParticleSystemData->neighborLists();
-    _neighborLists.resize(fbsNeighborLists->size());
+    std::vector<std::vector<size_t>> neighborLists(fbsNeighborLists->size());
     for (uint32_t i = 0; i < fbsNeighborLists->size(); ++i) {
         auto fbsNeighborList = fbsNeighborLists->Get(i);
-        _neighborLists[i].resize(fbsNeighborList->data()->size());
+        neighborLists[i].resize(fbsNeighborList->data()->size());
         std::transform(
             fbsNeighborList->data()->begin(),
             fbsNeighborList->data()->end(),
-            _neighborLists[i].begin(),
+            neighborLists[i].begin(),
             [] (uint64_t val) {
                 return static_cast<size_t>(val);
             });
     }
+    _neighborLists = ParticleNeighborLists(neighborLists);
 }
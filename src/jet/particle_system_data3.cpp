@@ -14,6 +14,7 @@
 #include <fbs_helpers.h>
 #include <generated/particle_system_data3_generated.h>
 
+#include <jet/bounding_box3.h>
 #include <jet/parallel.h>
 #include <jet/particle_system_data3.h>
 #include <jet/point_parallel_hash_grid_searcher3.h>
@@ -26,6 +27,32 @@ using namespace jet;
 
 static const size_t kDefaultHashGridResolution = 64;
 
+static const uint64_t kMaxMortonCell = (1 << 21) - 1;
+
+// Spreads the lower 21 bits so that there are two zero bits between them.
+static uint64_t expandBitsForMorton(uint64_t x) {
+    x &= kMaxMortonCell;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8) & 0x100f00f00f00f00fULL;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2) & 0x1249249249249249ULL;
+    return x;
+}
+
+static uint64_t mortonCode(
+    const Vector3D& pt, const Vector3D& origin, double cellSize) {
+    auto cell = [&](double x, double o) {
+        double c = std::floor((x - o) / cellSize);
+        return static_cast<uint64_t>(
+            clamp(c, 0.0, static_cast<double>(kMaxMortonCell)));
+    };
+
+    return expandBitsForMorton(cell(pt.x, origin.x))
+        | (expandBitsForMorton(cell(pt.y, origin.y)) << 1)
+        | (expandBitsForMorton(cell(pt.z, origin.z)) << 2);
+}
+
 ParticleSystemData3::ParticleSystemData3()
 : ParticleSystemData3(0) {
 }
@@ -55,6 +82,13 @@ ParticleSystemData3::~ParticleSystemData3() {
 void ParticleSystemData3::resize(size_t newNumberOfParticles) {
     _numberOfParticles = newNumberOfParticles;
 
+    // New particles get new IDs
+    const size_t oldNumberOfParticles = _particleIds.size();
+    _particleIds.resize(newNumberOfParticles);
+    for (size_t i = oldNumberOfParticles; i < newNumberOfParticles; ++i) {
+        _particleIds[i] = _nextParticleId++;
+    }
+
     for (auto& attr : _scalarDataList) {
         attr.resize(newNumberOfParticles, 0.0);
     }
@@ -68,6 +102,14 @@ size_t ParticleSystemData3::numberOfParticles() const {
     return _numberOfParticles;
 }
 
+size_t ParticleSystemData3::numberOfScalarData() const {
+    return _scalarDataList.size();
+}
+
+size_t ParticleSystemData3::numberOfVectorData() const {
+    return _vectorDataList.size();
+}
+
 size_t ParticleSystemData3::addScalarData(double initialVal) {
     size_t attrIdx = _scalarDataList.size();
     _scalarDataList.emplace_back(numberOfParticles(), initialVal);
@@ -138,6 +180,26 @@ ArrayAccessor1<Vector3D> ParticleSystemData3::vectorDataAt(size_t idx) {
     return _vectorDataList[idx].accessor();
 }
 
+ConstArrayAccessor1<size_t> ParticleSystemData3::particleIds() const {
+    return _particleIds.constAccessor();
+}
+
+size_t ParticleSystemData3::nextParticleId() const {
+    return _nextParticleId;
+}
+
+void ParticleSystemData3::setParticleIds(
+    const ConstArrayAccessor1<size_t>& ids,
+    size_t nextParticleId) {
+    JET_THROW_INVALID_ARG_IF(ids.size() != _numberOfParticles);
+
+    _particleIds.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        _particleIds[i] = ids[i];
+    }
+    _nextParticleId = nextParticleId;
+}
+
 void ParticleSystemData3::addParticle(
     const Vector3D& newPosition,
     const Vector3D& newVelocity,
@@ -200,20 +262,130 @@ void ParticleSystemData3::setNeighborSearcher(
     _neighborSearcher = newNeighborSearcher;
 }
 
-const std::vector<std::vector<size_t>>&
-ParticleSystemData3::neighborLists() const {
+const ParticleNeighborLists& ParticleSystemData3::neighborLists() const {
     return _neighborLists;
 }
 
+void ParticleSystemData3::reorderParticles(
+    const ConstArrayAccessor1<size_t>& order) {
+    const size_t n = numberOfParticles();
+    JET_THROW_INVALID_ARG_IF(order.size() != n);
+
+    // Gather each data layer in the new order
+    Array1<size_t> newParticleIds(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        newParticleIds[i] = _particleIds[order[i]];
+    });
+    _particleIds.swap(newParticleIds);
+
+    ScalarData newScalarData(n);
+    for (auto& attr : _scalarDataList) {
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            newScalarData[i] = attr[order[i]];
+        });
+        attr.swap(newScalarData);
+    }
+
+    VectorData newVectorData(n);
+    for (auto& attr : _vectorDataList) {
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            newVectorData[i] = attr[order[i]];
+        });
+        attr.swap(newVectorData);
+    }
+
+    // Remap the neighbor lists if they are built for the current particles
+    if (_neighborLists.size() == n && n > 0) {
+        Array1<size_t> newIndices(n);
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            newIndices[order[i]] = i;
+        });
+
+        ParticleNeighborLists oldNeighborLists;
+        std::swap(oldNeighborLists, _neighborLists);
+        _neighborLists.build(
+            n,
+            [&](size_t i) {
+                return oldNeighborLists.numberOfNeighbors(order[i]);
+            },
+            [&](size_t i, size_t* neighbors) {
+                for (size_t j : oldNeighborLists[order[i]]) {
+                    *(neighbors++) = newIndices[j];
+                }
+            });
+    }
+}
+
+void ParticleSystemData3::sortParticlesSpatially(
+    double cellSize, Array1<size_t>* order) {
+    JET_THROW_INVALID_ARG_IF(cellSize <= 0.0);
+
+    Timer timer;
+
+    const size_t n = numberOfParticles();
+    auto points = positions();
+
+    // Compute the Morton codes relative to the lower corner of the particles
+    BoundingBox3D bbox = parallelReduce(
+        kZeroSize, n, BoundingBox3D(),
+        [&](size_t iBegin, size_t iEnd, BoundingBox3D init) {
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                init.merge(points[i]);
+            }
+            return init;
+        },
+        [](BoundingBox3D a, const BoundingBox3D& b) {
+            a.merge(b);
+            return a;
+        });
+
+    // Sorting the (code, index) pairs keeps the relative order of the
+    // particles within the same cell.
+    std::vector<std::pair<uint64_t, size_t>> codes(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        codes[i] = std::make_pair(
+            mortonCode(points[i], bbox.lowerCorner, cellSize), i);
+    });
+    parallelSort(codes.begin(), codes.end());
+
+    Array1<size_t> newOrder(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        newOrder[i] = codes[i].second;
+    });
+
+    reorderParticles(newOrder.constAccessor());
+
+    if (order != nullptr) {
+        order->swap(newOrder);
+    }
+
+    JET_INFO << "Sorting particles spatially took: "
+             << timer.durationInSeconds()
+             << " seconds";
+}
+
 void ParticleSystemData3::buildNeighborSearcher(double maxSearchRadius) {
     Timer timer;
 
-    // Use PointParallelHashGridSearcher3 by default
-    _neighborSearcher = std::make_shared<PointParallelHashGridSearcher3>(
+    // Use PointParallelHashGridSearcher3 by default. If the current searcher
+    // already has the same settings, reuse it so that its tables and the
+    // previous point ordering are kept.
+    const double gridSpacing = 2.0 * maxSearchRadius;
+    const Size3 defaultResolution(
         kDefaultHashGridResolution,
         kDefaultHashGridResolution,
-        kDefaultHashGridResolution,
-        2.0 * maxSearchRadius);
+        kDefaultHashGridResolution);
+    auto searcher =
+        std::dynamic_pointer_cast<PointParallelHashGridSearcher3>(
+            _neighborSearcher);
+    if (searcher == nullptr || searcher->gridSpacing() != gridSpacing ||
+        searcher->resolution() != defaultResolution) {
+        _neighborSearcher = std::make_shared<PointParallelHashGridSearcher3>(
+            kDefaultHashGridResolution,
+            kDefaultHashGridResolution,
+            kDefaultHashGridResolution,
+            gridSpacing);
+    }
 
     _neighborSearcher->build(positions());
 
@@ -225,22 +397,28 @@ void ParticleSystemData3::buildNeighborSearcher(double maxSearchRadius) {
 void ParticleSystemData3::buildNeighborLists(double maxSearchRadius) {
     Timer timer;
 
-    _neighborLists.resize(numberOfParticles());
-
     auto points = positions();
-    for (size_t i = 0; i < numberOfParticles(); ++i) {
-        Vector3D origin = points[i];
-        _neighborLists[i].clear();
-
-        _neighborSearcher->forEachNearbyPoint(
-            origin,
-            maxSearchRadius,
-            [&](size_t j, const Vector3D&) {
-                if (i != j) {
-                    _neighborLists[i].push_back(j);
-                }
-            });
-    }
+
+    _neighborLists.build(
+        numberOfParticles(),
+        [&](size_t i) {
+            size_t count = 0;
+            _neighborSearcher->forEachNearbyPoint(
+                points[i], maxSearchRadius, [&](size_t j, const Vector3D&) {
+                    if (i != j) {
+                        ++count;
+                    }
+                });
+            return count;
+        },
+        [&](size_t i, size_t* neighbors) {
+            _neighborSearcher->forEachNearbyPoint(
+                points[i], maxSearchRadius, [&](size_t j, const Vector3D&) {
+                    if (i != j) {
+                        *(neighbors++) = j;
+                    }
+                });
+        });
 
     JET_INFO << "Building neighbor list took: "
              << timer.durationInSeconds()
@@ -274,6 +452,8 @@ void ParticleSystemData3::set(const ParticleSystemData3& other) {
     _velocityIdx = other._velocityIdx;
     _forceIdx = other._forceIdx;
     _numberOfParticles = other._numberOfParticles;
+    _particleIds = other._particleIds;
+    _nextParticleId = other._nextParticleId;
 
     for (auto& attr : other._scalarDataList) {
         _scalarDataList.emplace_back(attr);
@@ -293,6 +473,29 @@ ParticleSystemData3& ParticleSystemData3::operator=(
     return *this;
 }
 
+void ParticleSystemData3::copyDataFrom(const ParticleSystemData3& other) {
+    _radius = other._radius;
+    _mass = other._mass;
+    _positionIdx = other._positionIdx;
+    _velocityIdx = other._velocityIdx;
+    _forceIdx = other._forceIdx;
+    _numberOfParticles = other._numberOfParticles;
+    _particleIds.set(other._particleIds);
+    _nextParticleId = other._nextParticleId;
+
+    _scalarDataList.resize(other._scalarDataList.size());
+    for (size_t i = 0; i < _scalarDataList.size(); ++i) {
+        _scalarDataList[i].set(other._scalarDataList[i]);
+    }
+
+    _vectorDataList.resize(other._vectorDataList.size());
+    for (size_t i = 0; i < _vectorDataList.size(); ++i) {
+        _vectorDataList[i].set(other._vectorDataList[i]);
+    }
+
+    _neighborLists.clear();
+}
+
 void ParticleSystemData3::serializeParticleSystemData(
     flatbuffers::FlatBufferBuilder* builder,
     flatbuffers::Offset<fbs::ParticleSystemData3>* fbsParticleSystemData)
@@ -336,7 +539,8 @@ void ParticleSystemData3::serializeParticleSystemData(
 
     // Copy neighbor lists
     std::vector<flatbuffers::Offset<fbs::ParticleNeighborList3>> neighborLists;
-    for (const auto& neighbors : _neighborLists) {
+    for (size_t i = 0; i < _neighborLists.size(); ++i) {
+        auto neighbors = _neighborLists[i];
         std::vector<uint64_t> neighbors64(neighbors.begin(), neighbors.end());
         flatbuffers::Offset<fbs::ParticleNeighborList3> fbsNeighborList
             = fbs::CreateParticleNeighborList3(
@@ -347,6 +551,12 @@ void ParticleSystemData3::serializeParticleSystemData(
 
     auto fbsNeighborLists = builder->CreateVector(neighborLists);
 
+    // Copy particle IDs
+    std::vector<uint64_t> particleIds64(
+        _particleIds.begin(), _particleIds.end());
+    auto fbsParticleIds =
+        builder->CreateVector(particleIds64.data(), particleIds64.size());
+
     // Copy the searcher
     *fbsParticleSystemData = fbs::CreateParticleSystemData3(
         *builder,
@@ -358,7 +568,9 @@ void ParticleSystemData3::serializeParticleSystemData(
         fbsScalarDataList,
         fbsVectorDataList,
         fbsNeighborSearcher,
-        fbsNeighborLists);
+        fbsNeighborLists,
+        fbsParticleIds,
+        _nextParticleId);
 }
 
 void ParticleSystemData3::deserializeParticleSystemData(
@@ -400,6 +612,23 @@ void ParticleSystemData3::deserializeParticleSystemData(
 
     _numberOfParticles = _vectorDataList[0].size();
 
+    // Copy particle IDs. Data without the IDs gets the sequential IDs.
+    auto fbsParticleIds = fbsParticleSystemData->particleIds();
+    _particleIds.resize(_numberOfParticles);
+    if (fbsParticleIds != nullptr
+        && fbsParticleIds->size() == _numberOfParticles) {
+        for (uint32_t i = 0; i < fbsParticleIds->size(); ++i) {
+            _particleIds[i] = static_cast<size_t>(fbsParticleIds->Get(i));
+        }
+        _nextParticleId
+            = static_cast<size_t>(fbsParticleSystemData->nextParticleId());
+    } else {
+        for (size_t i = 0; i < _numberOfParticles; ++i) {
+            _particleIds[i] = i;
+        }
+        _nextParticleId = _numberOfParticles;
+    }
+
     // Copy neighbor searcher
     auto fbsNeighborSearcher = fbsParticleSystemData->neighborSearcher();
     _neighborSearcher
@@ -412,16 +641,17 @@ void ParticleSystemData3::deserializeParticleSystemData(
 
     // Copy neighbor list
     auto fbsNeighborLists = fbsParticleSystemData->neighborLists();
-    _neighborLists.resize(fbsNeighborLists->size());
+    std::vector<std::vector<size_t>> neighborLists(fbsNeighborLists->size());
     for (uint32_t i = 0; i < fbsNeighborLists->size(); ++i) {
         auto fbsNeighborList = fbsNeighborLists->Get(i);
-        _neighborLists[i].resize(fbsNeighborList->data()->size());
+        neighborLists[i].resize(fbsNeighborList->data()->size());
         std::transform(
             fbsNeighborList->data()->begin(),
             fbsNeighborList->data()->end(),
-            _neighborLists[i].begin(),
+            neighborLists[i].begin(),
             [](uint64_t val) {
             return static_cast<size_t>(val);
         });
     }
+    _neighborLists = ParticleNeighborLists(neighborLists);
 }
@@ -89,6 +89,16 @@ void ParticleSystemSolver2::setWind(const VectorField2Ptr& newWind) {
     _wind = newWind;
 }
 
+unsigned int ParticleSystemSolver2::spatialSortingInterval() const {
+    return _spatialSortingInterval;
+}
+
+void ParticleSystemSolver2::setSpatialSortingInterval(
+    unsigned int newInterval) {
+    _spatialSortingInterval = newInterval;
+    _numberOfStepsSinceSorting = 0;
+}
+
 void ParticleSystemSolver2::onInitialize() {
     // When initializing the solver, update the collider and emitter state as
     // well since they also affects the initial condition of the simulation.
@@ -147,6 +157,14 @@ void ParticleSystemSolver2::beginAdvanceTimeStep(double timeStepInSeconds) {
     JET_INFO << "Update emitter took "
              << timer.durationInSeconds() << " seconds";
 
+    // Sort the particles periodically to keep the neighbors close in memory
+    if (_spatialSortingInterval > 0
+        && ++_numberOfStepsSinceSorting >= _spatialSortingInterval) {
+        _particleSystemData->sortParticlesSpatially(
+            2.0 * std::max(_particleSystemData->radius(), kEpsilonD));
+        _numberOfStepsSinceSorting = 0;
+    }
+
     // Allocate buffers
     size_t n = _particleSystemData->numberOfParticles();
     _newPositions.resize(n);
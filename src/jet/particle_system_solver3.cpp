@@ -89,6 +89,16 @@ void ParticleSystemSolver3::setWind(const VectorField3Ptr& newWind) {
     _wind = newWind;
 }
 
+unsigned int ParticleSystemSolver3::spatialSortingInterval() const {
+    return _spatialSortingInterval;
+}
+
+void ParticleSystemSolver3::setSpatialSortingInterval(
+    unsigned int newInterval) {
+    _spatialSortingInterval = newInterval;
+    _numberOfStepsSinceSorting = 0;
+}
+
 void ParticleSystemSolver3::onInitialize() {
     // When initializing the solver, update the collider and emitter state as
     // well since they also affects the initial condition of the simulation.
@@ -124,6 +134,54 @@ void ParticleSystemSolver3::onAdvanceTimeStep(double timeStepInSeconds) {
     endAdvanceTimeStep(timeStepInSeconds);
 }
 
+void ParticleSystemSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    PhysicsAnimation::onSaveCheckpoint(checkpoint);
+
+    checkpoint->setValue("ParticleSystemSolver3/dragCoefficient",
+                         _dragCoefficient);
+    checkpoint->setValue("ParticleSystemSolver3/restitutionCoefficient",
+                         _restitutionCoefficient);
+    checkpoint->setValue("ParticleSystemSolver3/gravity", _gravity);
+    checkpoint->setValue("ParticleSystemSolver3/spatialSortingInterval",
+                         _spatialSortingInterval);
+    checkpoint->setValue("ParticleSystemSolver3/numberOfStepsSinceSorting",
+                         _numberOfStepsSinceSorting);
+    checkpoint->setData("ParticleSystemSolver3/particles",
+                        *_particleSystemData);
+
+    if (_collider != nullptr) {
+        _collider->saveCheckpoint("ParticleSystemSolver3/collider/",
+                                  checkpoint);
+    }
+    if (_emitter != nullptr) {
+        _emitter->saveCheckpoint("ParticleSystemSolver3/emitter/", checkpoint);
+    }
+}
+
+void ParticleSystemSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    PhysicsAnimation::onLoadCheckpoint(checkpoint);
+
+    checkpoint.getValue("ParticleSystemSolver3/dragCoefficient",
+                        &_dragCoefficient);
+    checkpoint.getValue("ParticleSystemSolver3/restitutionCoefficient",
+                        &_restitutionCoefficient);
+    checkpoint.getValue("ParticleSystemSolver3/gravity", &_gravity);
+    checkpoint.getValue("ParticleSystemSolver3/spatialSortingInterval",
+                        &_spatialSortingInterval);
+    checkpoint.getValue("ParticleSystemSolver3/numberOfStepsSinceSorting",
+                        &_numberOfStepsSinceSorting);
+    checkpoint.getData("ParticleSystemSolver3/particles",
+                       _particleSystemData.get());
+
+    if (_collider != nullptr) {
+        _collider->loadCheckpoint("ParticleSystemSolver3/collider/",
+                                  checkpoint);
+    }
+    if (_emitter != nullptr) {
+        _emitter->loadCheckpoint("ParticleSystemSolver3/emitter/", checkpoint);
+    }
+}
+
 void ParticleSystemSolver3::accumulateForces(double timeStepInSeconds) {
     UNUSED_VARIABLE(timeStepInSeconds);
 
@@ -147,6 +205,14 @@ void ParticleSystemSolver3::beginAdvanceTimeStep(double timeStepInSeconds) {
     JET_INFO << "Update emitter took "
              << timer.durationInSeconds() << " seconds";
 
+    // Sort the particles periodically to keep the neighbors close in memory
+    if (_spatialSortingInterval > 0
+        && ++_numberOfStepsSinceSorting >= _spatialSortingInterval) {
+        _particleSystemData->sortParticlesSpatially(
+            2.0 * std::max(_particleSystemData->radius(), kEpsilonD));
+        _numberOfStepsSinceSorting = 0;
+    }
+
     // Allocate buffers
     size_t n = _particleSystemData->numberOfParticles();
     _newPositions.resize(n);
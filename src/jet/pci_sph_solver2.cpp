@@ -107,7 +107,7 @@ void PciSphSolver2::accumulatePressureForce(
             numberOfParticles,
             [&] (size_t i) {
                 double weightSum = 0.0;
-                const auto& neighbors = particles->neighborLists()[i];
+                auto neighbors = particles->neighborLists()[i];
 
                 for (size_t j : neighbors) {
                     double dist
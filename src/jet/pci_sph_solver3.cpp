@@ -48,6 +48,24 @@ void PciSphSolver3::setMaxNumberOfIterations(unsigned int n) {
     _maxNumberOfIterations = n;
 }
 
+void PciSphSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    SphSolver3::onSaveCheckpoint(checkpoint);
+
+    checkpoint->setValue("PciSphSolver3/maxDensityErrorRatio",
+                         _maxDensityErrorRatio);
+    checkpoint->setValue("PciSphSolver3/maxNumberOfIterations",
+                         _maxNumberOfIterations);
+}
+
+void PciSphSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    SphSolver3::onLoadCheckpoint(checkpoint);
+
+    checkpoint.getValue("PciSphSolver3/maxDensityErrorRatio",
+                        &_maxDensityErrorRatio);
+    checkpoint.getValue("PciSphSolver3/maxNumberOfIterations",
+                        &_maxNumberOfIterations);
+}
+
 void PciSphSolver3::accumulatePressureForce(
     double timeIntervalInSeconds) {
     auto particles = sphSystemData();
@@ -107,7 +125,7 @@ void PciSphSolver3::accumulatePressureForce(
             numberOfParticles,
             [&] (size_t i) {
                 double weightSum = 0.0;
-                const auto& neighbors = particles->neighborLists()[i];
+                auto neighbors = particles->neighborLists()[i];
 
                 for (size_t j : neighbors) {
                     double dist
@@ -48,6 +48,14 @@ void PhysicsAnimation::setCurrentFrame(const Frame& frame) {
 
 double PhysicsAnimation::currentTimeInSeconds() const { return _currentTime; }
 
+void PhysicsAnimation::saveCheckpoint(Checkpoint* checkpoint) const {
+    onSaveCheckpoint(checkpoint);
+}
+
+void PhysicsAnimation::loadCheckpoint(const Checkpoint& checkpoint) {
+    onLoadCheckpoint(checkpoint);
+}
+
 unsigned int PhysicsAnimation::numberOfSubTimeSteps(
     double timeIntervalInSeconds) const {
     UNUSED_VARIABLE(timeIntervalInSeconds);
@@ -127,3 +135,21 @@ void PhysicsAnimation::initialize() { onInitialize(); }
 void PhysicsAnimation::onInitialize() {
     // Do nothing
 }
+
+void PhysicsAnimation::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    checkpoint->setValue("PhysicsAnimation/currentFrame", _currentFrame);
+    checkpoint->setValue("PhysicsAnimation/currentTime", _currentTime);
+    checkpoint->setValue("PhysicsAnimation/isUsingFixedSubTimeSteps",
+                         _isUsingFixedSubTimeSteps);
+    checkpoint->setValue("PhysicsAnimation/numberOfFixedSubTimeSteps",
+                         _numberOfFixedSubTimeSteps);
+}
+
+void PhysicsAnimation::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    checkpoint.getValue("PhysicsAnimation/currentFrame", &_currentFrame);
+    checkpoint.getValue("PhysicsAnimation/currentTime", &_currentTime);
+    checkpoint.getValue("PhysicsAnimation/isUsingFixedSubTimeSteps",
+                        &_isUsingFixedSubTimeSteps);
+    checkpoint.getValue("PhysicsAnimation/numberOfFixedSubTimeSteps",
+                        &_numberOfFixedSubTimeSteps);
+}
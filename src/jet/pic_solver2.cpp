@@ -51,6 +51,15 @@ void PicSolver2::setParticleEmitter(const ParticleEmitter2Ptr& newEmitter) {
     newEmitter->setTarget(_particles);
 }
 
+unsigned int PicSolver2::spatialSortingInterval() const {
+    return _spatialSortingInterval;
+}
+
+void PicSolver2::setSpatialSortingInterval(unsigned int newInterval) {
+    _spatialSortingInterval = newInterval;
+    _numberOfStepsSinceSorting = 0;
+}
+
 void PicSolver2::onInitialize() {
     GridFluidSolver2::onInitialize();
 
@@ -71,6 +80,12 @@ void PicSolver2::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
     JET_INFO << "Number of PIC-type particles: "
              << _particles->numberOfParticles();
 
+    if (_spatialSortingInterval > 0
+        && ++_numberOfStepsSinceSorting >= _spatialSortingInterval) {
+        sortParticlesSpatially();
+        _numberOfStepsSinceSorting = 0;
+    }
+
     timer.reset();
     transferFromParticlesToGrids();
     JET_INFO << "transferFromParticlesToGrids took "
@@ -116,7 +131,6 @@ void PicSolver2::transferFromParticlesToGrids() {
     auto flow = gridSystemData()->velocity();
     auto positions = _particles->positions();
     auto velocities = _particles->velocities();
-    size_t numberOfParticles = _particles->numberOfParticles();
 
     // Clear velocity to zero
     flow->fill(Vector2D());
@@ -138,7 +152,8 @@ void PicSolver2::transferFromParticlesToGrids() {
         flow->vConstAccessor(),
         flow->gridSpacing(),
         flow->vOrigin());
-    for (size_t i = 0; i < numberOfParticles; ++i) {
+    binParticlesToSlabs();
+    parallelForEachParticleInSlabs([&](size_t i) {
         std::array<Point2UI, 4> indices;
         std::array<double, 4> weights;
 
@@ -148,6 +163,11 @@ void PicSolver2::transferFromParticlesToGrids() {
             uWeight(indices[j]) += weights[j];
             _uMarkers(indices[j]) = 1;
         }
+    });
+
+    parallelForEachParticleInSlabs([&](size_t i) {
+        std::array<Point2UI, 4> indices;
+        std::array<double, 4> weights;
 
         vSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
         for (int j = 0; j < 4; ++j) {
@@ -155,7 +175,7 @@ void PicSolver2::transferFromParticlesToGrids() {
             vWeight(indices[j]) += weights[j];
             _vMarkers(indices[j]) = 1;
         }
-    }
+    });
 
     uWeight.parallelForEachIndex([&](size_t i, size_t j) {
         if (uWeight(i, j) > 0.0) {
@@ -279,6 +299,74 @@ void PicSolver2::buildSignedDistanceField() {
     extrapolateIntoCollider(sdf.get());
 }
 
+void PicSolver2::onParticlesSorted(
+    const ConstArrayAccessor1<size_t>& order) {
+    UNUSED_VARIABLE(order);
+}
+
+void PicSolver2::binParticlesToSlabs() {
+    const size_t numberOfParticles = _particles->numberOfParticles();
+    const auto positions = _particles->positions();
+    const double origin = gridOrigin().y;
+    const double invGridSpacing = 1.0 / gridSpacing().y;
+    const size_t numberOfSlabs = std::max(resolution().y, kOneSize);
+    const double lastSlab = static_cast<double>(numberOfSlabs - 1);
+
+    // Stable counting sort of the particles by the slab. Each chunk of
+    // particles counts into its own histogram, and the histograms are
+    // scanned in (slab, chunk) order, so each chunk can scatter its
+    // particles in parallel while keeping the index order within a slab.
+    const size_t numberOfChunks = std::max(
+        std::min(static_cast<size_t>(maxNumberOfThreads()), numberOfParticles),
+        kOneSize);
+    const size_t chunkSize =
+        (numberOfParticles + numberOfChunks - 1) / numberOfChunks;
+    std::vector<size_t> cursors(numberOfChunks * numberOfSlabs, 0);
+
+    _particleSlabs.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+        size_t* counts = &cursors[c * numberOfSlabs];
+        const size_t end = std::min((c + 1) * chunkSize, numberOfParticles);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            const double slab = std::floor(
+                (positions[i].y - origin) * invGridSpacing);
+            _particleSlabs[i] =
+                static_cast<size_t>(clamp(slab, 0.0, lastSlab));
+            ++counts[_particleSlabs[i]];
+        }
+    });
+
+    _slabStarts.resize(numberOfSlabs + 1);
+    size_t offset = 0;
+    for (size_t s = 0; s < numberOfSlabs; ++s) {
+        _slabStarts[s] = offset;
+        for (size_t c = 0; c < numberOfChunks; ++c) {
+            const size_t count = cursors[c * numberOfSlabs + s];
+            cursors[c * numberOfSlabs + s] = offset;
+            offset += count;
+        }
+    }
+    _slabStarts[numberOfSlabs] = offset;
+
+    _slabParticles.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+        size_t* chunkCursors = &cursors[c * numberOfSlabs];
+        const size_t end = std::min((c + 1) * chunkSize, numberOfParticles);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            _slabParticles[chunkCursors[_particleSlabs[i]]++] = i;
+        }
+    });
+}
+
+void PicSolver2::sortParticlesSpatially() {
+    // Use the grid cells so that the particles splatting to the same cells
+    // are stored next to each other.
+    const Vector2D h = gridSpacing();
+    Array1<size_t> order;
+    _particles->sortParticlesSpatially(std::max(h.x, h.y), &order);
+    onParticlesSorted(order.constAccessor());
+}
+
 void PicSolver2::updateParticleEmitter(double timeIntervalInSeconds) {
     if (_particleEmitter != nullptr) {
         _particleEmitter->update(currentTimeInSeconds(), timeIntervalInSeconds);
@@ -14,9 +14,16 @@
 #include <jet/pic_solver3.h>
 #include <jet/timer.h>
 #include <algorithm>
+#include <array>
 
 using namespace jet;
 
+namespace {
+
+const size_t kMoveBatchSize = 256;
+
+}  // namespace
+
 PicSolver3::PicSolver3() : PicSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {
 }
 
@@ -51,6 +58,15 @@ void PicSolver3::setParticleEmitter(const ParticleEmitter3Ptr& newEmitter) {
     newEmitter->setTarget(_particles);
 }
 
+unsigned int PicSolver3::spatialSortingInterval() const {
+    return _spatialSortingInterval;
+}
+
+void PicSolver3::setSpatialSortingInterval(unsigned int newInterval) {
+    _spatialSortingInterval = newInterval;
+    _numberOfStepsSinceSorting = 0;
+}
+
 void PicSolver3::onInitialize() {
     GridFluidSolver3::onInitialize();
 
@@ -60,6 +76,36 @@ void PicSolver3::onInitialize() {
              << timer.durationInSeconds() << " seconds";
 }
 
+void PicSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    GridFluidSolver3::onSaveCheckpoint(checkpoint);
+
+    checkpoint->setData("PicSolver3/particles", *_particles);
+    checkpoint->setValue("PicSolver3/spatialSortingInterval",
+                         _spatialSortingInterval);
+    checkpoint->setValue("PicSolver3/numberOfStepsSinceSorting",
+                         _numberOfStepsSinceSorting);
+
+    if (_particleEmitter != nullptr) {
+        _particleEmitter->saveCheckpoint("PicSolver3/particleEmitter/",
+                                         checkpoint);
+    }
+}
+
+void PicSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    GridFluidSolver3::onLoadCheckpoint(checkpoint);
+
+    checkpoint.getData("PicSolver3/particles", _particles.get());
+    checkpoint.getValue("PicSolver3/spatialSortingInterval",
+                        &_spatialSortingInterval);
+    checkpoint.getValue("PicSolver3/numberOfStepsSinceSorting",
+                        &_numberOfStepsSinceSorting);
+
+    if (_particleEmitter != nullptr) {
+        _particleEmitter->loadCheckpoint("PicSolver3/particleEmitter/",
+                                         checkpoint);
+    }
+}
+
 void PicSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
     UNUSED_VARIABLE(timeIntervalInSeconds);
 
@@ -74,6 +120,12 @@ void PicSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
     JET_INFO << "Number of PIC-type particles: "
              << _particles->numberOfParticles();
 
+    if (_spatialSortingInterval > 0
+        && ++_numberOfStepsSinceSorting >= _spatialSortingInterval) {
+        sortParticlesSpatially();
+        _numberOfStepsSinceSorting = 0;
+    }
+
     timer.reset();
     transferFromParticlesToGrids();
     JET_INFO << "transferFromParticlesToGrids took "
@@ -119,7 +171,6 @@ void PicSolver3::transferFromParticlesToGrids() {
     auto flow = gridSystemData()->velocity();
     auto positions = _particles->positions();
     auto velocities = _particles->velocities();
-    size_t numberOfParticles = _particles->numberOfParticles();
 
     // Clear velocity to zero
     flow->fill(Vector3D());
@@ -149,7 +200,8 @@ void PicSolver3::transferFromParticlesToGrids() {
         flow->wConstAccessor(),
         flow->gridSpacing(),
         flow->wOrigin());
-    for (size_t i = 0; i < numberOfParticles; ++i) {
+    binParticlesToSlabs();
+    parallelForEachParticleInSlabs([&](size_t i) {
         std::array<Point3UI, 8> indices;
         std::array<double, 8> weights;
 
@@ -159,6 +211,11 @@ void PicSolver3::transferFromParticlesToGrids() {
             uWeight(indices[j]) += weights[j];
             _uMarkers(indices[j]) = 1;
         }
+    });
+
+    parallelForEachParticleInSlabs([&](size_t i) {
+        std::array<Point3UI, 8> indices;
+        std::array<double, 8> weights;
 
         vSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
         for (int j = 0; j < 8; ++j) {
@@ -166,6 +223,11 @@ void PicSolver3::transferFromParticlesToGrids() {
             vWeight(indices[j]) += weights[j];
             _vMarkers(indices[j]) = 1;
         }
+    });
+
+    parallelForEachParticleInSlabs([&](size_t i) {
+        std::array<Point3UI, 8> indices;
+        std::array<double, 8> weights;
 
         wSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
         for (int j = 0; j < 8; ++j) {
@@ -173,7 +235,7 @@ void PicSolver3::transferFromParticlesToGrids() {
             wWeight(indices[j]) += weights[j];
             _wMarkers(indices[j]) = 1;
         }
-    }
+    });
 
     uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
         if (uWeight(i, j, k) > 0.0) {
@@ -196,11 +258,8 @@ void PicSolver3::transferFromGridsToParticles() {
     auto flow = gridSystemData()->velocity();
     auto positions = _particles->positions();
     auto velocities = _particles->velocities();
-    size_t numberOfParticles = _particles->numberOfParticles();
 
-    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        velocities[i] = flow->sample(positions[i]);
-    });
+    flow->sample(ConstArrayAccessor1<Vector3D>(positions), velocities);
 }
 
 void PicSolver3::moveParticles(double timeIntervalInSeconds) {
@@ -211,59 +270,81 @@ void PicSolver3::moveParticles(double timeIntervalInSeconds) {
     int domainBoundaryFlag = closedDomainBoundaryFlag();
     BoundingBox3D boundingBox = flow->boundingBox();
 
-    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        Vector3D pt0 = positions[i];
-        Vector3D pt1 = pt0;
-        Vector3D vel = velocities[i];
-
-        // Adaptive time-stepping
-        unsigned int numSubSteps
-            = static_cast<unsigned int>(std::max(maxCfl(), 1.0));
-        double dt = timeIntervalInSeconds / numSubSteps;
+    // Adaptive time-stepping
+    unsigned int numSubSteps
+        = static_cast<unsigned int>(std::max(maxCfl(), 1.0));
+    double dt = timeIntervalInSeconds / numSubSteps;
+
+    // The particles are moved in batches so that the velocity is sampled for
+    // the whole batch at once.
+    const size_t numberOfBatches
+        = (numberOfParticles + kMoveBatchSize - 1) / kMoveBatchSize;
+    parallelFor(kZeroSize, numberOfBatches, [&](size_t b) {
+        const size_t begin = b * kMoveBatchSize;
+        const size_t n = std::min(numberOfParticles - begin, kMoveBatchSize);
+
+        std::array<Vector3D, kMoveBatchSize> pts;
+        std::array<Vector3D, kMoveBatchSize> midPts;
+        std::array<Vector3D, kMoveBatchSize> vels;
+        ConstArrayAccessor1<Vector3D> ptsAcc(n, pts.data());
+        ConstArrayAccessor1<Vector3D> midPtsAcc(n, midPts.data());
+        ArrayAccessor1<Vector3D> velsAcc(n, vels.data());
+
+        std::copy(positions.begin() + begin, positions.begin() + begin + n,
+                  pts.begin());
         for (unsigned int t = 0; t < numSubSteps; ++t) {
-            Vector3D vel0 = flow->sample(pt0);
+            flow->sample(ptsAcc, velsAcc, ExecutionPolicy::kSerial);
 
             // Mid-point rule
-            Vector3D midPt = pt0 + 0.5 * dt * vel0;
-            Vector3D midVel = flow->sample(midPt);
-            pt1 = pt0 + dt * midVel;
-
-            pt0 = pt1;
+            for (size_t a = 0; a < n; ++a) {
+                midPts[a] = pts[a] + 0.5 * dt * vels[a];
+            }
+            flow->sample(midPtsAcc, velsAcc, ExecutionPolicy::kSerial);
+
+            for (size_t a = 0; a < n; ++a) {
+                pts[a] = pts[a] + dt * vels[a];
+            }
         }
 
-        if ((domainBoundaryFlag & kDirectionLeft)
-            && pt1.x <= boundingBox.lowerCorner.x) {
-            pt1.x = boundingBox.lowerCorner.x;
-            vel.x = 0.0;
-        }
-        if ((domainBoundaryFlag & kDirectionRight)
-            && pt1.x >= boundingBox.upperCorner.x) {
-            pt1.x = boundingBox.upperCorner.x;
-            vel.x = 0.0;
-        }
-        if ((domainBoundaryFlag & kDirectionDown)
-            && pt1.y <= boundingBox.lowerCorner.y) {
-            pt1.y = boundingBox.lowerCorner.y;
-            vel.y = 0.0;
+        for (size_t a = 0; a < n; ++a) {
+            const size_t i = begin + a;
+            Vector3D pt1 = pts[a];
+            Vector3D vel = velocities[i];
+
+            if ((domainBoundaryFlag & kDirectionLeft)
+                && pt1.x <= boundingBox.lowerCorner.x) {
+                pt1.x = boundingBox.lowerCorner.x;
+                vel.x = 0.0;
+            }
+            if ((domainBoundaryFlag & kDirectionRight)
+                && pt1.x >= boundingBox.upperCorner.x) {
+                pt1.x = boundingBox.upperCorner.x;
+                vel.x = 0.0;
+            }
+            if ((domainBoundaryFlag & kDirectionDown)
+                && pt1.y <= boundingBox.lowerCorner.y) {
+                pt1.y = boundingBox.lowerCorner.y;
+                vel.y = 0.0;
+            }
+            if ((domainBoundaryFlag & kDirectionUp)
+                && pt1.y >= boundingBox.upperCorner.y) {
+                pt1.y = boundingBox.upperCorner.y;
+                vel.y = 0.0;
+            }
+            if ((domainBoundaryFlag & kDirectionBack)
+                && pt1.z <= boundingBox.lowerCorner.z) {
+                pt1.z = boundingBox.lowerCorner.z;
+                vel.z = 0.0;
+            }
+            if ((domainBoundaryFlag & kDirectionFront)
+                && pt1.z >= boundingBox.upperCorner.z) {
+                pt1.z = boundingBox.upperCorner.z;
+                vel.z = 0.0;
+            }
+
+            positions[i] = pt1;
+            velocities[i] = vel;
         }
-        if ((domainBoundaryFlag & kDirectionUp)
-            && pt1.y >= boundingBox.upperCorner.y) {
-            pt1.y = boundingBox.upperCorner.y;
-            vel.y = 0.0;
-        }
-        if ((domainBoundaryFlag & kDirectionBack)
-            && pt1.z <= boundingBox.lowerCorner.z) {
-            pt1.z = boundingBox.lowerCorner.z;
-            vel.z = 0.0;
-        }
-        if ((domainBoundaryFlag & kDirectionFront)
-            && pt1.z >= boundingBox.upperCorner.z) {
-            pt1.z = boundingBox.upperCorner.z;
-            vel.z = 0.0;
-        }
-
-        positions[i] = pt1;
-        velocities[i] = vel;
     });
 
     Collider3Ptr col = collider();
@@ -303,19 +384,107 @@ void PicSolver3::buildSignedDistanceField() {
 
     _particles->buildNeighborSearcher(2 * radius);
     auto searcher = _particles->neighborSearcher();
-    sdf->parallelForEachDataPointIndex([&] (size_t i, size_t j, size_t k) {
-        Vector3D pt = sdfPos(i, j, k);
-        double minDist = sdfBandRadius;
-        searcher->forEachNearbyPoint(
-            pt, sdfBandRadius, [&] (size_t, const Vector3D& x) {
-                minDist = std::min(minDist, pt.distanceTo(x));
-            });
-        (*sdf)(i, j, k) = minDist - radius;
-    });
+
+    // Query the grid points slab by slab with the batched neighbor search,
+    // reusing the result buffers across the slabs.
+    const Size3 size = sdf->dataSize();
+    auto sdfData = sdf->dataAccessor();
+    Array1<Vector3D> slabPoints(size.x * size.y);
+    ParticleNeighborLists neighborLists;
+    std::vector<double> distancesSquared;
+    PointNeighborSearcher3::NearbyPointBuffers queryBuffers;
+    for (size_t k = 0; k < size.z; ++k) {
+        parallelFor(kZeroSize, size.x, kZeroSize, size.y,
+                    [&](size_t i, size_t j) {
+                        slabPoints[i + size.x * j] = sdfPos(i, j, k);
+                    });
+
+        searcher->findNearbyPoints(slabPoints, sdfBandRadius, &neighborLists,
+                                   &distancesSquared, &queryBuffers);
+
+        const auto offsets = neighborLists.offsets();
+        parallelFor(kZeroSize, size.x, kZeroSize, size.y,
+                    [&](size_t i, size_t j) {
+                        const size_t n = i + size.x * j;
+                        double minDist2 = sdfBandRadius * sdfBandRadius;
+                        for (size_t m = offsets[n]; m < offsets[n + 1]; ++m) {
+                            minDist2 = std::min(minDist2, distancesSquared[m]);
+                        }
+                        sdfData(i, j, k) = std::sqrt(minDist2) - radius;
+                    });
+    }
 
     extrapolateIntoCollider(sdf.get());
 }
 
+void PicSolver3::onParticlesSorted(
+    const ConstArrayAccessor1<size_t>& order) {
+    UNUSED_VARIABLE(order);
+}
+
+void PicSolver3::binParticlesToSlabs() {
+    const size_t numberOfParticles = _particles->numberOfParticles();
+    const auto positions = _particles->positions();
+    const double origin = gridOrigin().z;
+    const double invGridSpacing = 1.0 / gridSpacing().z;
+    const size_t numberOfSlabs = std::max(resolution().z, kOneSize);
+    const double lastSlab = static_cast<double>(numberOfSlabs - 1);
+
+    // Stable counting sort of the particles by the slab. Each chunk of
+    // particles counts into its own histogram, and the histograms are
+    // scanned in (slab, chunk) order, so each chunk can scatter its
+    // particles in parallel while keeping the index order within a slab.
+    const size_t numberOfChunks = std::max(
+        std::min(static_cast<size_t>(maxNumberOfThreads()), numberOfParticles),
+        kOneSize);
+    const size_t chunkSize =
+        (numberOfParticles + numberOfChunks - 1) / numberOfChunks;
+    std::vector<size_t> cursors(numberOfChunks * numberOfSlabs, 0);
+
+    _particleSlabs.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+        size_t* counts = &cursors[c * numberOfSlabs];
+        const size_t end = std::min((c + 1) * chunkSize, numberOfParticles);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            const double slab = std::floor(
+                (positions[i].z - origin) * invGridSpacing);
+            _particleSlabs[i] =
+                static_cast<size_t>(clamp(slab, 0.0, lastSlab));
+            ++counts[_particleSlabs[i]];
+        }
+    });
+
+    _slabStarts.resize(numberOfSlabs + 1);
+    size_t offset = 0;
+    for (size_t s = 0; s < numberOfSlabs; ++s) {
+        _slabStarts[s] = offset;
+        for (size_t c = 0; c < numberOfChunks; ++c) {
+            const size_t count = cursors[c * numberOfSlabs + s];
+            cursors[c * numberOfSlabs + s] = offset;
+            offset += count;
+        }
+    }
+    _slabStarts[numberOfSlabs] = offset;
+
+    _slabParticles.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+        size_t* chunkCursors = &cursors[c * numberOfSlabs];
+        const size_t end = std::min((c + 1) * chunkSize, numberOfParticles);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            _slabParticles[chunkCursors[_particleSlabs[i]]++] = i;
+        }
+    });
+}
+
+void PicSolver3::sortParticlesSpatially() {
+    // Use the grid cells so that the particles splatting to the same cells
+    // are stored next to each other.
+    const Vector3D h = gridSpacing();
+    Array1<size_t> order;
+    _particles->sortParticlesSpatially(max3(h.x, h.y, h.z), &order);
+    onParticlesSorted(order.constAccessor());
+}
+
 void PicSolver3::updateParticleEmitter(double timeIntervalInSeconds) {
     if (_particleEmitter != nullptr) {
         _particleEmitter->update(currentTimeInSeconds(), timeIntervalInSeconds);
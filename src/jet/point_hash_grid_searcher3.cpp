@@ -69,30 +69,12 @@ void PointHashGridSearcher3::build(
 }
 
 void PointHashGridSearcher3::forEachNearbyPoint(
-    const Vector3D& origin,
-    double radius,
-    const std::function<void(size_t, const Vector3D&)>& callback) const {
-    if (_buckets.empty()) {
-        return;
-    }
-
-    size_t nearbyKeys[8];
-    getNearbyKeys(origin, nearbyKeys);
-
-    const double queryRadiusSquared = radius * radius;
-
-    for (int i = 0; i < 8; i++) {
-        const auto& bucket = _buckets[nearbyKeys[i]];
-        size_t numberOfPointsInBucket = bucket.size();
-
-        for (size_t j = 0; j < numberOfPointsInBucket; ++j) {
-            size_t pointIndex = bucket[j];
-            double rSquared = (_points[pointIndex] - origin).lengthSquared();
-            if (rSquared <= queryRadiusSquared) {
-                callback(pointIndex, _points[pointIndex]);
-            }
-        }
-    }
+    const Vector3D& origin, double radius,
+    const ForEachNearbyPointFunc& callback) const {
+    visitNearbyPoints(origin, radius,
+                      [&callback](size_t i, const Vector3D& pt, double) {
+                          callback(i, pt);
+                      });
 }
 
 bool PointHashGridSearcher3::hasNearbyPoint(
@@ -123,6 +105,15 @@ bool PointHashGridSearcher3::hasNearbyPoint(
     return false;
 }
 
+void PointHashGridSearcher3::findNearbyPoints(
+    const ConstArrayAccessor1<Vector3D>& origins, double radius,
+    ParticleNeighborLists* lists,
+    std::vector<double>* distancesSquared,
+    NearbyPointBuffers* buffers) const {
+    buildNearbyPointLists(*this, origins, radius, lists, distancesSquared,
+                          buffers);
+}
+
 void PointHashGridSearcher3::add(const Vector3D& point) {
     if (_buckets.empty()) {
         Array1<Vector3D> arr = {point};
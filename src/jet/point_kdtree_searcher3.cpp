@@ -33,7 +33,10 @@ void PointKdTreeSearcher3::build(const ConstArrayAccessor1<Vector3D>& points) {
 void PointKdTreeSearcher3::forEachNearbyPoint(
     const Vector3D& origin, double radius,
     const ForEachNearbyPointFunc& callback) const {
-    _tree.forEachNearbyPoint(origin, radius, callback);
+    visitNearbyPoints(origin, radius,
+                      [&callback](size_t i, const Vector3D& pt, double) {
+                          callback(i, pt);
+                      });
 }
 
 bool PointKdTreeSearcher3::hasNearbyPoint(const Vector3D& origin,
@@ -41,6 +44,15 @@ bool PointKdTreeSearcher3::hasNearbyPoint(const Vector3D& origin,
     return _tree.hasNearbyPoint(origin, radius);
 }
 
+void PointKdTreeSearcher3::findNearbyPoints(
+    const ConstArrayAccessor1<Vector3D>& origins, double radius,
+    ParticleNeighborLists* lists,
+    std::vector<double>* distancesSquared,
+    NearbyPointBuffers* buffers) const {
+    buildNearbyPointLists(*this, origins, radius, lists, distancesSquared,
+                          buffers);
+}
+
 PointNeighborSearcher3Ptr PointKdTreeSearcher3::clone() const {
     return CLONE_W_CUSTOM_DELETER(PointKdTreeSearcher3);
 }
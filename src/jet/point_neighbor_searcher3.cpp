@@ -14,3 +14,35 @@ PointNeighborSearcher3::PointNeighborSearcher3() {
 
 PointNeighborSearcher3::~PointNeighborSearcher3() {
 }
+
+namespace {
+
+// Adapts the virtual forEachNearbyPoint to the visitor interface.
+class ForEachNearbyPointVisitor {
+ public:
+    explicit ForEachNearbyPointVisitor(const PointNeighborSearcher3& searcher)
+        : _searcher(searcher) {}
+
+    template <typename Visitor>
+    void visitNearbyPoints(const Vector3D& origin, double radius,
+                           const Visitor& visitor) const {
+        _searcher.forEachNearbyPoint(
+            origin, radius, [&](size_t i, const Vector3D& pt) {
+                visitor(i, pt, origin.distanceSquaredTo(pt));
+            });
+    }
+
+ private:
+    const PointNeighborSearcher3& _searcher;
+};
+
+}  // namespace
+
+void PointNeighborSearcher3::findNearbyPoints(
+    const ConstArrayAccessor1<Vector3D>& origins, double radius,
+    ParticleNeighborLists* lists,
+    std::vector<double>* distancesSquared,
+    NearbyPointBuffers* buffers) const {
+    buildNearbyPointLists(ForEachNearbyPointVisitor(*this), origins, radius,
+                          lists, distancesSquared, buffers);
+}
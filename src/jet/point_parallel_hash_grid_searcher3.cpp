@@ -21,6 +21,15 @@
 
 using namespace jet;
 
+namespace {
+
+// The counting sort splits the points into chunks only if each chunk has at
+// least this many points, since every chunk has its own histogram over the
+// whole hash table.
+const size_t kMinNumberOfPointsPerChunk = 4096;
+
+}  // namespace
+
 PointParallelHashGridSearcher3::PointParallelHashGridSearcher3(
     const Size3& resolution,
     double gridSpacing) :
@@ -51,77 +60,187 @@ PointParallelHashGridSearcher3::PointParallelHashGridSearcher3(
 
 void PointParallelHashGridSearcher3::build(
     const ConstArrayAccessor1<Vector3D>& points) {
-    _points.clear();
-    _keys.clear();
-    _startIndexTable.clear();
-    _endIndexTable.clear();
-    _sortedIndices.clear();
-
-    // Allocate memory chuncks
-    size_t numberOfPoints = points.size();
-    std::vector<size_t> tempKeys(numberOfPoints);
-    _startIndexTable.resize(_resolution.x * _resolution.y * _resolution.z);
-    _endIndexTable.resize(_resolution.x * _resolution.y * _resolution.z);
-    parallelFill(_startIndexTable.begin(), _startIndexTable.end(), kMaxSize);
-    parallelFill(_endIndexTable.begin(), _endIndexTable.end(), kMaxSize);
+    const size_t numberOfPoints = points.size();
+    const size_t tableSize = _resolution.x * _resolution.y * _resolution.z;
+
+    // Keep the tables if the resolution hasn't changed and only reset the
+    // buckets occupied by the previous build. Otherwise, reallocate.
+    if (_startIndexTable.size() == tableSize &&
+        _endIndexTable.size() == tableSize) {
+        parallelFor(kZeroSize, _keys.size(), [&](size_t i) {
+            if (i == 0 || _keys[i] != _keys[i - 1]) {
+                _startIndexTable[_keys[i]] = kMaxSize;
+                _endIndexTable[_keys[i]] = kMaxSize;
+            }
+        });
+    } else {
+        _startIndexTable.assign(tableSize, kMaxSize);
+        _endIndexTable.assign(tableSize, kMaxSize);
+    }
+
+    // Previous sorted order is reused as the initial order since the points
+    // are likely to be nearly sorted. If the number of points has changed,
+    // the indices that are gone are dropped and the new ones are appended.
+    const size_t oldNumberOfPoints = _sortedIndices.size();
+    if (numberOfPoints < oldNumberOfPoints) {
+        _sortedIndices.erase(
+            std::remove_if(_sortedIndices.begin(), _sortedIndices.end(),
+                           [&](size_t i) { return i >= numberOfPoints; }),
+            _sortedIndices.end());
+    } else if (numberOfPoints > oldNumberOfPoints) {
+        _sortedIndices.resize(numberOfPoints);
+        parallelFor(oldNumberOfPoints, numberOfPoints,
+                    [&](size_t i) { _sortedIndices[i] = i; });
+    }
+
     _keys.resize(numberOfPoints);
-    _sortedIndices.resize(numberOfPoints);
     _points.resize(numberOfPoints);
 
     if (numberOfPoints == 0) {
         return;
     }
 
-    // Initialize indices array and generate hash key for each point
+    // Generate hash key for each point, and then gather them in the previous
+    // sorted order
+    std::vector<size_t> pointKeys(numberOfPoints);
     parallelFor(
         kZeroSize,
         numberOfPoints,
         [&](size_t i) {
-            _sortedIndices[i] = i;
-            _points[i] = points[i];
-            tempKeys[i] = getHashKeyFromPosition(points[i]);
-        });
-
-    // Sort indices based on hash key
-    parallelSort(
-        _sortedIndices.begin(),
-        _sortedIndices.end(),
-        [&tempKeys](size_t indexA, size_t indexB) {
-            return tempKeys[indexA] < tempKeys[indexB];
+            pointKeys[i] = getHashKeyFromPosition(points[i]);
         });
 
-    // Re-order point and key arrays
+    std::vector<size_t> tempKeys(numberOfPoints);
     parallelFor(
         kZeroSize,
         numberOfPoints,
         [&](size_t i) {
-            _points[i] = points[_sortedIndices[i]];
-            _keys[i] = tempKeys[_sortedIndices[i]];
+            tempKeys[i] = pointKeys[_sortedIndices[i]];
         });
 
-    // Now _points and _keys are sorted by points' hash key values.
-    // Let's fill in start/end index table with _keys.
+    // Check if the previous order is still sorted by the new keys
+    bool isSorted = parallelReduce(
+        kOneSize, numberOfPoints, true,
+        [&](size_t iBegin, size_t iEnd, bool init) {
+            for (size_t i = iBegin; i < iEnd && init; ++i) {
+                init = tempKeys[i - 1] <= tempKeys[i];
+            }
+            return init;
+        },
+        [](bool a, bool b) { return a && b; });
+
+    if (isSorted) {
+        _keys.swap(tempKeys);
+
+        // Now _keys is sorted by points' hash key values.
+        // Let's fill in start/end index table with _keys.
+
+        // Assume that _keys array looks like:
+        // [5|8|8|10|10|10]
+        // Then _startIndexTable and _endIndexTable should be like:
+        // [.....|0|...|1|..|3|..]
+        // [.....|1|...|3|..|6|..]
+        //       ^5    ^8   ^10
+        // So that _endIndexTable[i] - _startIndexTable[i] is the number points
+        // in i-th table bucket.
+
+        _startIndexTable[_keys[0]] = 0;
+        _endIndexTable[_keys[numberOfPoints - 1]] = numberOfPoints;
+
+        parallelFor(
+            (size_t)1,
+            numberOfPoints,
+            [&](size_t i) {
+                if (_keys[i] > _keys[i - 1]) {
+                    _startIndexTable[_keys[i]] = i;
+                    _endIndexTable[_keys[i - 1]] = i;
+                }
+            });
+    } else {
+        // Stable counting sort keyed on the previous order. The points are
+        // split into chunks, and each chunk counts its keys into its own
+        // histogram. The histograms are then scanned bucket by bucket, in the
+        // chunk order, into the scatter offsets of each chunk, so that every
+        // chunk can scatter its points independently and the order within
+        // each bucket stays the same as the previous order.
+        const size_t numberOfPointChunks = std::max(
+            std::min(static_cast<size_t>(maxNumberOfThreads()),
+                     numberOfPoints / kMinNumberOfPointsPerChunk),
+            kOneSize);
+        const size_t pointChunkSize =
+            (numberOfPoints + numberOfPointChunks - 1) / numberOfPointChunks;
+        std::vector<size_t> offsets(numberOfPointChunks * tableSize, 0);
+        parallelFor(kZeroSize, numberOfPointChunks, [&](size_t c) {
+            size_t* counts = offsets.data() + c * tableSize;
+            const size_t end =
+                std::min((c + 1) * pointChunkSize, numberOfPoints);
+            for (size_t i = c * pointChunkSize; i < end; ++i) {
+                ++counts[tempKeys[i]];
+            }
+        });
+
+        // Exclusive prefix sum of the counts over fixed chunks of the table:
+        // the chunk totals are summed in parallel, scanned serially, and then
+        // each table chunk writes its own offsets in parallel.
+        const size_t chunkSize = std::max(
+            tableSize / (8 * static_cast<size_t>(maxNumberOfThreads())),
+            kOneSize);
+        const size_t numberOfChunks = (tableSize + chunkSize - 1) / chunkSize;
+        std::vector<size_t> chunkOffsets(numberOfChunks + 1, 0);
+        parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+            const size_t end = std::min((c + 1) * chunkSize, tableSize);
+            size_t sum = 0;
+            for (size_t p = 0; p < numberOfPointChunks; ++p) {
+                const size_t* counts = offsets.data() + p * tableSize;
+                for (size_t b = c * chunkSize; b < end; ++b) {
+                    sum += counts[b];
+                }
+            }
+            chunkOffsets[c + 1] = sum;
+        });
+        for (size_t c = 0; c < numberOfChunks; ++c) {
+            chunkOffsets[c + 1] += chunkOffsets[c];
+        }
+        parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+            const size_t end = std::min((c + 1) * chunkSize, tableSize);
+            size_t offset = chunkOffsets[c];
+            for (size_t b = c * chunkSize; b < end; ++b) {
+                const size_t start = offset;
+                for (size_t p = 0; p < numberOfPointChunks; ++p) {
+                    size_t& count = offsets[p * tableSize + b];
+                    const size_t n = count;
+                    count = offset;
+                    offset += n;
+                }
+                if (offset > start) {
+                    _startIndexTable[b] = start;
+                    _endIndexTable[b] = offset;
+                }
+            }
+        });
 
-    // Assume that _keys array looks like:
-    // [5|8|8|10|10|10]
-    // Then _startIndexTable and _endIndexTable should be like:
-    // [.....|0|...|1|..|3|..]
-    // [.....|1|...|3|..|6|..]
-    //       ^5    ^8   ^10
-    // So that _endIndexTable[i] - _startIndexTable[i] is the number points
-    // in i-th table bucket.
+        std::vector<size_t> newSortedIndices(numberOfPoints);
+        parallelFor(kZeroSize, numberOfPointChunks, [&](size_t c) {
+            size_t* cursors = offsets.data() + c * tableSize;
+            const size_t end =
+                std::min((c + 1) * pointChunkSize, numberOfPoints);
+            for (size_t i = c * pointChunkSize; i < end; ++i) {
+                size_t key = tempKeys[i];
+                size_t dst = cursors[key]++;
+                _keys[dst] = key;
+                newSortedIndices[dst] = _sortedIndices[i];
+            }
+        });
 
-    _startIndexTable[_keys[0]] = 0;
-    _endIndexTable[_keys[numberOfPoints - 1]] = numberOfPoints;
+        _sortedIndices.swap(newSortedIndices);
+    }
 
+    // Re-order point array
     parallelFor(
-        (size_t)1,
+        kZeroSize,
         numberOfPoints,
         [&](size_t i) {
-            if (_keys[i] > _keys[i - 1]) {
-                _startIndexTable[_keys[i]] = i;
-                _endIndexTable[_keys[i - 1]] = i;
-            }
+            _points[i] = points[_sortedIndices[i]];
         });
 
     size_t sumNumberOfPointsPerBucket = 0;
@@ -146,38 +265,12 @@ void PointParallelHashGridSearcher3::build(
 }
 
 void PointParallelHashGridSearcher3::forEachNearbyPoint(
-    const Vector3D& origin,
-    double radius,
+    const Vector3D& origin, double radius,
     const ForEachNearbyPointFunc& callback) const {
-    size_t nearbyKeys[8];
-    getNearbyKeys(origin, nearbyKeys);
-
-    const double queryRadiusSquared = radius * radius;
-
-    for (int i = 0; i < 8; i++) {
-        size_t nearbyKey = nearbyKeys[i];
-        size_t start = _startIndexTable[nearbyKey];
-        size_t end = _endIndexTable[nearbyKey];
-
-        // Empty bucket -- continue to next bucket
-        if (start == kMaxSize) {
-            continue;
-        }
-
-        for (size_t j = start; j < end; ++j) {
-            Vector3D direction = _points[j] - origin;
-            double distanceSquared = direction.lengthSquared();
-            if (distanceSquared <= queryRadiusSquared) {
-                double distance = 0.0;
-                if (distanceSquared > 0) {
-                    distance = std::sqrt(distanceSquared);
-                    direction /= distance;
-                }
-
-                callback(_sortedIndices[j], _points[j]);
-            }
-        }
-    }
+    visitNearbyPoints(origin, radius,
+                      [&callback](size_t i, const Vector3D& pt, double) {
+                          callback(i, pt);
+                      });
 }
 
 bool PointParallelHashGridSearcher3::hasNearbyPoint(
@@ -210,6 +303,15 @@ bool PointParallelHashGridSearcher3::hasNearbyPoint(
     return false;
 }
 
+void PointParallelHashGridSearcher3::findNearbyPoints(
+    const ConstArrayAccessor1<Vector3D>& origins, double radius,
+    ParticleNeighborLists* lists,
+    std::vector<double>* distancesSquared,
+    NearbyPointBuffers* buffers) const {
+    buildNearbyPointLists(*this, origins, radius, lists, distancesSquared,
+                          buffers);
+}
+
 const std::vector<size_t>& PointParallelHashGridSearcher3::keys() const {
     return _keys;
 }
@@ -229,6 +331,16 @@ PointParallelHashGridSearcher3::sortedIndices() const {
     return _sortedIndices;
 }
 
+double PointParallelHashGridSearcher3::gridSpacing() const {
+    return _gridSpacing;
+}
+
+Size3 PointParallelHashGridSearcher3::resolution() const {
+    return Size3(static_cast<size_t>(_resolution.x),
+                 static_cast<size_t>(_resolution.y),
+                 static_cast<size_t>(_resolution.z));
+}
+
 Point3I PointParallelHashGridSearcher3::getBucketIndex(
     const Vector3D& position) const {
     Point3I bucketIndex;
@@ -7,6 +7,8 @@
 #include <pch.h>
 #include <jet/point_particle_emitter3.h>
 #include <jet/samplers.h>
+#include <string>
+#include <vector>
 
 namespace jet {
 
@@ -110,6 +112,24 @@ double PointParticleEmitter3::random() {
     return d(_rng);
 }
 
+void PointParticleEmitter3::saveCheckpoint(const std::string& prefix,
+                                           Checkpoint* checkpoint) const {
+    checkpoint->setRandomEngine(prefix + "rng", _rng);
+    checkpoint->setValue(prefix + "firstFrameTimeInSeconds",
+                         _firstFrameTimeInSeconds);
+    checkpoint->setValue(prefix + "numberOfEmittedParticles",
+                         _numberOfEmittedParticles);
+}
+
+void PointParticleEmitter3::loadCheckpoint(const std::string& prefix,
+                                           const Checkpoint& checkpoint) {
+    checkpoint.getRandomEngine(prefix + "rng", &_rng);
+    checkpoint.getValue(prefix + "firstFrameTimeInSeconds",
+                        &_firstFrameTimeInSeconds);
+    checkpoint.getValue(prefix + "numberOfEmittedParticles",
+                        &_numberOfEmittedParticles);
+}
+
 PointParticleEmitter3::Builder PointParticleEmitter3::builder() {
     return Builder();
 }
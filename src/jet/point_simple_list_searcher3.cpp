@@ -30,17 +30,12 @@ void PointSimpleListSearcher3::build(
 }
 
 void PointSimpleListSearcher3::forEachNearbyPoint(
-    const Vector3D& origin,
-    double radius,
-    const std::function<void(size_t, const Vector3D&)>& callback) const {
-    double radiusSquared = radius * radius;
-    for (size_t i = 0; i < _points.size(); ++i) {
-        Vector3D r = _points[i] - origin;
-        double distanceSquared = r.dot(r);
-        if (distanceSquared <= radiusSquared) {
-            callback(i, _points[i]);
-        }
-    }
+    const Vector3D& origin, double radius,
+    const ForEachNearbyPointFunc& callback) const {
+    visitNearbyPoints(origin, radius,
+                      [&callback](size_t i, const Vector3D& pt, double) {
+                          callback(i, pt);
+                      });
 }
 
 bool PointSimpleListSearcher3::hasNearbyPoint(
@@ -58,6 +53,15 @@ bool PointSimpleListSearcher3::hasNearbyPoint(
     return false;
 }
 
+void PointSimpleListSearcher3::findNearbyPoints(
+    const ConstArrayAccessor1<Vector3D>& origins, double radius,
+    ParticleNeighborLists* lists,
+    std::vector<double>* distancesSquared,
+    NearbyPointBuffers* buffers) const {
+    buildNearbyPointLists(*this, origins, radius, lists, distancesSquared,
+                          buffers);
+}
+
 PointNeighborSearcher3Ptr PointSimpleListSearcher3::clone() const {
     return CLONE_W_CUSTOM_DELETER(PointSimpleListSearcher3);
 }
@@ -6,10 +6,213 @@
 
 #include <pch.h>
 
+#include <jet/array3.h>
+#include <jet/fmm_level_set_solver3.h>
+#include <jet/level_set_utils.h>
 #include <jet/points_to_implicit3.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace jet;
 
+namespace {
+
+// Number of grid points along each axis of the narrow-band blocks
+const size_t kNarrowBandBlockSize = 8;
+
+// Marks the narrow-band blocks overlapping the kernel bounds of the points.
+Array3<char> markActiveBlocks(const ConstArrayAccessor1<Vector3D>& points,
+                              double radius, const ScalarGrid3& output) {
+    const Size3 size = output.dataSize();
+    const Vector3D origin = output.dataOrigin();
+    const Vector3D invGridSpacing = 1.0 / output.gridSpacing();
+    const Size3 numberOfBlocks(
+        (size.x + kNarrowBandBlockSize - 1) / kNarrowBandBlockSize,
+        (size.y + kNarrowBandBlockSize - 1) / kNarrowBandBlockSize,
+        (size.z + kNarrowBandBlockSize - 1) / kNarrowBandBlockSize);
+
+    // Splat the points into the blocks overlapping their kernel bounds.
+    Array3<char> isActive(numberOfBlocks, 0);
+    for (size_t n = 0; n < points.size(); ++n) {
+        const Vector3D lower = (points[n] - origin - radius) * invGridSpacing;
+        const Vector3D upper = (points[n] - origin + radius) * invGridSpacing;
+
+        size_t begin[3];
+        size_t end[3];
+        bool isOutside = false;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const double lo = std::floor(lower[axis]);
+            const double hi = std::floor(upper[axis]) + 1.0;
+            const double maxIndex = static_cast<double>(size[axis]);
+            if (hi <= 0.0 || lo >= maxIndex) {
+                isOutside = true;
+                break;
+            }
+
+            begin[axis] = static_cast<size_t>(std::max(lo, 0.0)) /
+                          kNarrowBandBlockSize;
+            end[axis] = (static_cast<size_t>(std::min(hi, maxIndex)) - 1) /
+                            kNarrowBandBlockSize +
+                        1;
+        }
+
+        if (isOutside) {
+            continue;
+        }
+
+        for (size_t bk = begin[2]; bk < end[2]; ++bk) {
+            for (size_t bj = begin[1]; bj < end[1]; ++bj) {
+                for (size_t bi = begin[0]; bi < end[0]; ++bi) {
+                    isActive(bi, bj, bk) = 1;
+                }
+            }
+        }
+    }
+
+    return isActive;
+}
+
+}  // namespace
+
 PointsToImplicit3::PointsToImplicit3() {}
 
 PointsToImplicit3::~PointsToImplicit3() {}
+
+bool PointsToImplicit3::isNarrowBandEnabled() const {
+    return _isNarrowBandEnabled;
+}
+
+void PointsToImplicit3::setIsNarrowBandEnabled(bool isEnabled) {
+    _isNarrowBandEnabled = isEnabled;
+}
+
+const LevelSetSolver3Ptr& PointsToImplicit3::levelSetSolver() const {
+    return _levelSetSolver;
+}
+
+void PointsToImplicit3::setLevelSetSolver(const LevelSetSolver3Ptr& solver) {
+    _levelSetSolver = solver;
+}
+
+void PointsToImplicit3::evaluate(
+    const ConstArrayAccessor1<Vector3D>& points, double radius,
+    double farValue, const std::function<double(const Vector3D&)>& func,
+    ScalarGrid3* output) const {
+    if (!_isNarrowBandEnabled) {
+        output->fill(func);
+        return;
+    }
+
+    const Array3<char> isActive = markActiveBlocks(points, radius, *output);
+
+    // Evaluate the function only within the active blocks.
+    auto data = output->dataAccessor();
+    auto pos = output->dataPosition();
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (isActive(i / kNarrowBandBlockSize, j / kNarrowBandBlockSize,
+                     k / kNarrowBandBlockSize)) {
+            data(i, j, k) = func(pos(i, j, k));
+        } else {
+            data(i, j, k) = farValue;
+        }
+    });
+}
+
+void PointsToImplicit3::reinitialize(const ScalarGrid3& input,
+                                     double bandWidth,
+                                     ScalarGrid3* output) const {
+    LevelSetSolver3Ptr solver = _levelSetSolver;
+    if (solver == nullptr) {
+        solver = std::make_shared<FmmLevelSetSolver3>();
+    }
+
+    if (!_isNarrowBandEnabled) {
+        solver->reinitialize(input, kMaxD, output);
+        return;
+    }
+
+    // Away from the interface, the input values only provide the sign to the
+    // level set solver. Replacing them with the band width bounds the
+    // points which are not reached by the band-limited solve.
+    const Size3 size = input.dataSize();
+    const auto in = input.constDataAccessor();
+    auto band = input.clone();
+    auto bandData = band->dataAccessor();
+    band->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const bool isInside = isInsideSdf(in(i, j, k));
+        const bool isNearInterface =
+            (i > 0 && isInsideSdf(in(i - 1, j, k)) != isInside) ||
+            (i + 1 < size.x && isInsideSdf(in(i + 1, j, k)) != isInside) ||
+            (j > 0 && isInsideSdf(in(i, j - 1, k)) != isInside) ||
+            (j + 1 < size.y && isInsideSdf(in(i, j + 1, k)) != isInside) ||
+            (k > 0 && isInsideSdf(in(i, j, k - 1)) != isInside) ||
+            (k + 1 < size.z && isInsideSdf(in(i, j, k + 1)) != isInside);
+        if (!isNearInterface) {
+            bandData(i, j, k) = isInside ? -bandWidth : bandWidth;
+        }
+    });
+
+    solver->reinitialize(*band, bandWidth, output);
+
+    auto outData = output->dataAccessor();
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        outData(i, j, k) = clamp(outData(i, j, k), -bandWidth, bandWidth);
+    });
+}
+
+void PointsToImplicit3::evaluateInBatches(
+    const ConstArrayAccessor1<Vector3D>& points, double radius,
+    double farValue,
+    const std::function<void(const ConstArrayAccessor1<Vector3D>&,
+                             ArrayAccessor1<double>)>& func,
+    ScalarGrid3* output) const {
+    const Size3 size = output->dataSize();
+    Array3<char> isActive;
+    if (_isNarrowBandEnabled) {
+        isActive = markActiveBlocks(points, radius, *output);
+    }
+
+    auto data = output->dataAccessor();
+    auto pos = output->dataPosition();
+    std::vector<Vector3D> positions;
+    std::vector<double> values;
+    positions.reserve(size.x * size.y);
+    for (size_t k = 0; k < size.z; ++k) {
+        // Gather the grid points to evaluate in this slab.
+        positions.clear();
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                if (!_isNarrowBandEnabled ||
+                    isActive(i / kNarrowBandBlockSize,
+                             j / kNarrowBandBlockSize,
+                             k / kNarrowBandBlockSize)) {
+                    positions.push_back(pos(i, j, k));
+                } else {
+                    data(i, j, k) = farValue;
+                }
+            }
+        }
+
+        if (positions.empty()) {
+            continue;
+        }
+
+        values.resize(positions.size());
+        func(ConstArrayAccessor1<Vector3D>(positions.size(), positions.data()),
+             ArrayAccessor1<double>(values.size(), values.data()));
+
+        // Scatter the values back in the same order.
+        size_t n = 0;
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                if (!_isNarrowBandEnabled ||
+                    isActive(i / kNarrowBandBlockSize,
+                             j / kNarrowBandBlockSize,
+                             k / kNarrowBandBlockSize)) {
+                    data(i, j, k) = values[n++];
+                }
+            }
+        }
+    }
+}
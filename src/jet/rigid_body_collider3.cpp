@@ -6,9 +6,19 @@
 
 #include <pch.h>
 #include <jet/rigid_body_collider3.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+
+#include <cmath>
 
 using namespace jet;
 
+namespace {
+
+// Number of cells around the surface bounds in the cached SDF
+const double kSdfCacheMargin = 4.0;
+
+}  // namespace
+
 RigidBodyCollider3::RigidBodyCollider3(const Surface3Ptr& surface) {
     setSurface(surface);
 }
@@ -27,6 +37,111 @@ Vector3D RigidBodyCollider3::velocityAt(const Vector3D& point) const {
     return linearVelocity + angularVelocity.cross(r);
 }
 
+double RigidBodyCollider3::signedDistance(const Vector3D& point) const {
+    if (_sdfCache == nullptr) {
+        return Collider3::signedDistance(point);
+    }
+
+    return sampleSdfCache(surface()->transform.toLocal(point));
+}
+
+double RigidBodyCollider3::sdfCacheGridSpacing() const {
+    return _sdfCacheGridSpacing;
+}
+
+void RigidBodyCollider3::setSdfCacheGridSpacing(double gridSpacing) {
+    _sdfCacheGridSpacing = std::max(gridSpacing, 0.0);
+    updateSdfCache();
+}
+
+void RigidBodyCollider3::saveCheckpoint(const std::string& prefix,
+                                        Checkpoint* checkpoint) const {
+    Collider3::saveCheckpoint(prefix, checkpoint);
+    checkpoint->setValue(prefix + "linearVelocity", linearVelocity);
+    checkpoint->setValue(prefix + "angularVelocity", angularVelocity);
+}
+
+void RigidBodyCollider3::loadCheckpoint(const std::string& prefix,
+                                        const Checkpoint& checkpoint) {
+    Collider3::loadCheckpoint(prefix, checkpoint);
+    checkpoint.getValue(prefix + "linearVelocity", &linearVelocity);
+    checkpoint.getValue(prefix + "angularVelocity", &angularVelocity);
+}
+
+void RigidBodyCollider3::updateSdfCache() {
+    _sdfCache.reset();
+    if (_sdfCacheGridSpacing <= 0.0 || surface() == nullptr) {
+        return;
+    }
+
+    const Transform3& transform = surface()->transform;
+    const double h = _sdfCacheGridSpacing;
+
+    // Unbounded surfaces such as planes cannot be baked.
+    BoundingBox3D bounds = transform.toLocal(surface()->boundingBox());
+    for (size_t axis = 0; axis < 3; ++axis) {
+        if (!(std::fabs(bounds.lowerCorner[axis]) < kMaxD &&
+              std::fabs(bounds.upperCorner[axis]) < kMaxD &&
+              std::isfinite(bounds.upperCorner[axis] -
+                            bounds.lowerCorner[axis]))) {
+            return;
+        }
+    }
+    bounds.expand(kSdfCacheMargin * h);
+
+    const Size3 resolution(
+        static_cast<size_t>(std::ceil(bounds.width() / h)),
+        static_cast<size_t>(std::ceil(bounds.height() / h)),
+        static_cast<size_t>(std::ceil(bounds.depth() / h)));
+
+    // Bake the distances at the local grid points using the surface with its
+    // current transform. The transform is rigid, so the distances are valid
+    // for any later transform.
+    auto sdfCache = std::make_shared<VertexCenteredScalarGrid3>(
+        resolution, Vector3D(h, h, h), bounds.lowerCorner);
+    sdfCache->fill([&](const Vector3D& x) {
+        return Collider3::signedDistance(transform.toWorld(x));
+    });
+
+    _sdfCacheBounds = sdfCache->boundingBox();
+    _sdfCache = sdfCache;
+}
+
+void RigidBodyCollider3::getClosestPoint(const Surface3Ptr& surface,
+                                         const Vector3D& queryPoint,
+                                         ColliderQueryResult* result) const {
+    if (_sdfCache == nullptr || surface != this->surface()) {
+        Collider3::getClosestPoint(surface, queryPoint, result);
+        return;
+    }
+
+    const Transform3& transform = surface->transform;
+    const Vector3D x = transform.toLocal(queryPoint);
+    const Vector3D clamped = _sdfCacheBounds.clamp(x);
+    Vector3D normal = _sdfCache->gradient(clamped);
+    if (x != clamped) {
+        normal = x - clamped;
+    }
+
+    // Fall back to the surface query where the normal is undefined.
+    const double normalLength = normal.length();
+    if (normalLength < kEpsilonD) {
+        Collider3::getClosestPoint(surface, queryPoint, result);
+        return;
+    }
+
+    const double phi = sampleSdfCache(x);
+    result->normal = transform.toWorldDirection(normal / normalLength);
+    result->distance = std::fabs(phi);
+    result->point = queryPoint - phi * result->normal;
+    result->velocity = velocityAt(queryPoint);
+}
+
+double RigidBodyCollider3::sampleSdfCache(const Vector3D& pointInLocal) const {
+    const Vector3D clamped = _sdfCacheBounds.clamp(pointInLocal);
+    return _sdfCache->sample(clamped) + pointInLocal.distanceTo(clamped);
+}
+
 RigidBodyCollider3::Builder RigidBodyCollider3::builder() {
     return Builder();
 }
@@ -51,15 +166,23 @@ RigidBodyCollider3::Builder::withAngularVelocity(
     return *this;
 }
 
+RigidBodyCollider3::Builder&
+RigidBodyCollider3::Builder::withSdfCacheGridSpacing(double gridSpacing) {
+    _sdfCacheGridSpacing = gridSpacing;
+    return *this;
+}
+
 RigidBodyCollider3 RigidBodyCollider3::Builder::build() const {
-    return RigidBodyCollider3(
+    RigidBodyCollider3 collider(
         _surface,
         _linearVelocity,
         _angularVelocity);
+    collider.setSdfCacheGridSpacing(_sdfCacheGridSpacing);
+    return collider;
 }
 
 RigidBodyCollider3Ptr RigidBodyCollider3::Builder::makeShared() const {
-    return std::shared_ptr<RigidBodyCollider3>(
+    auto collider = std::shared_ptr<RigidBodyCollider3>(
         new RigidBodyCollider3(
             _surface,
             _linearVelocity,
@@ -67,4 +190,6 @@ RigidBodyCollider3Ptr RigidBodyCollider3::Builder::makeShared() const {
         [] (RigidBodyCollider3* obj) {
             delete obj;
     });
+    collider->setSdfCacheGridSpacing(_sdfCacheGridSpacing);
+    return collider;
 }
@@ -9,9 +9,151 @@
 #include <jet/parallel.h>
 #include <jet/semi_lagrangian3.h>
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 using namespace jet;
 
+namespace {
+
+// Groups the grids whose data points coincide while keeping the input order.
+template <typename GridType, typename Predicate>
+std::vector<std::vector<size_t>> groupGrids(
+    const std::vector<GridType*>& grids, const Predicate& isSameDataPoints) {
+    std::vector<std::vector<size_t>> groups;
+    for (size_t n = 0; n < grids.size(); ++n) {
+        auto iter = std::find_if(
+            groups.begin(), groups.end(),
+            [&](const std::vector<size_t>& group) {
+                return isSameDataPoints(*grids[group.front()], *grids[n]);
+            });
+        if (iter == groups.end()) {
+            groups.push_back({n});
+        } else {
+            iter->push_back(n);
+        }
+    }
+    return groups;
+}
+
+template <typename GridType>
+bool hasSameDataPoints(const GridType& a, const GridType& b) {
+    return a.dataSize() == b.dataSize() && a.dataOrigin() == b.dataOrigin() &&
+           a.gridSpacing() == b.gridSpacing();
+}
+
+bool hasSameFaces(const FaceCenteredGrid3& a, const FaceCenteredGrid3& b) {
+    return a.hasSameShape(b);
+}
+
+const size_t kBackTraceBatchSize = 256;
+
+// Traces the points back along the flow with the adaptive mid-point rule. The
+// flow is sampled with one batched call for all the points still moving, so
+// the flow field can share the sampling work across the points.
+void backTrace(const VectorField3& flow, double dt, double h,
+               const std::vector<Vector3D>& startPts,
+               const ScalarField3& boundarySdf,
+               std::vector<Vector3D>* endPts) {
+    const size_t numberOfPoints = startPts.size();
+    std::vector<Vector3D> pts0(startPts);
+    std::vector<double> remainingTs(numberOfPoints, dt);
+    *endPts = startPts;
+
+    std::vector<size_t> moving;
+    if (dt > kEpsilonD) {
+        moving.resize(numberOfPoints);
+        for (size_t n = 0; n < numberOfPoints; ++n) {
+            moving[n] = n;
+        }
+    }
+
+    std::vector<Vector3D> samplePts;
+    std::vector<Vector3D> vels;
+    std::vector<double> subDts;
+    while (!moving.empty()) {
+        const size_t m = moving.size();
+        samplePts.resize(m);
+        vels.resize(m);
+        subDts.resize(m);
+        ConstArrayAccessor1<Vector3D> samplePtsAcc(m, samplePts.data());
+        ArrayAccessor1<Vector3D> velsAcc(m, vels.data());
+
+        for (size_t a = 0; a < m; ++a) {
+            samplePts[a] = pts0[moving[a]];
+        }
+        flow.sample(samplePtsAcc, velsAcc, ExecutionPolicy::kSerial);
+
+        for (size_t a = 0; a < m; ++a) {
+            const size_t n = moving[a];
+
+            // Adaptive time-stepping
+            double numSubSteps = std::max(
+                std::ceil(vels[a].length() * remainingTs[n] / h), 1.0);
+            subDts[a] = remainingTs[n] / numSubSteps;
+
+            // Mid-point rule
+            samplePts[a] = pts0[n] - 0.5 * subDts[a] * vels[a];
+        }
+        flow.sample(samplePtsAcc, velsAcc, ExecutionPolicy::kSerial);
+
+        size_t numberOfMoving = 0;
+        for (size_t a = 0; a < m; ++a) {
+            const size_t n = moving[a];
+            Vector3D pt1 = pts0[n] - subDts[a] * vels[a];
+
+            // Boundary handling
+            double phi0 = boundarySdf.sample(pts0[n]);
+            double phi1 = boundarySdf.sample(pt1);
+
+            if (phi0 * phi1 < 0.0) {
+                double w
+                    = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
+                (*endPts)[n] = w * pts0[n] + (1.0 - w) * pt1;
+                continue;
+            }
+
+            (*endPts)[n] = pt1;
+            remainingTs[n] -= subDts[a];
+            pts0[n] = pt1;
+            if (remainingTs[n] > kEpsilonD) {
+                moving[numberOfMoving++] = n;
+            }
+        }
+        moving.resize(numberOfMoving);
+    }
+}
+
+// Back-traces the data points outside the collider row by row, and invokes
+// func(i, j, k, pt) with the departure point pt of each of them.
+template <typename Callback>
+void forEachDeparturePoint(const Size3& size,
+                           const Grid3::DataPositionFunc& sourceDataPos,
+                           const Grid3::DataPositionFunc& targetDataPos,
+                           const VectorField3& flow, double dt, double h,
+                           const ScalarField3& boundarySdf,
+                           const Callback& func) {
+    parallelFor(kZeroSize, size.y, kZeroSize, size.z, [&](size_t j, size_t k) {
+        std::vector<size_t> iIndices;
+        std::vector<Vector3D> startPts;
+        std::vector<Vector3D> endPts;
+        for (size_t i = 0; i < size.x; ++i) {
+            if (boundarySdf.sample(sourceDataPos(i, j, k)) > 0.0) {
+                iIndices.push_back(i);
+                startPts.push_back(targetDataPos(i, j, k));
+            }
+        }
+
+        backTrace(flow, dt, h, startPts, boundarySdf, &endPts);
+
+        for (size_t n = 0; n < iIndices.size(); ++n) {
+            func(iIndices[n], j, k, endPts[n]);
+        }
+    });
+}
+
+}  // namespace
+
 SemiLagrangian3::SemiLagrangian3() {
 }
 
@@ -34,11 +176,52 @@ void SemiLagrangian3::advect(
         output->gridSpacing().y,
         output->gridSpacing().z);
 
-    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, outputDataPos(i, j, k), boundarySdf);
+    forEachDeparturePoint(
+        output->dataSize(), inputDataPos, outputDataPos, flow, dt, h,
+        boundarySdf, [&](size_t i, size_t j, size_t k, const Vector3D& pt) {
             outputDataAcc(i, j, k) = inputSamplerFunc(pt);
+        });
+}
+
+void SemiLagrangian3::advectDataPoints(
+    const ScalarGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<Point3UI>& dataPoints,
+    ScalarGrid3* output,
+    const ScalarField3& boundarySdf) {
+    auto outputDataPos = output->dataPosition();
+    auto outputDataAcc = output->dataAccessor();
+    auto inputSamplerFunc = getScalarSamplerFunc(input);
+    auto inputDataPos = input.dataPosition();
+
+    double h = min3(
+        output->gridSpacing().x,
+        output->gridSpacing().y,
+        output->gridSpacing().z);
+
+    const size_t numberOfBatches
+        = (dataPoints.size() + kBackTraceBatchSize - 1) / kBackTraceBatchSize;
+    parallelFor(kZeroSize, numberOfBatches, [&](size_t b) {
+        const size_t end
+            = std::min((b + 1) * kBackTraceBatchSize, dataPoints.size());
+
+        std::vector<Point3UI> batch;
+        std::vector<Vector3D> startPts;
+        std::vector<Vector3D> endPts;
+        for (size_t n = b * kBackTraceBatchSize; n < end; ++n) {
+            const Point3UI& p = dataPoints[n];
+            if (boundarySdf.sample(inputDataPos(p.x, p.y, p.z)) > 0.0) {
+                batch.push_back(p);
+                startPts.push_back(outputDataPos(p.x, p.y, p.z));
+            }
+        }
+
+        backTrace(flow, dt, h, startPts, boundarySdf, &endPts);
+
+        for (size_t n = 0; n < batch.size(); ++n) {
+            outputDataAcc(batch[n].x, batch[n].y, batch[n].z)
+                = inputSamplerFunc(endPts[n]);
         }
     });
 }
@@ -60,13 +243,11 @@ void SemiLagrangian3::advect(
     auto outputDataAcc = output->dataAccessor();
     auto inputDataPos = input.dataPosition();
 
-    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, outputDataPos(i, j, k), boundarySdf);
+    forEachDeparturePoint(
+        output->dataSize(), inputDataPos, outputDataPos, flow, dt, h,
+        boundarySdf, [&](size_t i, size_t j, size_t k, const Vector3D& pt) {
             outputDataAcc(i, j, k) = inputSamplerFunc(pt);
-        }
-    });
+        });
 }
 
 void SemiLagrangian3::advect(
@@ -86,77 +267,169 @@ void SemiLagrangian3::advect(
     auto uTargetDataAcc = output->uAccessor();
     auto uSourceDataPos = input.uPosition();
 
-    output->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(uSourceDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, uTargetDataPos(i, j, k), boundarySdf);
+    forEachDeparturePoint(
+        output->uSize(), uSourceDataPos, uTargetDataPos, flow, dt, h,
+        boundarySdf, [&](size_t i, size_t j, size_t k, const Vector3D& pt) {
             uTargetDataAcc(i, j, k) = inputSamplerFunc(pt).x;
-        }
-    });
+        });
 
     auto vTargetDataPos = output->vPosition();
     auto vTargetDataAcc = output->vAccessor();
     auto vSourceDataPos = input.vPosition();
 
-    output->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(vSourceDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, vTargetDataPos(i, j, k), boundarySdf);
+    forEachDeparturePoint(
+        output->vSize(), vSourceDataPos, vTargetDataPos, flow, dt, h,
+        boundarySdf, [&](size_t i, size_t j, size_t k, const Vector3D& pt) {
             vTargetDataAcc(i, j, k) = inputSamplerFunc(pt).y;
-        }
-    });
+        });
 
     auto wTargetDataPos = output->wPosition();
     auto wTargetDataAcc = output->wAccessor();
     auto wSourceDataPos = input.wPosition();
 
-    output->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(wSourceDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, wTargetDataPos(i, j, k), boundarySdf);
+    forEachDeparturePoint(
+        output->wSize(), wSourceDataPos, wTargetDataPos, flow, dt, h,
+        boundarySdf, [&](size_t i, size_t j, size_t k, const Vector3D& pt) {
             wTargetDataAcc(i, j, k) = inputSamplerFunc(pt).z;
+        });
+}
+
+void SemiLagrangian3::advect(
+    const std::vector<const ScalarGrid3*>& inputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<ScalarGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(inputs.size() != outputs.size());
+
+    for (const auto& group
+         : groupGrids(outputs, hasSameDataPoints<ScalarGrid3>)) {
+        const ScalarGrid3* input0 = inputs[group.front()];
+        ScalarGrid3* output0 = outputs[group.front()];
+
+        auto outputDataPos = output0->dataPosition();
+        auto inputDataPos = input0->dataPosition();
+
+        std::vector<std::function<double(const Vector3D&)>> inputSamplerFuncs;
+        std::vector<ScalarGrid3::ScalarDataAccessor> outputDataAccs;
+        for (size_t n : group) {
+            inputSamplerFuncs.push_back(getScalarSamplerFunc(*inputs[n]));
+            outputDataAccs.push_back(outputs[n]->dataAccessor());
         }
-    });
+
+        double h = min3(
+            output0->gridSpacing().x,
+            output0->gridSpacing().y,
+            output0->gridSpacing().z);
+
+        forEachDeparturePoint(
+            output0->dataSize(), inputDataPos, outputDataPos, flow, dt, h,
+            boundarySdf,
+            [&](size_t i, size_t j, size_t k, const Vector3D& pt) {
+                for (size_t m = 0; m < group.size(); ++m) {
+                    outputDataAccs[m](i, j, k) = inputSamplerFuncs[m](pt);
+                }
+            });
+    }
 }
 
-Vector3D SemiLagrangian3::backTrace(
+void SemiLagrangian3::advect(
+    const std::vector<const CollocatedVectorGrid3*>& inputs,
     const VectorField3& flow,
     double dt,
-    double h,
-    const Vector3D& startPt,
+    const std::vector<CollocatedVectorGrid3*>& outputs,
     const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(inputs.size() != outputs.size());
 
-    double remainingT = dt;
-    Vector3D pt0 = startPt;
-    Vector3D pt1 = startPt;
-
-    while (remainingT > kEpsilonD) {
-        // Adaptive time-stepping
-        Vector3D vel0 = flow.sample(pt0);
-        double numSubSteps
-            = std::max(std::ceil(vel0.length() * remainingT / h), 1.0);
-        dt = remainingT / numSubSteps;
-
-        // Mid-point rule
-        Vector3D midPt = pt0 - 0.5 * dt * vel0;
-        Vector3D midVel = flow.sample(midPt);
-        pt1 = pt0 - dt * midVel;
-
-        // Boundary handling
-        double phi0 = boundarySdf.sample(pt0);
-        double phi1 = boundarySdf.sample(pt1);
-
-        if (phi0 * phi1 < 0.0) {
-            double w = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
-            pt1 = w * pt0 + (1.0 - w) * pt1;
-            break;
+    for (const auto& group
+         : groupGrids(outputs, hasSameDataPoints<CollocatedVectorGrid3>)) {
+        const CollocatedVectorGrid3* input0 = inputs[group.front()];
+        CollocatedVectorGrid3* output0 = outputs[group.front()];
+
+        auto outputDataPos = output0->dataPosition();
+        auto inputDataPos = input0->dataPosition();
+
+        std::vector<std::function<Vector3D(const Vector3D&)>>
+            inputSamplerFuncs;
+        std::vector<CollocatedVectorGrid3::VectorDataAccessor> outputDataAccs;
+        for (size_t n : group) {
+            inputSamplerFuncs.push_back(getVectorSamplerFunc(*inputs[n]));
+            outputDataAccs.push_back(outputs[n]->dataAccessor());
         }
 
-        remainingT -= dt;
-        pt0 = pt1;
+        double h = min3(
+            output0->gridSpacing().x,
+            output0->gridSpacing().y,
+            output0->gridSpacing().z);
+
+        forEachDeparturePoint(
+            output0->dataSize(), inputDataPos, outputDataPos, flow, dt, h,
+            boundarySdf,
+            [&](size_t i, size_t j, size_t k, const Vector3D& pt) {
+                for (size_t m = 0; m < group.size(); ++m) {
+                    outputDataAccs[m](i, j, k) = inputSamplerFuncs[m](pt);
+                }
+            });
     }
+}
 
-    return pt1;
+void SemiLagrangian3::advect(
+    const std::vector<const FaceCenteredGrid3*>& inputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<FaceCenteredGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(inputs.size() != outputs.size());
+
+    for (const auto& group : groupGrids(outputs, hasSameFaces)) {
+        const FaceCenteredGrid3* input0 = inputs[group.front()];
+        FaceCenteredGrid3* output0 = outputs[group.front()];
+
+        std::vector<std::function<Vector3D(const Vector3D&)>>
+            inputSamplerFuncs;
+        for (size_t n : group) {
+            inputSamplerFuncs.push_back(getVectorSamplerFunc(*inputs[n]));
+        }
+
+        double h = min3(
+            output0->gridSpacing().x,
+            output0->gridSpacing().y,
+            output0->gridSpacing().z);
+
+        // Traces the faces of the given direction once and gathers that
+        // component of all the grids in the group.
+        auto advectFaces = [&](
+            size_t component, const Size3& size,
+            const FaceCenteredGrid3::DataPositionFunc& targetDataPos,
+            const FaceCenteredGrid3::DataPositionFunc& sourceDataPos,
+            std::vector<FaceCenteredGrid3::ScalarDataAccessor>&
+                targetDataAccs) {
+            forEachDeparturePoint(
+                size, sourceDataPos, targetDataPos, flow, dt, h, boundarySdf,
+                [&](size_t i, size_t j, size_t k, const Vector3D& pt) {
+                    for (size_t m = 0; m < group.size(); ++m) {
+                        targetDataAccs[m](i, j, k) =
+                            inputSamplerFuncs[m](pt)[component];
+                    }
+                });
+        };
+
+        std::vector<FaceCenteredGrid3::ScalarDataAccessor> uTargetDataAccs;
+        std::vector<FaceCenteredGrid3::ScalarDataAccessor> vTargetDataAccs;
+        std::vector<FaceCenteredGrid3::ScalarDataAccessor> wTargetDataAccs;
+        for (size_t n : group) {
+            uTargetDataAccs.push_back(outputs[n]->uAccessor());
+            vTargetDataAccs.push_back(outputs[n]->vAccessor());
+            wTargetDataAccs.push_back(outputs[n]->wAccessor());
+        }
+
+        advectFaces(0, output0->uSize(), output0->uPosition(),
+                    input0->uPosition(), uTargetDataAccs);
+        advectFaces(1, output0->vSize(), output0->vPosition(),
+                    input0->vPosition(), vTargetDataAccs);
+        advectFaces(2, output0->wSize(), output0->wPosition(),
+                    input0->wPosition(), wTargetDataAccs);
+    }
 }
 
 std::function<double(const Vector3D&)>
@@ -0,0 +1,154 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/constants.h>
+#include <jet/parallel.h>
+#include <jet/soa_vector_array3.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+using namespace jet;
+
+constexpr size_t SoaVectorArray3::kAlignment;
+
+SoaVectorArray3::SoaVectorArray3() {}
+
+SoaVectorArray3::SoaVectorArray3(size_t size) { resize(size); }
+
+SoaVectorArray3::SoaVectorArray3(const SoaVectorArray3& other) {
+    set(other);
+}
+
+SoaVectorArray3::SoaVectorArray3(SoaVectorArray3&& other)
+    : _size(other._size),
+      _stride(other._stride),
+      _buffer(std::move(other._buffer)) {
+    other._size = 0;
+    other._stride = 0;
+}
+
+size_t SoaVectorArray3::size() const { return _size; }
+
+void SoaVectorArray3::resize(size_t size) {
+    if (size == _size) {
+        return;
+    }
+
+    // Round the stride up so that all three channels stay aligned, and pad
+    // the buffer to align the first channel.
+    const size_t lanes = kAlignment / sizeof(double);
+    const size_t stride = (size + lanes - 1) / lanes * lanes;
+
+    SoaVectorArray3 newArray;
+    newArray._size = size;
+    newArray._stride = stride;
+    newArray._buffer.resize(3 * stride + lanes, 0.0);
+
+    const size_t n = std::min(size, _size);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        std::copy(channel(axis), channel(axis) + n, newArray.channel(axis));
+    }
+
+    *this = std::move(newArray);
+}
+
+double* SoaVectorArray3::x() { return channel(0); }
+
+const double* SoaVectorArray3::x() const { return channel(0); }
+
+double* SoaVectorArray3::y() { return channel(1); }
+
+const double* SoaVectorArray3::y() const { return channel(1); }
+
+double* SoaVectorArray3::z() { return channel(2); }
+
+const double* SoaVectorArray3::z() const { return channel(2); }
+
+Vector3D SoaVectorArray3::operator[](size_t i) const {
+    JET_ASSERT(i < _size);
+    return Vector3D(x()[i], y()[i], z()[i]);
+}
+
+void SoaVectorArray3::set(size_t i, const Vector3D& value) {
+    JET_ASSERT(i < _size);
+    x()[i] = value.x;
+    y()[i] = value.y;
+    z()[i] = value.z;
+}
+
+void SoaVectorArray3::set(const SoaVectorArray3& other) {
+    if (&other == this) {
+        return;
+    }
+
+    resize(other._size);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        std::copy(other.channel(axis), other.channel(axis) + _size,
+                  channel(axis));
+    }
+}
+
+void SoaVectorArray3::copyFrom(const ConstArrayAccessor1<Vector3D>& input) {
+    resize(input.size());
+
+    double* xs = x();
+    double* ys = y();
+    double* zs = z();
+    parallelFor(kZeroSize, _size, [&](size_t i) {
+        xs[i] = input[i].x;
+        ys[i] = input[i].y;
+        zs[i] = input[i].z;
+    });
+}
+
+void SoaVectorArray3::copyTo(ArrayAccessor1<Vector3D> output) const {
+    JET_ASSERT(output.size() == _size);
+
+    const double* xs = x();
+    const double* ys = y();
+    const double* zs = z();
+    parallelFor(kZeroSize, _size, [&](size_t i) {
+        output[i] = Vector3D(xs[i], ys[i], zs[i]);
+    });
+}
+
+SoaVectorArray3& SoaVectorArray3::operator=(const SoaVectorArray3& other) {
+    set(other);
+    return *this;
+}
+
+SoaVectorArray3& SoaVectorArray3::operator=(SoaVectorArray3&& other) {
+    _size = other._size;
+    _stride = other._stride;
+    _buffer = std::move(other._buffer);
+    other._size = 0;
+    other._stride = 0;
+    return *this;
+}
+
+double* SoaVectorArray3::channel(size_t axis) {
+    return const_cast<double*>(
+        static_cast<const SoaVectorArray3&>(*this).channel(axis));
+}
+
+const double* SoaVectorArray3::channel(size_t axis) const {
+    if (_buffer.empty()) {
+        return nullptr;
+    }
+
+    // The buffer is aligned to sizeof(double), so the padding is a whole
+    // number of elements.
+    const std::uintptr_t address =
+        reinterpret_cast<std::uintptr_t>(_buffer.data());
+    const std::uintptr_t aligned =
+        (address + kAlignment - 1) / kAlignment * kAlignment;
+    return _buffer.data() + (aligned - address) / sizeof(double) +
+           axis * _stride;
+}
@@ -6,7 +6,7 @@
 
 #include <pch.h>
 
-#include <jet/fmm_level_set_solver3.h>
+#include <jet/parallel.h>
 #include <jet/sph_points_to_implicit3.h>
 #include <jet/sph_system_data3.h>
 
@@ -46,14 +46,17 @@ void SphPointsToImplicit3::convert(const ConstArrayAccessor1<Vector3D>& points,
 
     Array1<double> constData(sphParticles.numberOfParticles(), 1.0);
     auto temp = output->clone();
-    temp->fill([&](const Vector3D& x) {
-        double d = sphParticles.interpolate(x, constData);
-        return _cutOffDensity - d;
-    });
+    evaluateInBatches(
+        points, _kernelRadius, _cutOffDensity,
+        [&](const ConstArrayAccessor1<Vector3D>& x, ArrayAccessor1<double> d) {
+            sphParticles.interpolate(x, constData, d);
+            parallelFor(kZeroSize, d.size(),
+                        [&](size_t i) { d[i] = _cutOffDensity - d[i]; });
+        },
+        temp.get());
 
     if (_isOutputSdf) {
-        FmmLevelSetSolver3 solver;
-        solver.reinitialize(*temp, kMaxD, output);
+        reinitialize(*temp, _kernelRadius, output);
     } else {
         temp->swap(output);
     }
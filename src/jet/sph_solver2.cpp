@@ -217,7 +217,7 @@ void SphSolver2::accumulatePressureForce(
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
+            auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = positions[i].distanceTo(positions[j]);
 
@@ -248,7 +248,7 @@ void SphSolver2::accumulateViscosityForce() {
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
+            auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = x[i].distanceTo(x[j]);
 
@@ -278,7 +278,7 @@ void SphSolver2::computePseudoViscosity(double timeStepInSeconds) {
             double weightSum = 0.0;
             Vector2D smoothedVelocity;
 
-            const auto& neighbors = particles->neighborLists()[i];
+            auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = x[i].distanceTo(x[j]);
                 double wj = mass / d[j] * kernel(dist);
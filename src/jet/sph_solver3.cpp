@@ -13,11 +13,197 @@
 
 #include <algorithm>
 
+// The AVX2 code paths are compiled when the compiler targets AVX2 and FMA
+// (see JET_USE_AVX2 option).
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define JET_SPH_SOLVER3_AVX2
+#include <immintrin.h>
+#endif
+
 using namespace jet;
 
 static double kTimeStepLimitBySpeedFactor = 0.4;
 static double kTimeStepLimitByForceFactor = 0.25;
 
+namespace {
+
+#ifdef JET_SPH_SOLVER3_AVX2
+static_assert(sizeof(size_t) == sizeof(long long),
+              "The neighbor indices are gathered as 64-bit integers");
+
+// Returns the sum of the four lanes.
+inline double horizontalSum(__m256d v) {
+    const __m128d sum2 =
+        _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+}
+#endif
+
+// Computes -sum_j (c_i + c_j) (1 - r/h)^2 (x_j - x_i) / r over the neighbors
+// within the kernel radius, which is the pressure force of the spiky kernel
+// up to a constant factor.
+Vector3D sumPressureGradient(size_t i, const ConstArrayAccessor1<size_t>& nbrs,
+                             const double* xs, const double* ys,
+                             const double* zs, const double* cs,
+                             double invH) {
+    const double xi = xs[i];
+    const double yi = ys[i];
+    const double zi = zs[i];
+    const double ci = cs[i];
+    double fx = 0.0;
+    double fy = 0.0;
+    double fz = 0.0;
+    size_t n = 0;
+
+#ifdef JET_SPH_SOLVER3_AVX2
+    const __m256d xi4 = _mm256_set1_pd(xi);
+    const __m256d yi4 = _mm256_set1_pd(yi);
+    const __m256d zi4 = _mm256_set1_pd(zi);
+    const __m256d ci4 = _mm256_set1_pd(ci);
+    const __m256d invH4 = _mm256_set1_pd(invH);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d fx4 = zero;
+    __m256d fy4 = zero;
+    __m256d fz4 = zero;
+    for (; n + 4 <= nbrs.size(); n += 4) {
+        const __m256i j4 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(nbrs.data() + n));
+        const __m256d dx = _mm256_sub_pd(
+            _mm256_i64gather_pd(xs, j4, sizeof(double)), xi4);
+        const __m256d dy = _mm256_sub_pd(
+            _mm256_i64gather_pd(ys, j4, sizeof(double)), yi4);
+        const __m256d dz = _mm256_sub_pd(
+            _mm256_i64gather_pd(zs, j4, sizeof(double)), zi4);
+        const __m256d cj = _mm256_i64gather_pd(cs, j4, sizeof(double));
+
+        const __m256d dist = _mm256_sqrt_pd(_mm256_fmadd_pd(
+            dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dz, dz))));
+        const __m256d q = _mm256_fnmadd_pd(dist, invH4, one);
+        const __m256d isValid =
+            _mm256_and_pd(_mm256_cmp_pd(dist, zero, _CMP_GT_OQ),
+                          _mm256_cmp_pd(q, zero, _CMP_GT_OQ));
+        const __m256d w = _mm256_and_pd(
+            _mm256_div_pd(_mm256_mul_pd(_mm256_add_pd(ci4, cj),
+                                        _mm256_mul_pd(q, q)),
+                          dist),
+            isValid);
+
+        fx4 = _mm256_fmadd_pd(w, dx, fx4);
+        fy4 = _mm256_fmadd_pd(w, dy, fy4);
+        fz4 = _mm256_fmadd_pd(w, dz, fz4);
+    }
+    fx = horizontalSum(fx4);
+    fy = horizontalSum(fy4);
+    fz = horizontalSum(fz4);
+#endif
+
+    for (; n < nbrs.size(); ++n) {
+        const size_t j = nbrs[n];
+        const double dx = xs[j] - xi;
+        const double dy = ys[j] - yi;
+        const double dz = zs[j] - zi;
+        const double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const double q = 1.0 - dist * invH;
+        if (dist > 0.0 && q > 0.0) {
+            const double w = (ci + cs[j]) * q * q / dist;
+            fx += w * dx;
+            fy += w * dy;
+            fz += w * dz;
+        }
+    }
+
+    return Vector3D(-fx, -fy, -fz);
+}
+
+// Computes sum_j (v_j - v_i) / d_j (1 - r/h) over the neighbors within the
+// kernel radius, which is the viscosity force of the spiky kernel up to a
+// constant factor.
+Vector3D sumViscosityLaplacian(size_t i,
+                               const ConstArrayAccessor1<size_t>& nbrs,
+                               const double* xs, const double* ys,
+                               const double* zs, const double* vxs,
+                               const double* vys, const double* vzs,
+                               const double* invDs, double invH) {
+    const double xi = xs[i];
+    const double yi = ys[i];
+    const double zi = zs[i];
+    const double vxi = vxs[i];
+    const double vyi = vys[i];
+    const double vzi = vzs[i];
+    double fx = 0.0;
+    double fy = 0.0;
+    double fz = 0.0;
+    size_t n = 0;
+
+#ifdef JET_SPH_SOLVER3_AVX2
+    const __m256d xi4 = _mm256_set1_pd(xi);
+    const __m256d yi4 = _mm256_set1_pd(yi);
+    const __m256d zi4 = _mm256_set1_pd(zi);
+    const __m256d vxi4 = _mm256_set1_pd(vxi);
+    const __m256d vyi4 = _mm256_set1_pd(vyi);
+    const __m256d vzi4 = _mm256_set1_pd(vzi);
+    const __m256d invH4 = _mm256_set1_pd(invH);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d fx4 = zero;
+    __m256d fy4 = zero;
+    __m256d fz4 = zero;
+    for (; n + 4 <= nbrs.size(); n += 4) {
+        const __m256i j4 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(nbrs.data() + n));
+        const __m256d dx = _mm256_sub_pd(
+            _mm256_i64gather_pd(xs, j4, sizeof(double)), xi4);
+        const __m256d dy = _mm256_sub_pd(
+            _mm256_i64gather_pd(ys, j4, sizeof(double)), yi4);
+        const __m256d dz = _mm256_sub_pd(
+            _mm256_i64gather_pd(zs, j4, sizeof(double)), zi4);
+
+        const __m256d dist = _mm256_sqrt_pd(_mm256_fmadd_pd(
+            dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dz, dz))));
+        const __m256d q = _mm256_fnmadd_pd(dist, invH4, one);
+        const __m256d w = _mm256_and_pd(
+            _mm256_mul_pd(_mm256_i64gather_pd(invDs, j4, sizeof(double)), q),
+            _mm256_cmp_pd(q, zero, _CMP_GT_OQ));
+
+        fx4 = _mm256_fmadd_pd(
+            w,
+            _mm256_sub_pd(_mm256_i64gather_pd(vxs, j4, sizeof(double)), vxi4),
+            fx4);
+        fy4 = _mm256_fmadd_pd(
+            w,
+            _mm256_sub_pd(_mm256_i64gather_pd(vys, j4, sizeof(double)), vyi4),
+            fy4);
+        fz4 = _mm256_fmadd_pd(
+            w,
+            _mm256_sub_pd(_mm256_i64gather_pd(vzs, j4, sizeof(double)), vzi4),
+            fz4);
+    }
+    fx = horizontalSum(fx4);
+    fy = horizontalSum(fy4);
+    fz = horizontalSum(fz4);
+#endif
+
+    for (; n < nbrs.size(); ++n) {
+        const size_t j = nbrs[n];
+        const double dx = xs[j] - xi;
+        const double dy = ys[j] - yi;
+        const double dz = zs[j] - zi;
+        const double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const double q = 1.0 - dist * invH;
+        if (q > 0.0) {
+            const double w = invDs[j] * q;
+            fx += w * (vxs[j] - vxi);
+            fy += w * (vys[j] - vyi);
+            fz += w * (vzs[j] - vzi);
+        }
+    }
+
+    return Vector3D(fx, fy, fz);
+}
+
+}  // namespace
+
 SphSolver3::SphSolver3() {
     setParticleSystemData(std::make_shared<SphSystemData3>());
     setIsUsingFixedSubTimeSteps(false);
@@ -122,6 +308,34 @@ unsigned int SphSolver3::numberOfSubTimeSteps(
         std::ceil(timeIntervalInSeconds / desiredTimeStep));
 }
 
+void SphSolver3::onSaveCheckpoint(Checkpoint* checkpoint) const {
+    ParticleSystemSolver3::onSaveCheckpoint(checkpoint);
+
+    checkpoint->setValue("SphSolver3/eosExponent", _eosExponent);
+    checkpoint->setValue("SphSolver3/negativePressureScale",
+                         _negativePressureScale);
+    checkpoint->setValue("SphSolver3/viscosityCoefficient",
+                         _viscosityCoefficient);
+    checkpoint->setValue("SphSolver3/pseudoViscosityCoefficient",
+                         _pseudoViscosityCoefficient);
+    checkpoint->setValue("SphSolver3/speedOfSound", _speedOfSound);
+    checkpoint->setValue("SphSolver3/timeStepLimitScale", _timeStepLimitScale);
+}
+
+void SphSolver3::onLoadCheckpoint(const Checkpoint& checkpoint) {
+    ParticleSystemSolver3::onLoadCheckpoint(checkpoint);
+
+    checkpoint.getValue("SphSolver3/eosExponent", &_eosExponent);
+    checkpoint.getValue("SphSolver3/negativePressureScale",
+                        &_negativePressureScale);
+    checkpoint.getValue("SphSolver3/viscosityCoefficient",
+                        &_viscosityCoefficient);
+    checkpoint.getValue("SphSolver3/pseudoViscosityCoefficient",
+                        &_pseudoViscosityCoefficient);
+    checkpoint.getValue("SphSolver3/speedOfSound", &_speedOfSound);
+    checkpoint.getValue("SphSolver3/timeStepLimitScale", &_timeStepLimitScale);
+}
+
 void SphSolver3::accumulateForces(double timeStepInSeconds) {
     accumulateNonPressureForces(timeStepInSeconds);
     accumulatePressureForce(timeStepInSeconds);
@@ -209,26 +423,34 @@ void SphSolver3::accumulatePressureForce(
     ArrayAccessor1<Vector3D> pressureForces) {
     auto particles = sphSystemData();
     size_t numberOfParticles = particles->numberOfParticles();
+    const auto& neighborLists = particles->neighborLists();
 
     const double massSquared = square(particles->mass());
     const SphSpikyKernel3 kernel(particles->kernelRadius());
 
+    // Gather the positions and the p / d^2 terms so that the neighbor loop
+    // only reads contiguous per-channel arrays.
+    _soaPositions.copyFrom(positions);
+    _forceCoefficients.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        _forceCoefficients[i] =
+            pressures[i] / (densities[i] * densities[i]);
+    });
+
+    const double* xs = _soaPositions.x();
+    const double* ys = _soaPositions.y();
+    const double* zs = _soaPositions.z();
+    const double* cs = _forceCoefficients.data();
+    const double invH = 1.0 / kernel.h;
+    const double scale = massSquared * 45.0 / (kPiD * kernel.h4);
+
     parallelFor(
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
-            for (size_t j : neighbors) {
-                double dist = positions[i].distanceTo(positions[j]);
-
-                if (dist > 0.0) {
-                    Vector3D dir = (positions[j] - positions[i]) / dist;
-                    pressureForces[i] -= massSquared
-                        * (pressures[i] / (densities[i] * densities[i])
-                            + pressures[j] / (densities[j] * densities[j]))
-                        * kernel.gradient(dist, dir);
-                }
-            }
+            pressureForces[i] +=
+                scale * sumPressureGradient(i, neighborLists[i], xs, ys, zs,
+                                            cs, invH);
         });
 }
 
@@ -236,6 +458,7 @@ void SphSolver3::accumulatePressureForce(
 void SphSolver3::accumulateViscosityForce() {
     auto particles = sphSystemData();
     size_t numberOfParticles = particles->numberOfParticles();
+    const auto& neighborLists = particles->neighborLists();
     auto x = particles->positions();
     auto v = particles->velocities();
     auto d = particles->densities();
@@ -244,18 +467,30 @@ void SphSolver3::accumulateViscosityForce() {
     const double massSquared = square(particles->mass());
     const SphSpikyKernel3 kernel(particles->kernelRadius());
 
+    _soaPositions.copyFrom(ConstArrayAccessor1<Vector3D>(x));
+    _soaVelocities.copyFrom(ConstArrayAccessor1<Vector3D>(v));
+    _forceCoefficients.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles,
+                [&](size_t i) { _forceCoefficients[i] = 1.0 / d[i]; });
+
+    const double* xs = _soaPositions.x();
+    const double* ys = _soaPositions.y();
+    const double* zs = _soaPositions.z();
+    const double* vxs = _soaVelocities.x();
+    const double* vys = _soaVelocities.y();
+    const double* vzs = _soaVelocities.z();
+    const double* invDs = _forceCoefficients.data();
+    const double invH = 1.0 / kernel.h;
+    const double scale =
+        viscosityCoefficient() * massSquared * 90.0 / (kPiD * kernel.h5);
+
     parallelFor(
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
-            for (size_t j : neighbors) {
-                double dist = x[i].distanceTo(x[j]);
-
-                f[i] += viscosityCoefficient() * massSquared
-                    * (v[j] - v[i]) / d[j]
-                    * kernel.secondDerivative(dist);
-            }
+            f[i] += scale * sumViscosityLaplacian(i, neighborLists[i], xs, ys,
+                                                  zs, vxs, vys, vzs, invDs,
+                                                  invH);
         });
 }
 
@@ -278,7 +513,7 @@ void SphSolver3::computePseudoViscosity(double timeStepInSeconds) {
             double weightSum = 0.0;
             Vector3D smoothedVelocity;
 
-            const auto& neighbors = particles->neighborLists()[i];
+            auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = x[i].distanceTo(x[j]);
                 double wj = mass / d[j] * kernel(dist);
@@ -165,7 +165,7 @@ Vector2D SphSystemData2::gradientAt(
     Vector2D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    auto neighbors = neighborLists()[i];
     Vector2D origin = p[i];
     SphSpikyKernel2 kernel(_kernelRadius);
     const double m = mass();
@@ -189,7 +189,7 @@ double SphSystemData2::laplacianAt(
     double sum = 0.0;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    auto neighbors = neighborLists()[i];
     Vector2D origin = p[i];
     SphSpikyKernel2 kernel(_kernelRadius);
     const double m = mass();
@@ -209,7 +209,7 @@ Vector2D SphSystemData2::laplacianAt(
     Vector2D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    auto neighbors = neighborLists()[i];
     Vector2D origin = p[i];
     SphSpikyKernel2 kernel(_kernelRadius);
     const double m = mass();
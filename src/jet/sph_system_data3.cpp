@@ -24,6 +24,35 @@
 
 namespace jet {
 
+namespace {
+
+// Number of origins per batched neighbor query, which bounds the size of the
+// neighbor list buffers.
+const size_t kSphQueryBatchSize = 1 << 14;
+
+}  // namespace
+
+template <typename Func>
+void SphSystemData3::forEachNeighborBatch(
+    const ConstArrayAccessor1<Vector3D>& origins, double radius,
+    const Func& func) const {
+    for (size_t begin = 0; begin < origins.size();
+         begin += kSphQueryBatchSize) {
+        const size_t count =
+            std::min(kSphQueryBatchSize, origins.size() - begin);
+        neighborSearcher()->findNearbyPoints(
+            ConstArrayAccessor1<Vector3D>(count, origins.data() + begin),
+            radius, &_batchNeighborLists, &_batchDistancesSquared,
+            &_batchQueryBuffers);
+
+        const auto offsets = _batchNeighborLists.offsets();
+        parallelFor(kZeroSize, count, [&](size_t n) {
+            func(begin + n, _batchNeighborLists[n],
+                 _batchDistancesSquared.data() + offsets[n]);
+        });
+    }
+}
+
 SphSystemData3::SphSystemData3() : SphSystemData3(0) {}
 
 SphSystemData3::SphSystemData3(size_t numberOfParticles)
@@ -70,10 +99,18 @@ void SphSystemData3::updateDensities() {
     auto d = densities();
     const double m = mass();
 
-    parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
-        double sum = sumOfKernelNearby(p[i]);
-        d[i] = m * sum;
-    });
+    SphStdKernel3 kernel(_kernelRadius);
+
+    forEachNeighborBatch(
+        p, _kernelRadius,
+        [&](size_t i, const ConstArrayAccessor1<size_t>& neighbors,
+            const double* distancesSquared) {
+            double sum = 0.0;
+            for (size_t n = 0; n < neighbors.size(); ++n) {
+                sum += kernel(std::sqrt(distancesSquared[n]));
+            }
+            d[i] = m * sum;
+        });
 }
 
 void SphSystemData3::setTargetDensity(double targetDensity) {
@@ -160,12 +197,56 @@ Vector3D SphSystemData3::interpolate(
     return sum;
 }
 
+void SphSystemData3::interpolate(const ConstArrayAccessor1<Vector3D>& origins,
+                                 const ConstArrayAccessor1<double>& values,
+                                 ArrayAccessor1<double> results) const {
+    auto d = densities();
+    SphStdKernel3 kernel(_kernelRadius);
+    const double m = mass();
+
+    forEachNeighborBatch(
+        origins, _kernelRadius,
+        [&](size_t i, const ConstArrayAccessor1<size_t>& neighbors,
+            const double* distancesSquared) {
+            double sum = 0.0;
+            for (size_t n = 0; n < neighbors.size(); ++n) {
+                const size_t j = neighbors[n];
+                double weight =
+                    m / d[j] * kernel(std::sqrt(distancesSquared[n]));
+                sum += weight * values[j];
+            }
+            results[i] = sum;
+        });
+}
+
+void SphSystemData3::interpolate(const ConstArrayAccessor1<Vector3D>& origins,
+                                 const ConstArrayAccessor1<Vector3D>& values,
+                                 ArrayAccessor1<Vector3D> results) const {
+    auto d = densities();
+    SphStdKernel3 kernel(_kernelRadius);
+    const double m = mass();
+
+    forEachNeighborBatch(
+        origins, _kernelRadius,
+        [&](size_t i, const ConstArrayAccessor1<size_t>& neighbors,
+            const double* distancesSquared) {
+            Vector3D sum;
+            for (size_t n = 0; n < neighbors.size(); ++n) {
+                const size_t j = neighbors[n];
+                double weight =
+                    m / d[j] * kernel(std::sqrt(distancesSquared[n]));
+                sum += weight * values[j];
+            }
+            results[i] = sum;
+        });
+}
+
 Vector3D SphSystemData3::gradientAt(
     size_t i, const ConstArrayAccessor1<double>& values) const {
     Vector3D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    auto neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
@@ -189,7 +270,7 @@ double SphSystemData3::laplacianAt(
     double sum = 0.0;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    auto neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
@@ -209,7 +290,7 @@ Vector3D SphSystemData3::laplacianAt(
     Vector3D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    auto neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
@@ -6,7 +6,6 @@
 
 #include <pch.h>
 
-#include <jet/fmm_level_set_solver3.h>
 #include <jet/particle_system_data3.h>
 #include <jet/spherical_points_to_implicit3.h>
 
@@ -42,19 +41,20 @@ void SphericalPointsToImplicit3::convert(
     const auto neighborSearcher = particles.neighborSearcher();
 
     auto temp = output->clone();
-    temp->fill([&](const Vector3D& x) {
-        double minDist = 2.0 * _radius;
-        neighborSearcher->forEachNearbyPoint(
-            x, 2.0 * _radius, [&](size_t, const Vector3D& xj) {
-                minDist = std::min(minDist, (x - xj).length());
-            });
-
-        return minDist - _radius;
-    });
+    evaluate(points, 2.0 * _radius, _radius,
+             [&](const Vector3D& x) {
+                 double minDist = 2.0 * _radius;
+                 neighborSearcher->forEachNearbyPoint(
+                     x, 2.0 * _radius, [&](size_t, const Vector3D& xj) {
+                         minDist = std::min(minDist, (x - xj).length());
+                     });
+
+                 return minDist - _radius;
+             },
+             temp.get());
 
     if (_isOutputSdf) {
-        FmmLevelSetSolver3 solver;
-        solver.reinitialize(*temp, kMaxD, output);
+        reinitialize(*temp, 2.0 * _radius, output);
     } else {
         temp->swap(output);
     }
@@ -0,0 +1,151 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_SWEEPING_TILES3_H_
+#define SRC_JET_SWEEPING_TILES3_H_
+
+#include <jet/array3.h>
+#include <jet/parallel.h>
+#include <jet/point3.h>
+#include <jet/size3.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace jet {
+
+// Number of grid points along each axis of a sweeping tile
+constexpr size_t kSweepingTileSize = 8;
+
+// Tiles of the grid which are swept along the diagonal planes of tiles. The
+// tiles on the same plane do not depend on each other for any sweeping
+// direction, so they are swept in parallel while the points in a tile are
+// visited in the serial sweeping order. A tile is locked once a sweep leaves
+// it and its neighbors unchanged, so the later sweeps only visit the tiles
+// where the solution is still moving.
+class SweepingTiles3 {
+ public:
+    // Constructs the tiles for the grid of given size.
+    explicit SweepingTiles3(const Size3& size) : _size(size) {
+        _isActive.resize((size.x + kSweepingTileSize - 1) / kSweepingTileSize,
+                         (size.y + kSweepingTileSize - 1) / kSweepingTileSize,
+                         (size.z + kSweepingTileSize - 1) / kSweepingTileSize,
+                         0);
+
+        // Group the tiles by their diagonal planes.
+        const Size3 n = _isActive.size();
+        _planeOffsets.assign(n.x + n.y + n.z - 1, 0);
+        _isActive.forEachIndex([&](size_t i, size_t j, size_t k) {
+            ++_planeOffsets[i + j + k];
+        });
+        size_t offset = 0;
+        for (size_t& count : _planeOffsets) {
+            const size_t c = count;
+            count = offset;
+            offset += c;
+        }
+        _planeOffsets.push_back(offset);
+
+        std::vector<size_t> cursor(_planeOffsets);
+        _tiles.resize(offset);
+        _isActive.forEachIndex([&](size_t i, size_t j, size_t k) {
+            _tiles[cursor[i + j + k]++] = Point3UI(i, j, k);
+        });
+    }
+
+    Array3<char>& active() { return _isActive; }
+
+    //! Unlocks all the active tiles.
+    void unlockAll() {
+        _isUnlocked = _isActive;
+        _isChanged.resize(_isActive.size(), 0);
+    }
+
+    //!
+    //! Invokes func(i, j, k) for each grid point in the unlocked tiles,
+    //! sweeping in the direction given by the three sign bits of
+    //! \p direction. The callback returns true if the point has changed.
+    //! Returns true if any point has changed.
+    //!
+    template <typename Callback>
+    bool sweep(int direction, const Callback& func) {
+        const Size3 n = _isActive.size();
+        const bool flipX = (direction & 1) != 0;
+        const bool flipY = (direction & 2) != 0;
+        const bool flipZ = (direction & 4) != 0;
+
+        for (size_t p = 0; p + 1 < _planeOffsets.size(); ++p) {
+            parallelFor(_planeOffsets[p], _planeOffsets[p + 1], [&](size_t t) {
+                const Point3UI& tile = _tiles[t];
+                const size_t ti = flipX ? n.x - 1 - tile.x : tile.x;
+                const size_t tj = flipY ? n.y - 1 - tile.y : tile.y;
+                const size_t tk = flipZ ? n.z - 1 - tile.z : tile.z;
+                if (!_isUnlocked(ti, tj, tk)) {
+                    _isChanged(ti, tj, tk) = 0;
+                    return;
+                }
+
+                const size_t iBegin = ti * kSweepingTileSize;
+                const size_t jBegin = tj * kSweepingTileSize;
+                const size_t kBegin = tk * kSweepingTileSize;
+                const size_t iCount =
+                    std::min(kSweepingTileSize, _size.x - iBegin);
+                const size_t jCount =
+                    std::min(kSweepingTileSize, _size.y - jBegin);
+                const size_t kCount =
+                    std::min(kSweepingTileSize, _size.z - kBegin);
+
+                bool isChanged = false;
+                for (size_t kk = 0; kk < kCount; ++kk) {
+                    const size_t k =
+                        kBegin + (flipZ ? kCount - 1 - kk : kk);
+                    for (size_t jj = 0; jj < jCount; ++jj) {
+                        const size_t j =
+                            jBegin + (flipY ? jCount - 1 - jj : jj);
+                        for (size_t ii = 0; ii < iCount; ++ii) {
+                            const size_t i =
+                                iBegin + (flipX ? iCount - 1 - ii : ii);
+                            isChanged |= func(i, j, k);
+                        }
+                    }
+                }
+                _isChanged(ti, tj, tk) = isChanged;
+            });
+        }
+
+        // Keep the changed tiles and their neighbors unlocked.
+        std::atomic<bool> isAnyChanged(false);
+        _isUnlocked.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            const bool isChanged =
+                _isChanged(i, j, k) ||
+                (i > 0 && _isChanged(i - 1, j, k)) ||
+                (i + 1 < n.x && _isChanged(i + 1, j, k)) ||
+                (j > 0 && _isChanged(i, j - 1, k)) ||
+                (j + 1 < n.y && _isChanged(i, j + 1, k)) ||
+                (k > 0 && _isChanged(i, j, k - 1)) ||
+                (k + 1 < n.z && _isChanged(i, j, k + 1));
+            _isUnlocked(i, j, k) = _isActive(i, j, k) && isChanged;
+            if (_isChanged(i, j, k)) {
+                isAnyChanged = true;
+            }
+        });
+
+        return isAnyChanged;
+    }
+
+ private:
+    Size3 _size;
+    Array3<char> _isActive;
+    Array3<char> _isUnlocked;
+    Array3<char> _isChanged;
+    std::vector<size_t> _planeOffsets;
+    std::vector<Point3UI> _tiles;
+};
+
+}  // namespace jet
+
+#endif  // SRC_JET_SWEEPING_TILES3_H_
@@ -0,0 +1,247 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/parallel.h>
+#include <jet/thread_pool.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+namespace {
+
+// Identifies the pool and the deque owned by the current worker thread.
+thread_local ThreadPool* tCurrentPool = nullptr;
+thread_local size_t tWorkerIndex = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(unsigned int numberOfWorkers)
+    : _numQueuedTasks(0), _numRunningTasks(0), _nextQueue(0) {
+    startWorkers(numberOfWorkers);
+}
+
+ThreadPool::~ThreadPool() { stopWorkers(); }
+
+unsigned int ThreadPool::numberOfWorkers() const {
+    return static_cast<unsigned int>(_workers.size());
+}
+
+void ThreadPool::resize(unsigned int numberOfWorkers) {
+    if (numberOfWorkers == _workers.size()) {
+        return;
+    }
+
+    stopWorkers();
+    startWorkers(numberOfWorkers);
+}
+
+void ThreadPool::schedule(Task task) {
+    if (_workers.empty()) {
+        task();
+        return;
+    }
+
+    size_t index;
+    if (tCurrentPool == this) {
+        index = tWorkerIndex;
+    } else {
+        index = _nextQueue.fetch_add(1) % _workers.size();
+    }
+
+    push(index, std::move(task));
+}
+
+void ThreadPool::forEachChunk(size_t numberOfChunks,
+                              const std::function<void(size_t)>& func) {
+    if (numberOfChunks == 0) {
+        return;
+    }
+
+    if (_workers.empty() || numberOfChunks == 1) {
+        for (size_t c = 0; c < numberOfChunks; ++c) {
+            func(c);
+        }
+        return;
+    }
+
+    // Helpers which start after all the chunks are claimed only touch the
+    // shared counters, so the state must outlive this call.
+    struct LoopState {
+        std::atomic<size_t> next;
+        std::atomic<size_t> done;
+        size_t count;
+        const std::function<void(size_t)>* func;
+    };
+
+    auto state = std::make_shared<LoopState>();
+    state->next = 0;
+    state->done = 0;
+    state->count = numberOfChunks;
+    state->func = &func;
+
+    auto work = [state]() {
+        size_t numProcessed = 0;
+        size_t c;
+        while ((c = state->next.fetch_add(1)) < state->count) {
+            (*state->func)(c);
+            ++numProcessed;
+        }
+        if (numProcessed > 0) {
+            state->done.fetch_add(numProcessed);
+        }
+    };
+
+    const size_t numHelpers = std::min(_workers.size(), numberOfChunks - 1);
+    for (size_t i = 0; i < numHelpers; ++i) {
+        schedule(work);
+    }
+
+    work();
+
+    while (state->done.load() < numberOfChunks) {
+        if (!runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool ThreadPool::runPendingTask() {
+    if (_workers.empty()) {
+        return false;
+    }
+
+    Task task;
+    bool found;
+    if (tCurrentPool == this) {
+        found = popTask(tWorkerIndex, &task) ||
+                stealTask(tWorkerIndex, &task);
+    } else {
+        found = stealTask(_workers.size(), &task);
+    }
+
+    if (found) {
+        task();
+        _numRunningTasks.fetch_sub(1);
+    }
+
+    return found;
+}
+
+ThreadPool& ThreadPool::defaultPool() {
+    static ThreadPool pool(std::max(maxNumberOfThreads(), 1u) - 1);
+    return pool;
+}
+
+void ThreadPool::startWorkers(unsigned int numberOfWorkers) {
+    _stop = false;
+    _workers.clear();
+    for (unsigned int i = 0; i < numberOfWorkers; ++i) {
+        _workers.emplace_back(new Worker());
+    }
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        _workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+void ThreadPool::stopWorkers() {
+    // Drain the queues first so that no scheduled task is dropped.
+    while (_numQueuedTasks.load() > 0 || _numRunningTasks.load() > 0) {
+        if (!runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _wakeUp.notify_all();
+
+    for (auto& worker : _workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    _workers.clear();
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    tCurrentPool = this;
+    tWorkerIndex = index;
+
+    while (true) {
+        Task task;
+        if (popTask(index, &task) || stealTask(index, &task)) {
+            task();
+            _numRunningTasks.fetch_sub(1);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _wakeUp.wait(lock,
+                     [this] { return _stop || _numQueuedTasks.load() > 0; });
+        if (_stop) {
+            break;
+        }
+    }
+
+    tCurrentPool = nullptr;
+}
+
+bool ThreadPool::popTask(size_t index, Task* task) {
+    Worker& worker = *_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+
+    *task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    _numRunningTasks.fetch_add(1);
+    _numQueuedTasks.fetch_sub(1);
+    return true;
+}
+
+bool ThreadPool::stealTask(size_t thiefIndex, Task* task) {
+    const size_t n = _workers.size();
+    for (size_t i = 1; i <= n; ++i) {
+        size_t victim = (thiefIndex + i) % n;
+        if (victim == thiefIndex) {
+            continue;
+        }
+
+        Worker& worker = *_workers[victim];
+        std::unique_lock<std::mutex> lock(worker.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || worker.tasks.empty()) {
+            continue;
+        }
+
+        *task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        _numRunningTasks.fetch_add(1);
+        _numQueuedTasks.fetch_sub(1);
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::push(size_t index, Task&& task) {
+    Worker& worker = *_workers[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+        _numQueuedTasks.fetch_add(1);
+    }
+
+    // Taking the sleep mutex orders this wake-up after a worker's predicate
+    // check, so the notification cannot be lost.
+    { std::lock_guard<std::mutex> lock(_sleepMutex); }
+    _wakeUp.notify_one();
+}
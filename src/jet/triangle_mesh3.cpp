@@ -613,7 +613,7 @@ void TriangleMesh3::buildBvh() const {
             ids[i] = i;
             bounds[i] = triangle(i).boundingBox();
         }
-        _bvh.build(ids, bounds);
+        _bvh.build(ids, bounds, BvhBuildMethod::kSah);
         _bvhInvalidated = false;
     }
 }
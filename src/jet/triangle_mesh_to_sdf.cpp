@@ -28,106 +28,76 @@
 // SOFTWARE.
 
 #include <pch.h>
+#include <sweeping_tiles3.h>
 #include <jet/array_utils.h>
 #include <jet/array3.h>
+#include <jet/parallel.h>
 #include <jet/triangle_mesh_to_sdf.h>
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 using namespace jet;
 
 namespace jet {
 
-static void checkNeighbor(
-    const TriangleMesh3& mesh,
-    const Vector3D& gx,
-    ssize_t i0,
-    ssize_t j0,
-    ssize_t k0,
-    ssize_t i1,
-    ssize_t j1,
-    ssize_t k1,
-    ScalarGrid3* sdf,
-    Array3<size_t>* closestTri) {
-    if ((*closestTri)(i1, j1, k1) != kMaxSize) {
-        size_t t = (*closestTri)(i1, j1, k1);
-        Triangle3 tri = mesh.triangle(t);
-
-        double d = tri.closestDistance(gx);
-
-        if (d < (*sdf)(i0, j0, k0)) {
-            (*sdf)(i0, j0, k0) = d;
-            (*closestTri)(i0, j0, k0) = (*closestTri)(i1, j1, k1);
-        }
+// Returns the closest point on the line segment v0-v1 from the point.
+static Vector3D closestPointOnLine(const Vector3D& v0, const Vector3D& v1,
+                                   const Vector3D& pt) {
+    const double lenSquared = (v1 - v0).lengthSquared();
+    if (lenSquared < std::numeric_limits<double>::epsilon()) {
+        return v0;
     }
-}
 
-static void sweep(
-    const TriangleMesh3& mesh,
-    int di,
-    int dj,
-    int dk,
-    ScalarGrid3* sdf,
-    Array3<size_t>* closestTri) {
-    Size3 size = sdf->dataSize();
-    Vector3D h = sdf->gridSpacing();
-    Vector3D origin = sdf->dataOrigin();
+    const double t = (pt - v0).dot(v1 - v0) / lenSquared;
+    if (t < 0.0) {
+        return v0;
+    } else if (t > 1.0) {
+        return v1;
+    }
 
-    ssize_t ni = static_cast<ssize_t>(size.x);
-    ssize_t nj = static_cast<ssize_t>(size.y);
-    ssize_t nk = static_cast<ssize_t>(size.z);
+    return v0 + t * (v1 - v0);
+}
 
-    ssize_t i0, i1;
-    if (di > 0) {
-        i0 = 1;
-        i1 = ni;
-    } else {
-        i0 = ni - 2;
-        i1 = -1;
+// Returns the distance from the point to the t-th triangle of the mesh. This
+// is the same computation as Triangle3::closestDistance, but avoids building
+// a Triangle3 object which dominates the cost of the queries.
+static double closestDistance(const TriangleMesh3& mesh, size_t t,
+                              const Vector3D& pt) {
+    const Point3UI indices = mesh.pointIndex(t);
+    const Vector3D& p0 = mesh.point(indices.x);
+    const Vector3D& p1 = mesh.point(indices.y);
+    const Vector3D& p2 = mesh.point(indices.z);
+
+    const Vector3D normal = (p1 - p0).cross(p2 - p0);
+    const Vector3D n = normal.normalized();
+    double nd = n.dot(n);
+    double d = n.dot(p0);
+    double s = (d - n.dot(pt)) / nd;
+
+    Vector3D q = s * n + pt;
+
+    Vector3D q01 = (p1 - p0).cross(q - p0);
+    if (n.dot(q01) < 0) {
+        return pt.distanceTo(closestPointOnLine(p0, p1, q));
     }
 
-    ssize_t j0, j1;
-    if (dj > 0) {
-        j0 = 1;
-        j1 = nj;
-    } else {
-        j0 = nj - 2;
-        j1 = -1;
+    Vector3D q12 = (p2 - p1).cross(q - p1);
+    if (n.dot(q12) < 0) {
+        return pt.distanceTo(closestPointOnLine(p1, p2, q));
     }
 
-    ssize_t k0, k1;
-    if (dk > 0) {
-        k0 = 1;
-        k1 = nk;
-    } else {
-        k0 = nk - 2;
-        k1 = -1;
+    Vector3D q02 = (p0 - p2).cross(q - p2);
+    if (n.dot(q02) < 0) {
+        return pt.distanceTo(closestPointOnLine(p0, p2, q));
     }
 
-    for (ssize_t k = k0; k != k1; k += dk) {
-        for (ssize_t j = j0; j != j1; j += dj) {
-            for (ssize_t i = i0; i != i1; i += di) {
-                Vector3D gx({ i, j, k });
-                gx *= h;
-                gx += origin;
-
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j - dj, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j - dj, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j - dj, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j - dj, k - dk, sdf, closestTri);
-            }
-        }
-    }
+    double a = 0.5 * normal.length();
+    double b0 = 0.5 * q12.length() / a;
+    double b1 = 0.5 * q02.length() / a;
+    double b2 = 0.5 * q01.length() / a;
+
+    return pt.distanceTo(b0 * p0 + b1 * p1 + b2 * p2);
 }
 
 // calculate twice signed area of triangle (0,0)-(x1,y1)-(x2,y2)
@@ -199,6 +169,49 @@ static bool pointInTriangle2D(
     return true;
 }
 
+// Builds the compressed list of the triangles overlapping each bin. The bins
+// form a grid of size numBins, and binRange(t, lower, upper) writes the
+// inclusive range of the bins overlapped by the t-th triangle. The triangles
+// in each bin are sorted by their index.
+template <typename BinRangeFunc>
+static void binTriangles(size_t numberOfTriangles, const Size3& numBins,
+                         const BinRangeFunc& binRange,
+                         std::vector<size_t>* offsets,
+                         std::vector<size_t>* triangles) {
+    const size_t numBinsTotal = numBins.x * numBins.y * numBins.z;
+    offsets->assign(numBinsTotal + 1, 0);
+
+    Point3UI lower, upper;
+    for (size_t t = 0; t < numberOfTriangles; ++t) {
+        binRange(t, &lower, &upper);
+        for (size_t k = lower.z; k <= upper.z; ++k) {
+            for (size_t j = lower.y; j <= upper.y; ++j) {
+                for (size_t i = lower.x; i <= upper.x; ++i) {
+                    ++(*offsets)[i + numBins.x * (j + numBins.y * k) + 1];
+                }
+            }
+        }
+    }
+
+    for (size_t b = 0; b < numBinsTotal; ++b) {
+        (*offsets)[b + 1] += (*offsets)[b];
+    }
+
+    std::vector<size_t> cursor(offsets->begin(), offsets->end() - 1);
+    triangles->resize(offsets->back());
+    for (size_t t = 0; t < numberOfTriangles; ++t) {
+        binRange(t, &lower, &upper);
+        for (size_t k = lower.z; k <= upper.z; ++k) {
+            for (size_t j = lower.y; j <= upper.y; ++j) {
+                for (size_t i = lower.x; i <= upper.x; ++i) {
+                    const size_t b = i + numBins.x * (j + numBins.y * k);
+                    (*triangles)[cursor[b]++] = t;
+                }
+            }
+        }
+    }
+}
+
 void triangleMeshToSdf(
     const TriangleMesh3& mesh,
     ScalarGrid3* sdf,
@@ -212,6 +225,7 @@ void triangleMeshToSdf(
     sdf->fill(sdf->boundingBox().diagonalLength());
     Vector3D h = sdf->gridSpacing();
     Vector3D origin = sdf->dataOrigin();
+    auto phi = sdf->dataAccessor();
 
     Array3<size_t> closestTri(size, kMaxSize);
 
@@ -219,7 +233,9 @@ void triangleMeshToSdf(
     Array3<unsigned int> intersectionCount(size, 0);
 
     // We begin by initializing distances near the mesh, and figuring out
-    // intersection counts
+    // intersection counts. The triangles are binned to the tiles of the grid
+    // (and to the tiles of the (j, k) rows for the intersection counts), so
+    // that each tile can be processed by a single thread.
 
     auto gridPos = sdf->dataPosition();
 
@@ -228,111 +244,241 @@ void triangleMeshToSdf(
     ssize_t maxSizeX = static_cast<ssize_t>(size.x);
     ssize_t maxSizeY = static_cast<ssize_t>(size.y);
     ssize_t maxSizeZ = static_cast<ssize_t>(size.z);
-    for (size_t t = 0; t < nTri; ++t) {
-        Point3UI indices = mesh.pointIndex(t);
 
-        Triangle3 tri = mesh.triangle(t);
+    // Normalized coordinates of the triangle vertices
+    std::vector<Vector3D> normalizedPoints(mesh.numberOfPoints());
+    parallelFor(kZeroSize, mesh.numberOfPoints(), [&](size_t i) {
+        normalizedPoints[i] = (mesh.point(i) - origin) / h;
+    });
 
-        Vector3D pt1 = mesh.point(indices.x);
-        Vector3D pt2 = mesh.point(indices.y);
-        Vector3D pt3 = mesh.point(indices.z);
-
-        // Normalize coordinates
-        Vector3D f1 = (pt1 - origin) / h;
-        Vector3D f2 = (pt2 - origin) / h;
-        Vector3D f3 = (pt3 - origin) / h;
+    // Range of the grid points for the exact distances
+    auto distanceRange = [&](size_t t, Point3I* lower, Point3I* upper) {
+        Point3UI indices = mesh.pointIndex(t);
+        const Vector3D& f1 = normalizedPoints[indices.x];
+        const Vector3D& f2 = normalizedPoints[indices.y];
+        const Vector3D& f3 = normalizedPoints[indices.z];
 
-        // Do distances nearby
         ssize_t i0 = static_cast<ssize_t>(min3<double>(f1.x, f2.x, f3.x));
-        i0 = clamp(i0 - bandwidth, kZeroSSize, maxSizeX - 1);
+        lower->x = clamp(i0 - bandwidth, kZeroSSize, maxSizeX - 1);
         ssize_t i1 = static_cast<ssize_t>(max3<double>(f1.x, f2.x, f3.x));
-        i1 = clamp(i1 + bandwidth + 1, kZeroSSize, maxSizeX - 1);
+        upper->x = clamp(i1 + bandwidth + 1, kZeroSSize, maxSizeX - 1);
 
         ssize_t j0 = static_cast<ssize_t>(min3<double>(f1.y, f2.y, f3.y));
-        j0 = clamp(j0 - bandwidth, kZeroSSize, maxSizeY - 1);
+        lower->y = clamp(j0 - bandwidth, kZeroSSize, maxSizeY - 1);
         ssize_t j1 = static_cast<ssize_t>(max3<double>(f1.y, f2.y, f3.y));
-        j1 = clamp(j1 + bandwidth + 1, kZeroSSize, maxSizeY - 1);
+        upper->y = clamp(j1 + bandwidth + 1, kZeroSSize, maxSizeY - 1);
 
         ssize_t k0 = static_cast<ssize_t>(min3<double>(f1.z, f2.z, f3.z));
-        k0 = clamp(k0 - bandwidth, kZeroSSize, maxSizeZ - 1);
+        lower->z = clamp(k0 - bandwidth, kZeroSSize, maxSizeZ - 1);
         ssize_t k1 = static_cast<ssize_t>(max3<double>(f1.z, f2.z, f3.z));
-        k1 = clamp(k1 + bandwidth + 1, kZeroSSize, maxSizeZ - 1);
-
-        for (ssize_t k = k0; k <= k1; ++k) {
-            for (ssize_t j = j0; j <= j1; ++j) {
-                for (ssize_t i = i0; i <= i1; ++i) {
-                    Vector3D gx = gridPos(i, j, k);
-                    double d = tri.closestDistance(gx);
-                    if (d < (*sdf)(i, j, k)) {
-                        (*sdf)(i, j, k) = d;
-                        closestTri(i, j, k) = t;
+        upper->z = clamp(k1 + bandwidth + 1, kZeroSSize, maxSizeZ - 1);
+    };
+
+    // Range of the (j, k) rows for the intersection counts. The range can be
+    // empty if the triangle does not cross any row.
+    auto rowRange = [&](size_t t, Point3I* lower, Point3I* upper) {
+        Point3UI indices = mesh.pointIndex(t);
+        const Vector3D& f1 = normalizedPoints[indices.x];
+        const Vector3D& f2 = normalizedPoints[indices.y];
+        const Vector3D& f3 = normalizedPoints[indices.z];
+
+        ssize_t j0 =
+            static_cast<ssize_t>(std::ceil(min3<double>(f1.y, f2.y, f3.y)));
+        lower->y = clamp(j0, kZeroSSize, maxSizeY - 1);
+        ssize_t j1 =
+            static_cast<ssize_t>(std::floor(max3<double>(f1.y, f2.y, f3.y)));
+        upper->y = clamp(j1, kZeroSSize, maxSizeY - 1);
+        ssize_t k0 =
+            static_cast<ssize_t>(std::ceil(min3<double>(f1.z, f2.z, f3.z)));
+        lower->z = clamp(k0, kZeroSSize, maxSizeZ - 1);
+        ssize_t k1 =
+            static_cast<ssize_t>(std::floor(max3<double>(f1.z, f2.z, f3.z)));
+        upper->z = clamp(k1, kZeroSSize, maxSizeZ - 1);
+    };
+
+    const Size3 numTiles((size.x + kSweepingTileSize - 1) / kSweepingTileSize,
+                         (size.y + kSweepingTileSize - 1) / kSweepingTileSize,
+                         (size.z + kSweepingTileSize - 1) / kSweepingTileSize);
+
+    const ssize_t tileSize = static_cast<ssize_t>(kSweepingTileSize);
+    auto toTileIndex = [&](const Point3I& idx) {
+        return Point3UI(static_cast<size_t>(idx.x / tileSize),
+                        static_cast<size_t>(idx.y / tileSize),
+                        static_cast<size_t>(idx.z / tileSize));
+    };
+
+    // Do distances nearby
+    std::vector<size_t> binOffsets;
+    std::vector<size_t> binTris;
+    binTriangles(nTri, numTiles,
+                 [&](size_t t, Point3UI* lower, Point3UI* upper) {
+                     Point3I l, u;
+                     distanceRange(t, &l, &u);
+                     *lower = toTileIndex(l);
+                     *upper = toTileIndex(u);
+                 },
+                 &binOffsets, &binTris);
+
+    parallelFor(kZeroSize, numTiles.x, kZeroSize, numTiles.y, kZeroSize,
+                numTiles.z, [&](size_t ti, size_t tj, size_t tk) {
+        const size_t bin = ti + numTiles.x * (tj + numTiles.y * tk);
+        const Point3I tileLower(static_cast<ssize_t>(ti) * tileSize,
+                                static_cast<ssize_t>(tj) * tileSize,
+                                static_cast<ssize_t>(tk) * tileSize);
+        const Point3I tileUpper =
+            tileLower + Point3I(tileSize - 1, tileSize - 1, tileSize - 1);
+
+        for (size_t n = binOffsets[bin]; n < binOffsets[bin + 1]; ++n) {
+            const size_t t = binTris[n];
+            Point3I lower, upper;
+            distanceRange(t, &lower, &upper);
+            lower = max(lower, tileLower);
+            upper = min(upper, tileUpper);
+
+            for (ssize_t k = lower.z; k <= upper.z; ++k) {
+                for (ssize_t j = lower.y; j <= upper.y; ++j) {
+                    for (ssize_t i = lower.x; i <= upper.x; ++i) {
+                        Vector3D gx = gridPos(i, j, k);
+                        double d = closestDistance(mesh, t, gx);
+                        if (d < phi(i, j, k)) {
+                            phi(i, j, k) = d;
+                            closestTri(i, j, k) = t;
+                        }
                     }
                 }
             }
         }
-
-        // Do intersection counts
-        j0 = static_cast<ssize_t>(std::ceil(min3<double>(f1.y, f2.y, f3.y)));
-        j0 = clamp(j0 - bandwidth, kZeroSSize, maxSizeY - 1);
-        j1 = static_cast<ssize_t>(std::floor(max3<double>(f1.y, f2.y, f3.y)));
-        j1 = clamp(j1 + bandwidth + 1, kZeroSSize, maxSizeY - 1);
-        k0 = static_cast<ssize_t>(std::ceil(min3<double>(f1.z, f2.z, f3.z)));
-        k0 = clamp(k0 - bandwidth, kZeroSSize, maxSizeZ - 1);
-        k1 = static_cast<ssize_t>(std::floor(max3<double>(f1.z, f2.z, f3.z)));
-        k1 = clamp(k1 + bandwidth + 1, kZeroSSize, maxSizeZ - 1);
-
-        for (ssize_t k = k0; k <= k1; ++k) {
-            for (ssize_t j = j0; j <= j1; ++j) {
-                double a, b, c;
-                double jD = static_cast<double>(j);
-                double kD = static_cast<double>(k);
-                if (pointInTriangle2D(
-                    jD, kD, f1.y, f1.z, f2.y, f2.z, f3.y, f3.z, &a, &b, &c)) {
-                    // intersection i coordinate
-                    double fi = a * f1.x + b * f2.x + c * f3.x;
-
-                    // intersection is in (iInterval - 1, iInterval]
-                    int iInterval = static_cast<int>(std::ceil(fi));
-                    if (iInterval < 0) {
-                        // we enlarge the first interval to include everything
-                        // to the -x direction
-                        ++intersectionCount(0, j, k);
-                    } else if (iInterval < static_cast<int>(size.x)) {
-                        ++intersectionCount(iInterval, j, k);
+    });
+
+    // Do intersection counts
+    const Size3 numRowTiles(1, numTiles.y, numTiles.z);
+    binTriangles(nTri, numRowTiles,
+                 [&](size_t t, Point3UI* lower, Point3UI* upper) {
+                     Point3I l, u;
+                     rowRange(t, &l, &u);
+                     *lower = toTileIndex(Point3I(0, std::min(l.y, u.y),
+                                                  std::min(l.z, u.z)));
+                     *upper = toTileIndex(Point3I(0, u.y, u.z));
+                 },
+                 &binOffsets, &binTris);
+
+    parallelFor(kZeroSize, numRowTiles.y, kZeroSize, numRowTiles.z,
+                [&](size_t tj, size_t tk) {
+        const size_t bin = tj + numRowTiles.y * tk;
+        const ssize_t tileLowerJ = static_cast<ssize_t>(tj) * tileSize;
+        const ssize_t tileLowerK = static_cast<ssize_t>(tk) * tileSize;
+
+        for (size_t n = binOffsets[bin]; n < binOffsets[bin + 1]; ++n) {
+            const size_t t = binTris[n];
+            Point3UI indices = mesh.pointIndex(t);
+            const Vector3D& f1 = normalizedPoints[indices.x];
+            const Vector3D& f2 = normalizedPoints[indices.y];
+            const Vector3D& f3 = normalizedPoints[indices.z];
+
+            Point3I lower, upper;
+            rowRange(t, &lower, &upper);
+            const ssize_t j0 = std::max(lower.y, tileLowerJ);
+            const ssize_t j1 = std::min(upper.y, tileLowerJ + tileSize - 1);
+            const ssize_t k0 = std::max(lower.z, tileLowerK);
+            const ssize_t k1 = std::min(upper.z, tileLowerK + tileSize - 1);
+
+            for (ssize_t k = k0; k <= k1; ++k) {
+                for (ssize_t j = j0; j <= j1; ++j) {
+                    double a, b, c;
+                    double jD = static_cast<double>(j);
+                    double kD = static_cast<double>(k);
+                    if (pointInTriangle2D(jD, kD, f1.y, f1.z, f2.y, f2.z, f3.y,
+                                          f3.z, &a, &b, &c)) {
+                        // intersection i coordinate
+                        double fi = a * f1.x + b * f2.x + c * f3.x;
+
+                        // intersection is in (iInterval - 1, iInterval]
+                        int iInterval = static_cast<int>(std::ceil(fi));
+                        if (iInterval < 0) {
+                            // we enlarge the first interval to include
+                            // everything to the -x direction
+                            ++intersectionCount(0, j, k);
+                        } else if (iInterval < static_cast<int>(size.x)) {
+                            ++intersectionCount(iInterval, j, k);
+                        }
+                        // we ignore intersections that are beyond the +x side
+                        // of the grid
                     }
-                    // we ignore intersections that are beyond the +x side of
-                    // the grid
                 }
             }
         }
-    }
+    });
+
+    // and now we fill in the rest of the distances with fast sweeping. The
+    // sweeps run over the tiles of the grid in parallel. Each sweep only
+    // reads the upwind octant, so a sweep without any change does not mean
+    // that the other directions have converged. All the tiles are unlocked
+    // before each sweep and all the sweeps are always run.
+    SweepingTiles3 tiles(size);
+    tiles.active().set(1);
 
-    // and now we fill in the rest of the distances with fast sweeping
+    static const int kSweepDirections[8] = {0, 7, 4, 3, 2, 5, 6, 1};
     for (unsigned int pass = 0; pass < 2; ++pass) {
-        sweep(mesh, +1, +1, +1, sdf, &closestTri);
-        sweep(mesh, -1, -1, -1, sdf, &closestTri);
-        sweep(mesh, +1, +1, -1, sdf, &closestTri);
-        sweep(mesh, -1, -1, +1, sdf, &closestTri);
-        sweep(mesh, +1, -1, +1, sdf, &closestTri);
-        sweep(mesh, -1, +1, -1, sdf, &closestTri);
-        sweep(mesh, +1, -1, -1, sdf, &closestTri);
-        sweep(mesh, -1, +1, +1, sdf, &closestTri);
+        for (int d = 0; d < 8; ++d) {
+            const int direction = kSweepDirections[d];
+            const ssize_t di = (direction & 1) ? -1 : 1;
+            const ssize_t dj = (direction & 2) ? -1 : 1;
+            const ssize_t dk = (direction & 4) ? -1 : 1;
+
+            tiles.unlockAll();
+            tiles.sweep(direction, [&](size_t i, size_t j, size_t k) {
+                Vector3D gx = gridPos(i, j, k);
+                bool isPointChanged = false;
+
+                // Check the closest triangles of the seven neighbors in the
+                // upwind octant. The neighbors often share the same triangle,
+                // so each triangle is evaluated once.
+                size_t candidates[7];
+                size_t numCandidates = 0;
+                for (int n = 1; n < 8; ++n) {
+                    const ssize_t ni = static_cast<ssize_t>(i) - (n & 1) * di;
+                    const ssize_t nj =
+                        static_cast<ssize_t>(j) - ((n >> 1) & 1) * dj;
+                    const ssize_t nk =
+                        static_cast<ssize_t>(k) - ((n >> 2) & 1) * dk;
+                    if (ni < 0 || ni >= maxSizeX || nj < 0 ||
+                        nj >= maxSizeY || nk < 0 || nk >= maxSizeZ) {
+                        continue;
+                    }
+
+                    const size_t t = closestTri(ni, nj, nk);
+                    if (t == kMaxSize || t == closestTri(i, j, k) ||
+                        std::find(candidates, candidates + numCandidates, t) !=
+                            candidates + numCandidates) {
+                        continue;
+                    }
+                    candidates[numCandidates++] = t;
+
+                    double d = closestDistance(mesh, t, gx);
+                    if (d < phi(i, j, k)) {
+                        phi(i, j, k) = d;
+                        closestTri(i, j, k) = t;
+                        isPointChanged = true;
+                    }
+                }
+
+                return isPointChanged;
+            });
+        }
     }
 
     // then figure out signs (inside/outside) from intersection counts
-    for (size_t k = 0; k < size.z; ++k) {
-        for (size_t j = 0; j < size.y; ++j) {
-            unsigned int totalCount = 0U;
-            for (size_t i = 0; i < size.x; ++i) {
-                totalCount += intersectionCount(i, j, k);
-                // if parity of intersections so far is odd,
-                if (totalCount % 2 == 1) {
-                    // we are inside the mesh
-                    (*sdf)(i, j, k) = -(*sdf)(i, j, k);
-                }
+    parallelFor(kZeroSize, size.y, kZeroSize, size.z, [&](size_t j, size_t k) {
+        unsigned int totalCount = 0U;
+        for (size_t i = 0; i < size.x; ++i) {
+            totalCount += intersectionCount(i, j, k);
+            // if parity of intersections so far is odd,
+            if (totalCount % 2 == 1) {
+                // we are inside the mesh
+                phi(i, j, k) = -phi(i, j, k);
             }
         }
-    }
+    });
 }
 
 }  // namespace jet
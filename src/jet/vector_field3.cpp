@@ -5,6 +5,7 @@
 // property of any third parties.
 
 #include <pch.h>
+#include <jet/parallel.h>
 #include <jet/vector_field3.h>
 
 using namespace jet;
@@ -15,6 +16,16 @@ VectorField3::VectorField3() {
 VectorField3::~VectorField3() {
 }
 
+void VectorField3::sample(const ConstArrayAccessor1<Vector3D>& points,
+                          ArrayAccessor1<Vector3D> result,
+                          ExecutionPolicy policy) const {
+    JET_THROW_INVALID_ARG_IF(points.size() != result.size());
+
+    parallelFor(kZeroSize, points.size(), [&](size_t i) {
+        result[i] = sample(points[i]);
+    }, policy);
+}
+
 double VectorField3::divergence(const Vector3D&) const {
     return 0.0;
 }
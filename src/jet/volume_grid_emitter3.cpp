@@ -145,6 +145,16 @@ void VolumeGridEmitter3::emit() {
     }
 }
 
+void VolumeGridEmitter3::saveCheckpoint(const std::string& prefix,
+                                        Checkpoint* checkpoint) const {
+    checkpoint->setValue(prefix + "hasEmitted", _hasEmitted);
+}
+
+void VolumeGridEmitter3::loadCheckpoint(const std::string& prefix,
+                                        const Checkpoint& checkpoint) {
+    checkpoint.getValue(prefix + "hasEmitted", &_hasEmitted);
+}
+
 VolumeGridEmitter3::Builder VolumeGridEmitter3::builder() { return Builder(); }
 
 VolumeGridEmitter3::Builder& VolumeGridEmitter3::Builder::withSourceRegion(
@@ -12,6 +12,9 @@
 #include <jet/surface_to_implicit3.h>
 #include <jet/volume_particle_emitter3.h>
 
+#include <string>
+#include <vector>
+
 using namespace jet;
 
 static const size_t kDefaultHashGridResolution = 64;
@@ -167,6 +170,20 @@ double VolumeParticleEmitter3::random() {
     return d(_rng);
 }
 
+void VolumeParticleEmitter3::saveCheckpoint(const std::string& prefix,
+                                            Checkpoint* checkpoint) const {
+    checkpoint->setRandomEngine(prefix + "rng", _rng);
+    checkpoint->setValue(prefix + "numberOfEmittedParticles",
+                         _numberOfEmittedParticles);
+}
+
+void VolumeParticleEmitter3::loadCheckpoint(const std::string& prefix,
+                                            const Checkpoint& checkpoint) {
+    checkpoint.getRandomEngine(prefix + "rng", &_rng);
+    checkpoint.getValue(prefix + "numberOfEmittedParticles",
+                        &_numberOfEmittedParticles);
+}
+
 VolumeParticleEmitter3::Builder VolumeParticleEmitter3::builder() {
     return Builder();
 }
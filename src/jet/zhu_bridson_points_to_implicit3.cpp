@@ -6,7 +6,6 @@
 
 #include <pch.h>
 
-#include <jet/fmm_level_set_solver3.h>
 #include <jet/particle_system_data3.h>
 #include <jet/zhu_bridson_points_to_implicit3.h>
 
@@ -47,28 +46,31 @@ void ZhuBridsonPointsToImplicit3::convert(
     const auto neighborSearcher = particles.neighborSearcher();
     const double isoContValue = _cutOffThreshold * _kernelRadius;
 
+    const double farValue = output->boundingBox().diagonalLength();
+
     auto temp = output->clone();
-    temp->fill([&](const Vector3D& x) -> double {
-        Vector3D xAvg;
-        double wSum = 0.0;
-        const auto func = [&](size_t, const Vector3D& xi) {
-            const double wi = k((x - xi).length() / _kernelRadius);
-            wSum += wi;
-            xAvg += wi * xi;
-        };
-        neighborSearcher->forEachNearbyPoint(x, _kernelRadius, func);
+    evaluate(points, _kernelRadius, farValue,
+             [&](const Vector3D& x) -> double {
+                 Vector3D xAvg;
+                 double wSum = 0.0;
+                 const auto func = [&](size_t, const Vector3D& xi) {
+                     const double wi = k((x - xi).length() / _kernelRadius);
+                     wSum += wi;
+                     xAvg += wi * xi;
+                 };
+                 neighborSearcher->forEachNearbyPoint(x, _kernelRadius, func);
 
-        if (wSum > 0.0) {
-            xAvg /= wSum;
-            return (x - xAvg).length() - isoContValue;
-        } else {
-            return output->boundingBox().diagonalLength();
-        }
-    });
+                 if (wSum > 0.0) {
+                     xAvg /= wSum;
+                     return (x - xAvg).length() - isoContValue;
+                 } else {
+                     return farValue;
+                 }
+             },
+             temp.get());
 
     if (_isOutputSdf) {
-        FmmLevelSetSolver3 solver;
-        solver.reinitialize(*temp, kMaxD, output);
+        reinitialize(*temp, _kernelRadius, output);
     } else {
         temp->swap(output);
     }
@@ -138,7 +138,14 @@ void addCellCenteredVectorGrid3(py::module& m) {
             )pbdoc")
         .def("fill",
              [](CellCenteredVectorGrid3& instance, py::object obj) {
-                 if (py::isinstance<Vector3D>(obj)) {
+                 if (py::isinstance<py::array>(obj)) {
+                     if (!copyArrayToArrayAccessor3(
+                             obj, instance.dataAccessor())) {
+                         throw std::invalid_argument(
+                             "Input array must have shape (z, y, x, 3) of "
+                             "dataSize.");
+                     }
+                 } else if (py::isinstance<Vector3D>(obj)) {
                      instance.fill(obj.cast<Vector3D>());
                  } else if (py::isinstance<py::tuple>(obj)) {
                      instance.fill(objectToVector3D(obj));
@@ -151,11 +158,16 @@ void addCellCenteredVectorGrid3(py::module& m) {
                          ExecutionPolicy::kSerial);
                  } else {
                      throw std::invalid_argument(
-                         "Input type must be Vector3D or function object -> "
-                         "Vector3D");
+                         "Input type must be Vector3D, NumPy array or "
+                         "function object -> Vector3D");
                  }
              },
-             R"pbdoc(Fills the grid with given value or function.)pbdoc")
+             R"pbdoc(
+             Fills the grid with given value, array or function.
+
+             An array must have shape (z, y, x, 3) of dataSize and is copied
+             without calling back into Python.
+             )pbdoc")
         .def("set", &CellCenteredVectorGrid3::set,
              R"pbdoc(
              Sets the contents with the given `other` grid.
@@ -6,6 +6,7 @@
 
 #include "collocated_vector_grid.h"
 #include "pybind11_utils.h"
+#include "vector_field.h"
 
 #include <jet/collocated_vector_grid2.h>
 #include <jet/collocated_vector_grid3.h>
@@ -254,6 +255,17 @@ void addCollocatedVectorGrid3(py::module& m) {
              py::arg("i"), py::arg("j"), py::arg("k"))
         .def("dataAccessor", &CollocatedVectorGrid3::dataAccessor,
              R"pbdoc(Returns the data array accessor.)pbdoc")
+        .def("dataView",
+             [](py::object self) {
+                 auto& instance = self.cast<CollocatedVectorGrid3&>();
+                 return arrayAccessor3ToView(instance.dataAccessor(), self);
+             },
+             R"pbdoc(
+             Returns a writable NumPy view of the grid data.
+
+             The view shares memory with the grid and has shape (z, y, x, 3)
+             of dataSize. It becomes invalid when the grid is resized.
+             )pbdoc")
         .def(
             "dataPosition", &CollocatedVectorGrid3::dataPosition,
             R"pbdoc(Returns the function that maps data point to its position.)pbdoc")
@@ -271,9 +283,14 @@ void addCollocatedVectorGrid3(py::module& m) {
              py::arg("func"))
         .def("sample",
              [](const CollocatedVectorGrid3& instance, py::object obj) {
-                 return instance.sample(objectToVector3D(obj));
+                 return sampleVectorField3(instance, obj);
              },
-             R"pbdoc(Returns sampled value at given position `x`.)pbdoc",
+             R"pbdoc(
+             Returns sampled value at given position `x`.
+
+             If `x` is a NumPy array of shape (N, 3), returns an array of
+             shape (N, 3) with the value at each point.
+             )pbdoc",
              py::arg("x"))
         .def("divergence",
              [](const CollocatedVectorGrid3& instance, py::object obj) {
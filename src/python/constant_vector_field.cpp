@@ -6,6 +6,7 @@
 
 #include "constant_vector_field.h"
 #include "pybind11_utils.h"
+#include "vector_field.h"
 
 #include <jet/constant_vector_field2.h>
 #include <jet/constant_vector_field3.h>
@@ -49,9 +50,14 @@ void addConstantVectorField3(py::module& m) {
             py::arg("value"))
         .def("sample",
              [](const ConstantVectorField3& instance, py::object obj) {
-                 return instance.sample(objectToVector3D(obj));
+                 return sampleVectorField3(instance, obj);
              },
-             R"pbdoc(Returns sampled value at given position `x`.)pbdoc",
+             R"pbdoc(
+             Returns sampled value at given position `x`.
+
+             If `x` is a NumPy array of shape (N, 3), returns an array of
+             shape (N, 3) with the value at each point.
+             )pbdoc",
              py::arg("x"))
         .def("sampler",
              [](const ConstantVectorField3& instance) {
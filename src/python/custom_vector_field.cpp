@@ -6,6 +6,7 @@
 
 #include "custom_vector_field.h"
 #include "pybind11_utils.h"
+#include "vector_field.h"
 
 #include <jet/custom_vector_field2.h>
 #include <jet/custom_vector_field3.h>
@@ -124,9 +125,14 @@ void addCustomVectorField3(py::module& m) {
              py::arg("curlFunc") = nullptr)
         .def("sample",
              [](const CustomVectorField3& instance, py::object obj) {
-                 return instance.sample(objectToVector3D(obj));
+                 return sampleVectorField3(instance, obj);
              },
-             R"pbdoc(Returns sampled value at given position `x`.)pbdoc",
+             R"pbdoc(
+             Returns sampled value at given position `x`.
+
+             If `x` is a NumPy array of shape (N, 3), returns an array of
+             shape (N, 3) with the value at each point.
+             )pbdoc",
              py::arg("x"))
         .def("divergence",
              [](const CustomVectorField3& instance, py::object obj) {
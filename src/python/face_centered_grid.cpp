@@ -6,6 +6,7 @@
 
 #include "face_centered_grid.h"
 #include "pybind11_utils.h"
+#include "vector_field.h"
 
 #include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
@@ -395,6 +396,39 @@ void addFaceCenteredGrid3(py::module& m) {
              R"pbdoc(Returns v data accessor.)pbdoc")
         .def("wAccessor", &FaceCenteredGrid3::wAccessor,
              R"pbdoc(Returns w data accessor.)pbdoc")
+        .def("uView",
+             [](py::object self) {
+                 auto& instance = self.cast<FaceCenteredGrid3&>();
+                 return arrayAccessor3ToView(instance.uAccessor(), self);
+             },
+             R"pbdoc(
+             Returns a writable NumPy view of the u data.
+
+             The view shares memory with the grid and has shape (z, y, x) of
+             uSize. It becomes invalid when the grid is resized.
+             )pbdoc")
+        .def("vView",
+             [](py::object self) {
+                 auto& instance = self.cast<FaceCenteredGrid3&>();
+                 return arrayAccessor3ToView(instance.vAccessor(), self);
+             },
+             R"pbdoc(
+             Returns a writable NumPy view of the v data.
+
+             The view shares memory with the grid and has shape (z, y, x) of
+             vSize. It becomes invalid when the grid is resized.
+             )pbdoc")
+        .def("wView",
+             [](py::object self) {
+                 auto& instance = self.cast<FaceCenteredGrid3&>();
+                 return arrayAccessor3ToView(instance.wAccessor(), self);
+             },
+             R"pbdoc(
+             Returns a writable NumPy view of the w data.
+
+             The view shares memory with the grid and has shape (z, y, x) of
+             wSize. It becomes invalid when the grid is resized.
+             )pbdoc")
         .def("uPosition", &FaceCenteredGrid3::uPosition,
              R"pbdoc(
             Returns function object that maps u data point to its actual position.
@@ -436,7 +470,28 @@ void addFaceCenteredGrid3(py::module& m) {
              )pbdoc")
         .def("fill",
              [](FaceCenteredGrid3& instance, py::object obj) {
-                 if (py::isinstance<Vector3D>(obj)) {
+                 if ((py::isinstance<py::tuple>(obj) ||
+                      py::isinstance<py::list>(obj)) &&
+                     py::len(obj) == 3 &&
+                     py::isinstance<py::array>(obj[py::int_(0)])) {
+                     const py::sequence arrays = obj.cast<py::sequence>();
+                     if (!isArrayOfArrayAccessor3Shape(
+                             arrays[0], instance.uAccessor()) ||
+                         !isArrayOfArrayAccessor3Shape(
+                             arrays[1], instance.vAccessor()) ||
+                         !isArrayOfArrayAccessor3Shape(
+                             arrays[2], instance.wAccessor())) {
+                         throw std::invalid_argument(
+                             "Input arrays must have shapes (z, y, x) of "
+                             "uSize, vSize and wSize.");
+                     }
+                     copyArrayToArrayAccessor3(arrays[0],
+                                               instance.uAccessor());
+                     copyArrayToArrayAccessor3(arrays[1],
+                                               instance.vAccessor());
+                     copyArrayToArrayAccessor3(arrays[2],
+                                               instance.wAccessor());
+                 } else if (py::isinstance<Vector3D>(obj)) {
                      instance.fill(obj.cast<Vector3D>());
                  } else if (py::isinstance<py::tuple>(obj)) {
                      instance.fill(objectToVector3D(obj));
@@ -449,11 +504,17 @@ void addFaceCenteredGrid3(py::module& m) {
                          ExecutionPolicy::kSerial);
                  } else {
                      throw std::invalid_argument(
-                         "Input type must be Vector3D or function object -> "
-                         "Vector3D");
+                         "Input type must be Vector3D, three NumPy arrays or "
+                         "function object -> Vector3D");
                  }
              },
-             R"pbdoc(Fills the grid with given value or function.)pbdoc")
+             R"pbdoc(
+             Fills the grid with given value, arrays or function.
+
+             Arrays are given as a sequence (u, v, w) of shapes (z, y, x) of
+             uSize, vSize and wSize, matching uView, vView and wView, and are
+             copied without calling back into Python.
+             )pbdoc")
         .def("forEachUIndex",
              [](FaceCenteredGrid3& instance, py::function func) {
                  instance.forEachUIndex(func);
@@ -492,9 +553,14 @@ void addFaceCenteredGrid3(py::module& m) {
              py::arg("func"))
         .def("sample",
              [](const FaceCenteredGrid3& instance, py::object obj) {
-                 return instance.sample(objectToVector3D(obj));
+                 return sampleVectorField3(instance, obj);
              },
-             R"pbdoc(Returns sampled value at given position `x`.)pbdoc",
+             R"pbdoc(
+             Returns sampled value at given position `x`.
+
+             If `x` is a NumPy array of shape (N, 3), returns an array of
+             shape (N, 3) with the value at each point.
+             )pbdoc",
              py::arg("x"))
         .def("divergence",
              [](const FaceCenteredGrid3& instance, py::object obj) {
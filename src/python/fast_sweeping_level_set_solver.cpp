@@ -0,0 +1,102 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fast_sweeping_level_set_solver.h"
+#include "pybind11_utils.h"
+
+#include <jet/fast_sweeping_level_set_solver3.h>
+
+namespace py = pybind11;
+using namespace jet;
+
+void addFastSweepingLevelSetSolver3(py::module& m) {
+    py::class_<FastSweepingLevelSetSolver3, FastSweepingLevelSetSolver3Ptr,
+               LevelSetSolver3>(
+        m, "FastSweepingLevelSetSolver3",
+        R"pbdoc(
+         3-D parallel fast sweeping method implementation.
+
+         This class solves the same first-order upwind discretization as
+         FmmLevelSetSolver3 using Gauss-Seidel sweeps over the grid tiles, which
+         are processed in parallel along the diagonal planes of the tiles.
+
+         - See Zhao, Hongkai. "A fast sweeping method for eikonal equations."
+               Mathematics of computation 74.250 (2005): 603-627.
+         - See Detrixhe, Miles, Frederic Gibou, and Chohong Min. "A parallel fast
+               sweeping method for the Eikonal equation." Journal of Computational
+               Physics 237 (2013): 46-55.
+         )pbdoc")
+        .def(py::init<unsigned int>(),
+             R"pbdoc(
+             Constructs the solver with given max number of sweeping iterations.
+             )pbdoc",
+             py::arg("maxNumberOfIterations") = 10)
+        .def_property("maxNumberOfIterations",
+                      &FastSweepingLevelSetSolver3::maxNumberOfIterations,
+                      &FastSweepingLevelSetSolver3::setMaxNumberOfIterations,
+                      R"pbdoc(
+             The max number of sweeping iterations (eight sweeps each).
+             )pbdoc")
+        .def("reinitialize",
+             [](FastSweepingLevelSetSolver3& instance,
+                const ScalarGrid3Ptr& inputSdf, double maxDistance,
+                ScalarGrid3Ptr outputSdf) {
+                 instance.reinitialize(*inputSdf, maxDistance, outputSdf.get());
+             },
+             R"pbdoc(
+             Reinitializes given scalar field to signed-distance field.
+
+             Parameters
+             ----------
+             - inputSdf : Input signed-distance field which can be distorted.
+             - maxDistance : Max range of reinitialization.
+             - outputSdf : Output signed-distance field.
+             )pbdoc",
+             py::arg("inputSdf"), py::arg("maxDistance"), py::arg("outputSdf"))
+        .def(
+            "extrapolate",
+            [](FastSweepingLevelSetSolver3& instance, const Grid3Ptr& input,
+               const ScalarGrid3Ptr& sdf, double maxDistance,
+               Grid3Ptr output) {
+                auto inputSG = std::dynamic_pointer_cast<ScalarGrid3>(input);
+                auto inputCG =
+                    std::dynamic_pointer_cast<CollocatedVectorGrid3>(input);
+                auto inputFG =
+                    std::dynamic_pointer_cast<FaceCenteredGrid3>(input);
+
+                auto outputSG = std::dynamic_pointer_cast<ScalarGrid3>(output);
+                auto outputCG =
+                    std::dynamic_pointer_cast<CollocatedVectorGrid3>(output);
+                auto outputFG =
+                    std::dynamic_pointer_cast<FaceCenteredGrid3>(output);
+
+                if (inputSG != nullptr && outputSG != nullptr) {
+                    instance.extrapolate(*inputSG, *sdf, maxDistance,
+                                         outputSG.get());
+                } else if (inputCG != nullptr && outputCG != nullptr) {
+                    instance.extrapolate(*inputCG, *sdf, maxDistance,
+                                         outputCG.get());
+                } else if (inputFG != nullptr && outputFG != nullptr) {
+                    instance.extrapolate(*inputFG, *sdf, maxDistance,
+                                         outputFG.get());
+                } else {
+                    throw std::invalid_argument(
+                        "Grids input and output must have same type.");
+                }
+            },
+            R"pbdoc(
+             Extrapolates given field from negative to positive SDF region.
+
+             Parameters
+             ----------
+             - input : Input field to be extrapolated.
+             - sdf : Reference signed-distance field.
+             - maxDistance : Max range of extrapolation.
+             - output : Output field.
+            )pbdoc",
+            py::arg("input"), py::arg("sdf"), py::arg("maxDistance"),
+            py::arg("output"));
+}
@@ -57,13 +57,14 @@ void addFdmMgpcgSolver3(py::module& m) {
         3-D finite difference-type linear system solver using MGPCG.
         )pbdoc")
         .def(py::init<uint32_t, size_t, uint32_t, uint32_t, uint32_t, uint32_t,
-                      double, double, bool>(),
+                      double, double, bool, bool>(),
              py::arg("numberOfCgIter"), py::arg("maxNumberOfLevels"),
              py::arg("numberOfRestrictionIter") = 5,
              py::arg("numberOfCorrectionIter") = 5,
              py::arg("numberOfCoarsestIter") = 20,
              py::arg("numberOfFinalIter") = 20, py::arg("maxTolerance") = 1e-9,
-             py::arg("sorFactor") = 1.5, py::arg("useRedBlackOrdering") = false)
+             py::arg("sorFactor") = 1.5, py::arg("useRedBlackOrdering") = false,
+             py::arg("useSinglePrecisionPreconditioner") = false)
         .def_property_readonly("maxNumberOfIterations",
                                &FdmMgpcgSolver3::maxNumberOfIterations,
                                R"pbdoc(
@@ -84,5 +85,11 @@ void addFdmMgpcgSolver3(py::module& m) {
             )pbdoc")
         .def_property_readonly("sorFactor", &FdmMgpcgSolver3::sorFactor)
         .def_property_readonly("useRedBlackOrdering",
-                               &FdmMgpcgSolver3::useRedBlackOrdering);
+                               &FdmMgpcgSolver3::useRedBlackOrdering)
+        .def_property_readonly(
+            "useSinglePrecisionPreconditioner",
+            &FdmMgpcgSolver3::useSinglePrecisionPreconditioner,
+            R"pbdoc(
+            True if the MG preconditioner runs in single precision.
+            )pbdoc");
 }
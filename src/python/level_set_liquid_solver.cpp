@@ -152,6 +152,19 @@ void addLevelSetLiquidSolver3(py::module& m) {
              24, no. 1 (2005): 81-97.
              )pbdoc",
              py::arg("isEnabled"))
+        .def_property("narrowBandWidth",
+                      &LevelSetLiquidSolver3::narrowBandWidth,
+                      &LevelSetLiquidSolver3::setNarrowBandWidth,
+                      R"pbdoc(
+             Half width of the narrow band in number of cells.
+
+             When positive, the signed-distance field is only advected,
+             reinitialized and used for velocity extrapolation within this
+             distance from the interface, and it is clamped outside. The band
+             is at least one cell wider than the max CFL number. Zero disables
+             the narrow band, and widths between zero and one cell are
+             rejected.
+             )pbdoc")
         .def("computeVolume", &LevelSetLiquidSolver3::computeVolume,
              R"pbdoc(
              Returns liquid volume measured by smeared Heaviside function.
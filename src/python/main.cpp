@@ -24,6 +24,7 @@
 #include "cylinder.h"
 #include "eno_level_set_solver.h"
 #include "face_centered_grid.h"
+#include "fast_sweeping_level_set_solver.h"
 #include "fdm_cg_solver.h"
 #include "fdm_gauss_seidel_solver.h"
 #include "fdm_iccg_solver.h"
@@ -274,6 +275,7 @@ PYBIND11_PLUGIN(pyjet) {
     addEnoLevelSetSolver3(m);
     addFmmLevelSetSolver2(m);
     addFmmLevelSetSolver3(m);
+    addFastSweepingLevelSetSolver3(m);
     addPointsToImplicit2(m);
     addPointsToImplicit3(m);
     addSphericalPointsToImplicit2(m);
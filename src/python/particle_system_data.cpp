@@ -192,12 +192,15 @@ void addParticleSystemData2(py::module& m) {
              default, PointParallelHashGridSearcher2 is used.
              )pbdoc")
         .def_property_readonly("neighborLists",
-                               &ParticleSystemData2::neighborLists,
+                               [](const ParticleSystemData2& instance) {
+                                   return instance.neighborLists()
+                                       .toNestedVectors();
+                               },
                                R"pbdoc(
              The neighbor lists.
 
              This property returns neighbor lists which is available after calling
-             PointParallelHashGridSearcher2::buildNeighborLists. Each list stores
+             ParticleSystemData2::buildNeighborLists. Each list stores
              indices of the neighbors.
              )pbdoc")
         .def("set",
@@ -387,12 +390,15 @@ void addParticleSystemData3(py::module& m) {
              default, PointParallelHashGridSearcher2 is used.
              )pbdoc")
         .def_property_readonly("neighborLists",
-                               &ParticleSystemData3::neighborLists,
+                               [](const ParticleSystemData3& instance) {
+                                   return instance.neighborLists()
+                                       .toNestedVectors();
+                               },
                                R"pbdoc(
              The neighbor lists.
 
              This property returns neighbor lists which is available after calling
-             PointParallelHashGridSearcher2::buildNeighborLists. Each list stores
+             ParticleSystemData3::buildNeighborLists. Each list stores
              indices of the neighbors.
              )pbdoc")
         .def("set",
@@ -64,5 +64,16 @@ void addPointsToImplicit3(pybind11::module& m) {
              - points : List of 3D vectors.
              - output : Scalar grid output.
              )pbdoc",
-             py::arg("points"), py::arg("output"));
+             py::arg("points"), py::arg("output"))
+        .def_property("isNarrowBandEnabled",
+                      &PointsToImplicit3::isNarrowBandEnabled,
+                      &PointsToImplicit3::setIsNarrowBandEnabled,
+                      R"pbdoc(
+             True if the kernels are evaluated only near the points.
+             )pbdoc")
+        .def_property("levelSetSolver", &PointsToImplicit3::levelSetSolver,
+                      &PointsToImplicit3::setLevelSetSolver,
+                      R"pbdoc(
+             The level set solver for the reinitialization (FMM if None).
+             )pbdoc");
 }
@@ -7,6 +7,8 @@
 #ifndef SRC_PYTHON_PYBIND11_UTILS_H_
 #define SRC_PYTHON_PYBIND11_UTILS_H_
 
+#include <jet/array_accessor3.h>
+#include <jet/parallel.h>
 #include <jet/point2.h>
 #include <jet/point3.h>
 #include <jet/quaternion.h>
@@ -17,9 +19,12 @@
 #include <jet/vector4.h>
 
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <vector>
+
 namespace jet {
 
 inline Size2 tupleToSize2(pybind11::tuple tpl) {
@@ -486,6 +491,146 @@ inline void parseGridResizeParams(pybind11::args args, pybind11::kwargs kwargs,
         gridSpacing.set(domainSizeX / static_cast<double>(resolution.x));
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+//! C-contiguous double array. Other dtypes and layouts are converted.
+typedef pybind11::array_t<double, pybind11::array::c_style |
+                                      pybind11::array::forcecast>
+    DoubleArray;
+
+//! Returns true if \p obj is a NumPy array of shape (N, 3).
+inline bool isVector3DArray(const pybind11::object& obj) {
+    if (!pybind11::isinstance<pybind11::array>(obj)) {
+        return false;
+    }
+
+    const auto arr = pybind11::reinterpret_borrow<pybind11::array>(obj);
+    return arr.ndim() == 2 && arr.shape(1) == 3;
+}
+
+//! Converts \p obj to a C-contiguous double array of shape (N, 3).
+inline DoubleArray objectToVector3DArray(const pybind11::object& obj) {
+    DoubleArray arr = DoubleArray::ensure(obj);
+    if (!arr || arr.ndim() != 2 || arr.shape(1) != 3) {
+        throw std::invalid_argument("Input array must have shape (N, 3).");
+    }
+    return arr;
+}
+
+//!
+//! \brief Evaluates \p func for each row of an (N, 3) array.
+//!
+//! The rows are evaluated in parallel with the GIL released, so \p func must
+//! not touch Python objects. Returns an (N,) array for double results and an
+//! (N, 3) array for Vector3D results.
+//!
+template <typename T, typename Func>
+inline pybind11::array_t<double> evaluateVector3DArray(
+    const pybind11::object& obj, const Func& func) {
+    static_assert(sizeof(T) % sizeof(double) == 0,
+                  "Result type must be a packed array of doubles.");
+
+    const DoubleArray points = objectToVector3DArray(obj);
+    const size_t n = static_cast<size_t>(points.shape(0));
+
+    std::vector<size_t> shape = {n};
+    if (sizeof(T) > sizeof(double)) {
+        shape.push_back(sizeof(T) / sizeof(double));
+    }
+    pybind11::array_t<double> result(shape);
+
+    const Vector3D* src = reinterpret_cast<const Vector3D*>(points.data());
+    T* dst = reinterpret_cast<T*>(result.mutable_data());
+    {
+        pybind11::gil_scoped_release release;
+        parallelFor(kZeroSize, n, [&](size_t i) { dst[i] = func(src[i]); });
+    }
+
+    return result;
+}
+
+//!
+//! \brief Returns a writable NumPy view of \p data without copying.
+//!
+//! The view has shape (depth, height, width) for double data and
+//! (depth, height, width, 3) for Vector3D data. It keeps \p owner alive, but
+//! it is invalidated when the owner reallocates the data (e.g., resize).
+//!
+template <typename T>
+inline pybind11::array arrayAccessor3ToView(ArrayAccessor3<T> data,
+                                            pybind11::handle owner) {
+    static_assert(sizeof(T) % sizeof(double) == 0,
+                  "Element type must be a packed array of doubles.");
+
+    std::vector<size_t> shape = {data.depth(), data.height(), data.width()};
+    std::vector<size_t> strides = {sizeof(T) * data.width() * data.height(),
+                                   sizeof(T) * data.width(), sizeof(T)};
+    if (sizeof(T) > sizeof(double)) {
+        shape.push_back(sizeof(T) / sizeof(double));
+        strides.push_back(sizeof(double));
+    }
+
+    return pybind11::array_t<double>(
+        shape, strides, reinterpret_cast<double*>(data.data()), owner);
+}
+
+//! Returns true if \p obj is a NumPy array shaped like
+//! arrayAccessor3ToView(data).
+template <typename T>
+inline bool isArrayOfArrayAccessor3Shape(const pybind11::object& obj,
+                                         ArrayAccessor3<T> data) {
+    static_assert(sizeof(T) % sizeof(double) == 0,
+                  "Element type must be a packed array of doubles.");
+
+    if (!pybind11::isinstance<pybind11::array>(obj)) {
+        return false;
+    }
+
+    std::vector<size_t> shape = {data.depth(), data.height(), data.width()};
+    if (sizeof(T) > sizeof(double)) {
+        shape.push_back(sizeof(T) / sizeof(double));
+    }
+
+    const pybind11::array values = obj.cast<pybind11::array>();
+    if (static_cast<size_t>(values.ndim()) != shape.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < shape.size(); ++i) {
+        if (static_cast<size_t>(values.shape(i)) != shape[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//!
+//! \brief Copies NumPy array \p obj to \p data without calling back into
+//! Python.
+//!
+//! Returns false without copying if \p obj is not shaped like
+//! arrayAccessor3ToView(data). Other dtypes and layouts are converted.
+//!
+template <typename T>
+inline bool copyArrayToArrayAccessor3(const pybind11::object& obj,
+                                      ArrayAccessor3<T> data) {
+    if (!isArrayOfArrayAccessor3Shape(obj, data)) {
+        return false;
+    }
+
+    const DoubleArray values = DoubleArray::ensure(obj);
+    if (!values) {
+        return false;
+    }
+
+    const double* src = values.data();
+    double* dst = reinterpret_cast<double*>(data.data());
+    const size_t n = static_cast<size_t>(values.size());
+    pybind11::gil_scoped_release release;
+    parallelFor(kZeroSize, n, [&](size_t i) { dst[i] = src[i]; });
+    return true;
+}
+
 }  // namespace jet
 
 #endif  // SRC_PYTHON_PYBIND11_UTILS_H_
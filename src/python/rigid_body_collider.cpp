@@ -90,5 +90,20 @@ void addRigidBodyCollider3(py::module& m) {
                 return instance.velocityAt(objectToVector3D(obj));
             },
             R"pbdoc(Returns the velocity of the collider at given point.)pbdoc",
-            py::arg("point"));
+            py::arg("point"))
+        .def_property("sdfCacheGridSpacing",
+                      &RigidBodyCollider3::sdfCacheGridSpacing,
+                      &RigidBodyCollider3::setSdfCacheGridSpacing,
+                      R"pbdoc(
+            Grid spacing of the local-space signed-distance cache.
+
+            Zero or negative value disables the cache.
+            )pbdoc")
+        .def("updateSdfCache", &RigidBodyCollider3::updateSdfCache,
+             R"pbdoc(
+            Rebuilds the signed-distance cache from the current surface.
+
+            Call this after the surface geometry has changed. Changes of the
+            surface transform do not require rebuilding the cache.
+            )pbdoc");
 }
@@ -299,12 +299,56 @@ void addScalarGrid3(py::module& m) {
              py::arg("i"), py::arg("j"), py::arg("k"))
         .def("dataAccessor", &ScalarGrid3::dataAccessor,
              R"pbdoc(Returns the data array accessor.)pbdoc")
+        .def("dataView",
+             [](py::object self) {
+                 auto& instance = self.cast<ScalarGrid3&>();
+                 return arrayAccessor3ToView(instance.dataAccessor(), self);
+             },
+             R"pbdoc(
+             Returns a writable NumPy view of the grid data.
+
+             The view shares memory with the grid and has shape (z, y, x) of
+             dataSize. It becomes invalid when the grid is resized.
+             )pbdoc")
         .def(
             "dataPosition", &ScalarGrid3::dataPosition,
             R"pbdoc(Returns the function that maps data point to its position.)pbdoc")
+        .def("dataPositions",
+             [](const ScalarGrid3& instance) {
+                 const Size3 size = instance.dataSize();
+                 py::array_t<double> result(
+                     std::vector<size_t>{size.z, size.y, size.x, 3});
+                 Vector3D* dst =
+                     reinterpret_cast<Vector3D*>(result.mutable_data());
+                 auto pos = instance.dataPosition();
+                 {
+                     py::gil_scoped_release release;
+                     parallelFor(kZeroSize, size.x, kZeroSize, size.y,
+                                 kZeroSize, size.z,
+                                 [&](size_t i, size_t j, size_t k) {
+                                     dst[i + size.x * (j + size.y * k)] =
+                                         pos(i, j, k);
+                                 });
+                 }
+                 return result;
+             },
+             R"pbdoc(
+             Returns the positions of all data points.
+
+             The result is a NumPy array of shape (z, y, x, 3) of dataSize,
+             which matches dataView. Together they replace per-point
+             callbacks, e.g. `grid.dataView()[:] = f(grid.dataPositions())`.
+             )pbdoc")
         .def("fill",
              [](ScalarGrid3& instance, py::object obj) {
-                 if (py::isinstance<double>(obj)) {
+                 if (py::isinstance<py::array>(obj)) {
+                     if (!copyArrayToArrayAccessor3(
+                             obj, instance.dataAccessor())) {
+                         throw std::invalid_argument(
+                             "Input array must have shape (z, y, x) of "
+                             "dataSize.");
+                     }
+                 } else if (py::isinstance<double>(obj)) {
                      instance.fill(obj.cast<double>());
                  } else if (py::isinstance<py::function>(obj)) {
                      auto func = obj.cast<py::function>();
@@ -315,11 +359,16 @@ void addScalarGrid3(py::module& m) {
                          ExecutionPolicy::kSerial);
                  } else {
                      throw std::invalid_argument(
-                         "Input type must be Vector3D or function object -> "
-                         "double");
+                         "Input type must be double, NumPy array or function "
+                         "object -> double");
                  }
              },
-             R"pbdoc(Fills the grid with given value or function.)pbdoc")
+             R"pbdoc(
+             Fills the grid with given value, array or function.
+
+             An array must have shape (z, y, x) of dataSize and is copied
+             without calling back into Python.
+             )pbdoc")
         .def("forEachDataPointIndex",
              [](ScalarGrid3& instance, py::function func) {
                  instance.forEachDataPointIndex(func);
@@ -333,16 +382,38 @@ void addScalarGrid3(py::module& m) {
              )pbdoc",
              py::arg("func"))
         .def("sample",
-             [](const ScalarGrid3& instance, py::object obj) {
-                 return instance.sample(objectToVector3D(obj));
+             [](const ScalarGrid3& instance, py::object obj) -> py::object {
+                 if (isVector3DArray(obj)) {
+                     return evaluateVector3DArray<double>(
+                         obj, [&instance](const Vector3D& x) {
+                             return instance.sample(x);
+                         });
+                 }
+                 return py::cast(instance.sample(objectToVector3D(obj)));
              },
-             R"pbdoc(Returns sampled value at given position `x`.)pbdoc",
+             R"pbdoc(
+             Returns sampled value at given position `x`.
+
+             If `x` is a NumPy array of shape (N, 3), returns an array of
+             shape (N,) with the value at each point.
+             )pbdoc",
              py::arg("x"))
         .def("gradient",
-             [](const ScalarGrid3& instance, py::object obj) {
-                 return instance.gradient(objectToVector3D(obj));
+             [](const ScalarGrid3& instance, py::object obj) -> py::object {
+                 if (isVector3DArray(obj)) {
+                     return evaluateVector3DArray<Vector3D>(
+                         obj, [&instance](const Vector3D& x) {
+                             return instance.gradient(x);
+                         });
+                 }
+                 return py::cast(instance.gradient(objectToVector3D(obj)));
              },
-             R"pbdoc(Returns the gradient vector at given position `x`.)pbdoc",
+             R"pbdoc(
+             Returns the gradient vector at given position `x`.
+
+             If `x` is a NumPy array of shape (N, 3), returns an array of
+             shape (N, 3) with the gradient at each point.
+             )pbdoc",
              py::arg("x"))
         .def("laplacian",
              [](const ScalarGrid3& instance, py::object obj) {
@@ -7,6 +7,7 @@
 #include "vector_field.h"
 #include "pybind11_utils.h"
 
+#include <jet/custom_vector_field3.h>
 #include <jet/vector_field2.h>
 #include <jet/vector_field3.h>
 
@@ -22,5 +23,40 @@ void addVectorField2(py::module& m) {
 void addVectorField3(py::module& m) {
     py::class_<VectorField3, VectorField3Ptr, Field3>(
         m, "VectorField3",
-        R"pbdoc(Abstract base class for 3-D vector field.)pbdoc");
+        R"pbdoc(Abstract base class for 3-D vector field.)pbdoc")
+        .def("sample", &sampleVectorField3,
+             R"pbdoc(
+             Returns sampled value at given position `x`.
+
+             If `x` is a NumPy array of shape (N, 3), returns an array of
+             shape (N, 3) with the value at each point.
+             )pbdoc",
+             py::arg("x"));
+}
+
+py::object sampleVectorField3(const VectorField3& field,
+                              const py::object& obj) {
+    if (!isVector3DArray(obj)) {
+        return py::cast(field.sample(objectToVector3D(obj)));
+    }
+
+    const DoubleArray points = objectToVector3DArray(obj);
+    const size_t n = static_cast<size_t>(points.shape(0));
+    py::array_t<double> result(std::vector<size_t>{n, 3});
+
+    ConstArrayAccessor1<Vector3D> src(
+        n, reinterpret_cast<const Vector3D*>(points.data()));
+    ArrayAccessor1<Vector3D> dst(
+        n, reinterpret_cast<Vector3D*>(result.mutable_data()));
+
+    // Custom fields call back into Python, so they keep the GIL and run
+    // serially.
+    if (dynamic_cast<const CustomVectorField3*>(&field) != nullptr) {
+        field.sample(src, dst, ExecutionPolicy::kSerial);
+    } else {
+        py::gil_scoped_release release;
+        field.sample(src, dst);
+    }
+
+    return result;
 }
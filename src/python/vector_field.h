@@ -11,7 +11,13 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <jet/vector_field3.h>
+
 void addVectorField2(pybind11::module& m);
 void addVectorField3(pybind11::module& m);
 
+//! Samples \p field at a single point or at each row of an (N, 3) array.
+pybind11::object sampleVectorField3(const jet::VectorField3& field,
+                                    const pybind11::object& obj);
+
 #endif  // SRC_PYTHON_VECTOR_FIELD_H_
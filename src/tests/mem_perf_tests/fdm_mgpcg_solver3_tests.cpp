@@ -0,0 +1,48 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "mem_perf_tests.h"
+
+#include <jet/fdm_mgpcg_solver3.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+namespace {
+
+void runExperiment(size_t n, bool useSinglePrecisionPreconditioner) {
+    const size_t mem0 = getCurrentRSS();
+
+    FdmMatrixRow3 identity;
+    identity.center = 1.0;
+
+    FdmMgLinearSystem3 system;
+    system.resizeWithFinest({n, n, n}, 5);
+    for (size_t l = 0; l < system.numberOfLevels(); ++l) {
+        system.A[l].set(identity);
+        system.x[l].set(0.0);
+        system.b[l].set(0.0);
+    }
+
+    FdmMgpcgSolver3 solver(1, 5, 5, 5, 20, 20, 0.0, 1.5, false,
+                           useSinglePrecisionPreconditioner);
+    solver.solve(&system);
+
+    const size_t mem1 = getCurrentRSS();
+
+    const auto msg = makeReadableByteSize(mem1 - mem0);
+
+    printMemReport(msg.first, msg.second);
+}
+
+}  // namespace
+
+TEST(FdmMgpcgSolver3, Memory) { runExperiment(128, false); }
+
+TEST(FdmMgpcgSolver3, MemoryWithSinglePrecisionPreconditioner) {
+    runExperiment(128, true);
+}
@@ -0,0 +1,61 @@
+"""
+Copyright (c) 2018 Doyub Kim
+
+I am making my contributions/submissions to this project solely in my personal
+capacity and am not conveying any rights to any intellectual property of any
+third parties.
+"""
+
+import numpy as np
+import pyjet
+import unittest
+
+
+class CollocatedVectorGrid3Tests(unittest.TestCase):
+    def testBatchSample(self):
+        a = pyjet.CellCenteredVectorGrid3((4, 5, 6))
+
+        def filler(pt):
+            return (pt.z, pt.x, pt.y)
+
+        a.fill(filler)
+
+        pts = np.random.uniform(0.0, 4.0, (16, 3))
+        values = a.sample(pts)
+        self.assertEqual(values.shape, (16, 3))
+        for pt, value in zip(pts, values):
+            expected = a.sample(tuple(pt))
+            self.assertAlmostEqual(value[0], expected.x)
+            self.assertAlmostEqual(value[1], expected.y)
+            self.assertAlmostEqual(value[2], expected.z)
+
+    def testFillWithArray(self):
+        for grid in [pyjet.CellCenteredVectorGrid3((4, 5, 6)),
+                     pyjet.VertexCenteredVectorGrid3((4, 5, 6))]:
+            shape = grid.dataView().shape
+            values = np.random.uniform(-1.0, 1.0, shape)
+            grid.fill(values)
+            self.assertTrue(np.array_equal(grid.dataView(), values))
+
+            with self.assertRaises(ValueError):
+                grid.fill(np.zeros(shape[:3]))
+
+    def testDataView(self):
+        a = pyjet.CellCenteredVectorGrid3((4, 5, 6))
+        data = a.dataView()
+        self.assertEqual(data.shape, (6, 5, 4, 3))
+
+        data[1, 2, 3] = (1.0, 2.0, 3.0)
+        value = a[(3, 2, 1)]
+        self.assertEqual(value.x, 1.0)
+        self.assertEqual(value.y, 2.0)
+        self.assertEqual(value.z, 3.0)
+
+
+def main():
+    pyjet.Logging.mute()
+    unittest.main()
+
+
+if __name__ == '__main__':
+    main()
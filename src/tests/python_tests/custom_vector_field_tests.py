@@ -0,0 +1,30 @@
+"""
+Copyright (c) 2018 Doyub Kim
+
+I am making my contributions/submissions to this project solely in my personal
+capacity and am not conveying any rights to any intellectual property of any
+third parties.
+"""
+
+import numpy as np
+import pyjet
+import unittest
+
+
+class CustomVectorField3Tests(unittest.TestCase):
+    def testBatchSample(self):
+        field = pyjet.CustomVectorField3(
+            lambda pt: pyjet.Vector3D(pt.y, pt.z, pt.x))
+
+        pts = np.array([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]])
+        values = field.sample(pts)
+        self.assertTrue(np.array_equal(values, [[2, 3, 1], [5, 6, 4]]))
+
+
+def main():
+    pyjet.Logging.mute()
+    unittest.main()
+
+
+if __name__ == '__main__':
+    main()
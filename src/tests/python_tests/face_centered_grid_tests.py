@@ -6,6 +6,7 @@ capacity and am not conveying any rights to any intellectual property of any
 third parties.
 """
 
+import numpy as np
 import pyjet
 import unittest
 
@@ -78,6 +79,67 @@ class FaceCenteredGrid2Tests(unittest.TestCase):
             for i in range(10):
                 self.assertEqual(b.v(i, j), j)
 
+
+class FaceCenteredGrid3Tests(unittest.TestCase):
+    def testBatchSample(self):
+        a = pyjet.FaceCenteredGrid3((4, 5, 6))
+
+        def filler(pt):
+            return (pt.x, 2.0 * pt.y, -pt.z)
+
+        a.fill(filler)
+
+        pts = np.array([[0.5, 1.5, 2.5], [1.0, 2.0, 3.0], [3.5, 4.5, 5.5]])
+        values = a.sample(pts)
+        self.assertEqual(values.shape, (3, 3))
+        for pt, value in zip(pts, values):
+            expected = a.sample(tuple(pt))
+            self.assertAlmostEqual(value[0], expected.x)
+            self.assertAlmostEqual(value[1], expected.y)
+            self.assertAlmostEqual(value[2], expected.z)
+
+        self.assertEqual(a.sample(np.zeros((0, 3))).shape, (0, 3))
+
+    def testFillWithArrays(self):
+        a = pyjet.FaceCenteredGrid3((4, 5, 6))
+        u = np.random.uniform(-1.0, 1.0, (6, 5, 5))
+        v = np.random.uniform(-1.0, 1.0, (6, 6, 4))
+        w = np.random.uniform(-1.0, 1.0, (7, 5, 4))
+        a.fill((u, v, w))
+        self.assertTrue(np.array_equal(a.uView(), u))
+        self.assertTrue(np.array_equal(a.vView(), v))
+        self.assertTrue(np.array_equal(a.wView(), w))
+
+        # Arrays with mismatched shapes leave the grid untouched.
+        with self.assertRaises(ValueError):
+            a.fill([np.zeros((6, 5, 5)), np.zeros((6, 6, 4)), np.zeros(3)])
+        self.assertTrue(np.array_equal(a.uView(), u))
+
+    def testViews(self):
+        a = pyjet.FaceCenteredGrid3((4, 5, 6))
+        a.fill((1.0, 2.0, 3.0))
+
+        u = a.uView()
+        v = a.vView()
+        w = a.wView()
+        self.assertEqual(u.shape, (6, 5, 5))
+        self.assertEqual(v.shape, (6, 6, 4))
+        self.assertEqual(w.shape, (7, 5, 4))
+        self.assertTrue(np.all(u == 1.0))
+        self.assertTrue(np.all(v == 2.0))
+        self.assertTrue(np.all(w == 3.0))
+
+        # Views share memory with the grid.
+        u[2, 3, 4] = 7.0
+        w[:] = 9.0
+        self.assertEqual(a.u(4, 3, 2), 7.0)
+        self.assertEqual(a.w(1, 2, 3), 9.0)
+
+        # Views keep the grid alive.
+        del a
+        self.assertEqual(u[2, 3, 4], 7.0)
+
+
 def main():
     pyjet.Logging.mute()
     unittest.main()
@@ -10,10 +10,13 @@ import pyjet
 import unittest
 from animation_tests import *
 from bounding_box_tests import *
+from collocated_vector_grid_tests import *
+from custom_vector_field_tests import *
 from face_centered_grid_tests import *
 from flip_solver_tests import *
 from particle_system_data_tests import *
 from physics_animation_tests import *
+from scalar_grid_tests import *
 from sph_system_data_tests import *
 from sphere_tests import *
 from vector_tests import *
@@ -0,0 +1,73 @@
+"""
+Copyright (c) 2018 Doyub Kim
+
+I am making my contributions/submissions to this project solely in my personal
+capacity and am not conveying any rights to any intellectual property of any
+third parties.
+"""
+
+import numpy as np
+import pyjet
+import unittest
+
+
+class CellCenteredScalarGrid3Tests(unittest.TestCase):
+    def testBatchSample(self):
+        a = pyjet.CellCenteredScalarGrid3((4, 5, 6))
+        a.fill(lambda pt: pt.x + 2.0 * pt.y - pt.z)
+
+        pts = np.random.uniform(0.0, 4.0, (32, 3))
+        values = a.sample(pts)
+        gradients = a.gradient(pts)
+        self.assertEqual(values.shape, (32,))
+        self.assertEqual(gradients.shape, (32, 3))
+        for pt, value, gradient in zip(pts, values, gradients):
+            self.assertAlmostEqual(value, a.sample(tuple(pt)))
+            expected = a.gradient(tuple(pt))
+            self.assertAlmostEqual(gradient[0], expected.x)
+            self.assertAlmostEqual(gradient[1], expected.y)
+            self.assertAlmostEqual(gradient[2], expected.z)
+
+        # Other dtypes are converted.
+        values = a.sample(np.array([[1, 2, 3]], dtype=np.int32))
+        self.assertAlmostEqual(values[0], a.sample((1.0, 2.0, 3.0)))
+
+        with self.assertRaises(ValueError):
+            a.sample(np.zeros((4, 2)))
+
+    def testDataView(self):
+        a = pyjet.CellCenteredScalarGrid3((4, 5, 6))
+        data = a.dataView()
+        self.assertEqual(data.shape, (6, 5, 4))
+
+        data[3, 2, 1] = 5.0
+        self.assertEqual(a[(1, 2, 3)], 5.0)
+
+        a[(3, 2, 1)] = 7.0
+        self.assertEqual(data[1, 2, 3], 7.0)
+
+    def testFillWithArray(self):
+        a = pyjet.CellCenteredScalarGrid3((4, 5, 6))
+        pos = a.dataPositions()
+        self.assertEqual(pos.shape, (6, 5, 4, 3))
+
+        a.fill(pos[..., 0] + 2.0 * pos[..., 1] - pos[..., 2])
+        for k in range(6):
+            for j in range(5):
+                for i in range(4):
+                    x = i + 0.5
+                    y = j + 0.5
+                    z = k + 0.5
+                    self.assertEqual(a[(i, j, k)], x + 2.0 * y - z)
+
+        with self.assertRaises(ValueError):
+            a.fill(np.zeros((4, 5, 6)))
+
+
+def main():
+    pyjet.Logging.mute()
+    unittest.main()
+
+
+if __name__ == '__main__':
+    main()
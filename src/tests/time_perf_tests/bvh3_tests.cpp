@@ -9,22 +9,27 @@
 
 #include <benchmark/benchmark.h>
 
+#include <fstream>
 #include <random>
+#include <vector>
 
 using jet::TriangleMesh3;
 using jet::Triangle3;
 using jet::BoundingBox3D;
 using jet::Vector3D;
 using jet::Ray3D;
+using jet::BvhBuildMethod;
 
 class Bvh3 : public ::benchmark::Fixture {
  public:
     std::mt19937 rng{0};
     std::uniform_real_distribution<> dist{0.0, 1.0};
     TriangleMesh3 triMesh;
+    std::vector<Triangle3> triangles;
+    std::vector<BoundingBox3D> bounds;
     jet::Bvh3<Triangle3> queryEngine;
 
-    void SetUp(const ::benchmark::State&) {
+    void SetUp(const ::benchmark::State& state) {
         std::ifstream file(RESOURCES_DIR "bunny.obj");
 
         if (file) {
@@ -32,15 +37,22 @@ class Bvh3 : public ::benchmark::Fixture {
             file.close();
         }
 
-        std::vector<Triangle3> triangles;
-        std::vector<BoundingBox3D> bounds;
+        triangles.clear();
+        bounds.clear();
         for (size_t i = 0; i < triMesh.numberOfTriangles(); ++i) {
             auto tri = triMesh.triangle(i);
             triangles.push_back(tri);
             bounds.push_back(tri.boundingBox());
         }
 
-        queryEngine.build(triangles, bounds);
+        queryEngine.build(triangles, bounds, buildMethod(state));
+    }
+
+    // The first argument selects the build method; 0 for midpoint and 1 for
+    // SAH.
+    static BvhBuildMethod buildMethod(const ::benchmark::State& state) {
+        return (state.range(0) == 0) ? BvhBuildMethod::kMidpoint
+                                     : BvhBuildMethod::kSah;
     }
 
     Vector3D makeVec() { return Vector3D(dist(rng), dist(rng), dist(rng)); }
@@ -52,15 +64,38 @@ class Bvh3 : public ::benchmark::Fixture {
     static bool intersectsFunc(const Triangle3& tri, const Ray3D& ray) {
         return tri.intersects(ray);
     }
+
+    static double closestIntersectionFunc(const Triangle3& tri,
+                                          const Ray3D& ray) {
+        auto result = tri.closestIntersection(ray);
+        return result.isIntersecting ? result.distance : jet::kMaxD;
+    }
 };
 
+BENCHMARK_DEFINE_F(Bvh3, Build)(benchmark::State& state) {
+    jet::Bvh3<Triangle3> bvh;
+    while (state.KeepRunning()) {
+        bvh.build(triangles, bounds, buildMethod(state));
+    }
+}
+
+BENCHMARK_REGISTER_F(Bvh3, Build)->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(Bvh3, Refit)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        queryEngine.refit(bounds);
+    }
+}
+
+BENCHMARK_REGISTER_F(Bvh3, Refit)->Arg(0)->Arg(1);
+
 BENCHMARK_DEFINE_F(Bvh3, Nearest)(benchmark::State& state) {
     while (state.KeepRunning()) {
         benchmark::DoNotOptimize(queryEngine.nearest(makeVec(), distanceFunc));
     }
 }
 
-BENCHMARK_REGISTER_F(Bvh3, Nearest);
+BENCHMARK_REGISTER_F(Bvh3, Nearest)->Arg(0)->Arg(1);
 
 BENCHMARK_DEFINE_F(Bvh3, RayIntersects)(benchmark::State& state) {
     while (state.KeepRunning()) {
@@ -69,4 +104,14 @@ BENCHMARK_DEFINE_F(Bvh3, RayIntersects)(benchmark::State& state) {
     }
 }
 
-BENCHMARK_REGISTER_F(Bvh3, RayIntersects);
+BENCHMARK_REGISTER_F(Bvh3, RayIntersects)->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(Bvh3, ClosestIntersection)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(queryEngine.closestIntersection(
+            Ray3D(makeVec(), makeVec().normalized()),
+            closestIntersectionFunc));
+    }
+}
+
+BENCHMARK_REGISTER_F(Bvh3, ClosestIntersection)->Arg(0)->Arg(1);
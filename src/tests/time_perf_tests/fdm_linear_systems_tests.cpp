@@ -4,11 +4,14 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/cg.h>
 #include <jet/fdm_linear_system2.h>
 #include <jet/fdm_linear_system3.h>
+#include <jet/fdm_mgpcg_solver3.h>
 
 #include <benchmark/benchmark.h>
 
+#include <cmath>
 #include <random>
 
 using jet::Array3;
@@ -17,7 +20,11 @@ using jet::FdmVector2;
 using jet::FdmMatrix3;
 using jet::FdmVector3;
 using jet::FdmCompressedLinearSystem3;
+using jet::FdmLinearSystem3;
+using jet::FdmMgLinearSystem3;
+using jet::FdmMgpcgSolver3;
 using jet::Size3;
+using jet::VectorND;
 
 class FdmBlas2 : public ::benchmark::Fixture {
  public:
@@ -153,6 +160,143 @@ class FdmCompressedBlas3 : public ::benchmark::Fixture {
     }
 };
 
+class FdmCg3 : public ::benchmark::Fixture {
+ public:
+    FdmLinearSystem3 system;
+    FdmVector3 r;
+    FdmVector3 d;
+    FdmVector3 q;
+    FdmVector3 s;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto dim = static_cast<size_t>(state.range(0));
+
+        buildSystem(&system, {dim, dim, dim});
+        r.resize(system.x.size());
+        d.resize(system.x.size());
+        q.resize(system.x.size());
+        s.resize(system.x.size());
+    }
+
+    static void buildSystem(FdmLinearSystem3* system, const Size3& size) {
+        system->resize(size);
+
+        system->A.forEachIndex([&](size_t i, size_t j, size_t k) {
+            auto& row = system->A(i, j, k);
+            double bijk = 0.0;
+
+            row.center = 0.0;
+            row.right = 0.0;
+            row.up = 0.0;
+            row.front = 0.0;
+
+            if (i > 0) {
+                row.center += 1.0;
+            }
+            if (i < size.x - 1) {
+                row.center += 1.0;
+                row.right = -1.0;
+            }
+
+            if (j > 0) {
+                row.center += 1.0;
+            } else {
+                bijk += 1.0;
+            }
+
+            if (j < size.y - 1) {
+                row.center += 1.0;
+                row.up = -1.0;
+            } else {
+                bijk -= 1.0;
+            }
+
+            if (k > 0) {
+                row.center += 1.0;
+            } else {
+                bijk += 1.0;
+            }
+
+            if (k < size.z - 1) {
+                row.center += 1.0;
+                row.front = -1.0;
+            } else {
+                bijk -= 1.0;
+            }
+
+            system->b(i, j, k) = bijk;
+        });
+
+        system->x.set(0.0);
+    }
+};
+
+class FdmMgpcg3 : public ::benchmark::Fixture {
+ public:
+    FdmMgLinearSystem3 system;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto dim = static_cast<size_t>(state.range(0));
+
+        buildSystem(&system, {dim, dim, dim});
+    }
+
+    static void buildSystem(FdmMgLinearSystem3* system, const Size3& size) {
+        system->resizeWithFinest(size, 5);
+
+        // Poisson equation with the grid spacing doubling at each level
+        for (size_t l = 0; l < system->numberOfLevels(); ++l) {
+            const double invdx = std::pow(0.5, l);
+            const double invdx2 = invdx * invdx;
+            FdmMatrix3& A = system->A[l];
+            FdmVector3& b = system->b[l];
+            const Size3 n = A.size();
+
+            system->x[l].set(0.0);
+            A.forEachIndex([&](size_t i, size_t j, size_t k) {
+                auto& row = A(i, j, k);
+                double bijk = 0.0;
+
+                row.center = 0.0;
+                row.right = 0.0;
+                row.up = 0.0;
+                row.front = 0.0;
+
+                if (i > 0) {
+                    row.center += invdx2;
+                }
+                if (i < n.x - 1) {
+                    row.center += invdx2;
+                    row.right = -invdx2;
+                }
+
+                if (j > 0) {
+                    row.center += invdx2;
+                } else {
+                    bijk += invdx;
+                }
+
+                if (j < n.y - 1) {
+                    row.center += invdx2;
+                    row.up = -invdx2;
+                } else {
+                    bijk -= invdx;
+                }
+
+                if (k > 0) {
+                    row.center += invdx2;
+                }
+                if (k < n.z - 1) {
+                    row.center += invdx2;
+                    row.front = -invdx2;
+                }
+
+                b(i, j, k) = bijk;
+            });
+        }
+    }
+};
+
 BENCHMARK_DEFINE_F(FdmBlas2, Mvm)(benchmark::State& state) {
     while (state.KeepRunning()) {
         jet::FdmBlas2::mvm(m, a, &b);
@@ -179,3 +323,111 @@ BENCHMARK_REGISTER_F(FdmCompressedBlas3, Mvm)
     ->Arg(1 << 4)
     ->Arg(1 << 6)
     ->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmBlas3, Dot)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(jet::FdmBlas3::dot(a, a));
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmBlas3, Dot)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmCompressedBlas3, Dot)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(
+            jet::FdmCompressedBlas3::dot(system.b, system.b));
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmCompressedBlas3, Dot)
+    ->Arg(1 << 4)
+    ->Arg(1 << 6)
+    ->Arg(1 << 8);
+
+// Runs a fixed number of CG iterations on the 3-D Poisson system.
+static const unsigned int kNumberOfCgIterations = 10;
+
+BENCHMARK_DEFINE_F(FdmCg3, Cg)(benchmark::State& state) {
+    unsigned int lastNumberOfIterations;
+    double lastResidualNorm;
+
+    while (state.KeepRunning()) {
+        system.x.set(0.0);
+        jet::cg<jet::FdmBlas3>(system.A, system.b, kNumberOfCgIterations, 0.0,
+                               &system.x, &r, &d, &q, &s,
+                               &lastNumberOfIterations, &lastResidualNorm);
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmCg3, Cg)->Arg(1 << 6)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmCg3, CgFused)(benchmark::State& state) {
+    unsigned int lastNumberOfIterations;
+    double lastResidualNorm;
+
+    while (state.KeepRunning()) {
+        system.x.set(0.0);
+        jet::cgFused<jet::FdmBlas3>(system.A, system.b, kNumberOfCgIterations,
+                                    0.0, &system.x, &r, &d, &q,
+                                    &lastNumberOfIterations, &lastResidualNorm);
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmCg3, CgFused)->Arg(1 << 6)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmCompressedBlas3, Cg)(benchmark::State& state) {
+    const size_t n = system.b.size();
+    VectorND r(n), d(n), q(n), s(n);
+    unsigned int lastNumberOfIterations;
+    double lastResidualNorm;
+
+    while (state.KeepRunning()) {
+        system.x.set(0.0);
+        jet::cg<jet::FdmCompressedBlas3>(
+            system.A, system.b, kNumberOfCgIterations, 0.0, &system.x, &r, &d,
+            &q, &s, &lastNumberOfIterations, &lastResidualNorm);
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmCompressedBlas3, Cg)->Arg(1 << 6)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmCompressedBlas3, CgFused)(benchmark::State& state) {
+    const size_t n = system.b.size();
+    VectorND r(n), d(n), q(n);
+    unsigned int lastNumberOfIterations;
+    double lastResidualNorm;
+
+    while (state.KeepRunning()) {
+        system.x.set(0.0);
+        jet::cgFused<jet::FdmCompressedBlas3>(
+            system.A, system.b, kNumberOfCgIterations, 0.0, &system.x, &r, &d,
+            &q, &lastNumberOfIterations, &lastResidualNorm);
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmCompressedBlas3, CgFused)->Arg(1 << 6)->Arg(1 << 8);
+
+// Runs a fixed number of MGPCG iterations on the 3-D Poisson system.
+BENCHMARK_DEFINE_F(FdmMgpcg3, Solve)(benchmark::State& state) {
+    FdmMgpcgSolver3 solver(kNumberOfCgIterations, 5, 5, 5, 20, 20, 0.0);
+
+    while (state.KeepRunning()) {
+        solver.solve(&system);
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmMgpcg3, Solve)->Arg(1 << 6)->Arg(1 << 7);
+
+BENCHMARK_DEFINE_F(FdmMgpcg3, SolveWithSinglePrecisionPreconditioner)
+(benchmark::State& state) {
+    FdmMgpcgSolver3 solver(kNumberOfCgIterations, 5, 5, 5, 20, 20, 0.0, 1.5,
+                           false, true);
+
+    while (state.KeepRunning()) {
+        solver.solve(&system);
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmMgpcg3, SolveWithSinglePrecisionPreconditioner)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7);
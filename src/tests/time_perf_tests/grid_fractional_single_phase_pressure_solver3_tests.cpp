@@ -6,6 +6,7 @@
 
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/fdm_iccg_solver3.h>
 #include <jet/grid_fractional_single_phase_pressure_solver3.h>
 
 #include <benchmark/benchmark.h>
@@ -63,3 +64,36 @@ BENCHMARK_REGISTER_F(GridFractionalSinglePhasePressureSolver3, Solve)
     ->Args({128, 64, 1})
     ->Args({128, 32, 0})
     ->Args({128, 32, 1});
+
+BENCHMARK_DEFINE_F(GridFractionalSinglePhasePressureSolver3, SolveMic)
+(benchmark::State& state) {
+    bool compressed = state.range(2) == 1;
+    solver.setLinearSystemSolver(
+        std::make_shared<jet::FdmIccgSolver3>(100, 1e-6, 0.97));
+    while (state.KeepRunning()) {
+        solver.solve(vel, 1.0, &vel, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf, compressed);
+    }
+}
+
+BENCHMARK_REGISTER_F(GridFractionalSinglePhasePressureSolver3, SolveMic)
+    ->Args({128, 128, 0})
+    ->Args({128, 128, 1})
+    ->Args({128, 64, 0})
+    ->Args({128, 64, 1})
+    ->Args({128, 32, 0})
+    ->Args({128, 32, 1});
+
+BENCHMARK_DEFINE_F(GridFractionalSinglePhasePressureSolver3, BuildSystem)
+(benchmark::State& state) {
+    // Without the linear system solver, only the system is built.
+    solver.setLinearSystemSolver(nullptr);
+    while (state.KeepRunning()) {
+        solver.solve(vel, 1.0, &vel, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf, true);
+    }
+}
+
+BENCHMARK_REGISTER_F(GridFractionalSinglePhasePressureSolver3, BuildSystem)
+    ->Args({128, 64, 1})
+    ->Args({256, 128, 1});
@@ -0,0 +1,59 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
+#include <jet/fmm_level_set_solver3.h>
+
+#include <benchmark/benchmark.h>
+
+using jet::Vector3D;
+
+class LevelSetSolvers3 : public ::benchmark::Fixture {
+ protected:
+    jet::CellCenteredScalarGrid3 sdf;
+    jet::CellCenteredScalarGrid3 output;
+    double bandWidth = 0.0;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto n = static_cast<size_t>(state.range(0));
+        const double h = 1.0 / static_cast<double>(n);
+        sdf.resize(n, n, n, h, h, h);
+        output.resize(n, n, n, h, h, h);
+
+        // Distorted sphere with 5-cell wide band
+        sdf.fill([](const Vector3D& x) {
+            return 2.0 * (x.distanceTo(Vector3D(0.5, 0.5, 0.5)) - 0.3);
+        });
+        bandWidth = 5.0 * h;
+    }
+};
+
+BENCHMARK_DEFINE_F(LevelSetSolvers3, FmmReinitialize)
+(benchmark::State& state) {
+    jet::FmmLevelSetSolver3 solver;
+    while (state.KeepRunning()) {
+        solver.reinitialize(sdf, bandWidth, &output);
+    }
+}
+
+BENCHMARK_REGISTER_F(LevelSetSolvers3, FmmReinitialize)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7)
+    ->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(LevelSetSolvers3, FastSweepingReinitialize)
+(benchmark::State& state) {
+    jet::FastSweepingLevelSetSolver3 solver;
+    while (state.KeepRunning()) {
+        solver.reinitialize(sdf, bandWidth, &output);
+    }
+}
+
+BENCHMARK_REGISTER_F(LevelSetSolvers3, FastSweepingReinitialize)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7)
+    ->Arg(1 << 8);
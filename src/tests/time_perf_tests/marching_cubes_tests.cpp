@@ -0,0 +1,40 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/marching_cubes.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+
+#include <benchmark/benchmark.h>
+
+using jet::Vector3D;
+
+class MarchingCubes : public ::benchmark::Fixture {
+ protected:
+    jet::VertexCenteredScalarGrid3 grid;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto n = static_cast<size_t>(state.range(0));
+        const double h = 1.0 / static_cast<double>(n);
+        grid.resize(n, n, n, h, h, h);
+        grid.fill([](const Vector3D& x) {
+            return x.distanceTo(Vector3D(0.5, 0.5, 0.5)) - 0.3;
+        });
+    }
+};
+
+BENCHMARK_DEFINE_F(MarchingCubes, Sphere)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        jet::TriangleMesh3 mesh;
+        jet::marchingCubes(grid.constDataAccessor(), grid.gridSpacing(),
+                           grid.origin(), &mesh, 0.0, jet::kDirectionAll);
+        benchmark::DoNotOptimize(mesh.numberOfTriangles());
+    }
+}
+
+BENCHMARK_REGISTER_F(MarchingCubes, Sphere)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7)
+    ->Arg(1 << 8);
@@ -8,7 +8,47 @@
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
 #include <random>
+#include <thread>
+
+namespace {
+
+// Reference implementation of the previous C++11 thread backend which spawns
+// and joins one thread per slice on every call.
+template <typename Function>
+void threadPerSliceFor(size_t start, size_t end, unsigned int numThreads,
+                       const Function& func) {
+    size_t slice = std::max((end - start) / numThreads, size_t(1));
+
+    auto launchRange = [&func](size_t k1, size_t k2) {
+        for (size_t k = k1; k < k2; ++k) {
+            func(k);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(numThreads);
+    size_t i1 = start;
+    size_t i2 = std::min(start + slice, end);
+    for (unsigned int i = 0; i + 1 < numThreads && i1 < end; ++i) {
+        pool.emplace_back(launchRange, i1, i2);
+        i1 = i2;
+        i2 = std::min(i2 + slice, end);
+    }
+    if (i1 < end) {
+        pool.emplace_back(launchRange, i1, end);
+    }
+
+    for (std::thread& t : pool) {
+        t.join();
+    }
+}
+
+// Number of loops issued per iteration, similar to a single FLIP step.
+const int kNumLoopsPerStep = 50;
+
+}  // namespace
 
 class Parallel : public ::benchmark::Fixture {
  public:
@@ -87,3 +127,94 @@ BENCHMARK_REGISTER_F(Parallel, ParallelRangeFor)
     ->Args({1 << 24, 2})
     ->Args({1 << 24, 4})
     ->Args({1 << 24, 8});
+
+BENCHMARK_DEFINE_F(Parallel, ManyLoops)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    while (state.KeepRunning()) {
+        for (int l = 0; l < kNumLoopsPerStep; ++l) {
+            jet::parallelFor(jet::kZeroSize, n, [this](size_t i) {
+                c[i] = 1.0 / std::sqrt(a[i] / b[i] + 1.0);
+            });
+        }
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, ManyLoops)
+    ->UseRealTime()
+    ->Args({1 << 12, 1})
+    ->Args({1 << 12, 4})
+    ->Args({1 << 12, 8})
+    ->Args({1 << 18, 1})
+    ->Args({1 << 18, 4})
+    ->Args({1 << 18, 8});
+
+BENCHMARK_DEFINE_F(Parallel, ManyLoopsThreadPerSlice)
+(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        for (int l = 0; l < kNumLoopsPerStep; ++l) {
+            threadPerSliceFor(jet::kZeroSize, n, numThreads, [this](size_t i) {
+                c[i] = 1.0 / std::sqrt(a[i] / b[i] + 1.0);
+            });
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(Parallel, ManyLoopsThreadPerSlice)
+    ->UseRealTime()
+    ->Args({1 << 12, 1})
+    ->Args({1 << 12, 4})
+    ->Args({1 << 12, 8})
+    ->Args({1 << 18, 1})
+    ->Args({1 << 18, 4})
+    ->Args({1 << 18, 8});
+
+BENCHMARK_DEFINE_F(Parallel, ManyLoopsSerial)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        for (int l = 0; l < kNumLoopsPerStep; ++l) {
+            jet::parallelFor(jet::kZeroSize, n,
+                             [this](size_t i) {
+                                 c[i] = 1.0 / std::sqrt(a[i] / b[i] + 1.0);
+                             },
+                             jet::ExecutionPolicy::kSerial);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(Parallel, ManyLoopsSerial)
+    ->UseRealTime()
+    ->Args({1 << 12, 1})
+    ->Args({1 << 18, 1});
+
+BENCHMARK_DEFINE_F(Parallel, Reduce)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    while (state.KeepRunning()) {
+        double sum = jet::parallelReduce(
+            jet::kZeroSize, n, 0.0,
+            [this](size_t iBegin, size_t iEnd, double init) {
+                double result = init;
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    result += a[i] * b[i];
+                }
+                return result;
+            },
+            std::plus<double>());
+        benchmark::DoNotOptimize(sum);
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, Reduce)
+    ->UseRealTime()
+    ->Args({1 << 12, 1})
+    ->Args({1 << 12, 4})
+    ->Args({1 << 12, 8})
+    ->Args({1 << 24, 1})
+    ->Args({1 << 24, 4})
+    ->Args({1 << 24, 8});
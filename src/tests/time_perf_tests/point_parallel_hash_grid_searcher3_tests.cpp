@@ -11,6 +11,7 @@
 #include <benchmark/benchmark.h>
 
 #include <random>
+#include <vector>
 
 using jet::Array1;
 using jet::Vector3D;
@@ -46,6 +47,54 @@ BENCHMARK_REGISTER_F(PointParallelHashGridSearcher3, Build)
     ->Arg(1 << 10)
     ->Arg(1 << 20);
 
+BENCHMARK_DEFINE_F(PointParallelHashGridSearcher3, Rebuild)
+(benchmark::State& state) {
+    // Emulates a simulation substep: points move by a fraction of the grid
+    // spacing and the same searcher is rebuilt.
+    std::uniform_real_distribution<> jitter{-0.1 / 64.0, 0.1 / 64.0};
+    Array1<Vector3D> movedPoints(points);
+
+    jet::PointParallelHashGridSearcher3 grid(64, 64, 64, 1.0 / 64.0);
+    grid.build(points);
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        movedPoints.forEachIndex([&](size_t i) {
+            movedPoints[i] += Vector3D(jitter(rng), jitter(rng), jitter(rng));
+        });
+        state.ResumeTiming();
+
+        grid.build(movedPoints);
+    }
+}
+
+BENCHMARK_REGISTER_F(PointParallelHashGridSearcher3, Rebuild)
+    ->Arg(1 << 5)
+    ->Arg(1 << 10)
+    ->Arg(1 << 20);
+
+BENCHMARK_DEFINE_F(PointParallelHashGridSearcher3, RebuildFromScratch)
+(benchmark::State& state) {
+    std::uniform_real_distribution<> jitter{-0.1 / 64.0, 0.1 / 64.0};
+    Array1<Vector3D> movedPoints(points);
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        movedPoints.forEachIndex([&](size_t i) {
+            movedPoints[i] += Vector3D(jitter(rng), jitter(rng), jitter(rng));
+        });
+        state.ResumeTiming();
+
+        jet::PointParallelHashGridSearcher3 grid(64, 64, 64, 1.0 / 64.0);
+        grid.build(movedPoints);
+    }
+}
+
+BENCHMARK_REGISTER_F(PointParallelHashGridSearcher3, RebuildFromScratch)
+    ->Arg(1 << 5)
+    ->Arg(1 << 10)
+    ->Arg(1 << 20);
+
 BENCHMARK_DEFINE_F(PointParallelHashGridSearcher3, ForEachNearbyPoints)
 (benchmark::State& state) {
     jet::PointParallelHashGridSearcher3 grid(64, 64, 64, 1.0 / 64.0);
@@ -62,3 +111,45 @@ BENCHMARK_REGISTER_F(PointParallelHashGridSearcher3, ForEachNearbyPoints)
     ->Arg(1 << 5)
     ->Arg(1 << 10)
     ->Arg(1 << 20);
+
+BENCHMARK_DEFINE_F(PointParallelHashGridSearcher3, VisitNearbyPoints)
+(benchmark::State& state) {
+    jet::PointParallelHashGridSearcher3 grid(64, 64, 64, 1.0 / 64.0);
+    grid.build(points);
+
+    size_t sum = 0;
+    while (state.KeepRunning()) {
+        grid.visitNearbyPoints(makeVec(), 1.0 / 64.0,
+                               [&](size_t i, const Vector3D&, double) {
+                                   sum += i;
+                               });
+    }
+    benchmark::DoNotOptimize(sum);
+}
+
+BENCHMARK_REGISTER_F(PointParallelHashGridSearcher3, VisitNearbyPoints)
+    ->Arg(1 << 5)
+    ->Arg(1 << 10)
+    ->Arg(1 << 20);
+
+BENCHMARK_DEFINE_F(PointParallelHashGridSearcher3, FindNearbyPoints)
+(benchmark::State& state) {
+    jet::PointParallelHashGridSearcher3 grid(64, 64, 64, 1.0 / 64.0);
+    grid.build(points);
+
+    Array1<Vector3D> origins(1 << 10);
+    origins.forEachIndex([&](size_t i) { origins[i] = makeVec(); });
+
+    jet::ParticleNeighborLists lists;
+    std::vector<double> distancesSquared;
+    while (state.KeepRunning()) {
+        grid.findNearbyPoints(origins, 1.0 / 64.0, &lists, &distancesSquared);
+    }
+
+    state.SetItemsProcessed(state.iterations() * origins.size());
+}
+
+BENCHMARK_REGISTER_F(PointParallelHashGridSearcher3, FindNearbyPoints)
+    ->Arg(1 << 5)
+    ->Arg(1 << 10)
+    ->Arg(1 << 20);
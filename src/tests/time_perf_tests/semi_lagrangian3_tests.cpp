@@ -0,0 +1,80 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/cubic_semi_lagrangian3.h>
+#include <jet/face_centered_grid3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using jet::Vector3D;
+
+class SemiLagrangian3 : public ::benchmark::Fixture {
+ protected:
+    jet::FaceCenteredGrid3 flow;
+    jet::CellCenteredScalarGrid3 density;
+    jet::CellCenteredScalarGrid3 temperature;
+    jet::CellCenteredScalarGrid3 densityOutput;
+    jet::CellCenteredScalarGrid3 temperatureOutput;
+    double dt = 0.0;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto n = static_cast<size_t>(state.range(0));
+        const double h = 1.0 / static_cast<double>(n);
+        flow.resize(n, n, n, h, h, h);
+        density.resize(n, n, n, h, h, h);
+        temperature.resize(n, n, n, h, h, h);
+        densityOutput.resize(n, n, n, h, h, h);
+        temperatureOutput.resize(n, n, n, h, h, h);
+
+        // Swirl around the y-axis and a blob of smoke
+        flow.fill([](const Vector3D& x) {
+            return Vector3D(0.5 - x.z, 0.2, x.x - 0.5);
+        });
+        density.fill([](const Vector3D& x) {
+            return std::max(0.3 - x.distanceTo(Vector3D(0.5, 0.3, 0.5)), 0.0);
+        });
+        temperature.fill([](const Vector3D& x) {
+            return std::max(0.2 - x.distanceTo(Vector3D(0.5, 0.3, 0.5)), 0.0);
+        });
+
+        // CFL number of 2
+        dt = 2.0 * h;
+    }
+};
+
+BENCHMARK_DEFINE_F(SemiLagrangian3, AdvectSeparately)
+(benchmark::State& state) {
+    jet::CubicSemiLagrangian3 solver;
+    while (state.KeepRunning()) {
+        solver.advect(density, flow, dt, &densityOutput);
+        solver.advect(temperature, flow, dt, &temperatureOutput);
+        solver.advect(flow, flow, dt, &flow);
+    }
+}
+
+BENCHMARK_REGISTER_F(SemiLagrangian3, AdvectSeparately)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7);
+
+BENCHMARK_DEFINE_F(SemiLagrangian3, AdvectBatched)
+(benchmark::State& state) {
+    jet::CubicSemiLagrangian3 solver;
+    const std::vector<const jet::ScalarGrid3*> inputs = {&density,
+                                                         &temperature};
+    const std::vector<jet::ScalarGrid3*> outputs = {&densityOutput,
+                                                    &temperatureOutput};
+    while (state.KeepRunning()) {
+        solver.advect(inputs, flow, dt, outputs);
+        solver.advect(flow, flow, dt, &flow);
+    }
+}
+
+BENCHMARK_REGISTER_F(SemiLagrangian3, AdvectBatched)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7);
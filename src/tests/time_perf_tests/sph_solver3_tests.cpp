@@ -0,0 +1,88 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/logging.h>
+#include <jet/sph_solver3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using jet::Vector3D;
+
+namespace {
+
+class SphSolver3ForBenchmark : public jet::SphSolver3 {
+ public:
+    using jet::SphSolver3::accumulatePressureForce;
+    using jet::SphSolver3::accumulateViscosityForce;
+    using jet::SphSolver3::computePressure;
+};
+
+}  // namespace
+
+class SphSolver3 : public ::benchmark::Fixture {
+ protected:
+    SphSolver3ForBenchmark solver;
+
+    void SetUp(const ::benchmark::State& state) {
+        jet::Logging::mute();
+
+        // Jittered lattice of particles at the target spacing
+        const size_t n = static_cast<size_t>(state.range(0));
+        auto particles = solver.sphSystemData();
+        particles->resize(0);
+        particles->setTargetSpacing(0.02);
+
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<> jitter(-0.1, 0.1);
+        for (size_t k = 0; k < n; ++k) {
+            for (size_t j = 0; j < n; ++j) {
+                for (size_t i = 0; i < n; ++i) {
+                    particles->addParticle(
+                        0.02 * Vector3D(i + jitter(rng), j + jitter(rng),
+                                        k + jitter(rng)),
+                        Vector3D(jitter(rng), jitter(rng), jitter(rng)));
+                }
+            }
+        }
+
+        particles->buildNeighborSearcher();
+        particles->buildNeighborLists();
+        particles->updateDensities();
+        solver.computePressure();
+    }
+};
+
+BENCHMARK_DEFINE_F(SphSolver3, AccumulatePressureForce)
+(benchmark::State& state) {
+    auto particles = solver.sphSystemData();
+    jet::Array1<Vector3D> forces(particles->numberOfParticles());
+    const auto x = jet::ConstArrayAccessor1<Vector3D>(particles->positions());
+    const auto d = jet::ConstArrayAccessor1<double>(particles->densities());
+    const auto p = jet::ConstArrayAccessor1<double>(particles->pressures());
+
+    while (state.KeepRunning()) {
+        solver.accumulatePressureForce(x, d, p, forces.accessor());
+    }
+}
+
+BENCHMARK_REGISTER_F(SphSolver3, AccumulatePressureForce)
+    ->Arg(16)
+    ->Arg(32)
+    ->Arg(64);
+
+BENCHMARK_DEFINE_F(SphSolver3, AccumulateViscosityForce)
+(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        solver.accumulateViscosityForce();
+    }
+}
+
+BENCHMARK_REGISTER_F(SphSolver3, AccumulateViscosityForce)
+    ->Arg(16)
+    ->Arg(32)
+    ->Arg(64);
@@ -0,0 +1,56 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/marching_cubes.h>
+#include <jet/triangle_mesh_to_sdf.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+
+using jet::Vector3D;
+
+class TriangleMeshToSdf : public ::benchmark::Fixture {
+ protected:
+    jet::TriangleMesh3 mesh;
+    jet::VertexCenteredScalarGrid3 sdf;
+
+    void SetUp(const ::benchmark::State& state) {
+        // Torus merged with a sphere
+        const size_t m = 64;
+        const double hm = 1.0 / static_cast<double>(m);
+        jet::VertexCenteredScalarGrid3 source(m, m, m, hm, hm, hm);
+        source.fill([](const Vector3D& x) {
+            const Vector3D p = x - Vector3D(0.5, 0.5, 0.5);
+            const double q = std::sqrt(p.x * p.x + p.z * p.z) - 0.28;
+            const double torus = std::sqrt(q * q + p.y * p.y) - 0.1;
+            const double sphere = p.distanceTo(Vector3D(0.1, 0.1, 0.0)) - 0.18;
+            return std::min(torus, sphere);
+        });
+
+        mesh.clear();
+        jet::marchingCubes(source.constDataAccessor(), source.gridSpacing(),
+                           source.dataOrigin(), &mesh, 0.0,
+                           jet::kDirectionAll);
+
+        const auto n = static_cast<size_t>(state.range(0));
+        const double h = 1.0 / static_cast<double>(n);
+        sdf.resize(n, n, n, h, h, h);
+    }
+};
+
+BENCHMARK_DEFINE_F(TriangleMeshToSdf, Convert)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        jet::triangleMeshToSdf(mesh, &sdf);
+    }
+}
+
+BENCHMARK_REGISTER_F(TriangleMeshToSdf, Convert)
+    ->Arg(1 << 5)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7);
@@ -5,8 +5,12 @@
 // property of any third parties.
 
 #include <jet/apic_solver2.h>
+#include <jet/parallel.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 using namespace jet;
 
 TEST(ApicSolver2, UpdateEmpty) {
@@ -16,3 +20,50 @@ TEST(ApicSolver2, UpdateEmpty) {
         solver.update(frame);
     }
 }
+
+namespace {
+
+class ApicSolver2Tester : public ApicSolver2 {
+ public:
+    ApicSolver2Tester() : ApicSolver2({8, 8}, {0.125, 0.125}, {0.0, 0.0}) {
+    }
+
+    void transfer() { transferFromParticlesToGrids(); }
+};
+
+}  // namespace
+
+TEST(ApicSolver2, DeterministicTransfer) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.1, 1.1);
+
+    ApicSolver2Tester solver;
+    auto particles = solver.particleSystemData();
+    Array1<Vector2D> positions(1000);
+    Array1<Vector2D> velocities(1000);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector2D(d(rng), d(rng));
+        velocities[i] = Vector2D(d(rng), d(rng));
+    }
+    particles->addParticles(positions, velocities);
+
+    auto transfer = [&](unsigned int numThreads) {
+        setMaxNumberOfThreads(numThreads);
+        solver.transfer();
+        FaceCenteredGrid2 result;
+        result.set(*solver.gridSystemData()->velocity());
+        return result;
+    };
+
+    const unsigned int numThreads = maxNumberOfThreads();
+    FaceCenteredGrid2 serial = transfer(1);
+    FaceCenteredGrid2 parallel = transfer(std::max(numThreads, 4u));
+    setMaxNumberOfThreads(numThreads);
+
+    serial.forEachUIndex([&](size_t i, size_t j) {
+        EXPECT_EQ(serial.u(i, j), parallel.u(i, j));
+    });
+    serial.forEachVIndex([&](size_t i, size_t j) {
+        EXPECT_EQ(serial.v(i, j), parallel.v(i, j));
+    });
+}
@@ -5,8 +5,14 @@
 // property of any third parties.
 
 #include <jet/apic_solver3.h>
+#include <jet/box3.h>
+#include <jet/parallel.h>
+#include <jet/volume_particle_emitter3.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 using namespace jet;
 
 TEST(ApicSolver3, UpdateEmpty) {
@@ -16,3 +22,103 @@ TEST(ApicSolver3, UpdateEmpty) {
         solver.update(frame);
     }
 }
+
+namespace {
+
+class ApicSolver3Tester : public ApicSolver3 {
+ public:
+    ApicSolver3Tester()
+    : ApicSolver3({8, 8, 8}, {0.125, 0.125, 0.125}, {0.0, 0.0, 0.0}) {
+    }
+
+    void transfer() { transferFromParticlesToGrids(); }
+};
+
+}  // namespace
+
+TEST(ApicSolver3, DeterministicTransfer) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.1, 1.1);
+
+    ApicSolver3Tester solver;
+    auto particles = solver.particleSystemData();
+    Array1<Vector3D> positions(1000);
+    Array1<Vector3D> velocities(1000);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector3D(d(rng), d(rng), d(rng));
+        velocities[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+    particles->addParticles(positions, velocities);
+
+    auto transfer = [&](unsigned int numThreads) {
+        setMaxNumberOfThreads(numThreads);
+        solver.transfer();
+        FaceCenteredGrid3 result;
+        result.set(*solver.gridSystemData()->velocity());
+        return result;
+    };
+
+    const unsigned int numThreads = maxNumberOfThreads();
+    FaceCenteredGrid3 serial = transfer(1);
+    FaceCenteredGrid3 parallel = transfer(std::max(numThreads, 4u));
+    setMaxNumberOfThreads(numThreads);
+
+    serial.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(serial.u(i, j, k), parallel.u(i, j, k));
+    });
+    serial.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(serial.v(i, j, k), parallel.v(i, j, k));
+    });
+    serial.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(serial.w(i, j, k), parallel.w(i, j, k));
+    });
+}
+
+TEST(ApicSolver3, Restart) {
+    auto makeSolver = []() {
+        auto solver = ApicSolver3::builder()
+                          .withResolution({8, 8, 8})
+                          .withDomainSizeX(1.0)
+                          .makeShared();
+        auto box = Box3::builder()
+                       .withLowerCorner({0.0, 0.0, 0.0})
+                       .withUpperCorner({0.5, 0.5, 1.0})
+                       .makeShared();
+        auto emitter = VolumeParticleEmitter3::builder()
+                           .withSurface(box)
+                           .withSpacing(1.0 / 16.0)
+                           .withIsOneShot(true)
+                           .makeShared();
+        solver->setParticleEmitter(emitter);
+        return solver;
+    };
+
+    auto solver = makeSolver();
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 2; ++frame) {
+        solver->update(frame);
+    }
+
+    Checkpoint checkpoint;
+    solver->saveCheckpoint(&checkpoint);
+    const Frame restartFrame = frame;
+
+    for (; frame.index < 4; ++frame) {
+        solver->update(frame);
+    }
+
+    // The affine velocities are carried over the time-steps, so the restored
+    // solver only matches if they are part of the checkpoint.
+    auto restored = makeSolver();
+    restored->loadCheckpoint(checkpoint);
+    for (frame = restartFrame; frame.index < 4; ++frame) {
+        restored->update(frame);
+    }
+
+    auto positions = solver->particleSystemData()->positions();
+    auto restoredPositions = restored->particleSystemData()->positions();
+    ASSERT_EQ(positions.size(), restoredPositions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(positions[i], restoredPositions[i]);
+    }
+}
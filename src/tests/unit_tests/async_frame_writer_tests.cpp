@@ -0,0 +1,107 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/async_frame_writer.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+using namespace jet;
+
+TEST(AsyncFrameWriter, Write) {
+    std::vector<int> frames;
+    std::vector<double> sums;
+    std::atomic<size_t> maxPending(0);
+
+    {
+        AsyncFrameWriter<Array1<double>> writer(
+            [&](const Frame& frame, const Array1<double>& snapshot) {
+                // Slow down the writes so that the queue fills up.
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                double sum = 0.0;
+                for (double v : snapshot) {
+                    sum += v;
+                }
+                frames.push_back(frame.index);
+                sums.push_back(sum);
+            },
+            3);
+        EXPECT_EQ(3u, writer.maxNumberOfPendingFrames());
+
+        Array1<double> state(100);
+        for (Frame frame; frame.index < 20; ++frame) {
+            state.set(static_cast<double>(frame.index));
+            writer.write(frame, [&](const Frame&, Array1<double>* snapshot) {
+                snapshot->set(state);
+            });
+
+            const size_t pending = writer.numberOfPendingFrames();
+            EXPECT_GE(3u, pending);
+            if (pending > maxPending) {
+                maxPending = pending;
+            }
+        }
+
+        writer.flush();
+        EXPECT_EQ(0u, writer.numberOfPendingFrames());
+        EXPECT_EQ(20u, frames.size());
+
+        // Frames queued after a flush are written when the writer is
+        // destroyed.
+        writer.write(Frame(20, 1.0 / 60.0),
+                     [&](const Frame&, Array1<double>* snapshot) {
+                         snapshot->set(state);
+                     });
+    }
+
+    EXPECT_LT(1u, maxPending);
+    ASSERT_EQ(21u, frames.size());
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(i, frames[i]);
+        EXPECT_EQ(100.0 * i, sums[i]);
+    }
+    EXPECT_EQ(20, frames[20]);
+    EXPECT_EQ(1900.0, sums[20]);
+}
+
+TEST(AsyncFrameWriter, SnapshotFailure) {
+    std::vector<int> frames;
+    AsyncFrameWriter<Array1<double>> writer(
+        [&](const Frame& frame, const Array1<double>&) {
+            frames.push_back(frame.index);
+        },
+        1);
+
+    // A failed snapshot returns its buffer, so the writer keeps working.
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_THROW(writer.write(Frame(i, 1.0 / 60.0),
+                                  [](const Frame&, Array1<double>*) {
+                                      throw std::runtime_error("Failed.");
+                                  }),
+                     std::runtime_error);
+        EXPECT_EQ(0u, writer.numberOfPendingFrames());
+    }
+
+    writer.write(Frame(3, 1.0 / 60.0), [](const Frame&, Array1<double>*) {});
+    writer.flush();
+    ASSERT_EQ(1u, frames.size());
+    EXPECT_EQ(3, frames[0]);
+}
+
+TEST(AsyncFrameWriter, Constructors) {
+    auto writeFunction = [](const Frame&, const Array1<double>&) {};
+    AsyncFrameWriter<Array1<double>> writer(writeFunction);
+    EXPECT_EQ(2u, writer.maxNumberOfPendingFrames());
+    EXPECT_EQ(0u, writer.numberOfPendingFrames());
+
+    EXPECT_THROW(AsyncFrameWriter<Array1<double>>(writeFunction, 0),
+                 std::invalid_argument);
+}
@@ -212,3 +212,115 @@ TEST(Bvh2, ForEachOverlappingItems) {
 
     EXPECT_EQ(numOverlaps, measured);
 }
+
+TEST(Bvh2, SahBuild) {
+    Bvh2<BoundingBox2D> bvh;
+
+    auto distanceFunc = [](const BoundingBox2D& a, const Vector2D& pt) {
+        return a.clamp(pt).distanceTo(pt);
+    };
+
+    auto intersectsFunc = [](const BoundingBox2D& a, const Ray2D& ray) {
+        auto bboxResult = a.closestIntersection(ray);
+        if (bboxResult.isIntersecting) {
+            return bboxResult.tNear;
+        } else {
+            return kMaxD;
+        }
+    };
+
+    size_t numSamples = getNumberOfSamplePoints2();
+    std::vector<BoundingBox2D> items(numSamples / 2);
+    size_t i = 0;
+    std::generate(items.begin(), items.end(), [&]() {
+        auto c = getSamplePoints2()[i++];
+        BoundingBox2D box(c, c);
+        box.expand(0.02);
+        return box;
+    });
+
+    bvh.build(items, items, BvhBuildMethod::kSah);
+    EXPECT_EQ(items.size(), bvh.numberOfItems());
+
+    for (i = 0; i < numSamples / 2; ++i) {
+        const Vector2D& pt = getSamplePoints2()[i + numSamples / 2];
+        Ray2D ray(pt, getSampleDirs2()[i + numSamples / 2]);
+
+        // ad-hoc search
+        double ansDist = kMaxD;
+        ClosestIntersectionQueryResult2<BoundingBox2D> ansInts;
+        for (size_t j = 0; j < numSamples / 2; ++j) {
+            ansDist = std::min(ansDist, distanceFunc(items[j], pt));
+
+            double dist = intersectsFunc(items[j], ray);
+            if (dist < ansInts.distance) {
+                ansInts.distance = dist;
+                ansInts.item = &bvh.item(j);
+            }
+        }
+
+        // bvh search
+        EXPECT_DOUBLE_EQ(ansDist, bvh.nearest(pt, distanceFunc).distance);
+
+        auto bvhInts = bvh.closestIntersection(ray, intersectsFunc);
+        EXPECT_DOUBLE_EQ(ansInts.distance, bvhInts.distance);
+        EXPECT_EQ(ansInts.item, bvhInts.item);
+    }
+}
+
+TEST(Bvh2, Refit) {
+    Bvh2<size_t> bvh;
+
+    size_t numSamples = getNumberOfSamplePoints2();
+    std::vector<size_t> items(numSamples);
+    std::vector<Vector2D> points(getSamplePoints2(),
+                                 getSamplePoints2() + numSamples);
+    std::vector<BoundingBox2D> bounds(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        items[i] = i;
+        bounds[i] = BoundingBox2D(points[i], points[i]);
+    }
+
+    bvh.build(items, bounds, BvhBuildMethod::kSah);
+
+    // Move the points without changing the tree.
+    for (size_t i = 0; i < numSamples; ++i) {
+        points[i] = getSamplePoints2()[(i * 7) % numSamples] +
+                    Vector2D(1.0, -2.0);
+        bounds[i] = BoundingBox2D(points[i], points[i]);
+    }
+
+    bvh.refit(bounds);
+
+    BoundingBox2D allBound;
+    for (const auto& b : bounds) {
+        allBound.merge(b);
+    }
+    EXPECT_EQ(allBound.lowerCorner, bvh.boundingBox().lowerCorner);
+    EXPECT_EQ(allBound.upperCorner, bvh.boundingBox().upperCorner);
+
+    auto containsFunc = [&](size_t item, const BoundingBox2D& box) {
+        return box.contains(points[item]);
+    };
+
+    BoundingBox2D testBox({1.3, -1.8}, {1.6, -1.5});
+    size_t numOverlaps = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        numOverlaps += testBox.contains(points[i]);
+    }
+
+    size_t measured = 0;
+    bvh.forEachIntersectingItem(testBox, containsFunc,
+                                [&](size_t) { ++measured; });
+    EXPECT_EQ(numOverlaps, measured);
+
+    Vector2D testPt(1.5, -1.5);
+    auto distanceFunc = [&](size_t item, const Vector2D& pt) {
+        return points[item].distanceTo(pt);
+    };
+    double ansDist = kMaxD;
+    for (size_t i = 0; i < numSamples; ++i) {
+        ansDist = std::min(ansDist, distanceFunc(i, testPt));
+    }
+    EXPECT_DOUBLE_EQ(ansDist, bvh.nearest(testPt, distanceFunc).distance);
+}
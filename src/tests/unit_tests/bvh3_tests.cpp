@@ -209,3 +209,115 @@ TEST(Bvh3, ForEachOverlappingItems) {
 
     EXPECT_EQ(numOverlaps, measured);
 }
+
+TEST(Bvh3, SahBuild) {
+    Bvh3<BoundingBox3D> bvh;
+
+    auto distanceFunc = [](const BoundingBox3D& a, const Vector3D& pt) {
+        return a.clamp(pt).distanceTo(pt);
+    };
+
+    auto intersectsFunc = [](const BoundingBox3D& a, const Ray3D& ray) {
+        auto bboxResult = a.closestIntersection(ray);
+        if (bboxResult.isIntersecting) {
+            return bboxResult.tNear;
+        } else {
+            return kMaxD;
+        }
+    };
+
+    size_t numSamples = getNumberOfSamplePoints3();
+    std::vector<BoundingBox3D> items(numSamples / 2);
+    size_t i = 0;
+    std::generate(items.begin(), items.end(), [&]() {
+        auto c = getSamplePoints3()[i++];
+        BoundingBox3D box(c, c);
+        box.expand(0.02);
+        return box;
+    });
+
+    bvh.build(items, items, BvhBuildMethod::kSah);
+    EXPECT_EQ(items.size(), bvh.numberOfItems());
+
+    for (i = 0; i < numSamples / 2; ++i) {
+        const Vector3D& pt = getSamplePoints3()[i + numSamples / 2];
+        Ray3D ray(pt, getSampleDirs3()[i + numSamples / 2]);
+
+        // ad-hoc search
+        double ansDist = kMaxD;
+        ClosestIntersectionQueryResult3<BoundingBox3D> ansInts;
+        for (size_t j = 0; j < numSamples / 2; ++j) {
+            ansDist = std::min(ansDist, distanceFunc(items[j], pt));
+
+            double dist = intersectsFunc(items[j], ray);
+            if (dist < ansInts.distance) {
+                ansInts.distance = dist;
+                ansInts.item = &bvh.item(j);
+            }
+        }
+
+        // bvh search
+        EXPECT_DOUBLE_EQ(ansDist, bvh.nearest(pt, distanceFunc).distance);
+
+        auto bvhInts = bvh.closestIntersection(ray, intersectsFunc);
+        EXPECT_DOUBLE_EQ(ansInts.distance, bvhInts.distance);
+        EXPECT_EQ(ansInts.item, bvhInts.item);
+    }
+}
+
+TEST(Bvh3, Refit) {
+    Bvh3<size_t> bvh;
+
+    size_t numSamples = getNumberOfSamplePoints3();
+    std::vector<size_t> items(numSamples);
+    std::vector<Vector3D> points(getSamplePoints3(),
+                                 getSamplePoints3() + numSamples);
+    std::vector<BoundingBox3D> bounds(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        items[i] = i;
+        bounds[i] = BoundingBox3D(points[i], points[i]);
+    }
+
+    bvh.build(items, bounds, BvhBuildMethod::kSah);
+
+    // Move the points without changing the tree.
+    for (size_t i = 0; i < numSamples; ++i) {
+        points[i] = getSamplePoints3()[(i * 7) % numSamples] +
+                    Vector3D(1.0, -2.0, 0.5);
+        bounds[i] = BoundingBox3D(points[i], points[i]);
+    }
+
+    bvh.refit(bounds);
+
+    BoundingBox3D allBound;
+    for (const auto& b : bounds) {
+        allBound.merge(b);
+    }
+    EXPECT_EQ(allBound.lowerCorner, bvh.boundingBox().lowerCorner);
+    EXPECT_EQ(allBound.upperCorner, bvh.boundingBox().upperCorner);
+
+    auto containsFunc = [&](size_t item, const BoundingBox3D& box) {
+        return box.contains(points[item]);
+    };
+
+    BoundingBox3D testBox({1.3, -1.8, 0.6}, {1.6, -1.5, 0.9});
+    size_t numOverlaps = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        numOverlaps += testBox.contains(points[i]);
+    }
+
+    size_t measured = 0;
+    bvh.forEachIntersectingItem(testBox, containsFunc,
+                                [&](size_t) { ++measured; });
+    EXPECT_EQ(numOverlaps, measured);
+
+    Vector3D testPt(1.5, -1.5, 1.0);
+    auto distanceFunc = [&](size_t item, const Vector3D& pt) {
+        return points[item].distanceTo(pt);
+    };
+    double ansDist = kMaxD;
+    for (size_t i = 0; i < numSamples; ++i) {
+        ansDist = std::min(ansDist, distanceFunc(i, testPt));
+    }
+    EXPECT_DOUBLE_EQ(ansDist, bvh.nearest(testPt, distanceFunc).distance);
+}
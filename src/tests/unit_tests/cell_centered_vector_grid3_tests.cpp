@@ -317,6 +317,27 @@ TEST(CellCenteredVectorGrid3, Fill) {
     }
 }
 
+TEST(CellCenteredVectorGrid3, BatchedSample) {
+    CellCenteredVectorGrid3 grid(5, 8, 6, 2.0, 3.0, 1.5, -1.0, 2.0, 0.5);
+    grid.fill([](const Vector3D& x) {
+        return Vector3D(x.y * x.z, x.x - x.z, x.x * x.y + 1.0);
+    });
+
+    std::vector<Vector3D> points;
+    for (int n = -5; n < 40; ++n) {
+        points.emplace_back(0.31 * n - 1.0, 0.67 * n + 2.0, 0.23 * n);
+    }
+    std::vector<Vector3D> values(points.size());
+    grid.sample(ConstArrayAccessor1<Vector3D>(points.size(), points.data()),
+                ArrayAccessor1<Vector3D>(values.size(), values.data()),
+                ExecutionPolicy::kSerial);
+
+    auto sampler = grid.sampler();
+    for (size_t n = 0; n < points.size(); ++n) {
+        EXPECT_EQ(sampler(points[n]), values[n]);
+    }
+}
+
 TEST(CellCenteredVectorGrid3, DivergenceAtDataPoint) {
     CellCenteredVectorGrid3 grid(5, 8, 6);
 
@@ -4,6 +4,8 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include "fdm_linear_system_solver_test_helper3.h"
+
 #include <gtest/gtest.h>
 #include <jet/blas.h>
 #include <jet/cg.h>
@@ -93,3 +95,42 @@ TEST(Pcg, Solve) {
         EXPECT_LE(lastNumIter, 2u);
     }
 }
+
+TEST(PcgFused, MatchesPcg) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {8, 8, 8});
+
+    struct JacobiPreconditioner {
+        const FdmMatrix3* A;
+
+        void solve(const FdmVector3& b, FdmVector3* x) {
+            b.forEachIndex([&](size_t i, size_t j, size_t k) {
+                (*x)(i, j, k) = b(i, j, k) / (*A)(i, j, k).center;
+            });
+        }
+    };
+
+    const Size3 size = system.A.size();
+    JacobiPreconditioner precond{&system.A};
+
+    FdmVector3 x1(size), r1(size), d1(size), q1(size), s1(size);
+    unsigned int numIter1;
+    double residual1;
+    pcg<FdmBlas3>(system.A, system.b, 100, 1e-6, &precond, &x1, &r1, &d1,
+                  &q1, &s1, &numIter1, &residual1);
+
+    FdmVector3 x2(size), r2(size), d2(size), q2(size), s2(size);
+    unsigned int numIter2;
+    double residual2;
+    pcgFused<FdmBlas3>(system.A, system.b, 100, 1e-6, &precond, &x2, &r2,
+                       &d2, &q2, &s2, &numIter2, &residual2);
+
+    // Both test the convergence with r.(M^-1)r.
+    EXPECT_EQ(numIter1, numIter2);
+    EXPECT_NEAR(residual1, residual2, 1e-9);
+    EXPECT_GT(1e-6, residual2);
+    x1.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(x1(i, j, k), x2(i, j, k), 1e-9);
+    });
+}
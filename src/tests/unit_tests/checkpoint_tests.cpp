@@ -0,0 +1,160 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/checkpoint.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jet;
+
+TEST(Checkpoint, Values) {
+    Checkpoint checkpoint;
+    EXPECT_EQ(0u, checkpoint.numberOfChunks());
+
+    checkpoint.setValue("a", 3.5);
+    checkpoint.setValue("b", Vector3D(1.0, 2.0, 3.0));
+    EXPECT_EQ(2u, checkpoint.numberOfChunks());
+    EXPECT_TRUE(checkpoint.hasChunk("a"));
+    EXPECT_FALSE(checkpoint.hasChunk("c"));
+
+    double a = 0.0;
+    Vector3D b;
+    EXPECT_TRUE(checkpoint.getValue("a", &a));
+    EXPECT_TRUE(checkpoint.getValue("b", &b));
+    EXPECT_EQ(3.5, a);
+    EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), b);
+
+    // Missing chunks keep the value.
+    int c = 7;
+    EXPECT_FALSE(checkpoint.getValue("c", &c));
+    EXPECT_EQ(7, c);
+
+    // Mismatching sizes are errors.
+    EXPECT_THROW(checkpoint.getValue("a", &c), std::invalid_argument);
+    EXPECT_THROW(checkpoint.chunk("c"), std::invalid_argument);
+
+    checkpoint.clear();
+    EXPECT_EQ(0u, checkpoint.numberOfChunks());
+}
+
+TEST(Checkpoint, Arrays) {
+    Checkpoint checkpoint;
+
+    Array1<Vector3D> positions = {Vector3D(1, 2, 3), Vector3D(4, 5, 6)};
+    checkpoint.setArray("positions", positions.constAccessor());
+    checkpoint.setArray("empty", ConstArrayAccessor1<double>());
+
+    std::vector<Vector3D> loaded;
+    EXPECT_TRUE(checkpoint.getArray("positions", &loaded));
+    ASSERT_EQ(2u, loaded.size());
+    EXPECT_EQ(positions[0], loaded[0]);
+    EXPECT_EQ(positions[1], loaded[1]);
+
+    std::vector<double> empty = {1.0};
+    EXPECT_TRUE(checkpoint.getArray("empty", &empty));
+    EXPECT_TRUE(empty.empty());
+
+    std::vector<Vector3D> wrongSize;
+    checkpoint.setValue("scalar", 1.0);
+    EXPECT_THROW(checkpoint.getArray("scalar", &wrongSize),
+                 std::invalid_argument);
+}
+
+TEST(Checkpoint, Data) {
+    CellCenteredScalarGrid3 grid(4, 5, 6, 0.5, 0.5, 0.5);
+    grid.fill([](const Vector3D& x) { return x.x + 2.0 * x.y - x.z; });
+
+    Checkpoint checkpoint;
+    checkpoint.setData("grid", grid);
+
+    CellCenteredScalarGrid3 loaded;
+    EXPECT_TRUE(checkpoint.getData("grid", &loaded));
+    EXPECT_FALSE(checkpoint.getData("other", &loaded));
+    EXPECT_EQ(grid.resolution(), loaded.resolution());
+    grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(grid(i, j, k), loaded(i, j, k));
+    });
+}
+
+TEST(Checkpoint, RandomEngine) {
+    std::mt19937 rng(42);
+    rng.discard(100);
+
+    Checkpoint checkpoint;
+    checkpoint.setRandomEngine("rng", rng);
+
+    std::mt19937 loaded;
+    EXPECT_TRUE(checkpoint.getRandomEngine("rng", &loaded));
+    EXPECT_FALSE(checkpoint.getRandomEngine("other", &loaded));
+    EXPECT_EQ(rng(), loaded());
+
+    checkpoint.setValue("value", 1.0);
+    EXPECT_THROW(checkpoint.getRandomEngine("value", &loaded),
+                 std::invalid_argument);
+}
+
+TEST(Checkpoint, Serialization) {
+    Checkpoint checkpoint;
+    checkpoint.setValue("frame", 12);
+    checkpoint.setChunk("bytes", {1, 2, 3});
+    checkpoint.setChunk("empty", {});
+
+    std::vector<uint8_t> buffer;
+    checkpoint.serialize(&buffer);
+
+    Checkpoint loaded;
+    loaded.deserialize(buffer);
+    EXPECT_EQ(3u, loaded.numberOfChunks());
+    EXPECT_EQ(checkpoint.chunk("frame"), loaded.chunk("frame"));
+    EXPECT_EQ(checkpoint.chunk("bytes"), loaded.chunk("bytes"));
+    EXPECT_TRUE(loaded.chunk("empty").empty());
+
+    // Truncated buffers are rejected.
+    buffer.pop_back();
+    EXPECT_THROW(loaded.deserialize(buffer), std::invalid_argument);
+    EXPECT_EQ(0u, loaded.numberOfChunks());
+
+    std::vector<uint8_t> garbage(64, 0xff);
+    EXPECT_THROW(loaded.deserialize(garbage), std::invalid_argument);
+}
+
+TEST(Checkpoint, SaveAndLoad) {
+    const std::string filename = "checkpoint_tests.ckpt";
+
+    Checkpoint checkpoint;
+    checkpoint.setValue("time", 0.25);
+    Array1<double> values = {0.5, 1.5, 2.5};
+    checkpoint.setArray("values", values.constAccessor());
+    ASSERT_TRUE(checkpoint.save(filename));
+
+    // The file matches the in-memory serialization.
+    std::vector<uint8_t> buffer;
+    checkpoint.serialize(&buffer);
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+    EXPECT_EQ(static_cast<std::streamoff>(buffer.size()),
+              static_cast<std::streamoff>(file.tellg()));
+    file.close();
+
+    Checkpoint loaded;
+    ASSERT_TRUE(loaded.load(filename));
+    double time = 0.0;
+    std::vector<double> loadedValues;
+    EXPECT_TRUE(loaded.getValue("time", &time));
+    EXPECT_TRUE(loaded.getArray("values", &loadedValues));
+    EXPECT_EQ(0.25, time);
+    EXPECT_EQ(std::vector<double>({0.5, 1.5, 2.5}), loadedValues);
+
+    std::remove(filename.c_str());
+    EXPECT_FALSE(loaded.load(filename));
+    EXPECT_EQ(0u, loaded.numberOfChunks());
+}
@@ -6,6 +6,7 @@
 
 #include <jet/face_centered_grid3.h>
 #include <gtest/gtest.h>
+#include <cmath>
 #include <vector>
 
 using namespace jet;
@@ -268,6 +269,40 @@ TEST(FaceCenteredGrid3, Sample) {
     });
 }
 
+TEST(FaceCenteredGrid3, BatchedSample) {
+    FaceCenteredGrid3 grid(5, 8, 6, 2.0, 3.0, 1.5, -1.0, 2.0, 0.5);
+    grid.fill([&](const Vector3D& x) {
+        return Vector3D(std::sin(x.y) + x.z, x.x * x.z, std::cos(x.x * x.y));
+    });
+
+    // Points inside, on the faces and outside of the grid
+    std::vector<Vector3D> points;
+    for (int k = -2; k < 14; ++k) {
+        for (int j = -2; j < 28; ++j) {
+            for (int i = -2; i < 12; ++i) {
+                points.emplace_back(0.97 * i - 1.0, 0.91 * j + 2.0,
+                                    0.73 * k + 0.5);
+            }
+        }
+    }
+    std::vector<Vector3D> values(points.size());
+    grid.sample(ConstArrayAccessor1<Vector3D>(points.size(), points.data()),
+                ArrayAccessor1<Vector3D>(values.size(), values.data()));
+
+    // Same as the component samplers, bit by bit.
+    auto sampler = grid.sampler();
+    for (size_t n = 0; n < points.size(); ++n) {
+        EXPECT_EQ(sampler(points[n]), values[n]);
+        EXPECT_EQ(sampler(points[n]), grid.sample(points[n]));
+    }
+
+    std::vector<Vector3D> tooShort(points.size() - 1);
+    EXPECT_THROW(grid.sample(
+        ConstArrayAccessor1<Vector3D>(points.size(), points.data()),
+        ArrayAccessor1<Vector3D>(tooShort.size(), tooShort.data())),
+        std::invalid_argument);
+}
+
 TEST(FaceCenteredGrid3, Builder) {
     {
         auto builder = FaceCenteredGrid3::builder();
@@ -43,3 +43,31 @@ TEST(FdmIccgSolver3, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmIccgSolver3, SolveMic) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {32, 32, 32});
+
+    FdmIccgSolver3 icSolver(100, 1e-4);
+    EXPECT_TRUE(icSolver.solve(&system));
+
+    FdmIccgSolver3 micSolver(100, 1e-4, 0.97);
+    EXPECT_DOUBLE_EQ(0.97, micSolver.micTuningFactor());
+    EXPECT_TRUE(micSolver.solve(&system));
+    EXPECT_GE(icSolver.lastNumberOfIterations(),
+              micSolver.lastNumberOfIterations());
+
+    EXPECT_THROW(micSolver.setMicTuningFactor(-0.1), std::invalid_argument);
+}
+
+TEST(FdmIccgSolver3, SolveCompressedMic) {
+    FdmCompressedLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(
+        &system, {16, 16, 16});
+
+    FdmIccgSolver3 solver(100, 1e-4, 0.97);
+    solver.solveCompressed(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
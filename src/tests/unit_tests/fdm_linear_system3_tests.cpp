@@ -0,0 +1,212 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_linear_system_solver_test_helper3.h"
+
+#include <jet/fdm_linear_system3.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace jet;
+
+TEST(FdmBlas3, Dot) {
+    FdmVector3 a(7, 5, 3);
+    FdmVector3 b(7, 5, 3);
+    double expected = 0.0;
+    a.forEachIndex([&](size_t i, size_t j, size_t k) {
+        a(i, j, k) = static_cast<double>(i + j) - 0.5 * k;
+        b(i, j, k) = static_cast<double>(j) + 0.25 * i;
+        expected += a(i, j, k) * b(i, j, k);
+    });
+
+    EXPECT_NEAR(expected, FdmBlas3::dot(a, b), 1e-9);
+    EXPECT_NEAR(std::sqrt(FdmBlas3::dot(a, a)), FdmBlas3::l2Norm(a), 1e-9);
+    EXPECT_DOUBLE_EQ(10.0, FdmBlas3::lInfNorm(a));
+}
+
+TEST(FdmBlas3, FusedOperations) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {7, 5, 3});
+
+    FdmVector3 v(system.b.size());
+    v.forEachIndex([&](size_t i, size_t j, size_t k) {
+        v(i, j, k) = std::sin(static_cast<double>(i + 3 * j + 5 * k));
+    });
+    FdmVector3 mv(v.size());
+    FdmVector3 fusedMv(v.size());
+    FdmBlas3::mvm(system.A, v, &mv);
+    double vDotMv = FdmBlas3::mvmDot(system.A, v, &fusedMv);
+
+    mv.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(mv(i, j, k), fusedMv(i, j, k));
+    });
+    EXPECT_NEAR(FdmBlas3::dot(v, mv), vDotMv, 1e-9);
+
+    FdmVector3 x(v.size(), 1.0);
+    FdmVector3 r(v);
+    FdmVector3 fusedX(x);
+    FdmVector3 fusedR(r);
+    FdmBlas3::axpy(0.5, v, x, &x);
+    FdmBlas3::axpy(-0.5, mv, r, &r);
+    double rDotR = FdmBlas3::axpyAxpyDot(0.5, v, mv, &fusedX, &fusedR);
+
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(x(i, j, k), fusedX(i, j, k));
+        EXPECT_DOUBLE_EQ(r(i, j, k), fusedR(i, j, k));
+    });
+    EXPECT_NEAR(FdmBlas3::dot(r, r), rDotR, 1e-9);
+}
+
+TEST(FdmBlas3F, SinglePrecision) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {7, 5, 3});
+
+    FdmVector3 v(system.b.size());
+    v.forEachIndex([&](size_t i, size_t j, size_t k) {
+        v(i, j, k) = std::sin(static_cast<double>(i + 3 * j + 5 * k));
+    });
+    FdmVector3 mv(v.size());
+    FdmBlas3::mvm(system.A, v, &mv);
+
+    FdmMatrix3F aF;
+    FdmVector3F vF;
+    FdmBlas3F::convert(system.A, &aF);
+    FdmBlas3F::convert(v, &vF);
+    EXPECT_EQ(system.A.size(), aF.size());
+    EXPECT_EQ(v.size(), vF.size());
+
+    FdmVector3F mvF(v.size());
+    double vDotMvF = FdmBlas3F::mvmDot(aF, vF, &mvF);
+    mv.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(mv(i, j, k), mvF(i, j, k), 1e-5);
+    });
+    EXPECT_NEAR(FdmBlas3::dot(v, mv), vDotMvF, 1e-4);
+    EXPECT_NEAR(FdmBlas3::l2Norm(v), FdmBlas3F::l2Norm(vF), 1e-5);
+    EXPECT_NEAR(FdmBlas3::lInfNorm(v), FdmBlas3F::lInfNorm(vF), 1e-6);
+
+    FdmVector3F rF(v.size());
+    FdmVector3F bF;
+    FdmBlas3F::convert(system.b, &bF);
+    FdmBlas3F::residual(aF, vF, bF, &rF);
+
+    FdmVector3 r(v.size());
+    FdmBlas3::residual(system.A, v, system.b, &r);
+
+    FdmVector3 rD;
+    FdmBlas3::convert(rF, &rD);
+    r.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(r(i, j, k), rD(i, j, k), 1e-5);
+    });
+}
+
+TEST(FdmCompressedBlas3, FusedOperations) {
+    FdmCompressedLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(
+        &system, {7, 5, 3});
+
+    VectorND v(system.b.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = std::sin(static_cast<double>(i));
+    }
+    VectorND mv(v.size());
+    VectorND fusedMv(v.size());
+    FdmCompressedBlas3::mvm(system.A, v, &mv);
+    double vDotMv = FdmCompressedBlas3::mvmDot(system.A, v, &fusedMv);
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_DOUBLE_EQ(mv[i], fusedMv[i]);
+    }
+    EXPECT_NEAR(v.dot(mv), vDotMv, 1e-9);
+    EXPECT_NEAR(v.dot(mv), FdmCompressedBlas3::dot(v, mv), 1e-9);
+
+    VectorND x(v.size(), 1.0);
+    VectorND r(v);
+    VectorND fusedX(x);
+    VectorND fusedR(r);
+    FdmCompressedBlas3::axpy(0.5, v, x, &x);
+    FdmCompressedBlas3::axpy(-0.5, mv, r, &r);
+    double rDotR =
+        FdmCompressedBlas3::axpyAxpyDot(0.5, v, mv, &fusedX, &fusedR);
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_DOUBLE_EQ(x[i], fusedX[i]);
+        EXPECT_DOUBLE_EQ(r[i], fusedR[i]);
+    }
+    EXPECT_NEAR(r.dot(r), rDotR, 1e-9);
+    EXPECT_DOUBLE_EQ(std::fabs(r.absmax()), FdmCompressedBlas3::lInfNorm(r));
+}
+
+TEST(FdmCompressedLinearSystem3, BuildPattern) {
+    const Size3 size(5, 4, 3);
+    auto isActive = [](size_t i, size_t j, size_t k) {
+        return (i + 2 * j + 3 * k) % 4 != 0;
+    };
+
+    FdmCompressedLinearSystem3 system;
+    EXPECT_TRUE(system.buildPattern(size, isActive));
+
+    // Reference numbering in the (i, j, k) iteration order
+    Array3<size_t> expectedIndex(size, kMaxSize);
+    size_t numRows = 0;
+    expectedIndex.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (isActive(i, j, k)) {
+            expectedIndex(i, j, k) = numRows++;
+        }
+    });
+
+    EXPECT_EQ(numRows, system.A.rows());
+    EXPECT_EQ(numRows, system.A.cols());
+    EXPECT_EQ(numRows, system.b.size());
+    EXPECT_EQ(numRows, system.x.size());
+
+    expectedIndex.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const size_t row = expectedIndex(i, j, k);
+        EXPECT_EQ(row, system.coordToIndex(i, j, k));
+        if (row == kMaxSize) {
+            return;
+        }
+
+        std::vector<size_t> columns;
+        if (k > 0 && isActive(i, j, k - 1)) {
+            columns.push_back(expectedIndex(i, j, k - 1));
+        }
+        if (j > 0 && isActive(i, j - 1, k)) {
+            columns.push_back(expectedIndex(i, j - 1, k));
+        }
+        if (i > 0 && isActive(i - 1, j, k)) {
+            columns.push_back(expectedIndex(i - 1, j, k));
+        }
+        columns.push_back(row);
+        if (i + 1 < size.x && isActive(i + 1, j, k)) {
+            columns.push_back(expectedIndex(i + 1, j, k));
+        }
+        if (j + 1 < size.y && isActive(i, j + 1, k)) {
+            columns.push_back(expectedIndex(i, j + 1, k));
+        }
+        if (k + 1 < size.z && isActive(i, j, k + 1)) {
+            columns.push_back(expectedIndex(i, j, k + 1));
+        }
+
+        const size_t begin = system.A.rowPointer(row);
+        ASSERT_EQ(columns.size(), system.A.rowPointer(row + 1) - begin);
+        for (size_t n = 0; n < columns.size(); ++n) {
+            EXPECT_EQ(columns[n], system.A.columnIndex(begin + n));
+        }
+    });
+
+    // Same active points keep the pattern.
+    EXPECT_FALSE(system.buildPattern(size, isActive));
+    EXPECT_EQ(numRows, system.A.rows());
+
+    EXPECT_TRUE(system.buildPattern(
+        size, [](size_t i, size_t, size_t) { return i > 0; }));
+    EXPECT_EQ(4u * 4u * 3u, system.A.rows());
+}
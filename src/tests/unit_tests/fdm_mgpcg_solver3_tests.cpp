@@ -10,18 +10,18 @@
 
 using namespace jet;
 
-TEST(FdmMgpcgSolver3, Solve) {
-    size_t levels = 4;
-    FdmMgLinearSystem3 system;
-    system.resizeWithCoarsest({4, 4, 4}, levels);
+namespace {
+
+void buildTestSystem(size_t levels, FdmMgLinearSystem3* system) {
+    system->resizeWithCoarsest({4, 4, 4}, levels);
 
     // Simple Poisson eq.
-    for (size_t l = 0; l < system.numberOfLevels(); ++l) {
+    for (size_t l = 0; l < system->numberOfLevels(); ++l) {
         double invdx = pow(0.5, l);
-        FdmMatrix3& A = system.A[l];
-        FdmVector3& b = system.b[l];
+        FdmMatrix3& A = system->A[l];
+        FdmVector3& b = system->b[l];
 
-        system.x[l].set(0);
+        system->x[l].set(0);
 
         A.forEachIndex([&](size_t i, size_t j, size_t k) {
             if (i > 0) {
@@ -55,6 +55,69 @@ TEST(FdmMgpcgSolver3, Solve) {
         });
     }
 
+}
+
+}  // namespace
+
+TEST(FdmMgpcgSolver3, Solve) {
+    size_t levels = 4;
+    FdmMgLinearSystem3 system;
+    buildTestSystem(levels, &system);
+
     FdmMgpcgSolver3 solver(50, levels, 5, 5, 10, 10, 1e-4, 1.5, false);
     EXPECT_TRUE(solver.solve(&system));
 }
+
+TEST(FdmMgpcgSolver3, SolveWithSinglePrecisionPreconditioner) {
+    size_t levels = 4;
+    FdmMgLinearSystem3 system;
+    buildTestSystem(levels, &system);
+    FdmMgLinearSystem3 systemF = system;
+
+    FdmMgpcgSolver3 solver(50, levels, 5, 5, 10, 10, 1e-6, 1.5, false);
+    EXPECT_FALSE(solver.useSinglePrecisionPreconditioner());
+    EXPECT_TRUE(solver.solve(&system));
+
+    FdmMgpcgSolver3 solverF(50, levels, 5, 5, 10, 10, 1e-6, 1.5, false, true);
+    EXPECT_TRUE(solverF.useSinglePrecisionPreconditioner());
+    EXPECT_TRUE(solverF.solve(&systemF));
+    EXPECT_GE(1e-6, solverF.lastResidual());
+    EXPECT_LE(solverF.lastNumberOfIterations(),
+              solver.lastNumberOfIterations() + 2);
+
+    const FdmVector3& x = system.x.finest();
+    const FdmVector3& xF = systemF.x.finest();
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(x(i, j, k), xF(i, j, k), 1e-5);
+    });
+}
+
+TEST(FdmMgpcgSolver3, SolveTwiceWithSinglePrecisionPreconditioner) {
+    size_t levels = 4;
+    FdmMgLinearSystem3 system;
+    buildTestSystem(levels, &system);
+
+    FdmMgpcgSolver3 solver(50, levels, 5, 5, 10, 10, 1e-6, 1.5, false, true);
+    EXPECT_TRUE(solver.solve(&system));
+
+    // Reassemble the system with the same resolution but different values.
+    for (size_t l = 0; l < system.numberOfLevels(); ++l) {
+        system.A[l].forEachIndex([&](size_t i, size_t j, size_t k) {
+            system.A[l](i, j, k).center *= 1.0 + 0.1 * static_cast<double>(i);
+        });
+    }
+    FdmMgLinearSystem3 systemF = system;
+    EXPECT_TRUE(solver.solve(&system));
+
+    // A fresh solver should give the same result.
+    FdmMgpcgSolver3 fresh(50, levels, 5, 5, 10, 10, 1e-6, 1.5, false, true);
+    EXPECT_TRUE(fresh.solve(&systemF));
+    EXPECT_EQ(fresh.lastNumberOfIterations(), solver.lastNumberOfIterations());
+    EXPECT_DOUBLE_EQ(fresh.lastResidual(), solver.lastResidual());
+
+    const FdmVector3& x = system.x.finest();
+    const FdmVector3& xF = systemF.x.finest();
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(xF(i, j, k), x(i, j, k));
+    });
+}
@@ -4,7 +4,11 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/box3.h>
 #include <jet/flip_solver3.h>
+#include <jet/rigid_body_collider3.h>
+#include <jet/sphere3.h>
+#include <jet/volume_particle_emitter3.h>
 #include <gtest/gtest.h>
 
 using namespace jet;
@@ -29,3 +33,78 @@ TEST(FlipSolver3, PicBlendingFactor) {
     solver.setPicBlendingFactor(-0.9);
     EXPECT_EQ(0.0, solver.picBlendingFactor());
 }
+
+namespace {
+
+FlipSolver3Ptr makeRestartTestSolver() {
+    auto solver = FlipSolver3::builder()
+                      .withResolution({8, 8, 8})
+                      .withDomainSizeX(1.0)
+                      .makeShared();
+    solver->setPicBlendingFactor(0.1);
+
+    auto box = Box3::builder()
+                   .withLowerCorner({0.0, 0.0, 0.0})
+                   .withUpperCorner({0.5, 0.5, 1.0})
+                   .makeShared();
+    auto emitter = VolumeParticleEmitter3::builder()
+                       .withSurface(box)
+                       .withSpacing(1.0 / 16.0)
+                       .withJitter(0.5)
+                       .withIsOneShot(true)
+                       .makeShared();
+    solver->setParticleEmitter(emitter);
+
+    auto sphere = Sphere3::builder()
+                      .withCenter({0.75, 0.25, 0.5})
+                      .withRadius(0.15)
+                      .makeShared();
+    auto collider = RigidBodyCollider3::builder()
+                        .withSurface(sphere)
+                        .makeShared();
+    solver->setCollider(collider);
+
+    return solver;
+}
+
+}  // namespace
+
+TEST(FlipSolver3, Restart) {
+    auto solver = makeRestartTestSolver();
+
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 2; ++frame) {
+        solver->update(frame);
+    }
+
+    Checkpoint checkpoint;
+    solver->saveCheckpoint(&checkpoint);
+    const Frame restartFrame = frame;
+
+    for (; frame.index < 4; ++frame) {
+        solver->update(frame);
+    }
+
+    // The restored solver should not emit the particles again and should
+    // reproduce the same trajectories.
+    auto restored = makeRestartTestSolver();
+    restored->loadCheckpoint(checkpoint);
+    for (frame = restartFrame; frame.index < 4; ++frame) {
+        restored->update(frame);
+    }
+
+    EXPECT_EQ(solver->currentFrame().index, restored->currentFrame().index);
+
+    auto particles = solver->particleSystemData();
+    auto restoredParticles = restored->particleSystemData();
+    ASSERT_EQ(particles->numberOfParticles(),
+              restoredParticles->numberOfParticles());
+    auto positions = particles->positions();
+    auto restoredPositions = restoredParticles->positions();
+    auto velocities = particles->velocities();
+    auto restoredVelocities = restoredParticles->velocities();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(positions[i], restoredPositions[i]);
+        EXPECT_EQ(velocities[i], restoredVelocities[i]);
+    }
+}
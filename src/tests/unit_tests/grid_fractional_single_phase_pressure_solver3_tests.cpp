@@ -12,6 +12,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 using namespace jet;
 
 TEST(GridFractionalSinglePhasePressureSolver3, SolveFreeSurface) {
@@ -131,3 +133,37 @@ TEST(GridFractionalSinglePhasePressureSolver3, SolveFreeSurfaceCompressed) {
         }
     }
 }
+
+TEST(GridFractionalSinglePhasePressureSolver3, SolveCompressedSamePattern) {
+    const Size3 res(16, 16, 16);
+    const Vector3D h(1.0 / 16.0, 1.0 / 16.0, 1.0 / 16.0);
+    FaceCenteredGrid3 vel(res, h), output(res, h), expected(res, h);
+    CellCenteredScalarGrid3 fluidSdf(res, h);
+
+    fluidSdf.fill([](const Vector3D& x) {
+        return x.distanceTo(Vector3D(0.5, 0.4, 0.5)) - 0.3;
+    });
+
+    GridFractionalSinglePhasePressureSolver3 solver;
+    GridFractionalSinglePhasePressureSolver3 freshSolver;
+
+    // The second solve reuses the sparsity pattern of the first one.
+    for (int step = 0; step < 2; ++step) {
+        const double s = 1.0 + step;
+        vel.fill([s](const Vector3D& x) {
+            return Vector3D(std::sin(s * x.y), -x.y * s, std::cos(s * x.x));
+        });
+
+        solver.solve(vel, 1.0, &output, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf, true);
+    }
+
+    freshSolver.solve(vel, 1.0, &expected, ConstantScalarField3(kMaxD),
+                      ConstantVectorField3({0, 0, 0}), fluidSdf, true);
+
+    const auto& pressure = solver.pressure();
+    const auto& expectedPressure = freshSolver.pressure();
+    pressure.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expectedPressure(i, j, k), pressure(i, j, k), 1e-4);
+    });
+}
@@ -12,6 +12,7 @@
 #include <jet/sphere3.h>
 #include <jet/surface_to_implicit2.h>
 #include <jet/surface_to_implicit3.h>
+#include <jet/volume_grid_emitter3.h>
 #include <gtest/gtest.h>
 
 using namespace jet;
@@ -69,3 +70,160 @@ TEST(LevelSetLiquidSolver3, ComputeVolume) {
 
     EXPECT_NEAR(ans, volume, 0.001);
 }
+
+TEST(LevelSetLiquidSolver3, NarrowBand) {
+    const double dx = 1.0 / 32.0;
+    const double bandWidth = 6.0;
+
+    LevelSetLiquidSolver3 fullSolver;
+    LevelSetLiquidSolver3 bandSolver;
+    bandSolver.setNarrowBandWidth(bandWidth);
+    EXPECT_EQ(bandWidth, bandSolver.narrowBandWidth());
+
+    // Drops the same sphere in both solvers.
+    for (auto solver : {&fullSolver, &bandSolver}) {
+        auto data = solver->gridSystemData();
+        data->resize(Size3(32, 32, 32), Vector3D(dx, dx, dx), Vector3D());
+
+        auto sdf = solver->signedDistanceField();
+        sdf->fill([](const Vector3D& x) {
+            const double sphere = x.distanceTo({0.5, 0.6, 0.5}) - 0.2;
+            return std::min(sphere, x.y - 0.25);
+        });
+    }
+
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 4; ++frame) {
+        fullSolver.update(frame);
+        bandSolver.update(frame);
+    }
+
+    auto fullSdf = fullSolver.signedDistanceField();
+    auto bandSdf = bandSolver.signedDistanceField();
+    const size_t numberOfDataPoints = 32 * 32 * 32;
+    EXPECT_LT(0u, bandSolver.narrowBandDataPoints().size());
+    EXPECT_GT(numberOfDataPoints, bandSolver.narrowBandDataPoints().size());
+
+    double maxDiff = 0.0;
+    bandSdf->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_GE(bandWidth * dx, std::fabs((*bandSdf)(i, j, k)));
+
+        // The interfaces of the two solvers should stay close.
+        if (std::fabs((*fullSdf)(i, j, k)) < 2.0 * dx) {
+            maxDiff = std::max(
+                maxDiff, std::fabs((*fullSdf)(i, j, k) - (*bandSdf)(i, j, k)));
+        }
+    });
+    EXPECT_GT(0.5 * dx, maxDiff);
+    EXPECT_NEAR(fullSolver.computeVolume(), bandSolver.computeVolume(),
+                1e-3);
+}
+
+TEST(LevelSetLiquidSolver3, NarrowBandUpdate) {
+    const double dx = 1.0 / 32.0;
+
+    LevelSetLiquidSolver3 solver;
+    EXPECT_THROW(solver.setNarrowBandWidth(0.5), std::invalid_argument);
+    solver.setNarrowBandWidth(-1.0);
+    EXPECT_EQ(0.0, solver.narrowBandWidth());
+
+    // The band of the first solver grows from the previous one, while the
+    // second one rebuilds the band from the whole grid every frame.
+    LevelSetLiquidSolver3 rebuiltSolver;
+    for (auto s : {&solver, &rebuiltSolver}) {
+        s->setNarrowBandWidth(2.0);
+        s->setIsGlobalCompensationEnabled(true);
+
+        auto data = s->gridSystemData();
+        data->resize(Size3(32, 32, 32), Vector3D(dx, dx, dx), Vector3D());
+
+        auto sdf = s->signedDistanceField();
+        sdf->fill([](const Vector3D& x) {
+            const double sphere = x.distanceTo({0.5, 0.6, 0.5}) - 0.2;
+            return std::min(sphere, x.y - 0.25);
+        });
+    }
+
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 4; ++frame) {
+        solver.update(frame);
+        rebuiltSolver.setNarrowBandWidth(2.0);
+        rebuiltSolver.update(frame);
+
+        EXPECT_EQ(rebuiltSolver.narrowBandDataPoints(),
+                  solver.narrowBandDataPoints());
+    }
+
+    // The band is at least one cell wider than the max CFL number.
+    auto sdf = solver.signedDistanceField();
+    const double width = (std::ceil(solver.maxCfl()) + 1.0) * dx;
+    double maxPhi = 0.0;
+    sdf->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        maxPhi = std::max(maxPhi, std::fabs((*sdf)(i, j, k)));
+    });
+    EXPECT_DOUBLE_EQ(width, maxPhi);
+}
+
+TEST(LevelSetLiquidSolver3, Restart) {
+    auto makeSolver = []() {
+        auto solver = LevelSetLiquidSolver3::builder()
+                          .withResolution({16, 16, 16})
+                          .withDomainSizeX(1.0)
+                          .makeShared();
+        solver->setNarrowBandWidth(4.0);
+
+        auto sphere = Sphere3::builder()
+                          .withCenter({0.5, 0.6, 0.5})
+                          .withRadius(0.2)
+                          .makeShared();
+        auto emitter = VolumeGridEmitter3::builder()
+                           .withSourceRegion(sphere)
+                           .withIsOneShot(true)
+                           .makeShared();
+        emitter->addSignedDistanceTarget(solver->signedDistanceField());
+        solver->setEmitter(emitter);
+        return solver;
+    };
+
+    auto solver = makeSolver();
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 2; ++frame) {
+        solver->update(frame);
+    }
+
+    Checkpoint checkpoint;
+    solver->saveCheckpoint(&checkpoint);
+    const Frame restartFrame = frame;
+
+    for (; frame.index < 4; ++frame) {
+        solver->update(frame);
+    }
+
+    // The emitter targets the grid of the restored solver, so the grids
+    // should be restored in place and the one-shot emitter should not fire
+    // again.
+    auto restored = makeSolver();
+    restored->loadCheckpoint(checkpoint);
+    for (frame = restartFrame; frame.index < 4; ++frame) {
+        restored->update(frame);
+    }
+
+    auto sdf = solver->signedDistanceField();
+    auto restoredSdf = restored->signedDistanceField();
+    sdf->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ((*sdf)(i, j, k), (*restoredSdf)(i, j, k));
+    });
+
+    auto velocity = solver->velocity();
+    auto restoredVelocity = restored->velocity();
+    velocity->forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(velocity->v(i, j, k), restoredVelocity->v(i, j, k));
+    });
+
+    // The grid resolution has to match.
+    auto other = LevelSetLiquidSolver3::builder()
+                     .withResolution({8, 8, 8})
+                     .withDomainSizeX(1.0)
+                     .makeShared();
+    EXPECT_THROW(other->loadCheckpoint(checkpoint), std::invalid_argument);
+}
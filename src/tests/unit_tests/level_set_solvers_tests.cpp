@@ -9,9 +9,11 @@
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/eno_level_set_solver2.h>
 #include <jet/eno_level_set_solver3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
 #include <jet/fdm_utils.h>
 #include <jet/fmm_level_set_solver2.h>
 #include <jet/fmm_level_set_solver3.h>
+#include <jet/parallel.h>
 #include <jet/upwind_level_set_solver2.h>
 #include <jet/upwind_level_set_solver3.h>
 #include <gtest/gtest.h>
@@ -253,3 +255,79 @@ TEST(FmmLevelSetSolver3, Extrapolate) {
         }
     }
 }
+
+TEST(FastSweepingLevelSetSolver3, Reinitialize) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+
+    // Distorted input with the same zero level set
+    sdf.fill([](const Vector3D& x) {
+        return 3.0 * ((x - Vector3D(20, 20, 20)).length() - 8.0);
+    });
+
+    FastSweepingLevelSetSolver3 solver;
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                double expected = sdf(i, j, k) / 3.0;
+                if (std::fabs(expected) < 4.0) {
+                    EXPECT_NEAR(expected, temp(i, j, k), 0.9)
+                        << i << ", " << j << ", " << k;
+                } else if (std::fabs(expected) > 6.0) {
+                    EXPECT_DOUBLE_EQ(sdf(i, j, k), temp(i, j, k))
+                        << i << ", " << j << ", " << k;
+                }
+            }
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver3, Extrapolate) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+    CellCenteredScalarGrid3 field(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+    field.fill([](const Vector3D& x) {
+        return ((x - Vector3D(20, 20, 20)).length() < 8.0) ? 5.0 : 0.0;
+    });
+
+    FastSweepingLevelSetSolver3 solver;
+    solver.extrapolate(field, sdf, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                double expected = (sdf(i, j, k) <= 5.0) ? 5.0 : 0.0;
+                EXPECT_DOUBLE_EQ(expected, temp(i, j, k))
+                    << i << ", " << j << ", " << k;
+            }
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver3, Deterministic) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50);
+    CellCenteredScalarGrid3 temp1(40, 30, 50), temp2(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return std::min((x - Vector3D(20, 20, 20)).length() - 8.0,
+                        x.y - 6.0);
+    });
+
+    FastSweepingLevelSetSolver3 solver;
+
+    const unsigned int numThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(1);
+    solver.reinitialize(sdf, 10.0, &temp1);
+    setMaxNumberOfThreads(std::max(numThreads, 4u));
+    solver.reinitialize(sdf, 10.0, &temp2);
+    setMaxNumberOfThreads(numThreads);
+
+    temp1.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(temp1(i, j, k), temp2(i, j, k))
+            << i << ", " << j << ", " << k;
+    });
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/marching_cubes.h>
+#include <jet/parallel.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+using namespace jet;
+
+namespace {
+
+TriangleMesh3 triangulateSphere(unsigned int numThreads) {
+    VertexCenteredScalarGrid3 grid(40, 40, 40, 1.0 / 40.0, 1.0 / 40.0,
+                                   1.0 / 40.0);
+    grid.fill([](const Vector3D& x) {
+        return x.distanceTo(Vector3D(0.5, 0.5, 0.5)) - 0.3;
+    });
+
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(numThreads);
+
+    TriangleMesh3 mesh;
+    marchingCubes(grid.constDataAccessor(), grid.gridSpacing(), grid.origin(),
+                  &mesh, 0.0, kDirectionNone);
+
+    setMaxNumberOfThreads(prevNumThreads);
+    return mesh;
+}
+
+}  // namespace
+
+TEST(MarchingCubes, Sphere) {
+    TriangleMesh3 mesh = triangulateSphere(maxNumberOfThreads());
+    ASSERT_GT(mesh.numberOfTriangles(), 0u);
+    EXPECT_EQ(mesh.numberOfPoints(), mesh.numberOfNormals());
+    EXPECT_EQ(mesh.numberOfPoints(), mesh.numberOfUvs());
+
+    for (size_t i = 0; i < mesh.numberOfPoints(); ++i) {
+        const Vector3D& p = mesh.point(i);
+        EXPECT_NEAR(0.3, p.distanceTo(Vector3D(0.5, 0.5, 0.5)), 0.01);
+        EXPECT_GT(mesh.normal(i).dot(p - Vector3D(0.5, 0.5, 0.5)), 0.0);
+    }
+
+    // Vertices are welded if every edge is shared by exactly two triangles.
+    std::map<std::pair<size_t, size_t>, int> edges;
+    for (size_t t = 0; t < mesh.numberOfTriangles(); ++t) {
+        const Point3UI& f = mesh.pointIndex(t);
+        for (size_t e = 0; e < 3; ++e) {
+            size_t a = f[e];
+            size_t b = f[(e + 1) % 3];
+            ++edges[std::make_pair(std::min(a, b), std::max(a, b))];
+        }
+    }
+    for (const auto& edge : edges) {
+        EXPECT_EQ(2, edge.second);
+    }
+
+    // Closed surface of genus zero
+    EXPECT_EQ(2, static_cast<int>(mesh.numberOfPoints()) -
+                     static_cast<int>(edges.size()) +
+                     static_cast<int>(mesh.numberOfTriangles()));
+}
+
+TEST(MarchingCubes, Plane) {
+    // The plane crosses all the coarse blocks along x and z.
+    VertexCenteredScalarGrid3 grid(37, 20, 29);
+    grid.fill([](const Vector3D& x) { return x.y - 9.5; });
+
+    TriangleMesh3 mesh;
+    marchingCubes(grid.constDataAccessor(), grid.gridSpacing(), grid.origin(),
+                  &mesh, 0.0, kDirectionNone);
+
+    EXPECT_EQ(38u * 30u, mesh.numberOfPoints());
+    EXPECT_EQ(2u * 37u * 29u, mesh.numberOfTriangles());
+    for (size_t i = 0; i < mesh.numberOfPoints(); ++i) {
+        EXPECT_DOUBLE_EQ(9.5, mesh.point(i).y);
+    }
+}
+
+TEST(MarchingCubes, Deterministic) {
+    TriangleMesh3 serial = triangulateSphere(1);
+    TriangleMesh3 parallel =
+        triangulateSphere(std::max(maxNumberOfThreads(), 4u));
+
+    ASSERT_EQ(serial.numberOfPoints(), parallel.numberOfPoints());
+    ASSERT_EQ(serial.numberOfTriangles(), parallel.numberOfTriangles());
+    for (size_t i = 0; i < serial.numberOfPoints(); ++i) {
+        EXPECT_EQ(serial.point(i), parallel.point(i));
+        EXPECT_EQ(serial.normal(i), parallel.normal(i));
+    }
+    for (size_t i = 0; i < serial.numberOfTriangles(); ++i) {
+        EXPECT_EQ(serial.pointIndex(i), parallel.pointIndex(i));
+    }
+}
@@ -151,3 +151,23 @@ TEST(MathUtils, MonotonicCatmullRom) {
         }
     }
 }
+
+TEST(MathUtils, RoundToFloat) {
+    const double values[] = {0.0,   1.0,    0.1,    -0.1,
+                             1e-50, -1e-50, 3.0e38, -3.0e38};
+    for (double x : values) {
+        EXPECT_LE(static_cast<double>(floorToFloat(x)), x);
+        EXPECT_GE(static_cast<double>(ceilToFloat(x)), x);
+        EXPECT_LE(ceilToFloat(x) - floorToFloat(x),
+                  std::fabs(static_cast<float>(x)) * 1e-6f +
+                      std::numeric_limits<float>::denorm_min());
+    }
+
+    EXPECT_EQ(1.0f, floorToFloat(1.0));
+    EXPECT_EQ(1.0f, ceilToFloat(1.0));
+
+    EXPECT_EQ(std::numeric_limits<float>::max(), floorToFloat(1e300));
+    EXPECT_EQ(std::numeric_limits<float>::infinity(), ceilToFloat(1e300));
+    EXPECT_EQ(-std::numeric_limits<float>::infinity(), floorToFloat(-1e300));
+    EXPECT_EQ(-std::numeric_limits<float>::max(), ceilToFloat(-1e300));
+}
@@ -0,0 +1,225 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/particle_cache3.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+using namespace jet;
+
+namespace {
+
+void buildParticles(size_t n, ParticleSystemData3* particles) {
+    particles->resize(n);
+    particles->setRadius(0.02);
+    particles->setMass(0.5);
+    const size_t temperatureIdx = particles->addScalarData(300.0);
+    const size_t vorticityIdx = particles->addVectorData();
+
+    auto positions = particles->positions();
+    auto velocities = particles->velocities();
+    auto forces = particles->forces();
+    auto temperatures = particles->scalarDataAt(temperatureIdx);
+    auto vorticities = particles->vectorDataAt(vorticityIdx);
+    for (size_t i = 0; i < n; ++i) {
+        const double t = static_cast<double>(i) / n;
+        positions[i] = Vector3D(t, 1.0 - t, 0.5 * t * t);
+        velocities[i] = Vector3D(-t, 2.0, t - 3.0);
+        forces[i] = Vector3D(0.0, -9.8, 0.1 * t);
+        temperatures[i] = 300.0 + 10.0 * t;
+        vorticities[i] = Vector3D(t * t, 0.0, -t);
+    }
+}
+
+std::streamoff fileSize(const std::string& filename) {
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+    return file.tellg();
+}
+
+}  // namespace
+
+TEST(ParticleCache3, WriteAndReadRaw) {
+    const std::string filename = "particle_cache3_tests_raw.pcache";
+
+    ParticleSystemData3 particles;
+    buildParticles(1000, &particles);
+
+    // IDs that the sequential ones would not reproduce.
+    Array1<size_t> ids(1000);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = 1999 - i;
+    }
+    particles.setParticleIds(ids.constAccessor(), 2000);
+
+    ParticleCacheWriter3 writer;
+    EXPECT_EQ(ParticleCacheEncoding::kRaw, writer.encoding());
+    ASSERT_TRUE(writer.write(particles, filename));
+
+    {
+        ParticleCache3 cache(filename);
+        ASSERT_TRUE(cache.isOpen());
+        EXPECT_EQ(1000u, cache.numberOfParticles());
+        EXPECT_EQ(particles.numberOfScalarData(), cache.numberOfScalarData());
+        EXPECT_EQ(particles.numberOfVectorData(), cache.numberOfVectorData());
+        EXPECT_EQ(0.02, cache.radius());
+        EXPECT_EQ(0.5, cache.mass());
+
+        for (size_t i = 0; i < particles.numberOfParticles(); ++i) {
+            EXPECT_EQ(particles.positions()[i], cache.positions()[i]);
+            EXPECT_EQ(particles.velocities()[i], cache.velocities()[i]);
+            EXPECT_EQ(particles.forces()[i], cache.forces()[i]);
+            EXPECT_EQ(particles.scalarDataAt(0)[i], cache.scalarDataAt(0)[i]);
+            EXPECT_EQ(particles.vectorDataAt(3)[i], cache.vectorDataAt(3)[i]);
+            EXPECT_EQ(particles.particleIds()[i], cache.particleIds()[i]);
+        }
+
+        ParticleSystemData3 copied;
+        cache.copyTo(&copied);
+        EXPECT_EQ(1000u, copied.numberOfParticles());
+        EXPECT_EQ(particles.numberOfScalarData(), copied.numberOfScalarData());
+        EXPECT_EQ(particles.numberOfVectorData(), copied.numberOfVectorData());
+        EXPECT_EQ(0.02, copied.radius());
+        EXPECT_EQ(particles.positions()[999], copied.positions()[999]);
+        EXPECT_EQ(particles.vectorDataAt(3)[10], copied.vectorDataAt(3)[10]);
+        EXPECT_EQ(1000u, copied.particleIds()[999]);
+        EXPECT_EQ(2000u, copied.nextParticleId());
+
+        copied.addParticle(Vector3D());
+        EXPECT_EQ(2000u, copied.particleIds()[1000]);
+
+        cache.close();
+        EXPECT_FALSE(cache.isOpen());
+        EXPECT_EQ(0u, cache.numberOfParticles());
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST(ParticleCache3, WriteAndReadQuantized) {
+    const std::string filename = "particle_cache3_tests_quantized.pcache";
+
+    ParticleSystemData3 particles;
+    buildParticles(1000, &particles);
+
+    ParticleCacheWriter3 writer;
+    ASSERT_TRUE(writer.write(particles, filename));
+    const std::streamoff rawSize = fileSize(filename);
+
+    writer.setEncoding(ParticleCacheEncoding::kQuantized16);
+    ASSERT_TRUE(writer.write(particles, filename));
+    EXPECT_GT(rawSize / 2, fileSize(filename));
+
+    {
+        ParticleCache3 cache;
+        ASSERT_TRUE(cache.open(filename));
+        EXPECT_EQ(1000u, cache.numberOfParticles());
+
+        // Each component is within half a quantization step of the range.
+        for (size_t i = 0; i < particles.numberOfParticles(); ++i) {
+            const Vector3D& x = particles.positions()[i];
+            const Vector3D& y = cache.positions()[i];
+            EXPECT_NEAR(x.x, y.x, 1.0 / 131070.0);
+            EXPECT_NEAR(x.y, y.y, 1.0 / 131070.0);
+            EXPECT_NEAR(x.z, y.z, 0.5 / 131070.0);
+            EXPECT_NEAR(particles.scalarDataAt(0)[i], cache.scalarDataAt(0)[i],
+                        10.0 / 131070.0);
+            EXPECT_EQ(particles.forces()[i].y, cache.forces()[i].y);
+            EXPECT_EQ(particles.particleIds()[i], cache.particleIds()[i]);
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST(ParticleCache3, InvalidFile) {
+    const std::string filename = "particle_cache3_tests_invalid.pcache";
+
+    ParticleCache3 cache;
+    EXPECT_FALSE(cache.open("particle_cache3_tests_missing.pcache"));
+    EXPECT_FALSE(cache.isOpen());
+
+    {
+        std::ofstream file(filename.c_str(), std::ios::binary);
+        file << "This is not a particle cache file.";
+    }
+    EXPECT_FALSE(cache.open(filename));
+    EXPECT_FALSE(cache.isOpen());
+
+    // A truncated cache is rejected as well.
+    ParticleSystemData3 particles;
+    buildParticles(100, &particles);
+    ASSERT_TRUE(ParticleCacheWriter3().write(particles, filename));
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+        file.close();
+
+        std::ofstream truncated(filename.c_str(), std::ios::binary);
+        truncated.write(contents.data(), contents.size() / 2);
+    }
+    EXPECT_FALSE(cache.open(filename));
+
+    std::remove(filename.c_str());
+}
+
+TEST(ParticleCache3, MalformedHeader) {
+    const std::string filename = "particle_cache3_tests_malformed.pcache";
+
+    ParticleSystemData3 particles;
+    buildParticles(100, &particles);
+    ASSERT_TRUE(ParticleCacheWriter3().write(particles, filename));
+
+    std::string contents;
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        contents.assign((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    }
+
+    // The channel counts follow the magic, the version and the number of
+    // particles. These counts sum to the valid number of channels in 32-bit
+    // arithmetic, and huge counts should be rejected without allocating.
+    const size_t kScalarCountOffset = 24;
+    const uint32_t counts[][2] = {
+        {0xffffffffu, static_cast<uint32_t>(particles.numberOfVectorData())},
+        {static_cast<uint32_t>(particles.numberOfScalarData()), 0xffffffffu},
+        {1000000u, static_cast<uint32_t>(particles.numberOfVectorData())}};
+    for (const auto& count : counts) {
+        std::string corrupted = contents;
+        std::memcpy(&corrupted[kScalarCountOffset], count, sizeof(count));
+        {
+            std::ofstream file(filename.c_str(), std::ios::binary);
+            file.write(corrupted.data(), corrupted.size());
+        }
+
+        ParticleCache3 cache;
+        EXPECT_FALSE(cache.open(filename));
+        EXPECT_FALSE(cache.isOpen());
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST(ParticleCache3, Empty) {
+    const std::string filename = "particle_cache3_tests_empty.pcache";
+
+    ParticleSystemData3 particles;
+    ASSERT_TRUE(ParticleCacheWriter3().write(particles, filename));
+
+    ParticleCache3 cache;
+    ASSERT_TRUE(cache.open(filename));
+    EXPECT_EQ(0u, cache.numberOfParticles());
+    EXPECT_EQ(0u, cache.positions().size());
+
+    cache.close();
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/particle_neighbor_lists.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+TEST(ParticleNeighborLists, Constructors) {
+    ParticleNeighborLists empty;
+    EXPECT_EQ(0u, empty.size());
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(1u, empty.offsets().size());
+    EXPECT_EQ(0u, empty.indices().size());
+
+    std::vector<std::vector<size_t>> nested = {{1, 2}, {}, {0, 1, 3}, {2}};
+    ParticleNeighborLists lists(nested);
+    EXPECT_EQ(4u, lists.size());
+    EXPECT_EQ(6u, lists.indices().size());
+
+    for (size_t i = 0; i < nested.size(); ++i) {
+        EXPECT_EQ(nested[i].size(), lists.numberOfNeighbors(i));
+        auto neighbors = lists[i];
+        ASSERT_EQ(nested[i].size(), neighbors.size());
+        for (size_t j = 0; j < neighbors.size(); ++j) {
+            EXPECT_EQ(nested[i][j], neighbors[j]);
+        }
+    }
+
+    EXPECT_EQ(nested, lists.toNestedVectors());
+}
+
+TEST(ParticleNeighborLists, Build) {
+    const size_t n = 1000;
+
+    // Each particle i is connected to the particles i % 7 steps before it.
+    ParticleNeighborLists lists;
+    lists.build(n,
+                [](size_t i) { return std::min(i, i % 7); },
+                [](size_t i, size_t* neighbors) {
+                    for (size_t k = 1; k <= std::min(i, i % 7); ++k) {
+                        *(neighbors++) = i - k;
+                    }
+                });
+
+    EXPECT_EQ(n, lists.size());
+    EXPECT_EQ(0u, lists.offsets()[0]);
+    EXPECT_EQ(lists.indices().size(), lists.offsets()[n]);
+
+    for (size_t i = 0; i < n; ++i) {
+        auto neighbors = lists[i];
+        ASSERT_EQ(std::min(i, i % 7), neighbors.size());
+        for (size_t k = 0; k < neighbors.size(); ++k) {
+            EXPECT_EQ(i - k - 1, neighbors[k]);
+        }
+    }
+
+    lists.clear();
+    EXPECT_EQ(0u, lists.size());
+}
@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <vector>
 
 using namespace jet;
@@ -259,3 +260,64 @@ TEST(ParticleSystemData2, Serialization) {
         }
     }
 }
+
+TEST(ParticleSystemData2, SortParticlesSpatially) {
+    ParticleSystemData2 particleSystem;
+    ParticleSystemData2::VectorData positions = {
+        {0.3, 0.5}, {0.6, 0.8}, {0.1, 0.8}, {0.7, 0.9}, {0.3, 0.2},
+        {0.8, 0.3}, {0.8, 0.5}, {0.4, 0.9}, {0.8, 0.6}, {0.2, 0.9},
+        {0.1, 0.2}, {0.6, 0.9}, {0.2, 0.2}, {0.5, 0.6}, {0.8, 0.4},
+        {0.4, 0.2}, {0.2, 0.3}, {0.8, 0.6}, {0.2, 0.8}, {1.0, 0.5}};
+    particleSystem.addParticles(positions);
+
+    size_t a0 = particleSystem.addScalarData();
+    auto scalars = particleSystem.scalarDataAt(a0);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        scalars[i] = static_cast<double>(i);
+        EXPECT_EQ(i, particleSystem.particleIds()[i]);
+    }
+
+    const double radius = 0.4;
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+    auto oldNeighborLists = particleSystem.neighborLists().toNestedVectors();
+
+    Array1<size_t> order;
+    particleSystem.sortParticlesSpatially(0.1, &order);
+    ASSERT_EQ(positions.size(), order.size());
+
+    std::vector<size_t> newIndices(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        newIndices[order[i]] = i;
+    }
+
+    const auto& neighborLists = particleSystem.neighborLists();
+    ASSERT_EQ(positions.size(), neighborLists.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(positions[order[i]], particleSystem.positions()[i]);
+        EXPECT_DOUBLE_EQ(static_cast<double>(order[i]),
+                         particleSystem.scalarDataAt(a0)[i]);
+        EXPECT_EQ(order[i], particleSystem.particleIds()[i]);
+
+        const auto& oldNeighbors = oldNeighborLists[order[i]];
+        auto neighbors = neighborLists[i];
+        ASSERT_EQ(oldNeighbors.size(), neighbors.size());
+        for (size_t j = 0; j < neighbors.size(); ++j) {
+            EXPECT_EQ(newIndices[oldNeighbors[j]], neighbors[j]);
+        }
+    }
+
+    // New particles get new IDs.
+    particleSystem.resize(positions.size() + 1);
+    EXPECT_EQ(positions.size(), particleSystem.particleIds()[positions.size()]);
+
+    // IDs are kept after the serialization.
+    std::vector<uint8_t> buffer;
+    particleSystem.serialize(&buffer);
+    ParticleSystemData2 particleSystem2;
+    particleSystem2.deserialize(buffer);
+    for (size_t i = 0; i < particleSystem.numberOfParticles(); ++i) {
+        EXPECT_EQ(particleSystem.particleIds()[i],
+                  particleSystem2.particleIds()[i]);
+    }
+}
@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <vector>
 
 using namespace jet;
@@ -210,6 +211,45 @@ TEST(ParticleSystemData3, BuildNeighborLists) {
     }
 }
 
+TEST(ParticleSystemData3, CopyDataFrom) {
+    ParticleSystemData3 particleSystem;
+    particleSystem.setRadius(0.1);
+    ParticleSystemData3::VectorData positions = {
+        {0.7, 0.2, 0.2}, {0.7, 0.8, 1.0}, {0.9, 0.4, 0.0}};
+    particleSystem.addParticles(positions);
+    const size_t scalarIdx = particleSystem.addScalarData(4.0);
+    particleSystem.buildNeighborSearcher(1.0);
+    particleSystem.buildNeighborLists(1.0);
+
+    ParticleSystemData3 snapshot(10);
+    snapshot.addScalarData();
+    snapshot.addScalarData();
+    snapshot.buildNeighborLists(1.0);
+
+    snapshot.copyDataFrom(particleSystem);
+    EXPECT_EQ(3u, snapshot.numberOfParticles());
+    EXPECT_EQ(1u, snapshot.numberOfScalarData());
+    EXPECT_EQ(3u, snapshot.numberOfVectorData());
+    EXPECT_EQ(0.1, snapshot.radius());
+    EXPECT_EQ(4.0, snapshot.scalarDataAt(scalarIdx)[2]);
+    EXPECT_EQ(Vector3D(0.9, 0.4, 0.0), snapshot.positions()[2]);
+    EXPECT_EQ(particleSystem.particleIds()[2], snapshot.particleIds()[2]);
+    EXPECT_EQ(0u, snapshot.neighborLists().size());
+
+    // The storage is reused when the sizes match.
+    const Vector3D* data = snapshot.positions().data();
+    particleSystem.positions()[0] = Vector3D(1, 2, 3);
+    snapshot.copyDataFrom(particleSystem);
+    EXPECT_EQ(data, snapshot.positions().data());
+    EXPECT_EQ(Vector3D(1, 2, 3), snapshot.positions()[0]);
+
+    // New particles continue the IDs of the source.
+    ParticleSystemData3::VectorData newPositions = {{0.0, 0.0, 0.0}};
+    snapshot.addParticles(newPositions);
+    particleSystem.addParticles(newPositions);
+    EXPECT_EQ(particleSystem.particleIds()[3], snapshot.particleIds()[3]);
+}
+
 TEST(ParticleSystemData3, Serialization) {
     ParticleSystemData3 particleSystem;
 
@@ -267,3 +307,65 @@ TEST(ParticleSystemData3, Serialization) {
         }
     }
 }
+
+TEST(ParticleSystemData3, SortParticlesSpatially) {
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions = {
+        {0.7, 0.2, 0.2}, {0.7, 0.8, 1.0}, {0.9, 0.4, 0.0}, {0.5, 0.1, 0.6},
+        {0.6, 0.3, 0.8}, {0.1, 0.6, 0.0}, {0.5, 1.0, 0.2}, {0.6, 0.7, 0.8},
+        {0.2, 0.4, 0.7}, {0.8, 0.5, 0.8}, {0.0, 0.8, 0.4}, {0.3, 0.0, 0.6},
+        {0.7, 0.8, 0.3}, {0.0, 0.7, 0.1}, {0.6, 0.3, 0.8}, {0.3, 0.2, 1.0},
+        {0.3, 0.5, 0.6}, {0.3, 0.9, 0.6}, {0.9, 1.0, 1.0}, {0.0, 0.1, 0.6}};
+    particleSystem.addParticles(positions);
+
+    size_t a0 = particleSystem.addScalarData();
+    auto scalars = particleSystem.scalarDataAt(a0);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        scalars[i] = static_cast<double>(i);
+        EXPECT_EQ(i, particleSystem.particleIds()[i]);
+    }
+
+    const double radius = 0.4;
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+    auto oldNeighborLists = particleSystem.neighborLists().toNestedVectors();
+
+    Array1<size_t> order;
+    particleSystem.sortParticlesSpatially(0.1, &order);
+    ASSERT_EQ(positions.size(), order.size());
+
+    std::vector<size_t> newIndices(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        newIndices[order[i]] = i;
+    }
+
+    const auto& neighborLists = particleSystem.neighborLists();
+    ASSERT_EQ(positions.size(), neighborLists.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(positions[order[i]], particleSystem.positions()[i]);
+        EXPECT_DOUBLE_EQ(static_cast<double>(order[i]),
+                         particleSystem.scalarDataAt(a0)[i]);
+        EXPECT_EQ(order[i], particleSystem.particleIds()[i]);
+
+        const auto& oldNeighbors = oldNeighborLists[order[i]];
+        auto neighbors = neighborLists[i];
+        ASSERT_EQ(oldNeighbors.size(), neighbors.size());
+        for (size_t j = 0; j < neighbors.size(); ++j) {
+            EXPECT_EQ(newIndices[oldNeighbors[j]], neighbors[j]);
+        }
+    }
+
+    // New particles get new IDs.
+    particleSystem.resize(positions.size() + 1);
+    EXPECT_EQ(positions.size(), particleSystem.particleIds()[positions.size()]);
+
+    // IDs are kept after the serialization.
+    std::vector<uint8_t> buffer;
+    particleSystem.serialize(&buffer);
+    ParticleSystemData3 particleSystem2;
+    particleSystem2.deserialize(buffer);
+    for (size_t i = 0; i < particleSystem.numberOfParticles(); ++i) {
+        EXPECT_EQ(particleSystem.particleIds()[i],
+                  particleSystem2.particleIds()[i]);
+    }
+}
@@ -4,9 +4,13 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/parallel.h>
 #include <jet/pic_solver3.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 using namespace jet;
 
 TEST(PicSolver3, UpdateEmpty) {
@@ -16,3 +20,54 @@ TEST(PicSolver3, UpdateEmpty) {
         solver.update(frame);
     }
 }
+
+namespace {
+
+class PicSolver3Tester : public PicSolver3 {
+ public:
+    PicSolver3Tester()
+    : PicSolver3({8, 8, 8}, {0.125, 0.125, 0.125}, {0.0, 0.0, 0.0}) {
+    }
+
+    void transfer() { transferFromParticlesToGrids(); }
+};
+
+}  // namespace
+
+TEST(PicSolver3, DeterministicTransfer) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.1, 1.1);
+
+    PicSolver3Tester solver;
+    auto particles = solver.particleSystemData();
+    Array1<Vector3D> positions(1000);
+    Array1<Vector3D> velocities(1000);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector3D(d(rng), d(rng), d(rng));
+        velocities[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+    particles->addParticles(positions, velocities);
+
+    auto transfer = [&](unsigned int numThreads) {
+        setMaxNumberOfThreads(numThreads);
+        solver.transfer();
+        FaceCenteredGrid3 result;
+        result.set(*solver.gridSystemData()->velocity());
+        return result;
+    };
+
+    const unsigned int numThreads = maxNumberOfThreads();
+    FaceCenteredGrid3 serial = transfer(1);
+    FaceCenteredGrid3 parallel = transfer(std::max(numThreads, 4u));
+    setMaxNumberOfThreads(numThreads);
+
+    serial.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(serial.u(i, j, k), parallel.u(i, j, k));
+    });
+    serial.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(serial.v(i, j, k), parallel.v(i, j, k));
+    });
+    serial.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(serial.w(i, j, k), parallel.w(i, j, k));
+    });
+}
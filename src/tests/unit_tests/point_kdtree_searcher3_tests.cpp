@@ -12,6 +12,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
 using namespace jet;
@@ -49,6 +51,50 @@ TEST(PointKdTreeSearcher3, ForEachNearbyPointEmpty) {
                                 [](size_t, const Vector3D&) {});
 }
 
+TEST(PointKdTreeSearcher3, FindNearbyPoints) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    Array1<Vector3D> points(300);
+    Array1<Vector3D> origins(50);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+    for (size_t i = 0; i < origins.size(); ++i) {
+        origins[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+
+    const double radius = 0.2;
+    PointKdTreeSearcher3 searcher;
+    searcher.build(points.accessor());
+
+    ParticleNeighborLists lists;
+    std::vector<double> distancesSquared;
+    searcher.findNearbyPoints(origins.constAccessor(), radius, &lists,
+                              &distancesSquared);
+    ASSERT_EQ(origins.size(), lists.size());
+    ASSERT_EQ(lists.indices().size(), distancesSquared.size());
+
+    for (size_t i = 0; i < origins.size(); ++i) {
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < points.size(); ++j) {
+            if (origins[i].distanceSquaredTo(points[j]) <= radius * radius) {
+                expected.push_back(j);
+            }
+        }
+
+        auto neighbors = lists[i];
+        std::vector<size_t> actual(neighbors.begin(), neighbors.end());
+        for (size_t k = 0; k < neighbors.size(); ++k) {
+            EXPECT_DOUBLE_EQ(
+                origins[i].distanceSquaredTo(points[neighbors[k]]),
+                distancesSquared[lists.offsets()[i] + k]);
+        }
+
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(expected, actual);
+    }
+}
+
 TEST(PointKdTreeSearcher3, CopyConstructor) {
     Array1<Vector3D> points = {Vector3D(0, 1, 3), Vector3D(2, 5, 4),
                                Vector3D(-1, 3, 0)};
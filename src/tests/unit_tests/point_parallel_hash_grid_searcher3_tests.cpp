@@ -7,6 +7,8 @@
 #include <jet/array1.h>
 #include <jet/point_parallel_hash_grid_searcher3.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include <vector>
 
 using namespace jet;
@@ -52,6 +54,85 @@ TEST(PointParallelHashGridSearcher3, ForEachNearbyPointEmpty) {
         });
 }
 
+TEST(PointParallelHashGridSearcher3, FindNearbyPoints) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    Array1<Vector3D> points(300);
+    Array1<Vector3D> origins(50);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+    for (size_t i = 0; i < origins.size(); ++i) {
+        origins[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+
+    const double radius = 0.2;
+    PointParallelHashGridSearcher3 searcher(8, 8, 8, 2.0 * radius);
+    searcher.build(points.accessor());
+
+    ParticleNeighborLists lists;
+    std::vector<double> distancesSquared;
+    searcher.findNearbyPoints(origins.constAccessor(), radius, &lists,
+                              &distancesSquared);
+    ASSERT_EQ(origins.size(), lists.size());
+    ASSERT_EQ(lists.indices().size(), distancesSquared.size());
+
+    for (size_t i = 0; i < origins.size(); ++i) {
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < points.size(); ++j) {
+            if (origins[i].distanceSquaredTo(points[j]) <= radius * radius) {
+                expected.push_back(j);
+            }
+        }
+
+        auto neighbors = lists[i];
+        std::vector<size_t> actual(neighbors.begin(), neighbors.end());
+        for (size_t k = 0; k < neighbors.size(); ++k) {
+            EXPECT_DOUBLE_EQ(
+                origins[i].distanceSquaredTo(points[neighbors[k]]),
+                distancesSquared[lists.offsets()[i] + k]);
+        }
+
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+TEST(PointParallelHashGridSearcher3, FindNearbyPointsWithBuffers) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    Array1<Vector3D> points(300);
+    Array1<Vector3D> origins(1000);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+    for (size_t i = 0; i < origins.size(); ++i) {
+        origins[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+
+    const double radius = 0.2;
+    PointParallelHashGridSearcher3 searcher(8, 8, 8, 2.0 * radius);
+    searcher.build(points.accessor());
+
+    // Reuse the buffers for a query with fewer chunks of origins.
+    PointNeighborSearcher3::NearbyPointBuffers buffers;
+    ParticleNeighborLists lists;
+    std::vector<double> distancesSquared;
+    for (size_t n : {origins.size(), size_t(300)}) {
+        ConstArrayAccessor1<Vector3D> queries(n, origins.data());
+        searcher.findNearbyPoints(queries, radius, &lists, &distancesSquared,
+                                  &buffers);
+
+        ParticleNeighborLists expectedLists;
+        std::vector<double> expectedDistancesSquared;
+        searcher.findNearbyPoints(queries, radius, &expectedLists,
+                                  &expectedDistancesSquared);
+
+        EXPECT_EQ(expectedLists.toNestedVectors(), lists.toNestedVectors());
+        EXPECT_EQ(expectedDistancesSquared, distancesSquared);
+    }
+}
+
 TEST(PointParallelHashGridSearcher3, CopyConstructor) {
     Array1<Vector3D> points = {
         Vector3D(0, 1, 3),
@@ -81,6 +162,121 @@ TEST(PointParallelHashGridSearcher3, CopyConstructor) {
     EXPECT_EQ(2, cnt);
 }
 
+TEST(PointParallelHashGridSearcher3, Rebuild) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    Array1<Vector3D> points(1000);
+    points.forEachIndex([&](size_t i) {
+        points[i] = Vector3D(d(rng), d(rng), d(rng));
+    });
+
+    PointParallelHashGridSearcher3 searcher(8, 8, 8, 0.125);
+    searcher.build(points.accessor());
+
+    // Move the points and rebuild the same searcher
+    std::uniform_real_distribution<> jitter(-0.05, 0.05);
+    points.forEachIndex([&](size_t i) {
+        points[i] += Vector3D(jitter(rng), jitter(rng), jitter(rng));
+    });
+    searcher.build(points.accessor());
+
+    PointParallelHashGridSearcher3 fresh(8, 8, 8, 0.125);
+    fresh.build(points.accessor());
+
+    EXPECT_EQ(fresh.keys(), searcher.keys());
+    EXPECT_EQ(fresh.startIndexTable(), searcher.startIndexTable());
+    EXPECT_EQ(fresh.endIndexTable(), searcher.endIndexTable());
+
+    const auto& sortedIndices = searcher.sortedIndices();
+    std::vector<bool> visited(points.size(), false);
+    for (size_t i = 0; i < sortedIndices.size(); ++i) {
+        EXPECT_FALSE(visited[sortedIndices[i]]);
+        visited[sortedIndices[i]] = true;
+    }
+
+    for (size_t i = 0; i < points.size(); i += 10) {
+        std::vector<size_t> expected, actual;
+        fresh.forEachNearbyPoint(points[i], 0.0625,
+                                 [&](size_t j, const Vector3D&) {
+                                     expected.push_back(j);
+                                 });
+        searcher.forEachNearbyPoint(points[i], 0.0625,
+                                    [&](size_t j, const Vector3D&) {
+                                        actual.push_back(j);
+                                    });
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(expected, actual);
+    }
+
+    // Rebuilding with fewer points keeps the order of the remaining points
+    std::vector<size_t> expectedIndices;
+    for (size_t i : searcher.sortedIndices()) {
+        if (i < 10) {
+            expectedIndices.push_back(i);
+        }
+    }
+    points.resize(10);
+    searcher.build(points.accessor());
+    EXPECT_EQ(expectedIndices, searcher.sortedIndices());
+}
+
+TEST(PointParallelHashGridSearcher3, RebuildWithMorePoints) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    Array1<Vector3D> points(20000);
+    points.forEachIndex([&](size_t i) {
+        points[i] = Vector3D(d(rng), d(rng), d(rng));
+    });
+
+    PointParallelHashGridSearcher3 searcher(8, 8, 8, 0.125);
+    searcher.build(points.accessor());
+    const std::vector<size_t> oldSortedIndices = searcher.sortedIndices();
+
+    // Add more points, and move all of them before rebuilding
+    points.resize(30000);
+    points.forEachIndex([&](size_t i) {
+        if (i >= 20000) {
+            points[i] = Vector3D(d(rng), d(rng), d(rng));
+        }
+    });
+    std::uniform_real_distribution<> jitter(-0.05, 0.05);
+    points.forEachIndex([&](size_t i) {
+        points[i] += Vector3D(jitter(rng), jitter(rng), jitter(rng));
+    });
+    searcher.build(points.accessor());
+
+    PointParallelHashGridSearcher3 fresh(8, 8, 8, 0.125);
+    fresh.build(points.accessor());
+
+    EXPECT_EQ(fresh.keys(), searcher.keys());
+    EXPECT_EQ(fresh.startIndexTable(), searcher.startIndexTable());
+    EXPECT_EQ(fresh.endIndexTable(), searcher.endIndexTable());
+
+    // The sort is stable, so the points within a bucket keep the previous
+    // order, and the new points come after them.
+    const auto& keys = searcher.keys();
+    const auto& sortedIndices = searcher.sortedIndices();
+    std::vector<size_t> oldRank(20000);
+    for (size_t i = 0; i < oldSortedIndices.size(); ++i) {
+        oldRank[oldSortedIndices[i]] = i;
+    }
+    for (size_t i = 1; i < sortedIndices.size(); ++i) {
+        if (keys[i] != keys[i - 1]) {
+            continue;
+        }
+        const size_t prev = sortedIndices[i - 1];
+        const size_t cur = sortedIndices[i];
+        if (prev < 20000 && cur < 20000) {
+            EXPECT_LT(oldRank[prev], oldRank[cur]);
+        } else {
+            EXPECT_TRUE(cur >= 20000 && (prev < 20000 || prev < cur));
+        }
+    }
+}
+
 TEST(PointParallelHashGridSearcher3, Serialization) {
     Array1<Vector3D> points = {
         Vector3D(0, 1, 3),
@@ -7,6 +7,8 @@
 #include <jet/array1.h>
 #include <jet/point_simple_list_searcher3.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include <vector>
 
 using namespace jet;
@@ -40,6 +42,50 @@ TEST(PointSimpleListSearcher3, ForEachNearbyPoint) {
     EXPECT_EQ(2, cnt);
 }
 
+TEST(PointSimpleListSearcher3, FindNearbyPoints) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    Array1<Vector3D> points(300);
+    Array1<Vector3D> origins(50);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+    for (size_t i = 0; i < origins.size(); ++i) {
+        origins[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+
+    const double radius = 0.2;
+    PointSimpleListSearcher3 searcher;
+    searcher.build(points.accessor());
+
+    ParticleNeighborLists lists;
+    std::vector<double> distancesSquared;
+    searcher.findNearbyPoints(origins.constAccessor(), radius, &lists,
+                              &distancesSquared);
+    ASSERT_EQ(origins.size(), lists.size());
+    ASSERT_EQ(lists.indices().size(), distancesSquared.size());
+
+    for (size_t i = 0; i < origins.size(); ++i) {
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < points.size(); ++j) {
+            if (origins[i].distanceSquaredTo(points[j]) <= radius * radius) {
+                expected.push_back(j);
+            }
+        }
+
+        auto neighbors = lists[i];
+        std::vector<size_t> actual(neighbors.begin(), neighbors.end());
+        for (size_t k = 0; k < neighbors.size(); ++k) {
+            EXPECT_DOUBLE_EQ(
+                origins[i].distanceSquaredTo(points[neighbors[k]]),
+                distancesSquared[lists.offsets()[i] + k]);
+        }
+
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(expected, actual);
+    }
+}
+
 TEST(PointSimpleListSearcher3, CopyConstructor) {
     Array1<Vector3D> points = {
         Vector3D(0, 1, 3),
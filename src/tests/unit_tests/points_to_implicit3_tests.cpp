@@ -0,0 +1,102 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/fast_sweeping_level_set_solver3.h>
+#include <jet/sph_points_to_implicit3.h>
+#include <jet/spherical_points_to_implicit3.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace jet;
+
+namespace {
+
+Array1<Vector3D> makeSplash() {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.4, 0.6);
+
+    Array1<Vector3D> points(500);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = Vector3D(d(rng), 0.5 * d(rng), d(rng));
+    }
+    return points;
+}
+
+}  // namespace
+
+TEST(PointsToImplicit3, NarrowBandEvaluation) {
+    Array1<Vector3D> points = makeSplash();
+
+    SphPointsToImplicit3 converter(0.05, 0.5, false);
+    EXPECT_FALSE(converter.isNarrowBandEnabled());
+
+    VertexCenteredScalarGrid3 dense(40, 40, 40, 0.025, 0.025, 0.025);
+    converter.convert(points, &dense);
+
+    converter.setIsNarrowBandEnabled(true);
+    EXPECT_TRUE(converter.isNarrowBandEnabled());
+
+    VertexCenteredScalarGrid3 band(40, 40, 40, 0.025, 0.025, 0.025);
+    converter.convert(points, &band);
+
+    dense.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(dense(i, j, k), band(i, j, k));
+    });
+}
+
+TEST(PointsToImplicit3, NarrowBandSdf) {
+    Array1<Vector3D> points = makeSplash();
+    const double radius = 0.05;
+
+    SphericalPointsToImplicit3 converter(radius, true);
+
+    VertexCenteredScalarGrid3 dense(40, 40, 40, 0.025, 0.025, 0.025);
+    converter.convert(points, &dense);
+
+    converter.setIsNarrowBandEnabled(true);
+    VertexCenteredScalarGrid3 band(40, 40, 40, 0.025, 0.025, 0.025);
+    converter.convert(points, &band);
+
+    // Distances are exact well within the band, and clamped to the band
+    // width near and beyond its boundary where the marching stops.
+    const double bandWidth = 2.0 * radius;
+    dense.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (std::fabs(dense(i, j, k)) < 0.5 * bandWidth) {
+            EXPECT_DOUBLE_EQ(dense(i, j, k), band(i, j, k));
+        } else {
+            EXPECT_EQ(dense(i, j, k) > 0.0, band(i, j, k) > 0.0);
+            EXPECT_LE(std::fabs(band(i, j, k)), bandWidth);
+        }
+    });
+}
+
+TEST(PointsToImplicit3, FastSweepingSdf) {
+    Array1<Vector3D> points = makeSplash();
+    const double radius = 0.05;
+
+    SphericalPointsToImplicit3 converter(radius, true);
+    converter.setIsNarrowBandEnabled(true);
+    EXPECT_EQ(nullptr, converter.levelSetSolver());
+
+    VertexCenteredScalarGrid3 fmm(40, 40, 40, 0.025, 0.025, 0.025);
+    converter.convert(points, &fmm);
+
+    auto solver = std::make_shared<FastSweepingLevelSetSolver3>();
+    converter.setLevelSetSolver(solver);
+    EXPECT_EQ(solver, converter.levelSetSolver());
+
+    VertexCenteredScalarGrid3 sweeping(40, 40, 40, 0.025, 0.025, 0.025);
+    converter.convert(points, &sweeping);
+
+    // Both solvers discretize the same eikonal equation, so they only differ
+    // by the discretization error.
+    fmm.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(fmm(i, j, k), sweeping(i, j, k), 0.025);
+    });
+}
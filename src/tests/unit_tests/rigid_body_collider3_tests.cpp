@@ -6,6 +6,7 @@
 
 #include <jet/rigid_body_collider3.h>
 #include <jet/plane3.h>
+#include <jet/sphere3.h>
 #include <gtest/gtest.h>
 
 using namespace jet;
@@ -145,3 +146,50 @@ TEST(RigidBodyCollider3, VelocityAt) {
     EXPECT_DOUBLE_EQ(27.0, result.y);
     EXPECT_DOUBLE_EQ(-2.0, result.z);
 }
+
+TEST(RigidBodyCollider3, SdfCache) {
+    auto sphere = std::make_shared<Sphere3>(Vector3D(0.1, 0, 0), 0.5);
+    RigidBodyCollider3 exact(sphere);
+
+    auto collider = RigidBodyCollider3::builder()
+                        .withSurface(sphere)
+                        .withSdfCacheGridSpacing(0.02)
+                        .makeShared();
+    EXPECT_DOUBLE_EQ(0.02, collider->sdfCacheGridSpacing());
+
+    // The cache is baked in the local frame, so moving the body does not
+    // require rebaking.
+    sphere->transform.setTranslation({1, -2, 0.5});
+    sphere->transform.setOrientation(QuaternionD({0, 1, 1}, 0.7));
+
+    // Points near the surface are within the cached region.
+    for (int n = 0; n < 100; ++n) {
+        const double t = static_cast<double>(n);
+        const Vector3D dir = Vector3D(std::sin(t), std::cos(1.3 * t),
+                                      std::sin(0.7 * t)).normalized();
+        const double r = 0.5 + 0.07 * std::cos(2.1 * t);
+        const Vector3D pt =
+            sphere->transform.toWorld(Vector3D(0.1, 0, 0) + r * dir);
+        EXPECT_NEAR(exact.signedDistance(pt), collider->signedDistance(pt),
+                    0.005);
+    }
+
+    // Far points get the distance to the cached region added.
+    const Vector3D farPoint(10, -2, 0.5);
+    EXPECT_NEAR(exact.signedDistance(farPoint),
+                collider->signedDistance(farPoint), 0.2);
+    EXPECT_LE(exact.signedDistance(farPoint),
+              collider->signedDistance(farPoint) + 0.01);
+
+    // Collision with the cached field
+    Vector3D newPosition = sphere->transform.toWorld({0.1, 0.4, 0});
+    Vector3D newVelocity(0, -1, 0);
+    collider->resolveCollision(0.05, 0.0, &newPosition, &newVelocity);
+    EXPECT_NEAR(0.55, sphere->transform.toLocal(newPosition).distanceTo(
+                          Vector3D(0.1, 0, 0)),
+                0.01);
+
+    collider->setSdfCacheGridSpacing(0.0);
+    EXPECT_DOUBLE_EQ(exact.signedDistance(farPoint),
+                     collider->signedDistance(farPoint));
+}
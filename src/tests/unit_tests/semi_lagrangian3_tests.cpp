@@ -0,0 +1,164 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/cell_centered_vector_grid3.h>
+#include <jet/cubic_semi_lagrangian3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/semi_lagrangian3.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+const Size3 kResolution(16, 12, 10);
+const Vector3D kGridSpacing(0.1, 0.1, 0.1);
+
+double scalarFunc(const Vector3D& x) {
+    return std::sin(3.0 * x.x) * std::cos(2.0 * x.y) + x.z;
+}
+
+Vector3D vectorFunc(const Vector3D& x) {
+    return Vector3D(std::sin(2.0 * x.y), x.z * x.x, std::cos(3.0 * x.x));
+}
+
+Vector3D flowFunc(const Vector3D& x) {
+    return Vector3D(0.5 - x.y, x.x - 0.5, 0.3 * x.z);
+}
+
+void expectSameData(const ScalarGrid3& a, const ScalarGrid3& b) {
+    a.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(a(i, j, k), b(i, j, k));
+    });
+}
+
+void expectSameData(const CollocatedVectorGrid3& a,
+                    const CollocatedVectorGrid3& b) {
+    a.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(a(i, j, k).x, b(i, j, k).x);
+        EXPECT_DOUBLE_EQ(a(i, j, k).y, b(i, j, k).y);
+        EXPECT_DOUBLE_EQ(a(i, j, k).z, b(i, j, k).z);
+    });
+}
+
+void testBatchedAdvection(AdvectionSolver3* solver) {
+    FaceCenteredGrid3 flow(kResolution, kGridSpacing);
+    flow.fill(flowFunc);
+    const double dt = 0.2;
+
+    // Scalar grids with two different data layouts.
+    CellCenteredScalarGrid3 scalar0(kResolution, kGridSpacing);
+    CellCenteredScalarGrid3 scalar1(kResolution, kGridSpacing);
+    VertexCenteredScalarGrid3 scalar2(kResolution, kGridSpacing);
+    scalar0.fill(scalarFunc);
+    scalar1.fill([](const Vector3D& x) { return 2.0 - scalarFunc(x); });
+    scalar2.fill(scalarFunc);
+
+    std::vector<CellCenteredScalarGrid3> cellAnswers(2, scalar0);
+    VertexCenteredScalarGrid3 vertexAnswer(scalar2);
+    solver->advect(scalar0, flow, dt, &cellAnswers[0]);
+    solver->advect(scalar1, flow, dt, &cellAnswers[1]);
+    solver->advect(scalar2, flow, dt, &vertexAnswer);
+
+    CellCenteredScalarGrid3 out0(scalar0), out1(scalar1);
+    VertexCenteredScalarGrid3 out2(scalar2);
+    solver->advect(std::vector<const ScalarGrid3*>{&scalar0, &scalar2,
+                                                   &scalar1},
+                   flow, dt,
+                   std::vector<ScalarGrid3*>{&out0, &out2, &out1});
+    expectSameData(cellAnswers[0], out0);
+    expectSameData(cellAnswers[1], out1);
+    expectSameData(vertexAnswer, out2);
+
+    // Collocated vector grids.
+    CellCenteredVectorGrid3 vector0(kResolution, kGridSpacing);
+    CellCenteredVectorGrid3 vector1(kResolution, kGridSpacing);
+    vector0.fill(vectorFunc);
+    vector1.fill(flowFunc);
+
+    CellCenteredVectorGrid3 vectorAnswer0(vector0), vectorAnswer1(vector1);
+    solver->advect(vector0, flow, dt, &vectorAnswer0);
+    solver->advect(vector1, flow, dt, &vectorAnswer1);
+
+    CellCenteredVectorGrid3 vectorOut0(vector0), vectorOut1(vector1);
+    solver->advect(
+        std::vector<const CollocatedVectorGrid3*>{&vector0, &vector1}, flow,
+        dt, std::vector<CollocatedVectorGrid3*>{&vectorOut0, &vectorOut1});
+    expectSameData(vectorAnswer0, vectorOut0);
+    expectSameData(vectorAnswer1, vectorOut1);
+
+    // Face-centered grids, including the flow itself.
+    FaceCenteredGrid3 face0(kResolution, kGridSpacing);
+    face0.fill(vectorFunc);
+
+    FaceCenteredGrid3 faceAnswer0(face0), flowAnswer(flow);
+    solver->advect(face0, flow, dt, &faceAnswer0);
+    solver->advect(flow, flow, dt, &flowAnswer);
+
+    FaceCenteredGrid3 faceOut0(face0), flowOut(flow);
+    solver->advect(std::vector<const FaceCenteredGrid3*>{&flow, &face0}, flow,
+                   dt, std::vector<FaceCenteredGrid3*>{&flowOut, &faceOut0});
+    faceAnswer0.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(faceAnswer0.u(i, j, k), faceOut0.u(i, j, k));
+        EXPECT_DOUBLE_EQ(flowAnswer.u(i, j, k), flowOut.u(i, j, k));
+    });
+    faceAnswer0.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(faceAnswer0.v(i, j, k), faceOut0.v(i, j, k));
+        EXPECT_DOUBLE_EQ(flowAnswer.v(i, j, k), flowOut.v(i, j, k));
+    });
+    faceAnswer0.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(faceAnswer0.w(i, j, k), faceOut0.w(i, j, k));
+        EXPECT_DOUBLE_EQ(flowAnswer.w(i, j, k), flowOut.w(i, j, k));
+    });
+}
+
+}  // namespace
+
+TEST(SemiLagrangian3, BatchedAdvect) {
+    SemiLagrangian3 solver;
+    testBatchedAdvection(&solver);
+}
+
+TEST(CubicSemiLagrangian3, BatchedAdvect) {
+    CubicSemiLagrangian3 solver;
+    testBatchedAdvection(&solver);
+}
+
+TEST(SemiLagrangian3, AdvectDataPoints) {
+    FaceCenteredGrid3 flow(kResolution, kGridSpacing);
+    flow.fill(flowFunc);
+
+    CellCenteredScalarGrid3 input(kResolution, kGridSpacing);
+    input.fill(scalarFunc);
+
+    CellCenteredScalarGrid3 answer(input);
+    SemiLagrangian3 solver;
+    solver.advect(input, flow, 0.2, &answer);
+
+    std::vector<Point3UI> dataPoints;
+    input.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if ((i + j + k) % 3 == 0) {
+            dataPoints.emplace_back(i, j, k);
+        }
+    });
+
+    CellCenteredScalarGrid3 output(kResolution, kGridSpacing);
+    output.fill(-1.0);
+    solver.advectDataPoints(input, flow, 0.2, dataPoints, &output);
+    output.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if ((i + j + k) % 3 == 0) {
+            EXPECT_DOUBLE_EQ(answer(i, j, k), output(i, j, k));
+        } else {
+            EXPECT_EQ(-1.0, output(i, j, k));
+        }
+    });
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/soa_vector_array3.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace jet;
+
+TEST(SoaVectorArray3, Constructors) {
+    SoaVectorArray3 empty;
+    EXPECT_EQ(0u, empty.size());
+
+    SoaVectorArray3 arr(5);
+    EXPECT_EQ(5u, arr.size());
+    for (size_t i = 0; i < arr.size(); ++i) {
+        EXPECT_EQ(Vector3D(), arr[i]);
+    }
+
+    arr.set(3, Vector3D(1, 2, 3));
+    SoaVectorArray3 arr2(arr);
+    EXPECT_EQ(5u, arr2.size());
+    EXPECT_EQ(Vector3D(1, 2, 3), arr2[3]);
+
+    SoaVectorArray3 arr3(std::move(arr2));
+    EXPECT_EQ(5u, arr3.size());
+    EXPECT_EQ(Vector3D(1, 2, 3), arr3[3]);
+}
+
+TEST(SoaVectorArray3, Resize) {
+    SoaVectorArray3 arr;
+    for (size_t size : {1u, 7u, 8u, 33u, 4u}) {
+        const size_t oldSize = arr.size();
+        arr.resize(size);
+        EXPECT_EQ(size, arr.size());
+
+        // Each channel is aligned for SIMD loads.
+        for (const double* channel : {arr.x(), arr.y(), arr.z()}) {
+            EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(channel) %
+                              SoaVectorArray3::kAlignment);
+        }
+
+        // The existing vectors are kept.
+        for (size_t i = 0; i < std::min(oldSize, size); ++i) {
+            EXPECT_EQ(Vector3D(i, 2.0 * i, 3.0 * i), arr[i]);
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            arr.set(i, Vector3D(i, 2.0 * i, 3.0 * i));
+        }
+    }
+}
+
+TEST(SoaVectorArray3, CopyFromAndTo) {
+    Array1<Vector3D> input(100);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = Vector3D(0.5 * i, -1.0 * i, 0.25 + i);
+    }
+
+    SoaVectorArray3 arr;
+    arr.copyFrom(input.constAccessor());
+    ASSERT_EQ(input.size(), arr.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        EXPECT_EQ(input[i].x, arr.x()[i]);
+        EXPECT_EQ(input[i].y, arr.y()[i]);
+        EXPECT_EQ(input[i].z, arr.z()[i]);
+    }
+
+    Array1<Vector3D> output(input.size());
+    arr.copyTo(output.accessor());
+    for (size_t i = 0; i < input.size(); ++i) {
+        EXPECT_EQ(input[i], output[i]);
+    }
+
+}
@@ -4,9 +4,18 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/box3.h>
+#include <jet/particle_emitter_set3.h>
+#include <jet/point_particle_emitter3.h>
+#include <jet/rigid_body_collider3.h>
+#include <jet/sph_kernels3.h>
 #include <jet/sph_solver3.h>
+#include <jet/volume_particle_emitter3.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 using namespace jet;
 
 TEST(SphSolver3, UpdateEmpty) {
@@ -61,3 +70,157 @@ TEST(SphSolver3, Parameters) {
 
     EXPECT_TRUE(solver.sphSystemData() != nullptr);
 }
+
+namespace {
+
+class SphSolver3ForTest : public SphSolver3 {
+ public:
+    using SphSolver3::accumulatePressureForce;
+    using SphSolver3::accumulateViscosityForce;
+};
+
+}  // namespace
+
+TEST(SphSolver3, ForceKernels) {
+    SphSolver3ForTest solver;
+    auto particles = solver.sphSystemData();
+    particles->setTargetSpacing(0.1);
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    for (size_t k = 0; k < 8; ++k) {
+        for (size_t j = 0; j < 8; ++j) {
+            for (size_t i = 0; i < 8; ++i) {
+                particles->addParticle(
+                    0.1 * Vector3D(i + 0.2 * d(rng), j + 0.2 * d(rng),
+                                   k + 0.2 * d(rng)),
+                    Vector3D(d(rng), d(rng), d(rng)));
+            }
+        }
+    }
+
+    particles->buildNeighborSearcher();
+    particles->buildNeighborLists();
+    particles->updateDensities();
+
+    const size_t n = particles->numberOfParticles();
+    auto x = particles->positions();
+    auto v = particles->velocities();
+    auto den = particles->densities();
+    auto p = particles->pressures();
+    for (size_t i = 0; i < n; ++i) {
+        p[i] = 1000.0 * (d(rng) - 0.5);
+    }
+
+    // Reference forces using the kernel functions. With JET_USE_AVX2, this
+    // checks the AVX2 force loops against the scalar kernels.
+    const double massSquared = square(particles->mass());
+    const SphSpikyKernel3 kernel(particles->kernelRadius());
+    Array1<Vector3D> expectedPressure(n);
+    Array1<Vector3D> expectedViscosity(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j : particles->neighborLists()[i]) {
+            double dist = x[i].distanceTo(x[j]);
+            if (dist > 0.0) {
+                Vector3D dir = (x[j] - x[i]) / dist;
+                expectedPressure[i] -=
+                    massSquared *
+                    (p[i] / (den[i] * den[i]) + p[j] / (den[j] * den[j])) *
+                    kernel.gradient(dist, dir);
+            }
+            expectedViscosity[i] += solver.viscosityCoefficient() *
+                                    massSquared * (v[j] - v[i]) / den[j] *
+                                    kernel.secondDerivative(dist);
+        }
+    }
+
+    Array1<Vector3D> pressureForces(n);
+    solver.accumulatePressureForce(ConstArrayAccessor1<Vector3D>(x),
+                                   ConstArrayAccessor1<double>(den),
+                                   ConstArrayAccessor1<double>(p),
+                                   pressureForces.accessor());
+    solver.accumulateViscosityForce();
+
+    auto f = particles->forces();
+    for (size_t i = 0; i < n; ++i) {
+        const double pScale = std::max(expectedPressure[i].length(), 1.0);
+        const double vScale = std::max(expectedViscosity[i].length(), 1e-6);
+        EXPECT_NEAR(0.0, (expectedPressure[i] - pressureForces[i]).length(),
+                    1e-10 * pScale);
+        EXPECT_NEAR(0.0, (expectedViscosity[i] - f[i]).length(),
+                    1e-10 * vScale);
+    }
+}
+
+TEST(SphSolver3, Restart) {
+    auto makeSolver = []() {
+        auto solver = SphSolver3::builder()
+                          .withTargetDensity(1000.0)
+                          .withTargetSpacing(0.05)
+                          .makeShared();
+        solver->setSpatialSortingInterval(3);
+
+        auto box = Box3::builder()
+                       .withLowerCorner({0.0, 0.0, 0.0})
+                       .withUpperCorner({0.3, 0.3, 0.3})
+                       .makeShared();
+        auto volumeEmitter = VolumeParticleEmitter3::builder()
+                                 .withSurface(box)
+                                 .withSpacing(0.05)
+                                 .withJitter(0.2)
+                                 .withIsOneShot(true)
+                                 .makeShared();
+        auto pointEmitter = PointParticleEmitter3::builder()
+                                .withOrigin({0.5, 0.5, 0.5})
+                                .withDirection({0.0, -1.0, 0.0})
+                                .withSpeed(0.5)
+                                .withSpreadAngleInDegrees(30.0)
+                                .withMaxNumberOfNewParticlesPerSecond(2000)
+                                .makeShared();
+        solver->setEmitter(ParticleEmitterSet3::builder()
+                               .withEmitters({volumeEmitter, pointEmitter})
+                               .makeShared());
+
+        auto domain = Box3::builder()
+                          .withLowerCorner({0.0, 0.0, 0.0})
+                          .withUpperCorner({1.0, 1.0, 1.0})
+                          .withIsNormalFlipped(true)
+                          .makeShared();
+        solver->setCollider(
+            RigidBodyCollider3::builder().withSurface(domain).makeShared());
+        return solver;
+    };
+
+    auto solver = makeSolver();
+    Frame frame(0, 0.005);
+    for (; frame.index < 3; ++frame) {
+        solver->update(frame);
+    }
+
+    Checkpoint checkpoint;
+    solver->saveCheckpoint(&checkpoint);
+    const Frame restartFrame = frame;
+
+    for (; frame.index < 6; ++frame) {
+        solver->update(frame);
+    }
+
+    auto restored = makeSolver();
+    restored->loadCheckpoint(checkpoint);
+    for (frame = restartFrame; frame.index < 6; ++frame) {
+        restored->update(frame);
+    }
+
+    auto particles = solver->sphSystemData();
+    auto restoredParticles = restored->sphSystemData();
+    ASSERT_EQ(particles->numberOfParticles(),
+              restoredParticles->numberOfParticles());
+    auto positions = particles->positions();
+    auto restoredPositions = restoredParticles->positions();
+    auto densities = particles->densities();
+    auto restoredDensities = restoredParticles->densities();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(positions[i], restoredPositions[i]);
+        EXPECT_EQ(densities[i], restoredDensities[i]);
+    }
+}
@@ -6,6 +6,7 @@
 
 #include <jet/sph_system_data3.h>
 #include <gtest/gtest.h>
+#include <random>
 #include <vector>
 
 using namespace jet;
@@ -61,6 +62,55 @@ TEST(SphSystemData3, Particles) {
     EXPECT_GT(1.0, midVal);
 }
 
+TEST(SphSystemData3, BatchedInterpolate) {
+    SphSystemData3 data;
+    data.setTargetSpacing(0.1);
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    for (size_t i = 0; i < 500; ++i) {
+        data.addParticle(Vector3D(d(rng), d(rng), d(rng)));
+    }
+
+    data.buildNeighborSearcher();
+    data.updateDensities();
+
+    auto p = data.positions();
+    auto den = data.densities();
+    for (size_t i = 0; i < data.numberOfParticles(); ++i) {
+        EXPECT_NEAR(data.mass() * data.sumOfKernelNearby(p[i]), den[i],
+                    1e-9 * den[i]);
+    }
+
+    Array1<Vector3D> origins(100);
+    Array1<double> values(data.numberOfParticles());
+    Array1<Vector3D> vectorValues(data.numberOfParticles());
+    for (size_t i = 0; i < origins.size(); ++i) {
+        origins[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = d(rng);
+        vectorValues[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+
+    Array1<double> results(origins.size());
+    Array1<Vector3D> vectorResults(origins.size());
+    data.interpolate(origins.constAccessor(), values.constAccessor(),
+                     results.accessor());
+    data.interpolate(origins.constAccessor(), vectorValues.constAccessor(),
+                     vectorResults.accessor());
+
+    for (size_t i = 0; i < origins.size(); ++i) {
+        EXPECT_NEAR(data.interpolate(origins[i], values.constAccessor()),
+                    results[i], 1e-9);
+        const Vector3D expected =
+            data.interpolate(origins[i], vectorValues.constAccessor());
+        EXPECT_NEAR(expected.x, vectorResults[i].x, 1e-9);
+        EXPECT_NEAR(expected.y, vectorResults[i].y, 1e-9);
+        EXPECT_NEAR(expected.z, vectorResults[i].z, 1e-9);
+    }
+}
+
 TEST(SphSystemData3, Serialization) {
     SphSystemData3 data;
 
@@ -0,0 +1,93 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/thread_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace jet;
+
+TEST(ThreadPool, Schedule) {
+    std::atomic<int> counter(0);
+    {
+        ThreadPool pool(3);
+        EXPECT_EQ(3u, pool.numberOfWorkers());
+
+        for (int i = 0; i < 100; ++i) {
+            pool.schedule([&counter]() { ++counter; });
+        }
+    }
+
+    // Destructor finishes all the queued tasks.
+    EXPECT_EQ(100, counter.load());
+}
+
+TEST(ThreadPool, ScheduleWithoutWorkers) {
+    ThreadPool pool(0);
+    int counter = 0;
+    pool.schedule([&counter]() { ++counter; });
+    EXPECT_EQ(1, counter);
+    EXPECT_FALSE(pool.runPendingTask());
+}
+
+TEST(ThreadPool, ForEachChunk) {
+    ThreadPool pool(3);
+
+    std::vector<int> visits(1000, 0);
+    pool.forEachChunk(visits.size(), [&visits](size_t c) { ++visits[c]; });
+
+    for (int v : visits) {
+        EXPECT_EQ(1, v);
+    }
+}
+
+TEST(ThreadPool, NestedForEachChunk) {
+    ThreadPool pool(2);
+
+    const size_t n = 32;
+    std::vector<std::atomic<int>> visits(n * n);
+    for (auto& v : visits) {
+        v = 0;
+    }
+
+    pool.forEachChunk(n, [&](size_t j) {
+        pool.forEachChunk(n, [&](size_t i) { ++visits[i + n * j]; });
+    });
+
+    for (const auto& v : visits) {
+        EXPECT_EQ(1, v.load());
+    }
+}
+
+TEST(ThreadPool, Resize) {
+    ThreadPool pool(1);
+
+    std::atomic<int> counter(0);
+    for (int i = 0; i < 10; ++i) {
+        pool.schedule([&counter]() { ++counter; });
+    }
+
+    pool.resize(4);
+    EXPECT_EQ(4u, pool.numberOfWorkers());
+    EXPECT_EQ(10, counter.load());
+
+    std::vector<int> visits(100, 0);
+    pool.forEachChunk(visits.size(), [&visits](size_t c) { ++visits[c]; });
+    for (int v : visits) {
+        EXPECT_EQ(1, v);
+    }
+
+    pool.resize(0);
+    EXPECT_EQ(0u, pool.numberOfWorkers());
+
+    pool.forEachChunk(visits.size(), [&visits](size_t c) { ++visits[c]; });
+    for (int v : visits) {
+        EXPECT_EQ(2, v);
+    }
+}
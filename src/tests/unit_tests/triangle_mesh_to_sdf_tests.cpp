@@ -55,3 +55,98 @@ TEST(TriangleMeshToSdf, TriangleMeshToSdf) {
             EXPECT_DOUBLE_EQ(ans, grid(i, j, k));
         });
 }
+
+TEST(TriangleMeshToSdf, NarrowBand) {
+    TriangleMesh3 mesh;
+
+    // Build a cube
+    mesh.addPoint({0.0, 0.0, 0.0});
+    mesh.addPoint({0.0, 0.0, 1.0});
+    mesh.addPoint({0.0, 1.0, 0.0});
+    mesh.addPoint({0.0, 1.0, 1.0});
+    mesh.addPoint({1.0, 0.0, 0.0});
+    mesh.addPoint({1.0, 0.0, 1.0});
+    mesh.addPoint({1.0, 1.0, 0.0});
+    mesh.addPoint({1.0, 1.0, 1.0});
+
+    mesh.addPointTriangle({0, 1, 3});
+    mesh.addPointTriangle({0, 3, 2});
+    mesh.addPointTriangle({4, 6, 7});
+    mesh.addPointTriangle({4, 7, 5});
+    mesh.addPointTriangle({0, 4, 5});
+    mesh.addPointTriangle({0, 5, 1});
+    mesh.addPointTriangle({2, 3, 7});
+    mesh.addPointTriangle({2, 7, 6});
+    mesh.addPointTriangle({0, 2, 6});
+    mesh.addPointTriangle({0, 6, 4});
+    mesh.addPointTriangle({1, 5, 7});
+    mesh.addPointTriangle({1, 7, 3});
+
+    // Larger than a single sweeping tile, and the far points are only
+    // reached by the sweeps.
+    CellCenteredScalarGrid3 grid(
+        37, 37, 37,
+        0.05, 0.05, 0.05,
+        -0.4, -0.4, -0.4);
+
+    triangleMeshToSdf(mesh, &grid, 1);
+
+    Box3 box(Vector3D(), Vector3D(1.0, 1.0, 1.0));
+
+    auto gridPos = grid.dataPosition();
+    grid.forEachDataPointIndex(
+        [&](size_t i, size_t j, size_t k) {
+            auto pos = gridPos(i, j, k);
+            double ans = box.closestDistance(pos);
+            ans *= box.bound.contains(pos) ? -1.0 : 1.0;
+            EXPECT_NEAR(ans, grid(i, j, k), 1e-9);
+        });
+}
+
+TEST(TriangleMeshToSdf, FarCorner) {
+    TriangleMesh3 mesh;
+
+    // Build a small cube near the +x+y+z corner of the grid, so most of the
+    // grid is only reached by the sweeps toward the -x-y-z corner.
+    const Vector3D lower(0.8, 0.8, 0.8);
+    const Vector3D upper(0.95, 0.95, 0.95);
+    mesh.addPoint({lower.x, lower.y, lower.z});
+    mesh.addPoint({lower.x, lower.y, upper.z});
+    mesh.addPoint({lower.x, upper.y, lower.z});
+    mesh.addPoint({lower.x, upper.y, upper.z});
+    mesh.addPoint({upper.x, lower.y, lower.z});
+    mesh.addPoint({upper.x, lower.y, upper.z});
+    mesh.addPoint({upper.x, upper.y, lower.z});
+    mesh.addPoint({upper.x, upper.y, upper.z});
+
+    mesh.addPointTriangle({0, 1, 3});
+    mesh.addPointTriangle({0, 3, 2});
+    mesh.addPointTriangle({4, 6, 7});
+    mesh.addPointTriangle({4, 7, 5});
+    mesh.addPointTriangle({0, 4, 5});
+    mesh.addPointTriangle({0, 5, 1});
+    mesh.addPointTriangle({2, 3, 7});
+    mesh.addPointTriangle({2, 7, 6});
+    mesh.addPointTriangle({0, 2, 6});
+    mesh.addPointTriangle({0, 6, 4});
+    mesh.addPointTriangle({1, 5, 7});
+    mesh.addPointTriangle({1, 7, 3});
+
+    CellCenteredScalarGrid3 grid(
+        64, 64, 64,
+        1.0 / 64.0, 1.0 / 64.0, 1.0 / 64.0,
+        0.0, 0.0, 0.0);
+
+    triangleMeshToSdf(mesh, &grid, 1);
+
+    Box3 box(lower, upper);
+
+    auto gridPos = grid.dataPosition();
+    grid.forEachDataPointIndex(
+        [&](size_t i, size_t j, size_t k) {
+            auto pos = gridPos(i, j, k);
+            double ans = box.closestDistance(pos);
+            ans *= box.bound.contains(pos) ? -1.0 : 1.0;
+            EXPECT_NEAR(ans, grid(i, j, k), 1e-9);
+        });
+}